@@ -0,0 +1,134 @@
+//
+//  PrecomputeBasisReconciliationWeights.cpp
+//  Camellia
+//
+//  Computes the BasisReconciliation weights needed for hanging nodes and polynomial-order mismatches on Poisson meshes
+//  of the requested topology and range of polynomial orders, and writes them to a file that can be read at startup with
+//  BasisReconciliation::loadPersistentWeights().  Run on a single MPI rank; several runs may append to the same file, e.g.:
+//    ./PrecomputeBasisReconciliationWeights --spaceDim=3 --maxPolyOrder=4 --weightsFile=weights.bin
+//    ./PrecomputeBasisReconciliationWeights --spaceDim=2 --useTriangles --maxPolyOrder=4 --weightsFile=weights.bin
+
+#include "BasisReconciliation.h"
+#include "GDAMinimumRule.h"
+#include "MeshFactory.h"
+#include "PoissonFormulation.h"
+
+#include "Epetra_Time.h"
+#include "Teuchos_CommandLineProcessor.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+
+#ifdef HAVE_MPI
+#include "Epetra_MpiComm.h"
+#else
+#include "Epetra_SerialComm.h"
+#endif
+
+using namespace Camellia;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv, NULL);
+  int rank = Teuchos::GlobalMPISession::getRank();
+
+#ifdef HAVE_MPI
+  Epetra_MpiComm Comm(MPI_COMM_WORLD);
+#else
+  Epetra_SerialComm Comm;
+#endif
+
+  Teuchos::CommandLineProcessor cmdp(false,true); // false: don't throw exceptions; true: do return errors for unrecognized options
+
+  int spaceDim = 2;
+  bool useTriangles = false;
+  bool useConformingTraces = true;
+  int minPolyOrder = 1;
+  int maxPolyOrder = 3;
+  int delta_k = -1; // -1: use spaceDim
+  string weightsFile = "BasisReconciliationWeights.bin";
+
+  cmdp.setOption("spaceDim", &spaceDim, "spatial dimension (1, 2, or 3)");
+  cmdp.setOption("useTriangles", "useQuads", &useTriangles, "use triangles (spaceDim 2 only)");
+  cmdp.setOption("conformingTraces", "nonconformingTraces", &useConformingTraces, "use H^1-conforming traces");
+  cmdp.setOption("minPolyOrder", &minPolyOrder, "least polynomial order for field variables");
+  cmdp.setOption("maxPolyOrder", &maxPolyOrder, "greatest polynomial order for field variables");
+  cmdp.setOption("delta_k", &delta_k, "test space polynomial order enrichment (-1 for spaceDim)");
+  cmdp.setOption("weightsFile", &weightsFile, "file to which weights are written; existing weights in the file are retained");
+
+  if (cmdp.parse(argc,argv) != Teuchos::CommandLineProcessor::PARSE_SUCCESSFUL)
+  {
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+    return -1;
+  }
+
+  if (delta_k == -1) delta_k = spaceDim;
+
+  BasisReconciliation::setUsePersistentWeights(true);
+  bool loadedExisting = BasisReconciliation::loadPersistentWeights(weightsFile);
+  int initialWeightsCount = BasisReconciliation::persistentWeightsCount();
+  if (rank == 0)
+  {
+    if (loadedExisting) cout << "Read " << initialWeightsCount << " weights from " << weightsFile << ".\n";
+    else cout << "Starting a new weights file " << weightsFile << ".\n";
+  }
+
+  Epetra_Time timer(Comm);
+  PoissonFormulation form(spaceDim, useConformingTraces);
+  for (int polyOrder=minPolyOrder; polyOrder<=maxPolyOrder; polyOrder++)
+  {
+    int H1Order = polyOrder + 1;
+    MeshPtr mesh;
+    if (useTriangles)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(spaceDim != 2, std::invalid_argument, "useTriangles is only supported for spaceDim = 2");
+      bool divideIntoTriangles = true;
+      mesh = MeshFactory::quadMeshMinRule(form.bf(), H1Order, delta_k, 1.0, 1.0, 2, 2, divideIntoTriangles);
+    }
+    else
+    {
+      vector<double> dimensions(spaceDim,1.0);
+      vector<int> elementCounts(spaceDim,2);
+      mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+    }
+
+    // two levels of refinement toward the origin produce hanging entities of each dimension; a p-refinement of one of the
+    // finest cells produces polynomial-order mismatches as well.
+    Intrepid::FieldContainer<double> originPoint(1,spaceDim);
+    originPoint.initialize(1e-3);
+    int numRefinements = 2;
+    for (int refNumber=0; refNumber<numRefinements; refNumber++)
+    {
+      bool minusOnesForOffRank = false;
+      GlobalIndexType cellID = mesh->cellIDsForPoints(originPoint, minusOnesForOffRank)[0];
+      mesh->hRefine(vector<GlobalIndexType>{cellID});
+      mesh->enforceOneIrregularity();
+    }
+    bool minusOnesForOffRank = false;
+    GlobalIndexType cornerCellID = mesh->cellIDsForPoints(originPoint, minusOnesForOffRank)[0];
+    mesh->pRefine(vector<GlobalIndexType>{cornerCellID});
+
+    // the weights are computed in the course of constructing the local-to-global dof maps
+    GDAMinimumRule* minRule = dynamic_cast<GDAMinimumRule*>(mesh->globalDofAssignment().get());
+    for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+    {
+      CellConstraints constraints = minRule->getCellConstraints(cellID);
+      minRule->getDofMapper(cellID, constraints);
+    }
+    if (rank == 0)
+    {
+      cout << "polyOrder " << polyOrder << ": " << BasisReconciliation::persistentWeightsCount() << " weights after ";
+      cout << timer.ElapsedTime() << " s.\n";
+    }
+  }
+
+  if (rank == 0)
+  {
+    BasisReconciliation::savePersistentWeights(weightsFile);
+    cout << "Wrote " << BasisReconciliation::persistentWeightsCount() << " weights (";
+    cout << BasisReconciliation::persistentWeightsCount() - initialWeightsCount << " new) to " << weightsFile << ".\n";
+  }
+
+  return 0;
+}
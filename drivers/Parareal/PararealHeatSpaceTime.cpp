@@ -0,0 +1,396 @@
+//
+//  PararealHeatSpaceTime.cpp
+//  Camellia
+//
+//  Parallel-in-time solution of the space-time heat equation by Parareal iteration over time slabs.  The MPI ranks are
+//  divided into groups of ranksPerSlab; each group owns one time slab [t_j, t_{j+1}], and solves on a space-time mesh
+//  distributed over its own sub-communicator.  Two propagators are built from the same SpaceTimeHeatFormulation bilinear
+//  form: a fine propagator F and a coarse propagator G that uses a lower polynomial order and/or coarser space-time mesh.
+//  The state at the slab interfaces is an L^2 projection of u onto a (replicated, serial) spatial mesh; interface states
+//  are passed between neighboring slab groups with MPI, and the Parareal update
+//    U_{j+1}^{k+1} = G(U_j^{k+1}) + F(U_j^k) - G(U_j^k)
+//  is iterated until the largest interface update falls below the requested tolerance.  After numSlabs iterations the
+//  interface states agree with sequential fine propagation.  E.g., with 4 slabs of 2 ranks each:
+//    mpirun -np 8 ./PararealHeatSpaceTime --ranksPerSlab=2 --finalTime=1.0 --polyOrder=3 --coarsePolyOrder=1
+
+#include "ExpFunction.h"
+#include "Function.h"
+#include "MeshFactory.h"
+#include "MeshPartitionPolicy.h"
+#include "MPIWrapper.h"
+#include "Solution.h"
+#include "SpaceTimeHeatFormulation.h"
+#include "TrigFunctions.h"
+#include "TypeDefs.h"
+#include "VarFactory.h"
+
+#include "Epetra_Time.h"
+#include "Teuchos_CommandLineProcessor.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+
+#ifdef HAVE_MPI
+#include "Epetra_MpiComm.h"
+#else
+#include "Epetra_SerialComm.h"
+#endif
+
+using namespace Camellia;
+using namespace Intrepid;
+using namespace std;
+
+const static double PI  = 3.141592653589793238462;
+
+// ! Evaluates an interface state (a function of space only) at space-time points, ignoring the temporal coordinate.
+// ! Used to impose the slab's initial condition.
+class InterfaceStateFunction : public TFunction<double>
+{
+  SolutionPtr _state;
+  VarPtr _var;
+public:
+  InterfaceStateFunction(SolutionPtr state, VarPtr var) : _state(state), _var(var) {}
+
+  void values(FieldContainer<double> &values, BasisCachePtr basisCache)
+  {
+    const FieldContainer<double>* points = &basisCache->getPhysicalCubaturePoints();
+    int numCells = values.dimension(0);
+    int numPoints = values.dimension(1);
+    int spaceDim = points->dimension(2) - 1; // last coordinate is time
+
+    FieldContainer<double> spatialPoints(numCells * numPoints, spaceDim);
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          spatialPoints(cellOrdinal*numPoints+pointOrdinal,d) = (*points)(cellOrdinal,pointOrdinal,d);
+        }
+      }
+    }
+    FieldContainer<double> stateValues(numCells * numPoints);
+    _state->solutionValues(stateValues, _var->ID(), spatialPoints);
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        values(cellOrdinal,pointOrdinal) = stateValues(cellOrdinal*numPoints+pointOrdinal);
+      }
+    }
+  }
+};
+
+// ! Evaluates a space-time solution at the final time of its slab, at spatial points.  Collective on the slab
+// ! communicator: each rank must make the same sequence of calls.
+class SlabFinalStateFunction : public TFunction<double>
+{
+  SolutionPtr _slabSolution;
+  VarPtr _var;
+  double _t1;
+public:
+  SlabFinalStateFunction(SolutionPtr slabSolution, VarPtr var, double t1) : _slabSolution(slabSolution), _var(var), _t1(t1) {}
+
+  void values(FieldContainer<double> &values, BasisCachePtr basisCache)
+  {
+    const FieldContainer<double>* points = &basisCache->getPhysicalCubaturePoints();
+    int numCells = values.dimension(0);
+    int numPoints = values.dimension(1);
+    int spaceDim = points->dimension(2);
+
+    FieldContainer<double> spaceTimePoints(numCells * numPoints, spaceDim + 1);
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          spaceTimePoints(cellOrdinal*numPoints+pointOrdinal,d) = (*points)(cellOrdinal,pointOrdinal,d);
+        }
+        spaceTimePoints(cellOrdinal*numPoints+pointOrdinal,spaceDim) = _t1;
+      }
+    }
+    FieldContainer<double> slabValues(numCells * numPoints);
+    _slabSolution->solutionValues(slabValues, _var->ID(), spaceTimePoints);
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        values(cellOrdinal,pointOrdinal) = slabValues(cellOrdinal*numPoints+pointOrdinal);
+      }
+    }
+  }
+};
+
+// ! Solves the heat equation on one time slab, with initial data taken from an interface state.
+class SlabPropagator
+{
+  SolutionPtr _slabSolution;
+  VarPtr _u;
+  FunctionPtr _finalState;
+public:
+  SlabPropagator(SpaceTimeHeatFormulation &form, int spaceDim, int spatialElements, int temporalDivisions,
+                 double t0, double t1, int polyOrder, int delta_k, SolutionPtr initialState, VarPtr interfaceVar,
+                 Epetra_CommPtr slabComm)
+  {
+    vector<double> dims(spaceDim,1.0);
+    vector<int> numElements(spaceDim,spatialElements);
+    vector<double> x0(spaceDim,0.0);
+    MeshTopologyPtr spatialMeshTopo = MeshFactory::rectilinearMeshTopology(dims,numElements,x0);
+    MeshTopologyPtr slabMeshTopo = MeshFactory::spaceTimeMeshTopology(spatialMeshTopo, t0, t1, temporalDivisions);
+
+    vector<int> H1Order = {polyOrder + 1, polyOrder + 1};
+    // the standard (Zoltan) partition policy partitions over MPI_COMM_WORLD; the space-filling curve respects slabComm
+    MeshPartitionPolicyPtr partitionPolicy = MeshPartitionPolicy::spaceFillingCurvePartitionPolicy(slabComm);
+    MeshPtr slabMesh = Teuchos::rcp( new Mesh(slabMeshTopo, form.bf()->varFactory(), H1Order, delta_k, map<int,int>(), map<int,int>(),
+                                              partitionPolicy, slabComm) );
+    slabMesh->setBilinearForm(form.bf());
+
+    BCPtr bc = BC::bc();
+    FunctionPtr initialCondition = Teuchos::rcp( new InterfaceStateFunction(initialState, interfaceVar) );
+    bc->addDirichlet(form.u_hat(), SpatialFilter::matchingT(t0), initialCondition);
+    SpatialFilterPtr spatialBoundary = SpatialFilter::matchingX(0) | SpatialFilter::matchingX(1);
+    if (spaceDim > 1) spatialBoundary = spatialBoundary | SpatialFilter::matchingY(0) | SpatialFilter::matchingY(1);
+    if (spaceDim > 2) spatialBoundary = spatialBoundary | SpatialFilter::matchingZ(0) | SpatialFilter::matchingZ(1);
+    bc->addDirichlet(form.sigma_n_hat(), spatialBoundary, Function::zero());
+
+    RHSPtr rhs = form.rhs(Teuchos::null);
+    IPPtr ip = form.bf()->graphNorm();
+    _slabSolution = Solution::solution(form.bf(), slabMesh, bc, rhs, ip);
+    _u = form.u();
+    _finalState = Teuchos::rcp( new SlabFinalStateFunction(_slabSolution, _u, t1) );
+  }
+
+  // ! solves on the slab using the present values of the initial state, and projects u at the final time onto finalState
+  void propagate(SolutionPtr finalState, VarPtr interfaceVar)
+  {
+    _slabSolution->solve();
+    map<int, FunctionPtr> projectionMap = {{interfaceVar->ID(), _finalState}};
+    finalState->projectOntoMesh(projectionMap);
+  }
+};
+
+vector<double> getCoefficients(SolutionPtr state)
+{
+  vector<double> coefficients;
+  for (GlobalIndexType cellID : state->mesh()->getActiveCellIDs())
+  {
+    bool warnAboutOffRankImports = false;
+    const FieldContainer<double>* cellCoefficients = &state->allCoefficientsForCellID(cellID, warnAboutOffRankImports);
+    coefficients.insert(coefficients.end(), &(*cellCoefficients)[0], &(*cellCoefficients)[0] + cellCoefficients->size());
+  }
+  return coefficients;
+}
+
+void setCoefficients(SolutionPtr state, const vector<double> &coefficients)
+{
+  int offset = 0;
+  for (GlobalIndexType cellID : state->mesh()->getActiveCellIDs())
+  {
+    int numDofs = state->mesh()->getElementType(cellID)->trialOrderPtr->totalDofs();
+    FieldContainer<double> cellCoefficients(numDofs);
+    for (int dofOrdinal=0; dofOrdinal<numDofs; dofOrdinal++)
+    {
+      cellCoefficients(dofOrdinal) = coefficients[offset+dofOrdinal];
+    }
+    state->setLocalCoefficientsForCell(cellID, cellCoefficients);
+    offset += numDofs;
+  }
+}
+
+void sendState(const vector<double> &coefficients, int destinationRank)
+{
+#ifdef HAVE_MPI
+  MPI_Send(const_cast<double*>(&coefficients[0]), coefficients.size(), MPI_DOUBLE, destinationRank, 0, MPI_COMM_WORLD);
+#endif
+}
+
+void receiveState(vector<double> &coefficients, int sourceRank)
+{
+#ifdef HAVE_MPI
+  MPI_Recv(&coefficients[0], coefficients.size(), MPI_DOUBLE, sourceRank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv, NULL);
+  int rank = Teuchos::GlobalMPISession::getRank();
+  int numProcs = Teuchos::GlobalMPISession::getNProc();
+
+  Epetra_CommPtr worldComm = MPIWrapper::CommWorld();
+
+  Teuchos::CommandLineProcessor cmdp(false,true); // false: don't throw exceptions; true: do return errors for unrecognized options
+
+  int spaceDim = 1;
+  double eps = 1e-2;
+  double finalTime = 1.0;
+  int ranksPerSlab = 1;
+  int spatialElements = 4;
+  int temporalDivisions = 4; // per slab, fine propagator
+  int polyOrder = 3;
+  int coarseSpatialElements = -1; // -1: same as fine
+  int coarseTemporalDivisions = 1;
+  int coarsePolyOrder = 1;
+  int delta_k = -1; // -1: use spaceDim + 1
+  int maxIterations = -1; // -1: numSlabs
+  double tol = 1e-8;
+
+  cmdp.setOption("spaceDim", &spaceDim, "spatial dimension (1, 2, or 3)");
+  cmdp.setOption("epsilon", &eps, "diffusion coefficient");
+  cmdp.setOption("finalTime", &finalTime, "final time; the interval [0, finalTime] is divided evenly among the slabs");
+  cmdp.setOption("ranksPerSlab", &ranksPerSlab, "MPI ranks per time slab; the number of slabs is numProcs / ranksPerSlab");
+  cmdp.setOption("spatialElements", &spatialElements, "elements in each spatial direction, fine propagator");
+  cmdp.setOption("temporalDivisions", &temporalDivisions, "temporal elements per slab, fine propagator");
+  cmdp.setOption("polyOrder", &polyOrder, "polynomial order for field variables, fine propagator");
+  cmdp.setOption("coarseSpatialElements", &coarseSpatialElements, "elements in each spatial direction, coarse propagator (-1 for fine value)");
+  cmdp.setOption("coarseTemporalDivisions", &coarseTemporalDivisions, "temporal elements per slab, coarse propagator");
+  cmdp.setOption("coarsePolyOrder", &coarsePolyOrder, "polynomial order for field variables, coarse propagator");
+  cmdp.setOption("delta_k", &delta_k, "test space polynomial order enrichment (-1 for spaceDim + 1)");
+  cmdp.setOption("maxIterations", &maxIterations, "maximum Parareal iterations (-1 for numSlabs)");
+  cmdp.setOption("tol", &tol, "tolerance for the L^2 norm of the interface update");
+
+  if (cmdp.parse(argc,argv) != Teuchos::CommandLineProcessor::PARSE_SUCCESSFUL)
+  {
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+    return -1;
+  }
+
+  TEUCHOS_TEST_FOR_EXCEPTION(numProcs % ranksPerSlab != 0, std::invalid_argument, "numProcs must be divisible by ranksPerSlab");
+  int numSlabs = numProcs / ranksPerSlab;
+  if (delta_k == -1) delta_k = spaceDim + 1;
+  if (coarseSpatialElements == -1) coarseSpatialElements = spatialElements;
+  if (maxIterations == -1) maxIterations = numSlabs;
+
+  int slabOrdinal = rank / ranksPerSlab;
+  double t0 = (finalTime * slabOrdinal) / numSlabs;
+  double t1 = (finalTime * (slabOrdinal + 1)) / numSlabs;
+  bool hasPreviousSlab = (slabOrdinal > 0);
+  bool hasNextSlab = (slabOrdinal < numSlabs - 1);
+  int previousSlabPeer = rank - ranksPerSlab; // ranks exchange with the rank in the same position in the neighboring group
+  int nextSlabPeer = rank + ranksPerSlab;
+
+#ifdef HAVE_MPI
+  MPI_Comm slabMPIComm;
+  MPI_Comm_split(MPI_COMM_WORLD, slabOrdinal, rank, &slabMPIComm);
+  Epetra_CommPtr slabComm = Teuchos::rcp( new Epetra_MpiComm(slabMPIComm) );
+#else
+  Epetra_CommPtr slabComm = MPIWrapper::CommSerial();
+#endif
+
+  {
+    Epetra_Time timer(*worldComm);
+
+    // interface states: L^2 projections of u onto a spatial mesh, replicated on every rank
+    VarFactoryPtr interfaceVF = VarFactory::varFactory();
+    VarPtr uInterface = interfaceVF->fieldVar("u");
+    VarPtr vInterface = interfaceVF->testVar("v", HGRAD);
+    BFPtr interfaceBF = BF::bf(interfaceVF);
+    interfaceBF->addTerm(uInterface, vInterface);
+
+    vector<double> dims(spaceDim,1.0);
+    vector<int> numElements(spaceDim,spatialElements);
+    vector<double> x0(spaceDim,0.0);
+    MeshTopologyPtr interfaceMeshTopo = MeshFactory::rectilinearMeshTopology(dims,numElements,x0);
+    Epetra_CommPtr serialComm = MPIWrapper::CommSerial();
+    MeshPartitionPolicyPtr serialPolicy = MeshPartitionPolicy::spaceFillingCurvePartitionPolicy(serialComm);
+    int interfacePToAdd = 1;
+    MeshPtr interfaceMesh = Teuchos::rcp( new Mesh(interfaceMeshTopo, interfaceVF, polyOrder + 1, interfacePToAdd,
+                                                   map<int,int>(), map<int,int>(), serialPolicy, serialComm) );
+    interfaceMesh->setBilinearForm(interfaceBF);
+
+    SolutionPtr initialState = Solution::solution(interfaceBF, interfaceMesh);
+    SolutionPtr finalState = Solution::solution(interfaceBF, interfaceMesh);
+    SolutionPtr scratchState = Solution::solution(interfaceBF, interfaceMesh);
+
+    FunctionPtr cos_2pi_x = Teuchos::rcp( new Cos_ax(2 * PI) );
+    double lambda = -4.0 * PI * PI * eps;
+    map<int, FunctionPtr> initialConditionMap = {{uInterface->ID(), cos_2pi_x}};
+    initialState->projectOntoMesh(initialConditionMap);
+    finalState->projectOntoMesh(initialConditionMap); // sizes the coefficient containers
+    scratchState->projectOntoMesh(initialConditionMap);
+
+    SpaceTimeHeatFormulation form(spaceDim, eps);
+    SlabPropagator fine(form, spaceDim, spatialElements, temporalDivisions, t0, t1, polyOrder, delta_k,
+                        initialState, uInterface, slabComm);
+    SlabPropagator coarse(form, spaceDim, coarseSpatialElements, coarseTemporalDivisions, t0, t1, coarsePolyOrder, delta_k,
+                          initialState, uInterface, slabComm);
+
+    vector<double> U_in = getCoefficients(initialState);
+    vector<double> U_out(U_in.size());
+
+    // iteration 0: sequential coarse sweep
+    if (hasPreviousSlab)
+    {
+      receiveState(U_in, previousSlabPeer);
+      setCoefficients(initialState, U_in);
+    }
+    coarse.propagate(finalState, uInterface);
+    vector<double> G_old = getCoefficients(finalState);
+    U_out = G_old;
+    if (hasNextSlab) sendState(U_out, nextSlabPeer);
+
+    if (rank == 0)
+    {
+      cout << "Parareal on " << numSlabs << " slabs of " << ranksPerSlab << " ranks; coarse sweep took ";
+      cout << timer.ElapsedTime() << " s.\n";
+      cout << setw(10) << "iteration" << setw(25) << "max interface update" << setw(15) << "time (s)" << endl;
+    }
+
+    double maxUpdate = 0.0;
+    int iteration;
+    for (iteration=1; iteration<=maxIterations; iteration++)
+    {
+      // fine propagation from the previous iterate: concurrent across slabs
+      fine.propagate(finalState, uInterface);
+      vector<double> F_old = getCoefficients(finalState);
+
+      // coarse correction: sequential across slabs
+      if (hasPreviousSlab)
+      {
+        receiveState(U_in, previousSlabPeer);
+        setCoefficients(initialState, U_in);
+      }
+      coarse.propagate(finalState, uInterface);
+      vector<double> G_new = getCoefficients(finalState);
+
+      vector<double> update(U_out.size());
+      for (int i=0; i<U_out.size(); i++)
+      {
+        double U_new = G_new[i] + F_old[i] - G_old[i];
+        update[i] = U_new - U_out[i];
+        U_out[i] = U_new;
+      }
+      G_old = G_new;
+      if (hasNextSlab) sendState(U_out, nextSlabPeer);
+
+      setCoefficients(scratchState, update);
+      double myUpdate = Function::solution(uInterface, scratchState)->l2norm(interfaceMesh);
+      worldComm->MaxAll(&myUpdate, &maxUpdate, 1);
+
+      if (rank == 0) cout << setw(10) << iteration << setw(25) << maxUpdate << setw(15) << timer.ElapsedTime() << endl;
+      if (maxUpdate < tol) break;
+    }
+
+    // error at the final time, measured on the last slab
+    double myError = 0.0;
+    if (!hasNextSlab && (slabComm->MyPID() == 0))
+    {
+      setCoefficients(finalState, U_out);
+      FunctionPtr u_exact_final = exp(lambda * finalTime) * cos_2pi_x;
+      myError = (Function::solution(uInterface, finalState) - u_exact_final)->l2norm(interfaceMesh);
+    }
+    double finalTimeError = MPIWrapper::sum(*worldComm, myError);
+    if (rank == 0)
+    {
+      cout << "L^2 error in u at t = " << finalTime << ": " << finalTimeError << endl;
+      cout << "Total time: " << timer.ElapsedTime() << " s.\n";
+    }
+  }
+
+#ifdef HAVE_MPI
+  MPI_Comm_free(&slabMPIComm);
+#endif
+
+  return 0;
+}
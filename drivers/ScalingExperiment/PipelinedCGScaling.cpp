@@ -0,0 +1,144 @@
+//
+//  PipelinedCGScaling.cpp
+//  Camellia
+//
+//  Strong-scaling comparison of GMG-preconditioned CG using AztecOO (two blocking reductions per iteration) and
+//  PipelinedCGSolver (one nonblocking reduction per iteration, overlapped with the preconditioner and operator applications).
+//  Run with the same problem size at several MPI rank counts, e.g.:
+//    for np in 1 2 4 8 16; do mpirun -np $np ./PipelinedCGScaling --meshWidth=32 --outputFile=scaling.dat; done
+//  Each run appends one line per Krylov variant to the output file.
+
+#include "GMGSolver.h"
+#include "MeshFactory.h"
+#include "PoissonFormulation.h"
+#include "RHS.h"
+#include "Solution.h"
+
+#include "Epetra_Time.h"
+#include "Teuchos_CommandLineProcessor.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+
+#ifdef HAVE_MPI
+#include "Epetra_MpiComm.h"
+#else
+#include "Epetra_SerialComm.h"
+#endif
+
+#include <fstream>
+
+using namespace Camellia;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv, NULL);
+  int rank = Teuchos::GlobalMPISession::getRank();
+  int numProcs = Teuchos::GlobalMPISession::getNProc();
+
+#ifdef HAVE_MPI
+  Epetra_MpiComm Comm(MPI_COMM_WORLD);
+#else
+  Epetra_SerialComm Comm;
+#endif
+
+  Teuchos::CommandLineProcessor cmdp(false,true); // false: don't throw exceptions; true: do return errors for unrecognized options
+
+  int spaceDim = 2;
+  int meshWidth = 16;
+  int polyOrder = 2;
+  int delta_k = 1;
+  int maxIters = 2000;
+  double relativeTol = 1e-8;
+  int residualReplacementInterval = 50;
+  int numSolves = 3; // we report the minimum solve time over these
+  string outputFile = "";
+
+  cmdp.setOption("spaceDim", &spaceDim, "spatial dimension (1, 2, or 3)");
+  cmdp.setOption("meshWidth", &meshWidth, "number of elements in each direction");
+  cmdp.setOption("polyOrder", &polyOrder, "polynomial order for field variables");
+  cmdp.setOption("delta_k", &delta_k, "test space polynomial order enrichment");
+  cmdp.setOption("maxIterations", &maxIters, "maximum number of CG iterations");
+  cmdp.setOption("relativeTol", &relativeTol, "CG relative residual tolerance");
+  cmdp.setOption("residualReplacementInterval", &residualReplacementInterval, "pipelined CG residual replacement interval (0 to disable)");
+  cmdp.setOption("numSolves", &numSolves, "number of timed solves per Krylov variant");
+  cmdp.setOption("outputFile", &outputFile, "file to which a line of results is appended for each Krylov variant (rank 0 only)");
+
+  if (cmdp.parse(argc,argv) != Teuchos::CommandLineProcessor::PARSE_SUCCESSFUL)
+  {
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+    return -1;
+  }
+
+  bool useConformingTraces = true;
+  PoissonFormulation form(spaceDim, useConformingTraces);
+  vector<double> dimensions(spaceDim,1.0);
+  vector<int> elementCounts(spaceDim,meshWidth);
+  int H1Order = polyOrder + 1;
+  MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+
+  RHSPtr rhs = RHS::rhs();
+  rhs->addTerm(1.0 * form.q());
+  BCPtr bc = BC::bc();
+  bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+  SolutionPtr solution = Solution::solution(mesh, bc, rhs, form.bf()->graphNorm());
+
+  GlobalIndexType numDofs = mesh->numGlobalDofs();
+  if (rank == 0)
+  {
+    cout << "Poisson problem with " << mesh->numActiveElements() << " elements and " << numDofs << " dofs on ";
+    cout << numProcs << " MPI ranks.\n";
+  }
+
+  Teuchos::RCP<GMGSolver> gmgSolver = Teuchos::rcp( new GMGSolver(solution, maxIters, relativeTol) );
+  gmgSolver->setUseConjugateGradient(true);
+  gmgSolver->setAztecOutput(0);
+  gmgSolver->setPreconditionerReuse(GMGSolver::REUSE_HIERARCHY, numSolves); // time the Krylov iteration, not the setup
+
+  ofstream fout;
+  if ((rank == 0) && (outputFile != ""))
+  {
+    fout.open(outputFile.c_str(), ios_base::app);
+  }
+
+  vector<bool> pipelinedChoices = {false, true};
+  for (bool usePipelinedCG : pipelinedChoices)
+  {
+    string krylovName = usePipelinedCG ? "pipelined CG" : "AztecOO CG";
+    gmgSolver->setUsePipelinedConjugateGradient(usePipelinedCG);
+    gmgSolver->forcePreconditionerRebuild();
+
+    double minSolveTime = -1, setupTime = 0;
+    int iterationCount = -1;
+    for (int solveOrdinal=0; solveOrdinal<numSolves; solveOrdinal++)
+    {
+      solution->clear(); // zero initial guess for each solve
+      solution->solve(gmgSolver);
+      map<string,double> timings = gmgSolver->timingReport();
+      // the slowest rank determines wall time
+      double localSolveTime = timings["solve (last)"], solveTime;
+      Comm.MaxAll(&localSolveTime, &solveTime, 1);
+      if (solveOrdinal == 0)
+      {
+        double localSetupTime = timings["setup (last)"];
+        Comm.MaxAll(&localSetupTime, &setupTime, 1);
+      }
+      if ((minSolveTime < 0) || (solveTime < minSolveTime)) minSolveTime = solveTime;
+      iterationCount = gmgSolver->iterationCount();
+    }
+
+    if (rank == 0)
+    {
+      cout << krylovName << ": " << iterationCount << " iterations; setup time " << setupTime << " s; ";
+      cout << "best solve time " << minSolveTime << " s; time per iteration " << minSolveTime / max(iterationCount,1) << " s.\n";
+      if (fout.is_open())
+      {
+        fout << krylovName << "\t" << numProcs << "\t" << numDofs << "\t" << iterationCount << "\t";
+        fout << setupTime << "\t" << minSolveTime << endl;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -56,6 +56,8 @@ using namespace std;
 using namespace Intrepid;
 using namespace Camellia;
 
+int BasisCache::_cubaturePhaseCacheSize = 0;
+
 typedef FunctionSpaceTools fst;
 
 const static bool CACHE_TRANSFORMED_VALUES = false; // save some memory by not caching these
@@ -81,6 +83,52 @@ int boundDegreeToMaxCubatureForCellTopo(int degree, unsigned cellTopoKey)
   }
 }
 
+typedef MeshTransformationFunction::CurvedCellGeometry CurvedCellGeometry;
+
+// for each cell, the mesh transformation's cached geometry (NULL for straight cells); empty if no cell is curved, or if the
+// transformation function is not a mesh transformation composed with the straight-edge map.
+static vector<CurvedCellGeometry*> curvedCellGeometries(TFunctionPtr<double> transformationFxn, bool composeWithMeshTransformation,
+                                                        const vector<GlobalIndexType> &cellIDs, int sideIndex,
+                                                        const FieldContainer<double> &physicalCellNodes,
+                                                        const FieldContainer<double> &refPoints)
+{
+  vector<CurvedCellGeometry*> geometries;
+  if (!composeWithMeshTransformation) return geometries;
+  MeshTransformationFunction* meshTransform = dynamic_cast<MeshTransformationFunction*>(transformationFxn.get());
+  if ((meshTransform == NULL) || !meshTransform->cachesGeometry()) return geometries;
+  if ((cellIDs.size() == 0) || (cellIDs.size() != physicalCellNodes.dimension(0))) return geometries;
+
+  bool anyCurved = false;
+  geometries.resize(cellIDs.size());
+  for (int cellOrdinal=0; cellOrdinal<cellIDs.size(); cellOrdinal++)
+  {
+    geometries[cellOrdinal] = meshTransform->curvedCellGeometry(cellIDs[cellOrdinal], sideIndex, physicalCellNodes, cellOrdinal, refPoints);
+    if (geometries[cellOrdinal] != NULL) anyCurved = true;
+  }
+  if (!anyCurved) geometries.clear();
+  return geometries;
+}
+
+// copies values(cellOrdinal,...) into cellValues
+static void getCellValues(FieldContainer<double> &cellValues, const FieldContainer<double> &values, int cellOrdinal)
+{
+  Teuchos::Array<int> dims;
+  values.dimensions(dims);
+  dims.erase(dims.begin());
+  cellValues.resize(dims);
+  int cellSize = cellValues.size();
+  if (cellSize == 0) return;
+  std::copy(&values[cellOrdinal*cellSize], &values[cellOrdinal*cellSize] + cellSize, &cellValues[0]);
+}
+
+// copies cellValues into values(cellOrdinal,...)
+static void setCellValues(FieldContainer<double> &values, const FieldContainer<double> &cellValues, int cellOrdinal)
+{
+  int cellSize = cellValues.size();
+  if (cellSize == 0) return;
+  std::copy(&cellValues[0], &cellValues[0] + cellSize, &values[cellOrdinal*cellSize]);
+}
+
 bool BasisCache::canComputeTransformedValues(Camellia::EOperator op)
 {
   // a bit ugly, in that this depends on
@@ -185,6 +233,7 @@ void BasisCache::initVolumeCache(bool createSideCacheToo, bool tensorProductTopo
   _maxPointsPerCubaturePhase = -1;
   _cubaturePhase = 0;
   _cubaturePhaseCount = 1;
+  _allCubPointsRestorePending = false;
   _phasePointOrdinalOffsets.push_back(0);
 
   _cellJacobianIsValid = false;
@@ -214,6 +263,7 @@ void BasisCache::initVolumeCache(const Intrepid::FieldContainer<double> &refPoin
   _maxPointsPerCubaturePhase = -1;
   _cubaturePhase = 0;
   _cubaturePhaseCount = 1;
+  _allCubPointsRestorePending = false;
   _phasePointOrdinalOffsets.push_back(0);
   
   _cellJacobianIsValid = false;
@@ -433,6 +483,7 @@ BasisCache::BasisCache(int fakeSideOrdinal, BasisCachePtr volumeCache, const Fie
   _maxPointsPerCubaturePhase = -1; // default: -1 (infinite)
   _cubaturePhase = 0; // index of the cubature phase; defaults to 0
   _cubaturePhaseCount = 1; // how many phases to get through all the points
+  _allCubPointsRestorePending = false;
   _phasePointOrdinalOffsets.push_back(0);
 
   // the assumption is that if you're using this constructor, the volume points provided are already in reference space
@@ -539,6 +590,7 @@ BasisCache::BasisCache(int sideIndex, BasisCachePtr volumeCache, int trialDegree
   _maxPointsPerCubaturePhase = -1; // default: -1 (infinite)
   _cubaturePhase = 0; // index of the cubature phase; defaults to 0
   _cubaturePhaseCount = 1; // how many phases to get through all the points
+  _allCubPointsRestorePending = false;
   _phasePointOrdinalOffsets.push_back(0);
 }
 
@@ -574,6 +626,7 @@ BasisCache::BasisCache(int sideIndex, BasisCachePtr volumeCache, const FieldCont
   _maxPointsPerCubaturePhase = -1; // default: -1 (infinite)
   _cubaturePhase = 0; // index of the cubature phase; defaults to 0
   _cubaturePhaseCount = 1; // how many phases to get through all the points
+  _allCubPointsRestorePending = false;
   _phasePointOrdinalOffsets.push_back(0);
   
   _cellJacobianIsValid = false;
@@ -670,11 +723,13 @@ void BasisCache::cubatureDegreeForElementType(ElementTypePtr elemType, bool test
 
 void BasisCache::setMaxPointsPerCubaturePhase(int maxPoints)
 {
-  if (_maxPointsPerCubaturePhase == -1)
+  if ((_maxPointsPerCubaturePhase == -1) && !_allCubPointsRestorePending)
   {
     _allCubPoints = _cubPoints;
     _allCubWeights = _cubWeights;
   }
+  // if a restore is pending, _allCubPoints still holds the whole set; a new phasing simply supersedes the restore
+  _allCubPointsRestorePending = false;
 
   _maxPointsPerCubaturePhase = maxPoints;
 
@@ -687,7 +742,8 @@ void BasisCache::setMaxPointsPerCubaturePhase(int maxPoints)
     _phasePointOrdinalOffsets = vector<int>(_cubaturePhaseCount+1);
     for (int phaseOrdinal=0; phaseOrdinal<_cubaturePhaseCount; phaseOrdinal++)
     {
-      _phasePointOrdinalOffsets[phaseOrdinal] = phaseOrdinal * (totalPointCount / _cubaturePhaseCount);
+      // spread the points evenly, so that no phase exceeds _maxPointsPerCubaturePhase
+      _phasePointOrdinalOffsets[phaseOrdinal] = (phaseOrdinal * totalPointCount) / _cubaturePhaseCount;
     }
     _phasePointOrdinalOffsets[_cubaturePhaseCount] = totalPointCount;
     _cubPoints.resize(0); // should trigger error if setCubaturePhase isn't called
@@ -700,12 +756,27 @@ void BasisCache::setMaxPointsPerCubaturePhase(int maxPoints)
     _phasePointOrdinalOffsets[0] = 0;
     _phasePointOrdinalOffsets[1] = totalPointCount;
 
-    setRefCellPoints(_allCubPoints, _allCubWeights);
+    // the points (and any geometry computed for them) of the last phase are kept until someone asks for values at the
+    // whole set; callers that phase every element batch thus avoid recomputing (and holding) geometry for all points
+    _allCubPointsRestorePending = (_cubPoints.dimension(0) != totalPointCount);
+    if (!_allCubPointsRestorePending)
+    {
+      _cubPoints = _allCubPoints;
+      _cubWeights = _allCubWeights;
+    }
   }
 }
 
+void BasisCache::restoreAllCubaturePoints()
+{
+  _allCubPointsRestorePending = false;
+  setRefCellPoints(_allCubPoints, _allCubWeights, _cubDegree);
+}
+
 void BasisCache::setCubaturePhase(int phaseOrdinal)
 {
+  TEUCHOS_TEST_FOR_EXCEPTION((phaseOrdinal < 0) || (phaseOrdinal >= _cubaturePhaseCount), std::invalid_argument, "phaseOrdinal out of range");
+  _cubaturePhase = phaseOrdinal;
   int offset = _phasePointOrdinalOffsets[phaseOrdinal];
   int phasePointCount = _phasePointOrdinalOffsets[phaseOrdinal+1] - offset;
   int cubSpaceDim = _allCubPoints.dimension(1);
@@ -719,7 +790,31 @@ void BasisCache::setCubaturePhase(int phaseOrdinal)
       cubPoints(ptOrdinal,d) = _allCubPoints(offset+ptOrdinal,d);
     }
   }
-  setRefCellPoints(cubPoints, cubWeights);
+  setRefCellPoints(cubPoints, cubWeights, _cubDegree);
+}
+
+int BasisCache::maxPointsPerCubaturePhaseForCache(int totalBasisCardinality)
+{
+  if ((_cubaturePhaseCacheSize <= 0) || isSideCache() || (_cellTopo->getTensorialDegree() > 0)) return -1;
+
+  int totalPointCount = (_maxPointsPerCubaturePhase == -1) ? _cubPoints.dimension(0) : _allCubPoints.dimension(0);
+  int numCells = max((int)_physicalCellNodes.dimension(0), 1);
+
+  // during integration, we hold both transformed and transformed-weighted values, of up to rank 1 (vector-valued or gradient)
+  long long bytesPerPoint = 2LL * numCells * totalBasisCardinality * _spaceDim * sizeof(double);
+  long long maxPoints = max(2LL, _cubaturePhaseCacheSize / max(bytesPerPoint, 1LL)); // minimally, compute 2 points at once
+  if (maxPoints >= totalPointCount) return -1;
+  return (int) maxPoints;
+}
+
+void BasisCache::setCubaturePhaseCacheSize(int cacheSizeInBytes)
+{
+  _cubaturePhaseCacheSize = cacheSizeInBytes;
+}
+
+int BasisCache::cubaturePhaseCacheSize()
+{
+  return _cubaturePhaseCacheSize;
 }
 
 void BasisCache::findMaximumDegreeBasisForSides(DofOrdering &trialOrdering)
@@ -846,6 +941,7 @@ void BasisCache::discardPhysicalNodeInfo()
 
 FieldContainer<double> & BasisCache::getWeightedMeasures()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_weightedMeasureIsValid) recomputeMeasures();
   return _weightedMeasure;
 }
@@ -857,12 +953,14 @@ const Intrepid::FieldContainer<double> &BasisCache::getPhysicalCellNodes()
 
 const FieldContainer<double> & BasisCache::getPhysicalCubaturePoints()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_physCubPointsIsValid) determinePhysicalPoints();
   return _physCubPoints;
 }
 
 FieldContainer<double> BasisCache::getCellMeasures()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_weightedMeasureIsValid) recomputeMeasures();
   int numCells = _weightedMeasure.dimension(0);
   int numPoints = _weightedMeasure.dimension(1);
@@ -879,21 +977,25 @@ FieldContainer<double> BasisCache::getCellMeasures()
 
 const Intrepid::FieldContainer<double> & BasisCache::getCubatureWeights()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   return _cubWeights;
 }
 
 const FieldContainer<double> & BasisCache::getJacobian()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_cellJacobianIsValid) determineJacobian();
   return _cellJacobian;
 }
 const FieldContainer<double> & BasisCache::getJacobianDet()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_cellJacobianDeterminantIsValid) determineJacobianInverseAndDeterminant();
   return _cellJacobDet;
 }
 const FieldContainer<double> & BasisCache::getJacobianInv()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   if (!_cellJacobianInverseIsValid) determineJacobianInverseAndDeterminant();
   return _cellJacobInv;
 }
@@ -901,6 +1003,7 @@ const FieldContainer<double> & BasisCache::getJacobianInv()
 constFCPtr BasisCache::getValues(BasisPtr basis, Camellia::EOperator op,
                                  bool useCubPointsSideRefCell)
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   const FieldContainer<double>* cubPoints;
   if (useCubPointsSideRefCell)
   {
@@ -960,6 +1063,7 @@ constFCPtr BasisCache::getValues(BasisPtr basis, Camellia::EOperator op,
 constFCPtr BasisCache::getTransformedValues(BasisPtr basis, Camellia::EOperator op,
     bool useCubPointsSideRefCell)
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   TEUCHOS_TEST_FOR_EXCEPTION(!canComputeTransformedValues(op), std::invalid_argument, "computing transformed values of this operator is not supported");
   
   pair<Camellia::Basis<>*, Camellia::EOperator> key = make_pair(basis.get(), op);
@@ -1145,6 +1249,7 @@ const FieldContainer<double> & BasisCache::getSideUnitNormals(int sideOrdinal)
 
 const FieldContainer<double>& BasisCache::getRefCellPoints()
 {
+  if (_allCubPointsRestorePending) restoreAllCubaturePoints();
   return _cubPoints;
 }
 
@@ -1183,6 +1288,7 @@ void BasisCache::setRefCellPoints(const FieldContainer<double> &pointsRefCell)
 void BasisCache::setRefCellPoints(const FieldContainer<double> &pointsRefCell, const FieldContainer<double> &cubWeights,
                                   int cubatureDegree, bool recomputePhysicalMeasures)
 {
+  _allCubPointsRestorePending = false; // explicitly set points supersede any pending restore
   _cubPoints = pointsRefCell;
   _cubDegree = cubatureDegree;
   int numPoints = pointsRefCell.dimension(0);
@@ -1307,6 +1413,26 @@ void BasisCache::determinePhysicalPoints()
   }
   if ( ! TFunction<double>::isNull(_transformationFxn) )
   {
+    // curved cells: use cached physical points if we have them for every curved cell
+    const FieldContainer<double>* refPoints = isSideCache() ? &_cubPointsSideRefCell : &_cubPoints;
+    vector<CurvedCellGeometry*> curvedGeometries = curvedCellGeometries(_transformationFxn, _composeTransformationFxnWithMeshTransformation,
+                                                                        _cellIDs, _sideIndex, _physicalCellNodes, *refPoints);
+    bool haveCachedPoints = (curvedGeometries.size() > 0);
+    for (CurvedCellGeometry* geometry : curvedGeometries)
+    {
+      if ((geometry != NULL) && (geometry->physicalPoints.size() == 0)) haveCachedPoints = false;
+    }
+    if (haveCachedPoints)
+    {
+      // straight cells were mapped above
+      for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+      {
+        if (curvedGeometries[cellOrdinal] == NULL) continue;
+        setCellValues(_physCubPoints, curvedGeometries[cellOrdinal]->physicalPoints, cellOrdinal);
+      }
+      return;
+    }
+
     FieldContainer<double> newPhysCubPoints(_numCells,numPoints,cellDim);
     BasisCachePtr thisPtr = Teuchos::rcp(this,false);
 
@@ -1329,6 +1455,12 @@ void BasisCache::determinePhysicalPoints()
     _transformationFxn = transformationFxn;
 
     _physCubPoints = newPhysCubPoints;
+
+    for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+    {
+      if (curvedGeometries[cellOrdinal] == NULL) continue;
+      getCellValues(curvedGeometries[cellOrdinal]->physicalPoints, _physCubPoints, cellOrdinal);
+    }
   }
 }
 
@@ -1369,6 +1501,25 @@ void BasisCache::determineJacobian()
     BasisCachePtr thisPtr = Teuchos::rcp(this,false);
     if (_composeTransformationFxnWithMeshTransformation)
     {
+      // curved cells: use cached Jacobians if we have them for every curved cell (straight cells were set above)
+      const FieldContainer<double>* refPoints = isSideCache() ? &_cubPointsSideRefCell : &_cubPoints;
+      vector<CurvedCellGeometry*> curvedGeometries = curvedCellGeometries(_transformationFxn, _composeTransformationFxnWithMeshTransformation,
+                                                                          _cellIDs, _sideIndex, _physicalCellNodes, *refPoints);
+      bool haveCachedJacobians = (curvedGeometries.size() > 0);
+      for (CurvedCellGeometry* geometry : curvedGeometries)
+      {
+        if ((geometry != NULL) && (geometry->jacobian.size() == 0)) haveCachedJacobians = false;
+      }
+      if (haveCachedJacobians)
+      {
+        for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+        {
+          if (curvedGeometries[cellOrdinal] == NULL) continue;
+          setCellValues(_cellJacobian, curvedGeometries[cellOrdinal]->jacobian, cellOrdinal);
+        }
+        return;
+      }
+
       // then we need to multiply one Jacobian by the other
       FieldContainer<double> fxnJacobian(_numCells,numCubPoints,cellDim,cellDim);
       // a little quirky, but since _transformationFxn calls BasisCache in its values determination,
@@ -1385,6 +1536,12 @@ void BasisCache::determineJacobian()
       FieldContainer<double> cellJacobianToMultiply(_cellJacobian); // tensorMultiplyDataData doesn't support multiplying in place
       fst::tensorMultiplyDataData<double>( _cellJacobian, fxnJacobian, cellJacobianToMultiply );
 //      cout << "_cellJacobian after multiplication:\n" << _cellJacobian;
+
+      for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+      {
+        if (curvedGeometries[cellOrdinal] == NULL) continue;
+        getCellValues(curvedGeometries[cellOrdinal]->jacobian, _cellJacobian, cellOrdinal);
+      }
     }
     else
     {
@@ -1410,7 +1567,38 @@ void BasisCache::determineJacobianInverseAndDeterminant()
   
   _cellJacobInv.resize(_numCells, numCubPoints, cellDim, cellDim);
   _cellJacobDet.resize(_numCells, numCubPoints);
-  SerialDenseWrapper::determinantAndInverse(_cellJacobDet, _cellJacobInv, getJacobian());
+
+  vector<CurvedCellGeometry*> curvedGeometries;
+  if (_transformationFxn != Teuchos::null)
+  {
+    const FieldContainer<double>* refPoints = isSideCache() ? &_cubPointsSideRefCell : &_cubPoints;
+    curvedGeometries = curvedCellGeometries(_transformationFxn, _composeTransformationFxnWithMeshTransformation,
+                                            _cellIDs, _sideIndex, _physicalCellNodes, *refPoints);
+  }
+  // the cached values can only be used when every cell is curved; straight cells are cheap to invert, but still need inverting
+  bool haveCachedInverses = (curvedGeometries.size() > 0);
+  for (CurvedCellGeometry* geometry : curvedGeometries)
+  {
+    if ((geometry == NULL) || (geometry->jacobianInverse.size() == 0)) haveCachedInverses = false;
+  }
+  if (haveCachedInverses)
+  {
+    for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+    {
+      setCellValues(_cellJacobDet, curvedGeometries[cellOrdinal]->jacobianDeterminant, cellOrdinal);
+      setCellValues(_cellJacobInv, curvedGeometries[cellOrdinal]->jacobianInverse, cellOrdinal);
+    }
+  }
+  else
+  {
+    SerialDenseWrapper::determinantAndInverse(_cellJacobDet, _cellJacobInv, getJacobian());
+    for (int cellOrdinal=0; cellOrdinal<curvedGeometries.size(); cellOrdinal++)
+    {
+      if (curvedGeometries[cellOrdinal] == NULL) continue;
+      getCellValues(curvedGeometries[cellOrdinal]->jacobianDeterminant, _cellJacobDet, cellOrdinal);
+      getCellValues(curvedGeometries[cellOrdinal]->jacobianInverse, _cellJacobInv, cellOrdinal);
+    }
+  }
   _cellJacobianInverseIsValid = true;
   _cellJacobianDeterminantIsValid = true;
 }
@@ -19,9 +19,67 @@
 #include "Intrepid_FunctionSpaceTools.hpp"
 #include "Intrepid_DefaultCubatureFactory.hpp"
 
+#include <cstdint>
+#include <fstream>
+#include <typeinfo>
+
 using namespace Intrepid;
 using namespace Camellia;
 
+bool BasisReconciliation::_usePersistentWeights = false;
+map< string, SubBasisReconciliationWeights > BasisReconciliation::_persistentWeights;
+int BasisReconciliation::_persistentWeightsHitCount = 0;
+const unsigned BasisReconciliation::PERSISTENT_WEIGHTS_VERSION = 2;
+
+static const string PERSISTENT_WEIGHTS_MAGIC = "CamelliaBasisReconciliationWeights";
+
+// 64-bit FNV-1a hash; unlike std::hash, this is the same from run to run and across standard library implementations
+static uint64_t fnvHash(const void* data, size_t numBytes, uint64_t hash = 14695981039346656037ULL)
+{
+  const unsigned char* bytes = (const unsigned char*) data;
+  for (size_t i=0; i<numBytes; i++)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+template<typename T>
+static void writeBinary(ofstream &fout, const T &value)
+{
+  fout.write((const char*) &value, sizeof(T));
+}
+
+template<typename T>
+static bool readBinary(ifstream &fin, T &value)
+{
+  fin.read((char*) &value, sizeof(T));
+  return fin.good();
+}
+
+static void writeOrdinals(ofstream &fout, const set<int> &ordinals)
+{
+  writeBinary<uint32_t>(fout, ordinals.size());
+  for (int ordinal : ordinals)
+  {
+    writeBinary<int32_t>(fout, ordinal);
+  }
+}
+
+static bool readOrdinals(ifstream &fin, set<int> &ordinals)
+{
+  uint32_t count;
+  if (!readBinary(fin, count)) return false;
+  for (uint32_t i=0; i<count; i++)
+  {
+    int32_t ordinal;
+    if (!readBinary(fin, ordinal)) return false;
+    ordinals.insert(ordinal);
+  }
+  return true;
+}
+
 void sizeFCForBasisValues(FieldContainer<double> &fc, BasisPtr basis, int numPoints, bool includeCellDimension = false, int numBasisFieldsToInclude = -1)
 {
   // values should have shape: (F,P[,D,D,...]) where the # of D's = rank of the basis's range
@@ -135,6 +193,32 @@ unsigned vertexPermutation(shards::CellTopology &fineTopo, unsigned fineSideInde
   return -1; // just for compilers that would otherwise warn that we're missing a return value...
 }
 
+string BasisReconciliation::basisIdentity(Camellia::Basis<>* basis)
+{
+  ostringstream identity;
+  CellTopologyKey topoKey = basis->domainTopology()->getKey();
+  identity << typeid(*basis).name() << "(" << topoKey.first << "," << topoKey.second << ";";
+  identity << basis->functionSpace() << ";" << basis->getDegree() << ";" << basis->getCardinality() << ";";
+  identity << basis->rangeRank() << ";" << basis->rangeDimension() << ";";
+  uint64_t tagHash = fnvHash(NULL, 0);
+  for (const vector<int> &dofTag : basis->getAllDofTags())
+  {
+    if (dofTag.size() > 0) tagHash = fnvHash(&dofTag[0], dofTag.size() * sizeof(int), tagHash);
+  }
+  // displayString() distinguishes bases that agree in all of the above but differ in their nodal points, say;
+  // it can be long for high-degree nodal bases, so we hash it to keep the keys compact
+  string display = basis->displayString();
+  uint64_t displayHash = fnvHash(display.c_str(), display.size());
+  identity << std::hex << tagHash << ";" << displayHash << ")";
+  return identity.str();
+}
+
+void BasisReconciliation::clearPersistentWeights()
+{
+  _persistentWeights.clear();
+  _persistentWeightsHitCount = 0;
+}
+
 SubBasisReconciliationWeights BasisReconciliation::composedSubBasisReconciliationWeights(const SubBasisReconciliationWeights &aWeights,
                                                                                          const SubBasisReconciliationWeights &bWeights)
 {
@@ -793,10 +877,28 @@ const SubBasisReconciliationWeights & BasisReconciliation::constrainedWeights(un
 
   if (_subcellReconcilationWeights.find(cacheKey) == _subcellReconcilationWeights.end())
   {
+    string persistentCacheKey;
+    if (_usePersistentWeights)
+    {
+      persistentCacheKey = persistentKey(subcellDimension, finerBasis, finerBasisSubcellOrdinal, refinements,
+                                         coarserBasis, coarserBasisSubcellOrdinal, vertexNodePermutation);
+      auto persistentEntry = _persistentWeights.find(persistentCacheKey);
+      if (persistentEntry != _persistentWeights.end())
+      {
+        _persistentWeightsHitCount++;
+        _subcellReconcilationWeights[cacheKey] = persistentEntry->second;
+        return _subcellReconcilationWeights[cacheKey];
+      }
+    }
     _subcellReconcilationWeights[cacheKey] = computeConstrainedWeights(subcellDimension, finerBasis, finerBasisSubcellOrdinal, refinements,
                                                                        coarserBasis, coarserBasisSubcellOrdinal, vertexNodePermutation);
     // 10-14-15 added filtering:
     _subcellReconcilationWeights[cacheKey] = filterOutZeroRowsAndColumns(_subcellReconcilationWeights[cacheKey]);
+    
+    if (_usePersistentWeights)
+    {
+      _persistentWeights[persistentCacheKey] = _subcellReconcilationWeights[cacheKey];
+    }
   }
 
   return _subcellReconcilationWeights[cacheKey];
@@ -1271,6 +1373,64 @@ unsigned BasisReconciliation::minimumSubcellDimension(BasisPtr basis)
   return minSubcellDimension;
 }
 
+bool BasisReconciliation::loadPersistentWeights(const string &fileName)
+{
+  _usePersistentWeights = true;
+  
+  ifstream fin(fileName.c_str(), ios::in | ios::binary);
+  if (!fin.is_open()) return false;
+  
+  string magic(PERSISTENT_WEIGHTS_MAGIC.size(), ' ');
+  fin.read(&magic[0], magic.size());
+  uint32_t version;
+  if (!fin.good() || (magic != PERSISTENT_WEIGHTS_MAGIC) || !readBinary(fin, version) || (version != PERSISTENT_WEIGHTS_VERSION))
+  {
+    return false;
+  }
+  
+  uint64_t entryCount;
+  if (!readBinary(fin, entryCount)) return false;
+  map< string, SubBasisReconciliationWeights > weightsRead;
+  for (uint64_t entryOrdinal=0; entryOrdinal<entryCount; entryOrdinal++)
+  {
+    uint32_t keyLength;
+    if (!readBinary(fin, keyLength)) return false;
+    string key(keyLength, ' ');
+    fin.read(&key[0], keyLength);
+    
+    SubBasisReconciliationWeights weights;
+    uint8_t isIdentity;
+    if (!readBinary(fin, isIdentity)) return false;
+    weights.isIdentity = (isIdentity != 0);
+    if (!readOrdinals(fin, weights.fineOrdinals)) return false;
+    if (!readOrdinals(fin, weights.coarseOrdinals)) return false;
+    
+    uint32_t rank;
+    if (!readBinary(fin, rank)) return false;
+    if (rank > 0)
+    {
+      Teuchos::Array<int> dims(rank);
+      for (uint32_t r=0; r<rank; r++)
+      {
+        int32_t dim;
+        if (!readBinary(fin, dim)) return false;
+        dims[r] = dim;
+      }
+      weights.weights.resize(dims);
+      if (weights.weights.size() > 0)
+      {
+        fin.read((char*) &weights.weights[0], weights.weights.size() * sizeof(double));
+      }
+    }
+    if (!fin.good()) return false;
+    weightsRead[key] = weights;
+  }
+  
+  // entries already in the store (e.g. computed in this run) are kept as they are
+  _persistentWeights.insert(weightsRead.begin(), weightsRead.end());
+  return true;
+}
+
 void BasisReconciliation::mapFineSubcellPointsToCoarseDomain(FieldContainer<double> &coarseDomainPoints,
     const FieldContainer<double> &fineSubcellPoints,
     unsigned fineSubcellDimension,
@@ -1444,6 +1604,79 @@ void BasisReconciliation::mapFineSubcellPointsToCoarseDomain(FieldContainer<doub
   }
 }
 
+string BasisReconciliation::persistentKey(unsigned subcellDimension, BasisPtr finerBasis, unsigned finerBasisSubcellOrdinal,
+                                          const RefinementBranch &refinements, BasisPtr coarserBasis, unsigned coarserBasisSubcellOrdinal,
+                                          unsigned vertexNodePermutation)
+{
+  ostringstream key;
+  key << subcellDimension << "|" << basisIdentity(finerBasis.get()) << "|" << finerBasisSubcellOrdinal;
+  key << "|" << basisIdentity(coarserBasis.get()) << "|" << coarserBasisSubcellOrdinal;
+  key << "|" << refinementBranchIdentity(refinements) << "|" << vertexNodePermutation;
+  return key.str();
+}
+
+int BasisReconciliation::persistentWeightsCount()
+{
+  return _persistentWeights.size();
+}
+
+int BasisReconciliation::persistentWeightsHitCount()
+{
+  return _persistentWeightsHitCount;
+}
+
+string BasisReconciliation::refinementBranchIdentity(const RefinementBranch &refinements)
+{
+  // a refinement pattern is determined by its parent topology and the reference-cell nodes of its children
+  ostringstream identity;
+  for (const pair<RefinementPattern*, unsigned> &refinement : refinements)
+  {
+    RefinementPattern* refPattern = refinement.first;
+    CellTopologyKey topoKey = refPattern->parentTopology()->getKey();
+    const FieldContainer<double>* refinedNodes = &refPattern->refinedNodes();
+    uint64_t nodeHash = fnvHash(NULL, 0);
+    if (refinedNodes->size() > 0) nodeHash = fnvHash(&(*refinedNodes)[0], refinedNodes->size() * sizeof(double));
+    identity << "(" << topoKey.first << "," << topoKey.second << ";" << refPattern->numChildren() << ";";
+    identity << std::hex << nodeHash << std::dec << ";" << refinement.second << ")";
+  }
+  return identity.str();
+}
+
+void BasisReconciliation::savePersistentWeights(const string &fileName)
+{
+  ofstream fout(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  TEUCHOS_TEST_FOR_EXCEPTION(!fout.is_open(), std::invalid_argument, "Could not open " + fileName + " for writing");
+  
+  fout.write(PERSISTENT_WEIGHTS_MAGIC.c_str(), PERSISTENT_WEIGHTS_MAGIC.size());
+  writeBinary<uint32_t>(fout, PERSISTENT_WEIGHTS_VERSION);
+  writeBinary<uint64_t>(fout, _persistentWeights.size());
+  for (auto &entry : _persistentWeights)
+  {
+    const string* key = &entry.first;
+    const SubBasisReconciliationWeights* weights = &entry.second;
+    writeBinary<uint32_t>(fout, key->size());
+    fout.write(key->c_str(), key->size());
+    writeBinary<uint8_t>(fout, weights->isIdentity ? 1 : 0);
+    writeOrdinals(fout, weights->fineOrdinals);
+    writeOrdinals(fout, weights->coarseOrdinals);
+    writeBinary<uint32_t>(fout, weights->weights.rank());
+    for (int r=0; r<weights->weights.rank(); r++)
+    {
+      writeBinary<int32_t>(fout, weights->weights.dimension(r));
+    }
+    if ((weights->weights.rank() > 0) && (weights->weights.size() > 0))
+    {
+      fout.write((const char*) &weights->weights[0], weights->weights.size() * sizeof(double));
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(!fout.good(), std::runtime_error, "Error while writing " + fileName);
+}
+
+void BasisReconciliation::setUsePersistentWeights(bool value)
+{
+  _usePersistentWeights = value;
+}
+
 void BasisReconciliation::setupFineAndCoarseBasisCachesForReconciliation(BasisCachePtr &fineDomainCache,
                                                                          BasisCachePtr &coarseDomainCache,
                                                                          unsigned fineSubcellDimension,
@@ -222,6 +222,18 @@ string TFunction<Scalar>::displayString()
   return "f";
 }
 
+template <typename Scalar>
+void TFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  std::vector<GlobalIndexType> cellIDs;
+  for (BasisCachePtr basisCache : basisCaches)
+  {
+    const std::vector<GlobalIndexType>* cacheCellIDs = &basisCache->cellIDs();
+    cellIDs.insert(cellIDs.end(), cacheCellIDs->begin(), cacheCellIDs->end());
+  }
+  importCellData(cellIDs);
+}
+
 template <typename Scalar>
 int TFunction<Scalar>::rank()
 {
@@ -1194,7 +1206,7 @@ Scalar TFunction<Scalar>::integrate(MeshPtr mesh, int cubatureDegreeEnrichment,
       integral += this->integrate(basisCache);
     }
   }
-  return MPIWrapper::sum(integral);
+  return MPIWrapper::sum(*mesh->Comm(), integral);
 }
 
   template <typename Scalar>
@@ -50,6 +50,53 @@ void MeshTransferFunction::didRepartition(MeshTopologyPtr meshTopo)
   rebuildMaps();
 }
 
+void MeshTransferFunction::didHRefine(MeshTopologyPtr meshTopo, const set<GlobalIndexType> &cellIDs, RefinementPatternPtr refPattern)
+{
+  bool newMeshRefined = (meshTopo.get() == _newMesh->getTopology().get());
+  bool originalMeshRefined = (meshTopo.get() == _originalMesh->getTopology().get());
+
+  // drop the locations that refer to the refined cells; the others remain valid
+  for (auto entryIt = _transferLocations.begin(); entryIt != _transferLocations.end();)
+  {
+    bool dropEntry = newMeshRefined && (cellIDs.find(entryIt->first.first) != cellIDs.end());
+    if (originalMeshRefined)
+    {
+      for (const OriginalMeshPoints &points : entryIt->second.originalMeshPoints)
+      {
+        if (cellIDs.find(points.originalCellSide.first) != cellIDs.end()) dropEntry = true;
+      }
+    }
+    if (dropEntry)
+      entryIt = _transferLocations.erase(entryIt);
+    else
+      entryIt++;
+  }
+}
+
+void MeshTransferFunction::didHUnrefine(MeshTopologyPtr meshTopo, const set<GlobalIndexType> &cellIDs)
+{
+  // unrefinement can change the ancestry of any side, so we start over
+  _transferLocations.clear();
+}
+
+void MeshTransferFunction::pRefine(const set<GlobalIndexType> &cellIDs)
+{
+  // the cached side caches on _originalMesh depend on the element type; we don't know which mesh is being p-refined, so
+  // we drop the entries that refer to the cells in either mesh
+  for (auto entryIt = _transferLocations.begin(); entryIt != _transferLocations.end();)
+  {
+    bool dropEntry = (cellIDs.find(entryIt->first.first) != cellIDs.end());
+    for (const OriginalMeshPoints &points : entryIt->second.originalMeshPoints)
+    {
+      if (cellIDs.find(points.originalCellSide.first) != cellIDs.end()) dropEntry = true;
+    }
+    if (dropEntry)
+      entryIt = _transferLocations.erase(entryIt);
+    else
+      entryIt++;
+  }
+}
+
 bool MeshTransferFunction::findAncestralPairForNewMeshCellSide(const CellSide &newMeshCellSide,
     CellSide &newMeshCellSideAncestor, CellSide &originalMeshCellSideAncestor,
     unsigned &newMeshCellSideAncestorPermutation)
@@ -223,16 +270,11 @@ void MeshTransferFunction::rebuildMaps()
         newMeshEntryIt != newMeshActiveCellSides.end(); newMeshEntryIt++)
   {
     CellSide newActiveCellSide = *newMeshEntryIt;
-    CellSide originalCellSide;
 
-    CellSide newCellSide;
-
-    unsigned permutation;
-    bool matchFound = findAncestralPairForNewMeshCellSide(newActiveCellSide, newCellSide, originalCellSide, permutation);
-    if (!matchFound)
-    {
-      TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "no match found during rebuildMaps()");
-    }
+    const TransferLocation* location = &transferLocation(newActiveCellSide);
+    CellSide originalCellSide = location->originalMeshAncestralCellSide;
+    CellSide newCellSide = location->newMeshAncestralCellSide;
+    unsigned permutation = location->newMeshAncestralCellSidePermutation;
 
     _newToOriginalMap[newCellSide] = originalCellSide;
     _originalToNewMap[originalCellSide] = newCellSide;
@@ -276,208 +318,230 @@ void MeshTransferFunction::rebuildMaps()
   // here typically only need to be done once per solve on newMesh, and this during the determination of boundary conditions.
 }
 
-void MeshTransferFunction::values(FieldContainer<double> &values, BasisCachePtr basisCache)
+MeshTransferFunction::TransferLocation & MeshTransferFunction::transferLocation(const CellSide &newMeshActiveCellSide)
 {
-  // incoming basisCache should be defined on newMesh
-  if (basisCache->mesh().get() != _newMesh.get())
+  auto entryIt = _transferLocations.find(newMeshActiveCellSide);
+  if (entryIt != _transferLocations.end()) return entryIt->second;
+
+  TransferLocation location;
+  bool matchFound = findAncestralPairForNewMeshCellSide(newMeshActiveCellSide, location.newMeshAncestralCellSide,
+                                                        location.originalMeshAncestralCellSide,
+                                                        location.newMeshAncestralCellSidePermutation);
+  if (!matchFound)
   {
-    cout << "ERROR: MeshTransferFunction::values() requires incoming BasisCache to be defined on newMesh.\n";
-    TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "BasisCache not defined on newMesh");
+    TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "CellSide not found!");
   }
+  return _transferLocations[newMeshActiveCellSide] = location;
+}
 
-  // to be general and to keep this first version simple, we just iterate over the cells in basisCache,
-  // creating BasisCache(s) on originalMesh
-
-  FieldContainer<double> refCellPoints = basisCache->getRefCellPoints();
-
-  Teuchos::Array<int> valuesLocation(values.rank());
-  Teuchos::Array<int> valuesDimOneCell;
-  values.dimensions(valuesDimOneCell);
-  valuesDimOneCell[0] = 1; // one cell
-  Teuchos::Array<int> valuesDimOneCellOnePoint = valuesDimOneCell;
-  valuesDimOneCellOnePoint[1] = 1; // one point
+void MeshTransferFunction::locatePoints(TransferLocation &location, const CellSide &newMeshActiveCellSide,
+                                        const FieldContainer<double> &refCellPoints)
+{
+  location.refCellPoints = refCellPoints;
+  location.originalMeshPoints.clear();
 
   int numPoints = refCellPoints.dimension(0);
+  unsigned sideDim = _originalMesh->getDimension() - 1;
 
-  vector<GlobalIndexType> newMeshCellIDs = basisCache->cellIDs();
-  int cellOrdinal = 0;
-  for (vector<GlobalIndexType>::iterator cellIDIt = newMeshCellIDs.begin(); cellIDIt != newMeshCellIDs.end(); cellIDIt++, cellOrdinal++)
-  {
-    valuesLocation[0] = cellOrdinal;
+  FieldContainer<double> newMeshCellReferencePoints;
 
-    GlobalIndexType newMeshCellID = *cellIDIt;
-    unsigned newMeshCellSideOrdinal = basisCache->getSideIndex();
-    CellSide newMeshActiveCellSide = make_pair(newMeshCellID, newMeshCellSideOrdinal);
+  // in newMesh, may have to map upward to an ancestor
+  if (newMeshActiveCellSide == location.newMeshAncestralCellSide)
+  {
+    newMeshCellReferencePoints = refCellPoints;
+  }
+  else
+  {
+    GlobalIndexType ancestralCellID = location.newMeshAncestralCellSide.first;
+    CellPtr cell = _newMesh->getTopology()->getCell(newMeshActiveCellSide.first);
+    RefinementBranch refBranchVolume;
+    while (cell->cellIndex() != ancestralCellID)
+    {
+      CellPtr parent = cell->getParent();
+      unsigned childOrdinal = parent->childOrdinal(cell->cellIndex());
+      refBranchVolume.insert(refBranchVolume.begin(), make_pair(parent->refinementPattern().get(),childOrdinal));
+      cell = parent;
+    }
+    RefinementBranch refBranch = RefinementPattern::sideRefinementBranch(refBranchVolume, location.newMeshAncestralCellSide.second);
+    RefinementPattern::mapRefCellPointsToAncestor(refBranch, refCellPoints, newMeshCellReferencePoints);
+  }
 
-    CellSide newMeshAncestralCellSide, originalMeshAncestralCellSide;
+  // permute newMeshCellReferencePoints according to the ancestral side permutation
+  CellPtr originalMeshAncestralCell = _originalMesh->getTopology()->getCell(location.originalMeshAncestralCellSide.first);
+  CellTopoPtr sideTopo = originalMeshAncestralCell->topology()->getSide(location.originalMeshAncestralCellSide.second);
 
-    unsigned newMeshAncestralCellSidePermutation;
-    bool matchFound = findAncestralPairForNewMeshCellSide(newMeshActiveCellSide, newMeshAncestralCellSide, originalMeshAncestralCellSide, newMeshAncestralCellSidePermutation);
+  FieldContainer<double> originalMeshCellReferencePoints(numPoints, sideDim);
+  CamelliaCellTools::permutedReferenceCellPoints(sideTopo, location.newMeshAncestralCellSidePermutation,
+                                                 newMeshCellReferencePoints, originalMeshCellReferencePoints);
 
-    if (!matchFound)
+  // in originalMesh, may have to map downward to descendants; we do this point by point, grouping the points by the
+  // active side that contains them
+  MeshTopologyViewPtr originalMeshTopology = _originalMesh->getTopology();
+  map<CellSide, vector<int>> pointOrdinalsForOriginalCellSide;
+  map<CellSide, vector<vector<double>>> pointsForOriginalCellSide;
+  for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+  {
+    FieldContainer<double> parentPointFC(1,sideDim);
+    vector<double> refPointParent(sideDim);
+    for (int d=0; d<sideDim; d++)
     {
-      TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "CellSide not found!");
+      parentPointFC(0,d) = originalMeshCellReferencePoints(pointOrdinal,d);
+      refPointParent[d] = originalMeshCellReferencePoints(pointOrdinal,d);
     }
 
-    FieldContainer<double> newMeshCellReferencePoints;
+    CellPtr descendantCell = originalMeshAncestralCell;
+    unsigned sideOrdinal = location.originalMeshAncestralCellSide.second;
 
-    // in newMesh, may have to map upward to an ancestor
-    if (newMeshActiveCellSide == newMeshAncestralCellSide)
+    while (descendantCell->isParent(originalMeshTopology))
     {
-      newMeshCellReferencePoints = refCellPoints;
-    }
-    else
-    {
-      GlobalIndexType ancestralCellID = newMeshAncestralCellSide.first;
-      CellPtr cell = _newMesh->getTopology()->getCell(newMeshCellID);
-      RefinementBranch refBranchVolume;
-      while (cell->cellIndex() != ancestralCellID)
-      {
-        CellPtr parent = cell->getParent();
-        unsigned childOrdinal = parent->childOrdinal(cell->cellIndex());
-        refBranchVolume.insert(refBranchVolume.end(), make_pair(parent->refinementPattern().get(),childOrdinal));
-        cell = parent;
-      }
-      RefinementBranch refBranch = RefinementPattern::sideRefinementBranch(refBranchVolume, newMeshAncestralCellSide.second);
-      RefinementPattern::mapRefCellPointsToAncestor(refBranch, refCellPoints, newMeshCellReferencePoints);
-    }
+      RefinementPatternPtr refPattern = descendantCell->refinementPattern();
+      RefinementPatternPtr sideRefPattern = refPattern->sideRefinementPatterns()[sideOrdinal];
 
-    {
-      // DEBUGGING
-      BasisCachePtr ancestorBasisCache = BasisCache::basisCacheForCell(_newMesh, newMeshAncestralCellSide.first);
-      BasisCachePtr ancestorSideBasisCache = ancestorBasisCache->getSideBasisCache(newMeshAncestralCellSide.second);
-      ancestorSideBasisCache->setRefCellPoints(newMeshCellReferencePoints);
+      unsigned childOrdinalInSide = sideRefPattern->childOrdinalForPoint(refPointParent);
+      unsigned childOrdinalVolume = refPattern->mapSideChildIndex(sideOrdinal, childOrdinalInSide);
+      unsigned childSideOrdinal = refPattern->mapSubcellFromParentToChild(childOrdinalVolume, sideDim, sideOrdinal).second;
 
-      FieldContainer<double> originalPhysicalPoints(1,newMeshCellReferencePoints.dimension(0), _newMesh->getDimension());
+      FieldContainer<double> childPoint(1,sideDim);
+      sideRefPattern->mapPointsToChildRefCoordinates(parentPointFC, childOrdinalInSide, childPoint);
+      parentPointFC = childPoint;
 
-      for (int pointOrdinal=0; pointOrdinal<newMeshCellReferencePoints.dimension(0); pointOrdinal++)
+      for (int d=0; d<sideDim; d++)
       {
-        for (int d=0; d<_newMesh->getDimension(); d++)
-        {
-          originalPhysicalPoints(0,pointOrdinal,d) = basisCache->getPhysicalCubaturePoints()(cellOrdinal,pointOrdinal,d);
-        }
+        refPointParent[d] = childPoint(0,d);
       }
 
-      FieldContainer<double> ancestorPhysicalPoints = ancestorSideBasisCache->getPhysicalCubaturePoints();
-      double tol = 1e-15;
-      double maxDiff = 0;
-      for (int pointOrdinal=0; pointOrdinal<newMeshCellReferencePoints.dimension(0); pointOrdinal++)
-      {
-        for (int d=0; d<_newMesh->getDimension(); d++)
-        {
-          double diff = abs( originalPhysicalPoints(0,pointOrdinal,d) - ancestorPhysicalPoints(0,pointOrdinal,d) );
-          if (diff==0) continue;
-          double maxVal = std::max(abs(originalPhysicalPoints(0,pointOrdinal,d)), abs(ancestorPhysicalPoints(0,pointOrdinal,d)));
-          double relDiff = diff / maxVal;
-          maxDiff = std::max(maxDiff,relDiff);
-        }
-      }
-      if (maxDiff > tol)
-      {
-        cout << "ERROR: ancestorPhysicalPoints and originalPhysicalPoints differ.\n";
-        cout << "originalPhysicalPoints:\n" << originalPhysicalPoints;
-        cout << "ancestorPhysicalPoints:\n" << ancestorPhysicalPoints;
-        TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "ancestorPhysicalPoints and originalPhysicalPoints differ");
-      }
+      sideOrdinal = childSideOrdinal;
+      descendantCell = descendantCell->children()[childOrdinalVolume];
     }
 
-    // permute newMeshCellReferencePoints according to newMeshAncestralCellSidePermutation
-
-    unsigned sideDim = _originalMesh->getDimension() - 1;
-    CellPtr originalMeshAncestralCell = _originalMesh->getTopology()->getCell(originalMeshAncestralCellSide.first);
-    CellTopoPtr sideTopo = originalMeshAncestralCell->topology()->getSide(originalMeshAncestralCellSide.second);
-//    IndexType originalSideEntityIndex = originalMeshAncenstralCell->entityIndex(sideDim,originalMeshAncestralCellSide.second);
-//    CellTopoPtr sideTopo = _originalMesh->getTopology()->getEntityTopology(sideDim, originalSideEntityIndex);
+    CellSide originalCellSide = make_pair(descendantCell->cellIndex(), sideOrdinal);
+    pointOrdinalsForOriginalCellSide[originalCellSide].push_back(pointOrdinal);
+    pointsForOriginalCellSide[originalCellSide].push_back(refPointParent);
+  }
 
-    FieldContainer<double> originalMeshCellReferencePoints(newMeshCellReferencePoints.dimension(0), newMeshCellReferencePoints.dimension(1));
-    CamelliaCellTools::permutedReferenceCellPoints(sideTopo, newMeshAncestralCellSidePermutation, newMeshCellReferencePoints, originalMeshCellReferencePoints);
+  for (auto entry : pointOrdinalsForOriginalCellSide)
+  {
+    OriginalMeshPoints points;
+    points.originalCellSide = entry.first;
+    points.pointOrdinals = entry.second;
 
-    // in originalMesh, may have to map downward to descendants
-    CellPtr cell = _originalMesh->getTopology()->getCell(originalMeshAncestralCellSide.first);
-    if (! cell->isParent(_originalMesh->getTopology()))
+    const vector<vector<double>>* refPoints = &pointsForOriginalCellSide[entry.first];
+    FieldContainer<double> sideRefPoints(refPoints->size(), sideDim);
+    for (int pointOrdinal=0; pointOrdinal<refPoints->size(); pointOrdinal++)
     {
-      BasisCachePtr originalBasisCache = BasisCache::basisCacheForCell(_originalMesh, originalMeshAncestralCellSide.first);
-      BasisCachePtr originalBasisCacheSide = originalBasisCache->getSideBasisCache(originalMeshAncestralCellSide.second);
-      originalBasisCacheSide->setRefCellPoints(originalMeshCellReferencePoints);
-      int enumeration = values.getEnumeration(valuesLocation);
-      FieldContainer<double> cellValues(valuesDimOneCell, &values[enumeration]);
-      _originalFunction->values(cellValues, originalBasisCacheSide);
+      for (int d=0; d<sideDim; d++)
+      {
+        sideRefPoints(pointOrdinal,d) = (*refPoints)[pointOrdinal][d];
+      }
     }
-    else
-    {
-      // otherwise, we examine points individually -- a good deal of room for optimization here, though I'm not sure how
-      // much this method will be used; should do a profile to see how expensive it really is
+    BasisCachePtr originalBasisCache = BasisCache::basisCacheForCell(_originalMesh, points.originalCellSide.first);
+    points.sideBasisCache = originalBasisCache->getSideBasisCache(points.originalCellSide.second);
+    points.sideBasisCache->setRefCellPoints(sideRefPoints);
 
-//      vector< vector<unsigned> > branchForPoint(numPoints); // list of child ordinals
-//      vector< unsigned > sideOrdinalForPoint(numPoints); // side ordinal in descendant
-//      vector< vector<double> > pointInDescendant(numPoints); // in ref space for descendant side
+    location.originalMeshPoints.push_back(points);
+  }
+}
 
-      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
-      {
-        FieldContainer<double> parentPointFC(1,sideDim);
-        vector<double> refPointParent(sideDim);
-        for (int d=0; d<sideDim; d++)
-        {
-          parentPointFC(0,d) = originalMeshCellReferencePoints(pointOrdinal,d);
-          refPointParent[d] = originalMeshCellReferencePoints(pointOrdinal,d);
-        }
+void MeshTransferFunction::values(FieldContainer<double> &values, BasisCachePtr basisCache)
+{
+  // incoming basisCache should be defined on newMesh
+  if (basisCache->mesh().get() != _newMesh.get())
+  {
+    cout << "ERROR: MeshTransferFunction::values() requires incoming BasisCache to be defined on newMesh.\n";
+    TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "BasisCache not defined on newMesh");
+  }
 
-        CellPtr descendantCell = cell;
-        vector<unsigned> branch;
-        unsigned sideOrdinal = originalMeshAncestralCellSide.second;
+  // we iterate over the cells in basisCache; the location of each side's points in originalMesh, along with BasisCaches on
+  // originalMesh set to those points, is determined on first use and cached in _transferLocations.
 
-        while (descendantCell->isParent(_originalMesh->getTopology()))
-        {
-          RefinementPatternPtr refPattern = descendantCell->refinementPattern();
-          RefinementPatternPtr sideRefPattern = refPattern->sideRefinementPatterns()[sideOrdinal];
+  const FieldContainer<double>* refCellPoints = &basisCache->getRefCellPoints();
 
-          unsigned childOrdinalInSide = sideRefPattern->childOrdinalForPoint(refPointParent);
-          unsigned childOrdinalVolume = refPattern->mapSideChildIndex(sideOrdinal, childOrdinalInSide);
-          unsigned childSideOrdinal = refPattern->mapSubcellFromParentToChild(childOrdinalVolume, sideDim, sideOrdinal).second;
+  Teuchos::Array<int> valuesLocation(values.rank());
+  Teuchos::Array<int> valuesDimOneCell;
+  values.dimensions(valuesDimOneCell);
+  valuesDimOneCell[0] = 1; // one cell
+  Teuchos::Array<int> valuesDimOneCellOnePoint = valuesDimOneCell;
+  valuesDimOneCellOnePoint[1] = 1; // one point
+  int valuesPerPoint = 1;
+  for (int d=2; d<valuesDimOneCell.size(); d++)
+  {
+    valuesPerPoint *= valuesDimOneCell[d];
+  }
 
-          branch.push_back(childOrdinalVolume);
+  int numPoints = refCellPoints->dimension(0);
 
-          FieldContainer<double> childPoint(1,sideDim);
-          sideRefPattern->mapPointsToChildRefCoordinates(parentPointFC, childOrdinalInSide, childPoint);
-          parentPointFC = childPoint;
+  vector<GlobalIndexType> newMeshCellIDs = basisCache->cellIDs();
+  unsigned newMeshCellSideOrdinal = basisCache->getSideIndex();
+  for (int cellOrdinal=0; cellOrdinal<newMeshCellIDs.size(); cellOrdinal++)
+  {
+    valuesLocation[0] = cellOrdinal;
 
-          for (int d=0; d<sideDim; d++)
+    CellSide newMeshActiveCellSide = make_pair(newMeshCellIDs[cellOrdinal], newMeshCellSideOrdinal);
+    TransferLocation* location = &transferLocation(newMeshActiveCellSide);
+
+    bool pointsMatch = (location->refCellPoints.size() == refCellPoints->size()) && (location->originalMeshPoints.size() > 0);
+    for (int i=0; pointsMatch && (i<refCellPoints->size()); i++)
+    {
+      pointsMatch = ((*refCellPoints)[i] == location->refCellPoints[i]);
+    }
+    if (!pointsMatch)
+    {
+      locatePoints(*location, newMeshActiveCellSide, *refCellPoints);
+
+      // check that the located points' physical coordinates match those in basisCache
+      double tol = 1e-14;
+      int spaceDim = _newMesh->getDimension();
+      const FieldContainer<double>* physicalPoints = &basisCache->getPhysicalCubaturePoints();
+      for (const OriginalMeshPoints &points : location->originalMeshPoints)
+      {
+        const FieldContainer<double>* originalPhysicalPoints = &points.sideBasisCache->getPhysicalCubaturePoints();
+        for (int i=0; i<points.pointOrdinals.size(); i++)
+        {
+          for (int d=0; d<spaceDim; d++)
           {
-            refPointParent[d] = childPoint(0,d);
+            double expectedValue = (*physicalPoints)(cellOrdinal,points.pointOrdinals[i],d);
+            double actualValue = (*originalPhysicalPoints)(0,i,d);
+            double diff = abs(expectedValue - actualValue);
+            double maxVal = std::max(std::max(abs(expectedValue), abs(actualValue)), 1.0);
+            if (diff / maxVal > tol)
+            {
+              cout << "ERROR: physical points in originalMesh and newMesh differ.\n";
+              cout << "newMesh physical points:\n" << *physicalPoints;
+              cout << "originalMesh physical points:\n" << *originalPhysicalPoints;
+              TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "physical points in originalMesh and newMesh differ");
+            }
           }
-
-          sideOrdinal = childSideOrdinal;
-          descendantCell = descendantCell->children()[childOrdinalVolume];
         }
-//        branchForPoint[pointOrdinal] = branch;
-//        sideOrdinalForPoint[pointOrdinal] = sideOrdinal;
-//        pointInDescendant[pointOrdinal] = refPointParent;
+      }
+    }
 
-        valuesLocation[1] = pointOrdinal;
+    for (const OriginalMeshPoints &points : location->originalMeshPoints)
+    {
+      int numPointsInSide = points.pointOrdinals.size();
+      if (numPointsInSide == numPoints)
+      {
+        // all points lie in one side, in order: write the values directly
         int enumeration = values.getEnumeration(valuesLocation);
-        valuesLocation[1] = 0; // clear
-
-        FieldContainer<double> pointValues(valuesDimOneCellOnePoint, &values[enumeration]);
-        BasisCachePtr originalMeshBasisCache = BasisCache::basisCacheForCell(_originalMesh, originalMeshAncestralCellSide.first);
-        BasisCachePtr originalMeshBasisCacheSide = basisCache->getSideBasisCache(sideOrdinal);
-        originalMeshBasisCacheSide->setRefCellPoints(parentPointFC);
-
-        _originalFunction->values(pointValues, originalMeshBasisCacheSide);
+        FieldContainer<double> cellValues(valuesDimOneCell, &values[enumeration]);
+        _originalFunction->values(cellValues, points.sideBasisCache);
+        continue;
       }
+      Teuchos::Array<int> sideValuesDim = valuesDimOneCell;
+      sideValuesDim[1] = numPointsInSide;
+      FieldContainer<double> sideValues(sideValuesDim);
+      _originalFunction->values(sideValues, points.sideBasisCache);
+      for (int i=0; i<numPointsInSide; i++)
+      {
+        valuesLocation[1] = points.pointOrdinals[i];
+        int enumeration = values.getEnumeration(valuesLocation);
+        for (int j=0; j<valuesPerPoint; j++)
+        {
+          values[enumeration + j] = sideValues[i * valuesPerPoint + j];
+        }
+      }
+      valuesLocation[1] = 0; // clear
     }
   }
-
-  /*
-   basisCache contains info on cells in newMesh.
-   Basic idea: for each CellSide in basisCache, determine the corresponding CellSide in originalMesh.
-   This may not be an active cell.  If it is not, we need to subdivide the physical points, assigning
-   subsets to active cells.  We might do this by sending *all* the physical points to all the owners of
-   the CellSide's descendants.  It would then be the owner's responsibility to determine which physical
-   points belong to them, and to communicate regarding these.  (It might be that this is done via an
-   integer array indicating which point ordinals are being claimed followed by a double array indicating
-   which values correspond.)
-   */
-
 }
 
 MeshTransferFunction::~MeshTransferFunction()
@@ -342,6 +342,7 @@ MeshTransformationFunction::MeshTransformationFunction(MeshPtr mesh, map< Global
   _cellTransforms = cellTransforms;
   _op = op;
   _maxPolynomialDegree = 1; // 1 is the degree of the identity transform (x,y) -> (x,y)
+  _cachesGeometry = false; // derivative functions are not handed to BasisCache as transformation functions
 }
 
 MeshTransformationFunction::MeshTransformationFunction(MeshPtr mesh, set<GlobalIndexType> cellIDsToTransform) : TFunction<double>(1)   // vector-valued Function
@@ -349,14 +350,98 @@ MeshTransformationFunction::MeshTransformationFunction(MeshPtr mesh, set<GlobalI
   _op = OP_VALUE;
   _mesh = mesh;
   _maxPolynomialDegree = 1; // 1 is the degree of the identity transform (x,y) -> (x,y)
+  _cachesGeometry = true;
   this->updateCells(cellIDsToTransform);
 }
 
+bool MeshTransformationFunction::cachesGeometry()
+{
+  return _cachesGeometry;
+}
+
+void MeshTransformationFunction::clearCurvedCellGeometry(const set<GlobalIndexType> &cellIDs)
+{
+  for (GlobalIndexType cellID : cellIDs)
+  {
+    _curvedCellGeometry.erase(cellID);
+  }
+}
+
+MeshTransformationFunction::CurvedCellGeometry* MeshTransformationFunction::curvedCellGeometry(GlobalIndexType cellID, int sideOrdinal,
+                                                                                               const FieldContainer<double> &physicalCellNodes,
+                                                                                               int cellOrdinal,
+                                                                                               const FieldContainer<double> &refPoints)
+{
+  if (!_cachesGeometry) return NULL;
+  if (_cellTransforms.find(cellID) == _cellTransforms.end()) return NULL;
+
+  size_t pointsHash = std::hash<int>()(refPoints.dimension(0)) ^ (std::hash<int>()(refPoints.dimension(1)) << 1);
+  for (int i=0; i<refPoints.size(); i++)
+  {
+    pointsHash ^= std::hash<double>()(refPoints[i]) + 0x9e3779b9 + (pointsHash << 6) + (pointsHash >> 2);
+  }
+  map< size_t, CurvedCellGeometry >* sideGeometry = &_curvedCellGeometry[cellID][sideOrdinal];
+  if ((sideGeometry->find(pointsHash) == sideGeometry->end()) && (sideGeometry->size() >= MAX_POINT_SETS_PER_SIDE))
+  {
+    sideGeometry->clear();
+  }
+  CurvedCellGeometry* geometry = &(*sideGeometry)[pointsHash];
+
+  // the entry is only good if it was computed from the same reference points and the same straight-edge cell nodes
+  int numNodes = physicalCellNodes.dimension(1);
+  int nodeDim = physicalCellNodes.dimension(2);
+  bool matches = (geometry->refPoints.size() == refPoints.size()) && (geometry->physicalCellNodes.size() == numNodes * nodeDim);
+  for (int i=0; matches && (i<refPoints.size()); i++)
+  {
+    matches = (geometry->refPoints[i] == refPoints[i]);
+  }
+  for (int node=0; matches && (node<numNodes); node++)
+  {
+    for (int d=0; matches && (d<nodeDim); d++)
+    {
+      matches = (geometry->physicalCellNodes(node,d) == physicalCellNodes(cellOrdinal,node,d));
+    }
+  }
+  if (!matches)
+  {
+    *geometry = CurvedCellGeometry();
+    geometry->refPoints = refPoints;
+    geometry->physicalCellNodes.resize(numNodes,nodeDim);
+    for (int node=0; node<numNodes; node++)
+    {
+      for (int d=0; d<nodeDim; d++)
+      {
+        geometry->physicalCellNodes(node,d) = physicalCellNodes(cellOrdinal,node,d);
+      }
+    }
+  }
+  return geometry;
+}
+
+int MeshTransformationFunction::curvedCellGeometryCount()
+{
+  int count = 0;
+  for (auto &cellEntry : _curvedCellGeometry)
+  {
+    for (auto &sideEntry : cellEntry.second)
+    {
+      count += sideEntry.second.size();
+    }
+  }
+  return count;
+}
+
 int MeshTransformationFunction::maxDegree()
 {
   return _maxPolynomialDegree;
 }
 
+void MeshTransformationFunction::setCachesGeometry(bool value)
+{
+  _cachesGeometry = value;
+  if (!_cachesGeometry) _curvedCellGeometry.clear();
+}
+
 bool MeshTransformationFunction::mapRefCellPointsUsingExactGeometry(FieldContainer<double> &cellPoints, const FieldContainer<double> &refCellPoints, GlobalIndexType cellID)
 {
   // returns true if the MeshTransformationFunction handles this cell, false otherwise
@@ -458,6 +543,8 @@ bool MeshTransformationFunction::mapRefCellPointsUsingExactGeometry(FieldContain
 
 void MeshTransformationFunction::updateCells(const set<GlobalIndexType> &cellIDs)
 {
+  // the cell transformations may change geometric order; discard any geometry computed with the old ones
+  clearCurvedCellGeometry(cellIDs);
   for (set<GlobalIndexType>::iterator cellIDIt = cellIDs.begin(); cellIDIt != cellIDs.end(); cellIDIt++)
   {
     GlobalIndexType cellID = *cellIDIt;
@@ -581,6 +668,7 @@ void MeshTransformationFunction::didHRefine(const set<GlobalIndexType> &cellIDs)
       }
     }
   }
+  clearCurvedCellGeometry(cellIDs); // parents are no longer active
   updateCells(childrenWithCurvedEdges);
 }
 
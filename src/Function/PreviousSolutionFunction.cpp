@@ -68,7 +68,7 @@ void PreviousSolutionFunction<Scalar>::setOverrideMeshCheck(bool value, bool don
 template <typename Scalar>
 void PreviousSolutionFunction<Scalar>::importCellData(std::vector<GlobalIndexType> cells)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _soln->mesh()->Comm()->MyPID();
   set<GlobalIndexType> offRankCells;
   const set<GlobalIndexType>* rankLocalCells = &_soln->mesh()->globalDofAssignment()->cellsInPartition(rank);
   for (int cellOrdinal=0; cellOrdinal < cells.size(); cellOrdinal++)
@@ -80,6 +80,12 @@ void PreviousSolutionFunction<Scalar>::importCellData(std::vector<GlobalIndexTyp
   }
   _soln->importSolutionForOffRankCells(offRankCells);
 }
+
+template <typename Scalar>
+void PreviousSolutionFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  _soln->importSolutionForOffRankCells(basisCaches);
+}
 template <typename Scalar>
 void PreviousSolutionFunction<Scalar>::values(FieldContainer<Scalar> &values, BasisCachePtr basisCache)
 {
@@ -185,6 +185,13 @@ bool ProductFunction<Scalar>::boundaryValueOnly()
   return _f1->boundaryValueOnly() || _f2->boundaryValueOnly();
 }
 
+template <typename Scalar>
+void ProductFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  _f1->importOffRankCellData(basisCaches);
+  _f2->importOffRankCellData(basisCaches);
+}
+
 template <typename Scalar>
 void ProductFunction<Scalar>::values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache)
 {
@@ -26,6 +26,13 @@ bool QuotientFunction<Scalar>::boundaryValueOnly()
   return _f->boundaryValueOnly() || _scalarDivisor->boundaryValueOnly();
 }
 
+template <typename Scalar>
+void QuotientFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  _f->importOffRankCellData(basisCaches);
+  _scalarDivisor->importOffRankCellData(basisCaches);
+}
+
 template <typename Scalar>
 string QuotientFunction<Scalar>::displayString()
 {
@@ -35,7 +35,7 @@ string SimpleSolutionFunction<Scalar>::displayString()
 template <typename Scalar>
 void SimpleSolutionFunction<Scalar>::importCellData(std::vector<GlobalIndexType> cells)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _soln->mesh()->Comm()->MyPID();
   set<GlobalIndexType> offRankCells;
   const set<GlobalIndexType>* rankLocalCells = &_soln->mesh()->globalDofAssignment()->cellsInPartition(rank);
   for (int cellOrdinal=0; cellOrdinal < cells.size(); cellOrdinal++)
@@ -48,6 +48,12 @@ void SimpleSolutionFunction<Scalar>::importCellData(std::vector<GlobalIndexType>
   _soln->importSolutionForOffRankCells(offRankCells);
 }
 
+template <typename Scalar>
+void SimpleSolutionFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  _soln->importSolutionForOffRankCells(basisCaches);
+}
+
 template <typename Scalar>
 void SimpleSolutionFunction<Scalar>::values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache)
 {
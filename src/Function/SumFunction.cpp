@@ -20,6 +20,13 @@ bool SumFunction<Scalar>::boundaryValueOnly()
   return _f1->boundaryValueOnly() || _f2->boundaryValueOnly();
 }
 
+template <typename Scalar>
+void SumFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  _f1->importOffRankCellData(basisCaches);
+  _f2->importOffRankCellData(basisCaches);
+}
+
 template <typename Scalar>
 string SumFunction<Scalar>::displayString()
 {
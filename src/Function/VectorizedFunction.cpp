@@ -182,6 +182,15 @@ TFunctionPtr<Scalar> VectorizedFunction<Scalar>::dt()
   return di(dim()-1);
 }
 
+template <typename Scalar>
+void VectorizedFunction<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  for (TFunctionPtr<Scalar> fxn : _fxns)
+  {
+    fxn->importOffRankCellData(basisCaches);
+  }
+}
+
 template <typename Scalar>
 bool VectorizedFunction<Scalar>::isZero()
 {
@@ -5,6 +5,7 @@
 #ifdef HAVE_EPETRAEXT_HDF5
 
 #include "CamelliaCellTools.h"
+#include "DataIO.h"
 #include "MeshTools.h"
 #include "GlobalDofAssignment.h"
 
@@ -25,15 +26,11 @@ using namespace Camellia;
 
 HDF5Exporter::HDF5Exporter(MeshPtr mesh, string outputDirName, string outputDirSuperPath) : _mesh(mesh), _dirName(outputDirName),
   _dirSuperPath(outputDirSuperPath), _fieldXdmf("Xdmf"), _traceXdmf("Xdmf"),
-  _fieldDomain("Domain"), _traceDomain("Domain"), _fieldGrids("Grid"), _traceGrids("Grid")
+  _fieldDomain("Domain"), _traceDomain("Domain"), _fieldGrids("Grid"), _traceGrids("Grid"), _outputMode(FILE_PER_RANK),
+  _asynchronous(false), _maxBufferedBytes(0), _bufferedBytes(0), _writeInProgress(false), _stopWriter(false)
 {
-  int commRank = Teuchos::GlobalMPISession::getRank();
-
-#ifdef HAVE_MPI
-  Epetra_MpiComm Comm(MPI_COMM_WORLD);
-#else
-  Epetra_SerialComm Comm;
-#endif
+  Epetra_CommPtr Comm = _mesh->Comm();
+  int commRank = Comm->MyPID();
 
   if (commRank==0)
   {
@@ -51,7 +48,7 @@ HDF5Exporter::HDF5Exporter(MeshPtr mesh, string outputDirName, string outputDirS
     success = mkdir(dirPath.str().c_str(), S_IRWXU | S_IRWXG);
   }
 
-  Comm.Barrier(); // everyone should wait until rank 0 has created the directories
+  Comm->Barrier(); // everyone should wait until rank 0 has created the directories
 
   if (commRank == 0)
   {
@@ -74,6 +71,170 @@ HDF5Exporter::HDF5Exporter(MeshPtr mesh, string outputDirName, string outputDirS
 
 HDF5Exporter::~HDF5Exporter()
 {
+  // destructors should not throw; any write error has been reported to cout by the writer thread
+  stopWriterThread();
+}
+
+size_t HDF5Exporter::PendingWrite::sizeInBytes() const
+{
+  size_t size = conns.size() * sizeof(int) + points.size() * sizeof(double);
+  for (const vector<double> &valueArray : values)
+  {
+    size += valueArray.size() * sizeof(double);
+  }
+  for (const pair<string, string> &textFile : textFiles)
+  {
+    size += textFile.second.size();
+  }
+  return size;
+}
+
+bool HDF5Exporter::asynchronousWrites() const
+{
+  return _asynchronous;
+}
+
+void HDF5Exporter::enqueueWrite(PendingWrite &&pendingWrite)
+{
+  size_t size = pendingWrite.sizeInBytes();
+  std::unique_lock<std::mutex> lock(_writeMutex);
+  // bound the memory held by the queue; a single write larger than the bound is still allowed once the queue is empty
+  _writeCondition.wait(lock, [&] { return (_bufferedBytes == 0) || (_bufferedBytes + size <= _maxBufferedBytes); });
+  _bufferedBytes += size;
+  _pendingWrites.push_back(std::move(pendingWrite));
+  _writeCondition.notify_all();
+}
+
+void HDF5Exporter::flush()
+{
+  std::unique_lock<std::mutex> lock(_writeMutex);
+  _writeCondition.wait(lock, [&] { return _pendingWrites.empty() && !_writeInProgress; });
+  string writeError = _writeError;
+  _writeError = "";
+  lock.unlock();
+  TEUCHOS_TEST_FOR_EXCEPTION(writeError != "", std::runtime_error, "Asynchronous HDF5 export failed: " << writeError);
+}
+
+void HDF5Exporter::performWrite(const PendingWrite &pendingWrite)
+{
+  if (pendingWrite.h5FilePath != "")
+  {
+    Epetra_SerialComm SerialComm;
+    std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex()); // other exporters' writer threads may also be in HDF5
+    EpetraExt::HDF5 hdf5(SerialComm);
+    hdf5.Create(pendingWrite.h5FilePath);
+    if (pendingWrite.conns.size() > 0)
+    {
+      hdf5.Write("Data", "Conns", H5T_NATIVE_INT, pendingWrite.conns.size(), &pendingWrite.conns[0]);
+      hdf5.Write("Data", "Points", H5T_NATIVE_DOUBLE, pendingWrite.points.size(), &pendingWrite.points[0]);
+      for (int i = 0; i < pendingWrite.valueNames.size(); i++)
+        hdf5.Write("Data", pendingWrite.valueNames[i], H5T_NATIVE_DOUBLE, pendingWrite.values[i].size(), &pendingWrite.values[i][0]);
+    }
+    hdf5.Close();
+  }
+  for (const pair<string, string> &textFile : pendingWrite.textFiles)
+  {
+    ofstream fileStream;
+    fileStream.open(textFile.first.c_str());
+    fileStream << textFile.second;
+    fileStream.close();
+  }
+}
+
+bool HDF5Exporter::asynchronousWritesSupported()
+{
+#ifdef HAVE_MPI
+  int mpiInitialized;
+  MPI_Initialized(&mpiInitialized);
+  if (mpiInitialized)
+  {
+    int threadLevel;
+    MPI_Query_thread(&threadLevel);
+    return threadLevel >= MPI_THREAD_MULTIPLE;
+  }
+#endif
+  return true;
+}
+
+void HDF5Exporter::setAsynchronousWrites(bool asynchronous, size_t maxBufferedBytes)
+{
+  if (asynchronous && !asynchronousWritesSupported())
+  {
+    if (_mesh->Comm()->MyPID() == 0)
+    {
+      cout << "HDF5Exporter: MPI does not provide MPI_THREAD_MULTIPLE, so asynchronous writes are disabled; writing synchronously.\n";
+    }
+    asynchronous = false;
+  }
+  if (!asynchronous)
+  {
+    flush();
+    stopWriterThread();
+  }
+  else if (!_writerThread.joinable())
+  {
+    _stopWriter = false;
+    _writerThread = std::thread(&HDF5Exporter::writerLoop, this);
+  }
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  _asynchronous = asynchronous;
+  _maxBufferedBytes = maxBufferedBytes;
+}
+
+void HDF5Exporter::stopWriterThread()
+{
+  if (!_writerThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _stopWriter = true;
+  }
+  _writeCondition.notify_all();
+  _writerThread.join(); // the writer drains the queue before exiting
+}
+
+void HDF5Exporter::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(_writeMutex);
+  while (true)
+  {
+    _writeCondition.wait(lock, [&] { return _stopWriter || !_pendingWrites.empty(); });
+    if (_pendingWrites.empty()) return; // _stopWriter is set, and there is nothing left to write
+
+    PendingWrite pendingWrite = std::move(_pendingWrites.front());
+    _pendingWrites.pop_front();
+    _writeInProgress = true;
+    lock.unlock();
+
+    string writeError;
+    try
+    {
+      performWrite(pendingWrite);
+    }
+    catch (std::exception &e)
+    {
+      writeError = e.what();
+      cout << "HDF5Exporter: asynchronous write to " << pendingWrite.h5FilePath << " failed: " << writeError << endl;
+    }
+
+    lock.lock();
+    _writeInProgress = false;
+    _bufferedBytes -= pendingWrite.sizeInBytes();
+    if ((writeError != "") && (_writeError == "")) _writeError = writeError;
+    _writeCondition.notify_all();
+  }
+}
+
+HDF5Exporter::OutputMode HDF5Exporter::getOutputMode() const
+{
+  return _outputMode;
+}
+
+void HDF5Exporter::setOutputMode(OutputMode mode)
+{
+  _outputMode = mode;
+  // geometry written in the other mode is laid out differently; don't refer to it
+  _fieldGeometry = ExportedGeometry();
+  _traceGeometry = ExportedGeometry();
 }
 
 void HDF5Exporter::exportSolution(TSolutionPtr<double> solution, double timeVal, unsigned int defaultNum1DPts, map<int, int> cellIDToNum1DPts, set<GlobalIndexType> cellIndices)
@@ -114,7 +275,7 @@ void HDF5Exporter::exportSolution(TSolutionPtr<double> solution, double timeVal,
 
 void HDF5Exporter::exportSolution(TSolutionPtr<double> solution, VarFactoryPtr varFactory, double timeVal, unsigned int defaultNum1DPts, map<int, int> cellIDToNum1DPts, set<GlobalIndexType> cellIndices)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
   if (rank==0) cout << "NOTE: this version of HDF5Exporter::exportSolution() is deprecated.  Remove the VarFactory argument to get rid of this message.\n";
   this->exportSolution(solution,timeVal,defaultNum1DPts,cellIDToNum1DPts,cellIndices);
 }
@@ -130,13 +291,14 @@ void HDF5Exporter::exportFunction(TFunctionPtr<double> function, string function
 
 void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector<string> functionNames, double timeVal, unsigned int defaultNum1DPts, map<int, int> cellIDToNum1DPts, set<GlobalIndexType> cellIndices)
 {
-  int commRank = Teuchos::GlobalMPISession::getRank();
-  int numProcs = Teuchos::GlobalMPISession::getNProc();
+  int commRank = _mesh->Comm()->MyPID();
+  int numProcs = _mesh->Comm()->NumProc();
 
   bool exportingBoundaryValues = functions[0]->boundaryValueOnly();
+  bool sharedFile = (_outputMode == SHARED_FILE);
 
   Teuchos::XMLObject partitionCollection("Grid");
-  if (commRank == 0)
+  if ((commRank == 0) && !sharedFile)
   {
     if (!exportingBoundaryValues)
     {
@@ -191,18 +353,31 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
         TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "Trace collection at timeVal already inserted");
     }
   }
-  ofstream gridFile;
   stringstream partitionFileName;
   if (!exportingBoundaryValues)
     partitionFileName << _dirSuperPath << "/" << _dirName << "/XMF/field" << "-part" << commRank << "-time" << timeVal << ".xmf";
   else
     partitionFileName << _dirSuperPath << "/" << _dirName << "/XMF/trace" << "-part" << commRank << "-time" << timeVal << ".xmf";
-  gridFile.open(partitionFileName.str().c_str());
   Teuchos::XMLObject grid("Grid");
   stringstream gridName;
-  gridName << "Time" << timeVal << "Partition" << commRank;
+  if (!sharedFile)
+    gridName << "Time" << timeVal << "Partition" << commRank;
+  else
+    gridName << "Time" << timeVal;
   grid.addAttribute("Name", gridName.str());
   grid.addAttribute("GridType", "Uniform");
+  if (sharedFile && (commRank == 0))
+  {
+    // a single grid per time value, which refers directly to the shared HDF5 file
+    if (!exportingBoundaryValues)
+      _fieldGrids.addChild(grid);
+    else
+      _traceGrids.addChild(grid);
+    Teuchos::XMLObject time("Time");
+    grid.addChild(time);
+    time.addAttribute("TimeType", "Single");
+    time.addDouble("Value", timeVal);
+  }
 
   int nFcns = functions.size();
 
@@ -218,17 +393,23 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
   stringstream h5OutRel, h5OutFull, connOutRel2, connOutFull2;//, ptOutRel, ptOutFull;
   if (!exportingBoundaryValues)
   {
-    h5OutRel << "HDF5/" << "field-part" << commRank << "-time" << timeVal << ".h5";
+    if (!sharedFile)
+      h5OutRel << "HDF5/" << "field-part" << commRank << "-time" << timeVal << ".h5";
+    else
+      h5OutRel << "HDF5/" << "field-time" << timeVal << ".h5";
     h5OutFull << _dirSuperPath << "/" << _dirName << "/" << h5OutRel.str();
   }
   else
   {
-    h5OutRel << "HDF5/" << "trace-part" << commRank << "-time" << timeVal << ".h5";
+    if (!sharedFile)
+      h5OutRel << "HDF5/" << "trace-part" << commRank << "-time" << timeVal << ".h5";
+    else
+      h5OutRel << "HDF5/" << "trace-time" << timeVal << ".h5";
     h5OutFull << _dirSuperPath << "/" << _dirName << "/" << h5OutRel.str();
   }
-  Epetra_SerialComm Comm;
-  EpetraExt::HDF5 hdf5(Comm);
-  hdf5.Create(h5OutFull.str());
+  // in SHARED_FILE mode, the file is created (and written) collectively on the mesh's communicator
+  Epetra_SerialComm SerialComm;
+  const Epetra_Comm* h5Comm = sharedFile ? _mesh->Comm().get() : &SerialComm;
 
   unsigned int total_vertices = 0;
 
@@ -468,25 +649,22 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
   }
   totalSubcells = totalBoundaryPts + totalSubLines + totalSubTriangles + totalSubQuads + totalSubTets + totalSubWedges + totalSubHexas;
 
-  // Topology
-  Teuchos::XMLObject topology("Topology");
-  grid.addChild(topology);
-  topology.addAttribute("TopologyType", "Mixed");
+  int numTopologyCells = 0;
   if (!exportingBoundaryValues)
   {
     if (spaceDim == 1)
-      topology.addInt("Dimensions", numLines);
+      numTopologyCells = numLines;
     else
-      topology.addInt("Dimensions", totalSubcells);
+      numTopologyCells = totalSubcells;
   }
   else
   {
     if (spaceDim == 1)
-      topology.addInt("Dimensions", totalBoundaryPts);
+      numTopologyCells = totalBoundaryPts;
     else if (spaceDim == 2)
-      topology.addInt("Dimensions", totalBoundaryLines);
+      numTopologyCells = totalBoundaryLines;
     else if (spaceDim == 3)
-      topology.addInt("Dimensions", totalSubQuads + totalSubTriangles);
+      numTopologyCells = totalSubQuads + totalSubTriangles;
   }
   hsize_t connDimsf;
   if (!exportingBoundaryValues)
@@ -506,15 +684,72 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
       connDimsf = 5*totalSubQuads + 4*totalSubTriangles;
   }
   vector<int> connArray(connDimsf);
+  hsize_t ptDimsf;
+  if (spaceDim == 1)
+    ptDimsf = 2 * totalPts;
+  else
+    ptDimsf = spaceDim * totalPts;
+  vector<double> ptArray(ptDimsf);
+
+  // sizes of the datasets as they appear in the XDMF: local in FILE_PER_RANK mode, global in SHARED_FILE mode
+  int xmfTopologyCells = numTopologyCells, xmfConnDims = connDimsf, xmfPtDims = ptDimsf, xmfTotalPts = totalPts;
+  string geometryH5Rel = h5OutRel.str();
+  bool writeGeometry = true;
+  if (sharedFile)
+  {
+    int localCounts[4] = {numTopologyCells, (int)connDimsf, (int)ptDimsf, totalPts};
+    int globalCounts[4];
+    h5Comm->SumAll(localCounts, globalCounts, 4);
+    xmfTopologyCells = globalCounts[0];
+    xmfConnDims = globalCounts[1];
+    xmfPtDims = globalCounts[2];
+    xmfTotalPts = globalCounts[3];
+
+    // connectivity refers to points by their index in the shared Points dataset
+    int myPointOffset;
+    h5Comm->ScanSum(&totalPts, &myPointOffset, 1);
+    total_vertices = myPointOffset - totalPts;
+
+    vector< pair<GlobalIndexType, int> > cellNum1DPts;
+    for (GlobalIndexType cellIndex : cellIndices)
+    {
+      cellNum1DPts.push_back({cellIndex, cellIDToNum1DPts[cellIndex]});
+    }
+    ExportedGeometry* exportedGeometry = exportingBoundaryValues ? &_traceGeometry : &_fieldGeometry;
+    // the topology's geometry version catches refinements and curve changes that leave the exported cells as they were
+    int localGeometryChanged = ((exportedGeometry->h5FilePath == "") || (exportedGeometry->meshTopo != _mesh->getTopology())
+                                || (exportedGeometry->geometryVersion != _mesh->getTopology()->geometryVersion())
+                                || (exportedGeometry->cellNum1DPts != cellNum1DPts)) ? 1 : 0;
+    int geometryChanged;
+    h5Comm->MaxAll(&localGeometryChanged, &geometryChanged, 1);
+    if (geometryChanged)
+    {
+      exportedGeometry->h5FilePath = h5OutRel.str();
+      exportedGeometry->meshTopo = _mesh->getTopology();
+      exportedGeometry->geometryVersion = _mesh->getTopology()->geometryVersion();
+      exportedGeometry->cellNum1DPts = cellNum1DPts;
+    }
+    else
+    {
+      writeGeometry = false;
+      geometryH5Rel = exportedGeometry->h5FilePath;
+    }
+  }
+
+  // Topology
+  Teuchos::XMLObject topology("Topology");
+  grid.addChild(topology);
+  topology.addAttribute("TopologyType", "Mixed");
+  topology.addInt("Dimensions", xmfTopologyCells);
   Teuchos::XMLObject topoDataItem("DataItem");
   topology.addChild(topoDataItem);
   topoDataItem.addAttribute("ItemType", "Uniform");
   topoDataItem.addAttribute("Format", "HDF");
   topoDataItem.addAttribute("NumberType", "Int");
   topoDataItem.addAttribute("Precision", "4");
-  topoDataItem.addInt("Dimensions", connDimsf);
+  topoDataItem.addInt("Dimensions", xmfConnDims);
   stringstream connOutRel;
-  connOutRel << h5OutRel.str() << ":/Data/Conns";
+  connOutRel << geometryH5Rel << ":/Data/Conns";
   topoDataItem.addContent(connOutRel.str());
 
   // Geometry
@@ -524,12 +759,6 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
     geometry.addAttribute("GeometryType", "XY");
   else if (spaceDim == 3)
     geometry.addAttribute("GeometryType", "XYZ");
-  hsize_t ptDimsf;
-  if (spaceDim == 1)
-    ptDimsf = 2 * totalPts;
-  else
-    ptDimsf = spaceDim * totalPts;
-  double ptArray[ptDimsf];
 
   Teuchos::XMLObject geoDataItem("DataItem");
   geometry.addChild(geoDataItem);
@@ -537,9 +766,9 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
   geoDataItem.addAttribute("Format", "HDF");
   geoDataItem.addAttribute("NumberType", "Float");
   geoDataItem.addAttribute("Precision", "8");
-  geoDataItem.addInt("Dimensions", ptDimsf);
+  geoDataItem.addInt("Dimensions", xmfPtDims);
   stringstream ptOutRel;
-  ptOutRel << h5OutRel.str() << ":/Data/Points";
+  ptOutRel << geometryH5Rel << ":/Data/Points";
   geoDataItem.addContent(ptOutRel.str());
 
   // Node Data
@@ -589,7 +818,7 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
     valDataItem.addAttribute("Format", "HDF");
     valDataItem.addAttribute("NumberType", "Float");
     valDataItem.addAttribute("Precision", "8");
-    valDataItem.addInt("Dimensions", valDimsf[i]);
+    valDataItem.addInt("Dimensions", (numFcnComponents[i] == 1) ? xmfTotalPts : 3*xmfTotalPts);
     stringstream valOutRel;
     valOutRel << h5OutRel.str() << ":/Data/" << functionNames[i];
     valDataItem.addContent(valOutRel.str());
@@ -1024,39 +1253,58 @@ void HDF5Exporter::exportFunction(vector<TFunctionPtr<double>> functions, vector
       }
     }
   }
-  if (connDimsf > 0)
+  // everything below is I/O: in FILE_PER_RANK mode, it is packaged so that it can be handed to the writer thread
+  PendingWrite pendingWrite;
+  if (sharedFile)
   {
-    hdf5.Write("Data", "Conns", H5T_NATIVE_INT, connDimsf, &connArray[0]);
-    hdf5.Write("Data", "Points", H5T_NATIVE_DOUBLE, ptDimsf, &ptArray[0]);
-    for (int i = 0; i < nFcns; i++)
-      hdf5.Write("Data", functionNames[i], H5T_NATIVE_DOUBLE, valDimsf[i], &valArrays[i][0]);
-  }
-  hdf5.Close();
+    // collective writes must be issued from this thread; finish any queued writes first, so HDF5 is never entered concurrently
+    flush();
 
-  gridFile << grid.toString();
-  gridFile.close();
+    std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
+    EpetraExt::HDF5 hdf5(*h5Comm);
+    hdf5.Create(h5OutFull.str());
+    if (xmfConnDims > 0)
+    {
+      // distributed writes: each rank contributes its contiguous piece, in rank order
+      if (writeGeometry)
+      {
+        hdf5.Write("Data", "Conns", connDimsf, xmfConnDims, H5T_NATIVE_INT, connArray.data());
+        hdf5.Write("Data", "Points", ptDimsf, xmfPtDims, H5T_NATIVE_DOUBLE, ptArray.data());
+      }
+      for (int i = 0; i < nFcns; i++)
+      {
+        int globalValDims = (numFcnComponents[i] == 1) ? xmfTotalPts : 3*xmfTotalPts;
+        hdf5.Write("Data", functionNames[i], valDimsf[i], globalValDims, H5T_NATIVE_DOUBLE, valArrays[i].data());
+      }
+    }
+    hdf5.Close();
+  }
+  else
+  {
+    pendingWrite.h5FilePath = h5OutFull.str();
+    if (connDimsf > 0)
+    {
+      pendingWrite.conns = std::move(connArray);
+      pendingWrite.points = std::move(ptArray);
+      pendingWrite.valueNames = functionNames;
+      pendingWrite.values = std::move(valArrays);
+    }
+    pendingWrite.textFiles.push_back({partitionFileName.str(), grid.toString()});
+  }
 
   if (commRank == 0)
   {
+    string xmfHeader = "<?xml version=\"1.0\" ?>\n<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n";
     if (_fieldGrids.numChildren() > 0)
-    {
-      ofstream xmfFieldFile;
-      xmfFieldFile.open((_dirSuperPath + "/" + _dirName+"/"+_dirName+"-field.xmf").c_str());
-      xmfFieldFile << "<?xml version=\"1.0\" ?>" << endl
-                   << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>" << endl;
-      xmfFieldFile << _fieldXdmf.toString();
-      xmfFieldFile.close();
-    }
+      pendingWrite.textFiles.push_back({_dirSuperPath + "/" + _dirName+"/"+_dirName+"-field.xmf", xmfHeader + _fieldXdmf.toString()});
     if (_traceGrids.numChildren() > 0)
-    {
-      ofstream xmfTraceFile;
-      xmfTraceFile.open((_dirSuperPath + "/" + _dirName+"/"+_dirName+"-trace.xmf").c_str());
-      xmfTraceFile << "<?xml version=\"1.0\" ?>" << endl
-                   << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>" << endl;
-      xmfTraceFile << _traceXdmf.toString();
-      xmfTraceFile.close();
-    }
+      pendingWrite.textFiles.push_back({_dirSuperPath + "/" + _dirName+"/"+_dirName+"-trace.xmf", xmfHeader + _traceXdmf.toString()});
   }
+
+  if (_asynchronous && !sharedFile)
+    enqueueWrite(std::move(pendingWrite));
+  else
+    performWrite(pendingWrite);
 }
 
 void HDF5Exporter::exportTimeSlab(TFunctionPtr<double> function, string functionName, double tInit, double tFinal, unsigned int numSlices, unsigned int sliceH1Order, unsigned int defaultNum1DPts)
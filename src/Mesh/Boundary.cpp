@@ -51,6 +51,8 @@
 #include "TensorBasis.h"
 #include "VarFactory.h"
 
+#include <tuple>
+
 using namespace Intrepid;
 using namespace Camellia;
 using namespace std;
@@ -58,6 +60,10 @@ using namespace std;
 Boundary::Boundary()
 {
   _mesh = Teuchos::null;
+  _boundarySideBatchesBuilt = false;
+  _boundarySideBatchGeometryVersion = 0;
+  _boundarySideBatchDofInterpreter = NULL;
+  _boundarySideBatchGlobalDofCount = 0;
 }
 
 void Boundary::setMesh(MeshPtr mesh)
@@ -66,11 +72,105 @@ void Boundary::setMesh(MeshPtr mesh)
   buildLookupTables();
 }
 
+void Boundary::buildBoundarySideBatches()
+{
+  _boundarySideBatches.clear();
+  _boundarySideBatchCellIDs = _mesh->cellIDsInPartition();
+  _boundarySideBatchTransformationFunction = _mesh->getTransformationFunction();
+  _boundarySideBatchGeometryVersion = _mesh->getTopology()->geometryVersion();
+
+  // space-time cells require a SpaceTimeBasisCache, which we construct one cell at a time; other cells are grouped
+  // by element type and side.  Key is (elemType, sideOrdinal, cellID), where cellID is -1 except for space-time cells.
+  map< tuple<ElementType*, unsigned, GlobalIndexType>, int > batchOrdinals;
+  for (GlobalIndexType cellID : _boundarySideBatchCellIDs)
+  {
+    CellPtr cell = _mesh->getTopology()->getCell(cellID);
+    ElementTypePtr elemType = _mesh->getElementType(cellID);
+    bool spaceTime = elemType->cellTopoPtr->getTensorialDegree() > 0;
+    for (unsigned sideOrdinal : cell->boundarySides())
+    {
+      auto key = make_tuple(elemType.get(), sideOrdinal, spaceTime ? cellID : (GlobalIndexType) -1);
+      if (batchOrdinals.find(key) == batchOrdinals.end())
+      {
+        batchOrdinals[key] = _boundarySideBatches.size();
+        BoundarySideBatch batch;
+        batch.elemType = elemType;
+        batch.sideOrdinal = sideOrdinal;
+        _boundarySideBatches.push_back(batch);
+      }
+      _boundarySideBatches[batchOrdinals[key]].cellIDs.push_back(cellID);
+    }
+  }
+
+  for (BoundarySideBatch &batch : _boundarySideBatches)
+  {
+    if (batch.elemType->cellTopoPtr->getTensorialDegree() > 0) continue; // space-time: see sideBasisCacheForBatch()
+    CellTopoPtr cellTopo = batch.elemType->cellTopoPtr;
+    int numCells = batch.cellIDs.size();
+    int numNodes = cellTopo->getNodeCount();
+    int numSides = cellTopo->getSideCount();
+    int spaceDim = cellTopo->getDimension();
+    batch.physicalCellNodes.resize(numCells, numNodes, spaceDim);
+    batch.cellSideParities.resize(numCells, numSides);
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      GlobalIndexType cellID = batch.cellIDs[cellOrdinal];
+      FieldContainer<double> cellNodes = _mesh->physicalCellNodesForCell(cellID);
+      for (int nodeOrdinal=0; nodeOrdinal<numNodes; nodeOrdinal++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          batch.physicalCellNodes(cellOrdinal,nodeOrdinal,d) = cellNodes(0,nodeOrdinal,d);
+        }
+      }
+      FieldContainer<double> parities = _mesh->cellSideParitiesForCell(cellID);
+      for (int sideOrdinal=0; sideOrdinal<numSides; sideOrdinal++)
+      {
+        batch.cellSideParities(cellOrdinal,sideOrdinal) = parities(0,sideOrdinal);
+      }
+    }
+  }
+  _boundarySideBatchesBuilt = true;
+}
+
+BasisCachePtr Boundary::sideBasisCacheForBatch(const BoundarySideBatch &batch)
+{
+  if (batch.elemType->cellTopoPtr->getTensorialDegree() > 0)
+  {
+    // space-time cells require a SpaceTimeBasisCache
+    return BasisCache::basisCacheForCell(_mesh, batch.cellIDs[0])->getSideBasisCache(batch.sideOrdinal);
+  }
+  BasisCachePtr volumeCache = Teuchos::rcp( new BasisCache(batch.elemType, _mesh) );
+  bool createSideCache = false; // we only need the one side
+  volumeCache->setPhysicalCellNodes(batch.physicalCellNodes, batch.cellIDs, createSideCache);
+  volumeCache->setCellSideParities(batch.cellSideParities);
+  return BasisCache::sideBasisCache(volumeCache, batch.sideOrdinal);
+}
+
+bool Boundary::boundarySideBatchesAreValid()
+{
+  if (!_boundarySideBatchesBuilt) return false;
+  if (_boundarySideBatchCellIDs != _mesh->cellIDsInPartition()) return false;
+  // curved geometry: setEdgeToCurveMap() replaces the transformation function, and refinements update it in place
+  if (_boundarySideBatchTransformationFunction.get() != _mesh->getTransformationFunction().get()) return false;
+  if (_boundarySideBatchGeometryVersion != _mesh->getTopology()->geometryVersion()) return false;
+  for (const BoundarySideBatch &batch : _boundarySideBatches)
+  {
+    for (GlobalIndexType cellID : batch.cellIDs)
+    {
+      if (_mesh->getElementType(cellID).get() != batch.elemType.get()) return false; // e.g., p-refinement
+    }
+  }
+  return true;
+}
+
 void Boundary::buildLookupTables()
 {
   _boundaryElements.clear();
+  _boundarySideBatches.clear();
+  _boundarySideBatchesBuilt = false; // batches are built lazily, on the next bcsToImpose() call
 
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
 
   set< GlobalIndexType > rankLocalCells = _mesh->cellIDsInPartition();
   for (set< GlobalIndexType >::iterator cellIDIt = rankLocalCells.begin(); cellIDIt != rankLocalCells.end(); cellIDIt++)
@@ -135,6 +235,122 @@ void Boundary::bcsToImpose(FieldContainer<GlobalIndexType> &globalIndices, Field
   }
 }
 
+template <typename Scalar>
+void Boundary::dirichletBCsToImpose(map< GlobalIndexType, Scalar > &globalDofIndicesAndValues, TBC<Scalar> &bc,
+                                    DofInterpreter* dofInterpreter)
+{
+  if (!boundarySideBatchesAreValid()) buildBoundarySideBatches();
+
+  GlobalIndexType globalDofCount = dofInterpreter->globalDofCount();
+  if ((dofInterpreter != _boundarySideBatchDofInterpreter) || (globalDofCount != _boundarySideBatchGlobalDofCount))
+  {
+    for (BoundarySideBatch &batch : _boundarySideBatches)
+    {
+      for (auto &entry : batch.projections)
+      {
+        entry.second.globalDofIndices.clear();
+        entry.second.localToGlobal.clear();
+      }
+    }
+    _boundarySideBatchDofInterpreter = dofInterpreter;
+    _boundarySideBatchGlobalDofCount = globalDofCount;
+  }
+
+  BCPtr bcPtr = Teuchos::rcp(&bc, false);
+  vector< int > trialIDs = _mesh->bilinearForm()->trialIDs();
+  for (BoundarySideBatch &batch : _boundarySideBatches)
+  {
+    DofOrderingPtr trialOrderingPtr = batch.elemType->trialOrderPtr;
+    unsigned sideOrdinal = batch.sideOrdinal;
+    BasisCachePtr sideBasisCache; // constructed only if some trial ID on this side has BCs
+    int numCells = batch.cellIDs.size();
+    for (int trialID : trialIDs)
+    {
+      if (! bc.bcsImposed(trialID) ) continue;
+
+      BasisPtr basis;
+      int numDofsSide;
+      if (trialOrderingPtr->getSidesForVarID(trialID).size() == 1)
+      {
+        // volume basis
+        basis = trialOrderingPtr->getBasis(trialID);
+        // get the dof ordinals for the side (interpreted as a "continuous" basis)
+        numDofsSide = basis->dofOrdinalsForSide(sideOrdinal).size();
+      }
+      else if (! trialOrderingPtr->hasBasisEntry(trialID, sideOrdinal))
+      {
+        continue;
+      }
+      else
+      {
+        basis = trialOrderingPtr->getBasis(trialID,sideOrdinal);
+        numDofsSide = basis->getCardinality();
+      }
+
+      if (sideBasisCache == Teuchos::null) sideBasisCache = sideBasisCacheForBatch(batch);
+
+      BoundarySideProjection* sideProjection = &batch.projections[trialID];
+      if (sideProjection->projection == Teuchos::null)
+      {
+        sideProjection->projection = Teuchos::rcp( new Projector<double>::InterpolatingProjection(basis, sideBasisCache) );
+      }
+      if (sideProjection->localToGlobal.size() == 0)
+      {
+        // the local-to-global interpretation is linear in the side coefficients; determine its matrix one column at a time
+        sideProjection->globalDofIndices.resize(numCells);
+        sideProjection->localToGlobal.resize(numCells);
+        FieldContainer<double> unitCoefficients(numDofsSide);
+        for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+        {
+          FieldContainer<double>* localToGlobal = &sideProjection->localToGlobal[cellOrdinal];
+          for (int dofOrdinal=0; dofOrdinal<numDofsSide; dofOrdinal++)
+          {
+            unitCoefficients.initialize(0.0);
+            unitCoefficients(dofOrdinal) = 1.0;
+            FieldContainer<double> globalData;
+            FieldContainer<GlobalIndexType> globalDofIndices;
+            dofInterpreter->interpretLocalBasisCoefficients(batch.cellIDs[cellOrdinal], trialID, sideOrdinal, unitCoefficients,
+                                                            globalData, globalDofIndices);
+            if (dofOrdinal == 0)
+            {
+              for (int globalDofOrdinal=0; globalDofOrdinal<globalDofIndices.size(); globalDofOrdinal++)
+              {
+                sideProjection->globalDofIndices[cellOrdinal].push_back(globalDofIndices(globalDofOrdinal));
+              }
+              localToGlobal->resize(globalDofIndices.size(), numDofsSide);
+            }
+            for (int globalDofOrdinal=0; globalDofOrdinal<globalDofIndices.size(); globalDofOrdinal++)
+            {
+              (*localToGlobal)(globalDofOrdinal,dofOrdinal) = globalData(globalDofOrdinal);
+            }
+          }
+        }
+      }
+
+      // project bc function onto side basis, on all the batch's cells at once; only the load depends on the BC function:
+      FieldContainer<double> dirichletValues(numCells,numDofsSide);
+      Teuchos::RCP<BCFunction<double>> bcFunction = BCFunction<double>::bcFunction(bcPtr, trialID);
+      sideProjection->projection->apply(dirichletValues, bcFunction, sideBasisCache);
+
+      for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+      {
+        if (!bcFunction->imposeOnCell(cellOrdinal)) continue;
+        const vector<GlobalIndexType>* globalDofIndices = &sideProjection->globalDofIndices[cellOrdinal];
+        const FieldContainer<double>* localToGlobal = &sideProjection->localToGlobal[cellOrdinal];
+        for (int globalDofOrdinal=0; globalDofOrdinal<globalDofIndices->size(); globalDofOrdinal++)
+        {
+          double value = 0.0;
+          for (int dofOrdinal=0; dofOrdinal<numDofsSide; dofOrdinal++)
+          {
+            value += (*localToGlobal)(globalDofOrdinal,dofOrdinal) * dirichletValues(cellOrdinal,dofOrdinal);
+          }
+          globalDofIndicesAndValues[(*globalDofIndices)[globalDofOrdinal]] = value;
+        }
+      }
+    }
+  }
+}
+
 template <typename Scalar>
 void Boundary::bcsToImpose(FieldContainer<GlobalIndexType> &globalIndices,
                            FieldContainer<Scalar> &globalValues, TBC<Scalar> &bc,
@@ -179,18 +395,11 @@ void Boundary::bcsToImpose(FieldContainer<GlobalIndexType> &globalIndices,
   }
 
   map< GlobalIndexType, double> bcGlobalIndicesAndValues;
-  set < pair<int, unsigned> > noSingletons;
 
-  for (set< GlobalIndexType >::iterator cellIDIt = rankLocalCells.begin(); cellIDIt != rankLocalCells.end(); cellIDIt++)
+  dirichletBCsToImpose(bcGlobalIndicesAndValues, bc, dofInterpreter);
+  for (auto cellSingletons : singletonsForCell)
   {
-    if (singletonsForCell.find(*cellIDIt) != singletonsForCell.end())
-    {
-      bcsToImpose(bcGlobalIndicesAndValues, bc, *cellIDIt, singletonsForCell[*cellIDIt], dofInterpreter);
-    }
-    else
-    {
-      bcsToImpose(bcGlobalIndicesAndValues, bc, *cellIDIt, noSingletons, dofInterpreter);
-    }
+    singletonBCsToImpose(bcGlobalIndicesAndValues, bc, cellSingletons.first, cellSingletons.second, dofInterpreter);
   }
   
   // ****** New, tag-based BC imposition follows ******
@@ -317,20 +526,10 @@ void Boundary::bcsToImpose( map<  GlobalIndexType, Scalar > &globalDofIndicesAnd
                             GlobalIndexType cellID, set < pair<int, unsigned> > &singletons,
                             DofInterpreter* dofInterpreter)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
-
-  // this is where we actually compute the BCs; the other bcsToImpose variants call this one.
+  // computes the BCs for a single cell, one side at a time; the other bcsToImpose variants use dirichletBCsToImpose(),
+  // which does the same projections in batches of cells.
   CellPtr cell = _mesh->getTopology()->getCell(cellID);
 
-  // define a couple of important inner products:
-  TIPPtr<Scalar> ipL2 = Teuchos::rcp( new TIP<Scalar> );
-  TIPPtr<Scalar> ipH1 = Teuchos::rcp( new TIP<Scalar> );
-  VarFactoryPtr varFactory = VarFactory::varFactory();
-  VarPtr trace = varFactory->traceVar("trace");
-  VarPtr flux = varFactory->traceVar("flux");
-  ipL2->addTerm(flux);
-  ipH1->addTerm(trace);
-  ipH1->addTerm(trace->grad());
   ElementTypePtr elemType = _mesh->getElementType(cellID);
   DofOrderingPtr trialOrderingPtr = elemType->trialOrderPtr;
   vector< int > trialIDs = _mesh->bilinearForm()->trialIDs();
@@ -412,6 +611,17 @@ void Boundary::bcsToImpose( map<  GlobalIndexType, Scalar > &globalDofIndicesAnd
     }
   }
 
+  singletonBCsToImpose(globalDofIndicesAndValues, bc, cellID, singletons, dofInterpreter);
+}
+
+template <typename Scalar>
+void Boundary::singletonBCsToImpose(map< GlobalIndexType, Scalar > &globalDofIndicesAndValues, TBC<Scalar> &bc,
+                                    GlobalIndexType cellID, set < pair<int, unsigned> > &singletons,
+                                    DofInterpreter* dofInterpreter)
+{
+  int rank = _mesh->Comm()->MyPID();
+  ElementTypePtr elemType = _mesh->getElementType(cellID);
+
   map<int, vector<unsigned> > vertexOrdinalsForTrialID;
   for (pair<int, unsigned> trialVertexPair : singletons)
   {
@@ -8,6 +8,8 @@
 
 #include <Teuchos_GlobalMPISession.hpp>
 
+#include "Epetra_Distributor.h"
+
 #include "CellDataMigration.h"
 
 #include "GlobalDofAssignment.h"
@@ -193,3 +195,75 @@ void CellDataMigration::unpackData(Mesh *mesh, GlobalIndexType cellID, const cha
 //    cout << "setting solution coefficients for cellID " << cellID << endl << solnCoeffs;
   }
 }
+
+int CellDataMigration::migrate(Mesh *mesh, const vector<GlobalIndexType> &exportCellIDs, const vector<int> &exportRanks)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(exportCellIDs.size() != exportRanks.size(), std::invalid_argument, "exportCellIDs and exportRanks must have the same length");
+
+  bool haveSolutions = mesh->globalDofAssignment()->getRegisteredSolutions().size() > 0;
+  int haveSolutionsInt = haveSolutions ? 1 : 0, anyHaveSolutions;
+  mesh->Comm()->MaxAll(&haveSolutionsInt, &anyHaveSolutions, 1);
+  if (anyHaveSolutions == 0) return 0; // nothing to migrate
+
+  // each record is (cellID, data size, data); records are self-describing so that the receiver can unpack them in sequence
+  int headerSize = sizeof(GlobalIndexType) + sizeof(int);
+  int numExports = exportCellIDs.size();
+  vector<int> recordSizes(numExports);
+  int totalExportSize = 0;
+  for (int i=0; i<numExports; i++)
+  {
+    recordSizes[i] = headerSize + dataSize(mesh, exportCellIDs[i]);
+    totalExportSize += recordSizes[i];
+  }
+
+  vector<char> exportBuffer(totalExportSize);
+  char* dataLocation = exportBuffer.data();
+  for (int i=0; i<numExports; i++)
+  {
+    GlobalIndexType cellID = exportCellIDs[i];
+    int size = recordSizes[i] - headerSize;
+    memcpy(dataLocation, &cellID, sizeof(cellID));
+    dataLocation += sizeof(cellID);
+    memcpy(dataLocation, &size, sizeof(size));
+    dataLocation += sizeof(size);
+
+    // same rule as ZoltanMeshPartitionPolicy: a child without coefficients of its own ships its parent's
+    CellPtr cell = mesh->getTopology()->getCell(cellID);
+    bool isChild = cell->getParent().get() != NULL;
+    bool hasData = false;
+    if (haveSolutions)
+    {
+      TSolutionPtr<double> soln = mesh->globalDofAssignment()->getRegisteredSolutions()[0];
+      hasData = soln->cellHasCoefficientsAssigned(cellID);
+    }
+    packData(mesh, cellID, isChild && !hasData, dataLocation, size);
+    dataLocation += size;
+  }
+
+  Teuchos::RCP<Epetra_Distributor> distributor = Teuchos::rcp( mesh->Comm()->CreateDistributor() );
+  int numImports;
+  bool deterministic = true;
+  distributor->CreateFromSends(numExports, exportRanks.data(), deterministic, numImports);
+
+  int importLength = 0;
+  char* importBuffer = NULL;
+  int* sizes = recordSizes.data();
+  int objSize = 1; // sizes are in bytes
+  distributor->Do(exportBuffer.data(), objSize, sizes, importLength, importBuffer);
+
+  const char* importLocation = importBuffer;
+  for (int i=0; i<numImports; i++)
+  {
+    GlobalIndexType cellID;
+    int size;
+    memcpy(&cellID, importLocation, sizeof(cellID));
+    importLocation += sizeof(cellID);
+    memcpy(&size, importLocation, sizeof(size));
+    importLocation += sizeof(size);
+    unpackData(mesh, cellID, importLocation, size);
+    importLocation += size;
+  }
+  delete[] importBuffer;
+
+  return totalExportSize;
+}
@@ -167,16 +167,11 @@ std::set<GlobalIndexType> DofInterpreter::importGlobalIndicesForCells(const std:
 {
   // INITIAL, DRAFT implementation: aiming first for correctness.
   // (that's to say, there may be a better way to do some of this)
-  int rank = Teuchos::GlobalMPISession::getRank();
+  Epetra_CommPtr Comm = _mesh->Comm();
+  int rank = Comm->MyPID();
 
   set<GlobalIndexType> dofIndicesSet;
 
-#ifdef HAVE_MPI
-  Epetra_MpiComm Comm(MPI_COMM_WORLD);
-#else
-  Epetra_SerialComm Comm;
-#endif
-
   vector<int> myRequestOwners;
   vector<GlobalIndexTypeToCast> myRequest;
   for (int cellOrdinal=0; cellOrdinal<cellIDs.size(); cellOrdinal++)
@@ -197,11 +192,18 @@ std::set<GlobalIndexType> DofInterpreter::importGlobalIndicesForCells(const std:
 
   int myRequestCount = myRequest.size();
 
+  Teuchos::RCP<Epetra_Distributor> distributor;
 #ifdef HAVE_MPI
-  Epetra_MpiDistributor distributor(Comm);
-#else
-  Epetra_SerialDistributor distributor(Comm);
+  Epetra_MpiComm* mpiComm = dynamic_cast<Epetra_MpiComm*>(Comm.get());
+  if (mpiComm != NULL)
+    distributor = Teuchos::rcp( new Epetra_MpiDistributor(*mpiComm) );
 #endif
+  if (distributor == Teuchos::null)
+  {
+    Epetra_SerialComm* serialComm = dynamic_cast<Epetra_SerialComm*>(Comm.get());
+    TEUCHOS_TEST_FOR_EXCEPTION(serialComm == NULL, std::invalid_argument, "importGlobalIndicesForCells() requires an Epetra_MpiComm or an Epetra_SerialComm");
+    distributor = Teuchos::rcp( new Epetra_SerialDistributor(*serialComm) );
+  }
 
   GlobalIndexTypeToCast* myRequestPtr = NULL;
   int *myRequestOwnersPtr = NULL;
@@ -214,7 +216,7 @@ std::set<GlobalIndexType> DofInterpreter::importGlobalIndicesForCells(const std:
   GlobalIndexTypeToCast* cellIDsToExport = NULL;  // we are responsible for deleting the allocated arrays
   int* exportRecipients = NULL;
 
-  distributor.CreateFromRecvs(myRequestCount, myRequestPtr, myRequestOwnersPtr, true, numCellsToExport, cellIDsToExport, exportRecipients);
+  distributor->CreateFromRecvs(myRequestCount, myRequestPtr, myRequestOwnersPtr, true, numCellsToExport, cellIDsToExport, exportRecipients);
 
   const std::set<GlobalIndexType>* myCells = &_mesh->globalDofAssignment()->cellsInPartition(-1);
 
@@ -248,7 +250,7 @@ std::set<GlobalIndexType> DofInterpreter::importGlobalIndicesForCells(const std:
     sizePtr = &sizes[0];
     indicesToExportPtr = (char *) &indicesToExport[0];
   }
-  distributor.Do(indicesToExportPtr, objSize, sizePtr, importLength, globalIndexData);
+  distributor->Do(indicesToExportPtr, objSize, sizePtr, importLength, globalIndexData);
   const char* copyFromLocation = globalIndexData;
   int numDofsImport = importLength / objSize;
   vector<GlobalIndexTypeToCast> globalIndicesVector(numDofsImport);
@@ -296,11 +298,7 @@ map<GlobalIndexType,set<GlobalIndexType>> DofInterpreter::importGlobalIndicesMap
    
    */
   
-#ifdef HAVE_MPI
-  Epetra_MpiComm Comm(MPI_COMM_WORLD);
-#else
-  Epetra_SerialComm Comm;
-#endif
+  const Epetra_Comm &Comm = *_mesh->Comm();
   
   map<GlobalIndexType,set<GlobalIndexType>> globalIndicesMap;
   
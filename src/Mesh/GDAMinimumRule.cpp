@@ -127,6 +127,51 @@ void GDAMinimumRule::setCheckConstraintConsistency(bool value)
   _checkConstraintConsistency = value;
 }
 
+void GDAMinimumRule::setUseIncrementalRebuild(bool value)
+{
+  _useIncrementalRebuild = value;
+}
+
+set<GlobalIndexType> GDAMinimumRule::cellsAffectedByChangesTo(const set<GlobalIndexType> &changedCellIDs)
+{
+  // Constraints and ownership for a cell are determined by the cells that share its subcells, together with the cells
+  // that own the entities constraining those subcells.  For a 1-irregular mesh, any cell whose constraints can change
+  // when a cell is h- or p-refined touches either that cell or one of its vertex neighbors at a vertex; we therefore take
+  // two layers of vertex neighbors.
+  const set<IndexType>* activeCellIDs = &_meshTopology->getActiveCellIndices();
+  static const unsigned vertexDim = 0;
+  
+  auto addVertexNeighbors = [this, activeCellIDs] (GlobalIndexType cellID, set<GlobalIndexType> &neighbors) -> void
+  {
+    CellPtr cell = _meshTopology->getCell(cellID);
+    if (activeCellIDs->find(cellID) != activeCellIDs->end()) neighbors.insert(cellID);
+    for (IndexType vertexIndex : cell->vertices())
+    {
+      for (auto activeCellEntry : _meshTopology->getActiveCellIndices(vertexDim, vertexIndex))
+      {
+        neighbors.insert(activeCellEntry.first);
+      }
+    }
+  };
+  
+  set<GlobalIndexType> firstLayer;
+  for (GlobalIndexType cellID : changedCellIDs)
+  {
+    if (!_meshTopology->isValidCellIndex(cellID)) continue;
+    addVertexNeighbors(cellID, firstLayer);
+    for (IndexType childCellID : _meshTopology->getCell(cellID)->getChildIndices(_meshTopology))
+    {
+      addVertexNeighbors(childCellID, firstLayer);
+    }
+  }
+  set<GlobalIndexType> affectedCellIDs = firstLayer;
+  for (GlobalIndexType cellID : firstLayer)
+  {
+    addVertexNeighbors(cellID, affectedCellIDs);
+  }
+  return affectedCellIDs;
+}
+
 GlobalDofAssignmentPtr GDAMinimumRule::deepCopy()
 {
   return Teuchos::rcp(new GDAMinimumRule(*this) );
@@ -143,6 +188,7 @@ void GDAMinimumRule::didHRefine(const set<GlobalIndexType> &parentCellIDs)
   for (set<GlobalIndexType>::const_iterator cellIDIt = parentCellIDs.begin(); cellIDIt != parentCellIDs.end(); cellIDIt++)
   {
     GlobalIndexType parentCellID = *cellIDIt;
+    _cellsChangedSinceRebuild.insert(parentCellID);
 //    cout << "GDAMinimumRule: h-refining " << parentCellID << endl;
     CellPtr parentCell = _meshTopology->getCell(parentCellID);
     vector<IndexType> childIDs = parentCell->getChildIndices(_meshTopology);
@@ -195,9 +241,11 @@ void GDAMinimumRule::didPRefine(const set<GlobalIndexType> &cellIDs, int deltaP)
   for (set<GlobalIndexType>::const_iterator cellIDIt = cellIDs.begin(); cellIDIt != cellIDs.end(); cellIDIt++)
   {
     CellPtr cell = _meshTopology->getCell(*cellIDIt);
+    _cellsChangedSinceRebuild.insert(*cellIDIt);
     CellPtr parent = cell->getParent();
     while (parent.get() != NULL)
     {
+      _cellsChangedSinceRebuild.insert(parent->cellIndex()); // ancestor H1 orders can change, too
       vector<IndexType> childIndices = parent->getChildIndices(_meshTopology);
       vector<int> minH1Order = _cellH1Orders[*cellIDIt];
       for (int childOrdinal=0; childOrdinal<childIndices.size(); childOrdinal++)
@@ -238,6 +286,7 @@ void GDAMinimumRule::didPRefine(const set<GlobalIndexType> &cellIDs, int deltaP)
 void GDAMinimumRule::didHUnrefine(const set<GlobalIndexType> &parentCellIDs)
 {
   this->GlobalDofAssignment::didHUnrefine(parentCellIDs);
+  _fullRebuildRequired = true;
   // TODO: implement this
   cout << "WARNING: GDAMinimumRule::didHUnrefine() unimplemented.\n";
   // will need to treat cell side parities here--probably suffices to redo those in parentCellIDs plus all their neighbors.
@@ -504,11 +553,11 @@ void GDAMinimumRule::interpretLocalData(GlobalIndexType cellID, const Intrepid::
 //  }
 
   globalData = dofMapper->mapLocalData(localData, false);
-  vector<GlobalIndexType> globalIndexVector = dofMapper->globalIndices();
-  globalDofIndices.resize(globalIndexVector.size());
-  for (int i=0; i<globalIndexVector.size(); i++)
+  const vector<GlobalIndexType>* globalIndexVector = &dofMapper->globalIndices();
+  globalDofIndices.resize(globalIndexVector->size());
+  for (int i=0; i<globalIndexVector->size(); i++)
   {
-    globalDofIndices(i) = globalIndexVector[i];
+    globalDofIndices(i) = (*globalIndexVector)[i];
   }
 
 //  // mostly for debugging purposes, let's sort according to global dof index:
@@ -3571,10 +3620,63 @@ void GDAMinimumRule::printGlobalDofInfo()
 
 void GDAMinimumRule::rebuildLookups()
 {
-  _constraintsCache.clear(); // to free up memory, could clear this again after the lookups are rebuilt.  Having the cache is most important during the construction below.
+  int rank = _partitionPolicy->Comm()->MyPID();
+//  cout << "GDAMinimumRule: Rebuilding lookups on rank " << rank << endl;
+  set<GlobalIndexType>* myCellIDs = &_partitions[rank];
+
+  bool incremental = _useIncrementalRebuild && _lookupsBuilt && !_fullRebuildRequired && !_allowCascadingConstraints;
+  if (incremental)
+  {
+    // retain constraints and owned dofs for cells whose neighborhood has not changed.  Owned dofs are retained only for
+    // cells in our partition; we shift these to be relative to the cell's dof offset, as they are when first computed below.
+    set<GlobalIndexType> affectedCellIDs = cellsAffectedByChangesTo(_cellsChangedSinceRebuild);
+    const set<IndexType>* activeCellIDs = &_meshTopology->getActiveCellIndices();
+    for (auto entryIt = _constraintsCache.begin(); entryIt != _constraintsCache.end();)
+    {
+      GlobalIndexType cellID = entryIt->first;
+      if ((activeCellIDs->find(cellID) == activeCellIDs->end()) || (affectedCellIDs.find(cellID) != affectedCellIDs.end()))
+        entryIt = _constraintsCache.erase(entryIt);
+      else
+        entryIt++;
+    }
+    for (auto entryIt = _ownedGlobalDofIndicesCache.begin(); entryIt != _ownedGlobalDofIndicesCache.end();)
+    {
+      GlobalIndexType cellID = entryIt->first;
+      if ((_constraintsCache.find(cellID) == _constraintsCache.end()) || (myCellIDs->find(cellID) == myCellIDs->end())
+          || (_globalCellDofOffsets.find(cellID) == _globalCellDofOffsets.end()))
+      {
+        entryIt = _ownedGlobalDofIndicesCache.erase(entryIt);
+        continue;
+      }
+      GlobalIndexType oldCellDofOffset = _globalCellDofOffsets[cellID];
+      for (SubCellOrdinalToMap &scordMap : entryIt->second)
+      {
+        for (auto &scordEntry : scordMap)
+        {
+          for (auto &varEntry : scordEntry.second)
+          {
+            for (GlobalIndexType &dofIndex : varEntry.second)
+            {
+              dofIndex -= oldCellDofOffset;
+            }
+          }
+        }
+      }
+      entryIt++;
+    }
+  }
+  else
+  {
+    _constraintsCache.clear(); // to free up memory, could clear this again after the lookups are rebuilt.  Having the cache is most important during the construction below.
+    _ownedGlobalDofIndicesCache.clear();
+  }
+  _cellsChangedSinceRebuild.clear();
+  _fullRebuildRequired = false;
+  _lookupsBuilt = true;
+
+  // these refer to dofs owned by other cells, whose offsets may change
   _dofMapperCache.clear();
   _dofMapperForVariableOnSideCache.clear();
-  _ownedGlobalDofIndicesCache.clear();
   _globalDofIndicesForCellCache.clear();
   _fittableGlobalIndicesCache.clear();
 
@@ -3582,10 +3684,6 @@ void GDAMinimumRule::rebuildLookups()
   _partitionFluxDofCount = 0;
   _partitionTraceDofCount = 0;
 
-  int rank = _partitionPolicy->Comm()->MyPID();
-//  cout << "GDAMinimumRule: Rebuilding lookups on rank " << rank << endl;
-  set<GlobalIndexType>* myCellIDs = &_partitions[rank];
-
   map<int, VarPtr> trialVars = _varFactory->trialVars();
 
   _cellDofOffsets.clear(); // within the partition, offsets for the owned dofs in cell
@@ -3608,7 +3706,8 @@ void GDAMinimumRule::rebuildLookups()
   int spaceDim = _meshTopology->getDimension();
 
   _partitionDofCount = 0; // how many dofs we own locally
-  for (GlobalIndexType cellID : *myCellIDs)
+  vector<GlobalIndexType> myOrderedCellIDs = orderedCellsInPartition(rank); // determines the partition-local dof numbering
+  for (GlobalIndexType cellID : myOrderedCellIDs)
   {
     _cellDofOffsets[cellID] = _partitionDofCount;
     CellPtr cell = _meshTopology->getCell(cellID);
@@ -3740,10 +3839,11 @@ void GDAMinimumRule::rebuildLookups()
   _cellIDsForElementType = vector< map< ElementType*, vector<GlobalIndexType> > >(numRanks);
   for (int i=0; i<numRanks; i++)
   {
-    set<GlobalIndexType> cellIDs = _partitions[i];
-    for (set<GlobalIndexType>::iterator cellIDIt = cellIDs.begin(); cellIDIt != cellIDs.end(); cellIDIt++)
+    // only our own cells need ordering (it determines our assembly batches); others are listed in cellID order
+    const set<GlobalIndexType>* partitionCellIDs = &_partitions[i];
+    vector<GlobalIndexType> cellIDs = (i == rank) ? myOrderedCellIDs : vector<GlobalIndexType>(partitionCellIDs->begin(), partitionCellIDs->end());
+    for (GlobalIndexType cellID : cellIDs)
     {
-      GlobalIndexType cellID = *cellIDIt;
       ElementTypePtr elemType = _elementTypeForCell[cellID];
       _cellIDsForElementType[i][elemType.get()].push_back(cellID);
     }
@@ -10,6 +10,8 @@
 
 #include "Teuchos_GlobalMPISession.hpp"
 
+#include <algorithm>
+#include <limits>
 
 // subclasses:
 #include "GDAMinimumRule.h"
@@ -17,8 +19,10 @@
 
 #include "CamelliaCellTools.h"
 #include "CamelliaDebugUtility.h"
+#include "CellDataMigration.h"
 #include "CondensedDofInterpreter.h"
 #include "Solution.h"
+#include "SpaceFillingCurvePartitionPolicy.h"
 
 using namespace Intrepid;
 using namespace Camellia;
@@ -65,11 +69,19 @@ GlobalDofAssignment::GlobalDofAssignment(MeshPtr mesh, VarFactoryPtr varFactory,
   // before repartitioning (which should happen immediately), put all active cells on rank 0
   _partitions[0] = _mesh->getActiveCellIDs();
   constructActiveCellMap();
+
+  _cellOrdering = CELL_ID_ORDERING;
+
+  _hasBeenPartitioned = false;
+  _lastRepartitionSkipped = false;
+  _lastRepartitionMigratedCellCount = 0;
+  _lastRepartitionMigratedBytes = 0;
 }
 
 GlobalDofAssignment::GlobalDofAssignment( GlobalDofAssignment &otherGDA ) : DofInterpreter(Teuchos::null)    // subclass deepCopy() is responsible for filling this in post-construction
 {
   _activeCellOffset = otherGDA._activeCellOffset;
+  _cellOrdering = otherGDA._cellOrdering;
   _cellSideParitiesForCellID = otherGDA._cellSideParitiesForCellID;
 
   _elementTypeFactory = otherGDA._elementTypeFactory;
@@ -96,6 +108,11 @@ GlobalDofAssignment::GlobalDofAssignment( GlobalDofAssignment &otherGDA ) : DofI
 
   _numPartitions = otherGDA._numPartitions;
 
+  _hasBeenPartitioned = otherGDA._hasBeenPartitioned;
+  _lastRepartitionSkipped = otherGDA._lastRepartitionSkipped;
+  _lastRepartitionMigratedCellCount = otherGDA._lastRepartitionMigratedCellCount;
+  _lastRepartitionMigratedBytes = otherGDA._lastRepartitionMigratedBytes;
+
   // we leave _registeredSolutions empty
   ///_registeredSolutions;
 }
@@ -320,9 +337,81 @@ void GlobalDofAssignment::constructActiveCellMap2()
                                     myCellIDsAV, indexBase, _partitionPolicy->TeuchosComm()) );
 }
 
+bool GlobalDofAssignment::lastRepartitionSkipped() const
+{
+  return _lastRepartitionSkipped;
+}
+
+GlobalIndexType GlobalDofAssignment::lastRepartitionMigratedCellCount() const
+{
+  return _lastRepartitionMigratedCellCount;
+}
+
+long long GlobalDofAssignment::lastRepartitionMigratedBytes() const
+{
+  return _lastRepartitionMigratedBytes;
+}
+
+double GlobalDofAssignment::partitionImbalance()
+{
+  if (_partitions.size() == 0) return -1;
+  GlobalIndexType totalSize = 0, maxSize = 0;
+  for (const set<GlobalIndexType> &partition : _partitions)
+  {
+    totalSize += partition.size();
+    maxSize = std::max(maxSize, (GlobalIndexType)partition.size());
+  }
+  // partitions that do not account for every active cell (e.g. before any partitioning has happened) are not candidates for reuse
+  if ((totalSize == 0) || (totalSize != _meshTopology->getActiveCellIndices().size())) return -1;
+  double averageSize = double(totalSize) / _partitions.size();
+  return maxSize / averageSize;
+}
+
 void GlobalDofAssignment::repartitionAndMigrate()
 {
-  _partitionPolicy->partitionMesh(_mesh.get(),_numPartitions);
+  int rank = _partitionPolicy->Comm()->MyPID();
+  int numProcs = _partitionPolicy->Comm()->NumProc();
+
+  set<GlobalIndexType> previousRankLocalCellIDs;
+  if (rank < (int)_partitions.size()) previousRankLocalCellIDs = _partitions[rank];
+
+  // the initial assignment (everything on rank 0) is never kept, whatever the threshold
+  double imbalance = partitionImbalance();
+  _lastRepartitionSkipped = _hasBeenPartitioned && ((int)_partitions.size() == numProcs) && (imbalance > 0)
+                            && (imbalance <= _partitionPolicy->imbalanceThreshold());
+  if (_lastRepartitionSkipped)
+  {
+    // new children were assigned to their parents' ranks in didHRefine(); keep that partition and just rebuild
+    vector< set<GlobalIndexType> > partitions = _partitions;
+    setPartitions(partitions);
+  }
+  else
+  {
+    _partitionPolicy->partitionMesh(_mesh.get(),_numPartitions);
+  }
+
+  // tally the cells that left this rank, and the data packed for them
+  int myMigratedCellCount = 0;
+  long long myMigratedBytes = 0;
+  const set<GlobalIndexType>* rankLocalCellIDs = &cellsInPartition(-1);
+  for (GlobalIndexType cellID : previousRankLocalCellIDs)
+  {
+    if (rankLocalCellIDs->find(cellID) != rankLocalCellIDs->end()) continue;
+    if (!_meshTopology->isValidCellIndex(cellID) || (partitionForCellID(cellID) == (PartitionIndexType)-1)) continue; // not active (e.g. a parent whose children were assigned on refinement)
+    myMigratedCellCount++;
+    myMigratedBytes += CellDataMigration::dataSize(_mesh.get(), cellID);
+  }
+  int globalMigratedCellCount;
+  long long globalMigratedBytes;
+  _partitionPolicy->Comm()->SumAll(&myMigratedCellCount, &globalMigratedCellCount, 1);
+  _partitionPolicy->Comm()->SumAll(&myMigratedBytes, &globalMigratedBytes, 1);
+  _lastRepartitionMigratedCellCount = globalMigratedCellCount;
+  _lastRepartitionMigratedBytes = globalMigratedBytes;
+  reinitializeRegisteredSolutions();
+}
+
+void GlobalDofAssignment::reinitializeRegisteredSolutions()
+{
   for (vector< TSolutionPtr<double> >::iterator solutionIt = _registeredSolutions.begin();
        solutionIt != _registeredSolutions.end(); solutionIt++)
   {
@@ -393,7 +482,7 @@ vector< ElementTypePtr > GlobalDofAssignment::elementTypes(PartitionIndexType pa
   }
   else
   {
-    int numRanks = Teuchos::GlobalMPISession::getNProc();
+    int numRanks = _partitionPolicy->Comm()->NumProc();
     set< ElementType* > includedTypes;
     vector< ElementTypePtr > types;
     for (int rank=0; rank<numRanks; rank++)
@@ -429,6 +518,112 @@ int GlobalDofAssignment::getCubatureDegree(GlobalIndexType cellID)
   return elemType->trialOrderPtr->maxBasisDegree() + elemType->testOrderPtr->maxBasisDegree();
 }
 
+GlobalDofAssignment::CellOrdering GlobalDofAssignment::getCellOrdering() const
+{
+  return _cellOrdering;
+}
+
+void GlobalDofAssignment::setCellOrdering(CellOrdering cellOrdering)
+{
+  // only the numbering changes: the partition (and the cell data) stay where they are
+  _cellOrdering = cellOrdering;
+  rebuildLookups();
+  reinitializeRegisteredSolutions();
+}
+
+vector<GlobalIndexType> GlobalDofAssignment::orderedCellsInPartition(PartitionIndexType partitionNumber)
+{
+  const set<GlobalIndexType>* cellIDs = &_partitions[partitionNumber];
+  vector<GlobalIndexType> orderedCells(cellIDs->begin(),cellIDs->end());
+  if ((_cellOrdering == CELL_ID_ORDERING) || (orderedCells.size() <= 2)) return orderedCells;
+
+  if (_cellOrdering == SPACE_FILLING_CURVE_ORDERING)
+  {
+    // Hilbert curve through the centroids, quantized within the partition's bounding box
+    int curveDim = SpaceFillingCurvePartitionPolicy::curveDimension(_meshTopology);
+    vector<double> minCoords(curveDim, std::numeric_limits<double>::max());
+    vector<double> maxCoords(curveDim, std::numeric_limits<double>::lowest());
+    for (GlobalIndexType cellID : orderedCells)
+    {
+      vector<double> centroid = _meshTopology->getCellCentroid(cellID);
+      for (int d=0; d<curveDim; d++)
+      {
+        minCoords[d] = std::min(minCoords[d], centroid[d]);
+        maxCoords[d] = std::max(maxCoords[d], centroid[d]);
+      }
+    }
+    SpaceFillingCurvePartitionPolicy::sortCellsByCurveIndex(SpaceFillingCurvePartitionPolicy::HILBERT, _meshTopology,
+                                                            minCoords, maxCoords, orderedCells);
+    return orderedCells;
+  }
+
+  // REVERSE_CUTHILL_MCKEE_ORDERING
+  // build partition-local cell adjacency through sides; neighbors that are refined contribute their active descendants on the side
+  map< GlobalIndexType, vector<GlobalIndexType> > neighbors;
+  for (GlobalIndexType cellID : orderedCells)
+  {
+    CellPtr cell = _meshTopology->getCell(cellID);
+    vector<GlobalIndexType>* cellNeighbors = &neighbors[cellID];
+    int sideCount = cell->getSideCount();
+    for (int sideOrdinal=0; sideOrdinal<sideCount; sideOrdinal++)
+    {
+      vector< pair<GlobalIndexType, unsigned> > neighborsToVisit = {cell->getNeighborInfo(sideOrdinal, _meshTopology)};
+      while (neighborsToVisit.size() > 0)
+      {
+        pair<GlobalIndexType, unsigned> neighborInfo = neighborsToVisit.back();
+        neighborsToVisit.pop_back();
+        GlobalIndexType neighborID = neighborInfo.first;
+        if (!_meshTopology->isValidCellIndex(neighborID)) continue;
+        if (cellIDs->find(neighborID) != cellIDs->end())
+        {
+          if (neighborID != cellID) cellNeighbors->push_back(neighborID);
+          continue;
+        }
+        CellPtr neighbor = _meshTopology->getCell(neighborID);
+        if (neighbor->isParent(_meshTopology))
+        {
+          vector< pair<GlobalIndexType, unsigned> > childrenForSide = neighbor->childrenForSide(neighborInfo.second);
+          neighborsToVisit.insert(neighborsToVisit.end(), childrenForSide.begin(), childrenForSide.end());
+        }
+      }
+    }
+  }
+
+  auto byDegree = [&neighbors] (GlobalIndexType cellA, GlobalIndexType cellB) -> bool
+  {
+    int degreeA = neighbors[cellA].size(), degreeB = neighbors[cellB].size();
+    return (degreeA < degreeB) || ((degreeA == degreeB) && (cellA < cellB));
+  };
+
+  // start each connected component at a cell of minimal degree
+  vector<GlobalIndexType> startCandidates = orderedCells;
+  std::sort(startCandidates.begin(), startCandidates.end(), byDegree);
+
+  vector<GlobalIndexType> cuthillMcKeeOrdering;
+  cuthillMcKeeOrdering.reserve(orderedCells.size());
+  set<GlobalIndexType> visitedCells;
+  for (GlobalIndexType startCellID : startCandidates)
+  {
+    if (visitedCells.find(startCellID) != visitedCells.end()) continue;
+    visitedCells.insert(startCellID);
+    int queueStart = cuthillMcKeeOrdering.size();
+    cuthillMcKeeOrdering.push_back(startCellID);
+    for (int queueOrdinal=queueStart; queueOrdinal<cuthillMcKeeOrdering.size(); queueOrdinal++)
+    {
+      vector<GlobalIndexType> unvisitedNeighbors;
+      for (GlobalIndexType neighborID : neighbors[cuthillMcKeeOrdering[queueOrdinal]])
+      {
+        if (visitedCells.find(neighborID) != visitedCells.end()) continue;
+        visitedCells.insert(neighborID);
+        unvisitedNeighbors.push_back(neighborID);
+      }
+      std::sort(unvisitedNeighbors.begin(), unvisitedNeighbors.end(), byDegree);
+      cuthillMcKeeOrdering.insert(cuthillMcKeeOrdering.end(), unvisitedNeighbors.begin(), unvisitedNeighbors.end());
+    }
+  }
+  return vector<GlobalIndexType>(cuthillMcKeeOrdering.rbegin(), cuthillMcKeeOrdering.rend());
+}
+
 DofOrderingFactoryPtr GlobalDofAssignment::getDofOrderingFactory()
 {
   return _dofOrderingFactory;
@@ -654,6 +849,8 @@ void GlobalDofAssignment::setPartitions(FieldContainer<GlobalIndexType> &partiti
   int partitionNumber     = _partitionPolicy->Comm()->MyPID();
   int partitionCount      = _partitionPolicy->Comm()->NumProc();
 
+  _hasBeenPartitioned = true;
+
   TEUCHOS_TEST_FOR_EXCEPTION(partitionedMesh.dimension(0) > partitionCount, std::invalid_argument,
                              "Number of partitions exceeds the maximum MPI rank; this is unsupported");
 
@@ -708,13 +905,14 @@ void GlobalDofAssignment::setPartitions(std::vector<std::set<GlobalIndexType> >
   int numProcs = _partitionPolicy->Comm()->NumProc();
   TEUCHOS_TEST_FOR_EXCEPTION(numProcs != partitions.size(), std::invalid_argument, "partitions.size() must be equal to numProcs!");
 
+  _hasBeenPartitioned = true;
+
   _partitions = partitions;
   _partitionForCellID.clear();
 
   _activeCellOffset = 0;
   for (PartitionIndexType i=0; i< _partitions.size(); i++)
   {
-    set< GlobalIndexType > partition;
     for (set< GlobalIndexType >::iterator cellIDIt = partitions[i].begin(); cellIDIt != partitions[i].end(); cellIDIt++)
     {
       GlobalIndexType cellID = *cellIDIt;
@@ -722,7 +920,7 @@ void GlobalDofAssignment::setPartitions(std::vector<std::set<GlobalIndexType> >
     }
     if (thisPartitionNumber > i)
     {
-      _activeCellOffset += partition.size();
+      _activeCellOffset += partitions[i].size();
     }
   }
   constructActiveCellMap();
@@ -650,6 +650,63 @@ const vector<GlobalIndexType>& LocalDofMapper::fittableGlobalIndices()
   return _fittableGlobalIndices;
 }
 
+const LocalDofMapper::CompiledMap & LocalDofMapper::compiledMap(bool fittableGlobalDofsOnly)
+{
+  int index = fittableGlobalDofsOnly ? 1 : 0;
+  CompiledMap* compiled = &_compiledMap[index];
+  if (_compiledMapIsValid[index]) return *compiled;
+
+  // the map is linear, so its columns are just the images of the unit vectors
+  unsigned dofCount = localDofCount();
+  int mappedDofCount = _globalIndexToOrdinal.size();
+  compiled->localOffsets.resize(dofCount+1);
+  compiled->globalOrdinals.clear();
+  compiled->weights.clear();
+  FieldContainer<double> unitVector(dofCount);
+  FieldContainer<double> mappedDataVector(mappedDofCount);
+  for (int i=0; i<dofCount; i++)
+  {
+    compiled->localOffsets[i] = compiled->globalOrdinals.size();
+    unitVector(i) = 1.0;
+    mapLocalDataVector(unitVector, fittableGlobalDofsOnly, mappedDataVector);
+    unitVector(i) = 0.0;
+    for (int globalOrdinal=0; globalOrdinal<mappedDofCount; globalOrdinal++)
+    {
+      double weight = mappedDataVector(globalOrdinal);
+      if (weight == 0.0) continue;
+      compiled->globalOrdinals.push_back(globalOrdinal);
+      compiled->weights.push_back(weight);
+    }
+  }
+  compiled->localOffsets[dofCount] = compiled->globalOrdinals.size();
+  _compiledMapIsValid[index] = true;
+  return *compiled;
+}
+
+bool LocalDofMapper::isCompiled(bool fittableGlobalDofsOnly) const
+{
+  return _compiledMapIsValid[fittableGlobalDofsOnly ? 1 : 0];
+}
+
+unsigned LocalDofMapper::localDofCount()
+{
+  if (_varIDToMap == -1)
+  {
+    return _dofOrdering->totalDofs();
+  }
+  else if (_volumeMaps.find(_varIDToMap) != _volumeMaps.end())
+  {
+    if (_sideOrdinalToMap == VOLUME_INTERIOR_SIDE_ORDINAL)
+      return _dofOrdering->getBasis(_varIDToMap)->getCardinality();
+    else
+      return _dofOrdering->getBasis(_varIDToMap)->dofOrdinalsForSide(_sideOrdinalToMap).size();
+  }
+  else
+  {
+    return _dofOrdering->getBasisCardinality(_varIDToMap, _sideOrdinalToMap);
+  }
+}
+
 FieldContainer<double> LocalDofMapper::mapLocalDataMatrix(const FieldContainer<double> &localData, bool fittableGlobalDofsOnly)
 {
   int dataSize = localData.dimension(0);
@@ -658,8 +715,37 @@ FieldContainer<double> LocalDofMapper::mapLocalDataMatrix(const FieldContainer<d
     cout << "Error: localData matrix must be square.\n";
     TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "localData matrix must be square");
   }
-  FieldContainer<double> dataVector(dataSize);
   int mappedDataSize = _globalIndexToOrdinal.size();
+  if (_useCompiledMap)
+  {
+    // G = C L C^T, where C is the compiled (column-compressed) constraint operator
+    const CompiledMap* C = &compiledMap(fittableGlobalDofsOnly);
+    FieldContainer<double> globalData(mappedDataSize,mappedDataSize);
+    double* globalValues = &globalData[0];
+    const int* offsets = &C->localOffsets[0];
+    const unsigned* ordinals = C->globalOrdinals.data();
+    const double* weights = C->weights.data();
+    for (int i=0; i<dataSize; i++)
+    {
+      for (int j=0; j<dataSize; j++)
+      {
+        double value = localData(i,j);
+        if (value == 0.0) continue;
+        for (int a=offsets[i]; a<offsets[i+1]; a++)
+        {
+          double weightedValue = weights[a] * value;
+          double* globalRow = globalValues + ordinals[a] * mappedDataSize;
+          for (int b=offsets[j]; b<offsets[j+1]; b++)
+          {
+            globalRow[ordinals[b]] += weightedValue * weights[b];
+          }
+        }
+      }
+    }
+    return globalData;
+  }
+
+  FieldContainer<double> dataVector(dataSize);
   FieldContainer<double> intermediateDataMatrix(dataSize,mappedDataSize);
   
   for (int i=0; i<dataSize; i++)
@@ -923,22 +1009,7 @@ void LocalDofMapper::mapLocalDataVector(const FieldContainer<double> &localData,
                                         FieldContainer<double> &mappedDataVector)
 {
   mappedDataVector.initialize(0.0);
-  unsigned dofCount;
-  if (_varIDToMap == -1)
-  {
-    dofCount = _dofOrdering->totalDofs();
-  }
-  else if (_volumeMaps.find(_varIDToMap) != _volumeMaps.end())
-  {
-    if (_sideOrdinalToMap == VOLUME_INTERIOR_SIDE_ORDINAL)
-      dofCount = _dofOrdering->getBasis(_varIDToMap)->getCardinality();
-    else
-      dofCount = _dofOrdering->getBasis(_varIDToMap)->dofOrdinalsForSide(_sideOrdinalToMap).size();
-  }
-  else
-  {
-    dofCount = _dofOrdering->getBasisCardinality(_varIDToMap, _sideOrdinalToMap);
-  }
+  unsigned dofCount = localDofCount();
   TEUCHOS_TEST_FOR_EXCEPTION(localData.rank() != 1, std::invalid_argument, "localData must have rank 1");
   if (localData.dimension(0) != dofCount)
   {
@@ -1028,22 +1099,7 @@ void LocalDofMapper::mapLocalDataVector(const FieldContainer<double> &localData,
 
 FieldContainer<double> LocalDofMapper::mapLocalData(const FieldContainer<double> &localData, bool fittableGlobalDofsOnly)
 {
-  unsigned dofCount;
-  if (_varIDToMap == -1)
-  {
-    dofCount = _dofOrdering->totalDofs();
-  }
-  else if (_volumeMaps.find(_varIDToMap) != _volumeMaps.end())
-  {
-    if (_sideOrdinalToMap == VOLUME_INTERIOR_SIDE_ORDINAL)
-      dofCount = _dofOrdering->getBasis(_varIDToMap)->getCardinality();
-    else
-      dofCount = _dofOrdering->getBasis(_varIDToMap)->dofOrdinalsForSide(_sideOrdinalToMap).size();
-  }
-  else
-  {
-    dofCount = _dofOrdering->getBasisCardinality(_varIDToMap, _sideOrdinalToMap);
-  }
+  unsigned dofCount = localDofCount();
   if ((localData.rank() != 1) && (localData.rank() != 2))
   {
     TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "localData must be rank 1 or rank 2");
@@ -1071,6 +1127,20 @@ FieldContainer<double> LocalDofMapper::mapLocalData(const FieldContainer<double>
   localData.dimensions(dim);
   dim[0] = mappedDofCount;
   FieldContainer<double> mappedData(dim);
+  if (_useCompiledMap && isCompiled(fittableGlobalDofsOnly))
+  {
+    const CompiledMap* C = &compiledMap(fittableGlobalDofsOnly);
+    for (int i=0; i<dofCount; i++)
+    {
+      double value = localData(i);
+      if (value == 0.0) continue;
+      for (int a=C->localOffsets[i]; a<C->localOffsets[i+1]; a++)
+      {
+        mappedData(C->globalOrdinals[a]) += C->weights[a] * value;
+      }
+    }
+    return mappedData;
+  }
   mapLocalDataVector(localData, fittableGlobalDofsOnly, mappedData);
   return mappedData;
 }
@@ -1351,4 +1421,11 @@ void LocalDofMapper::reverseParity(set<int> fluxVarIDs, set<unsigned int> sideOr
     }
   }
   _localCoefficientsFitMatrix.resize(0); // this will need to be recomputed
+  _compiledMapIsValid[0] = false;
+  _compiledMapIsValid[1] = false;
+}
+
+void LocalDofMapper::setUseCompiledMap(bool value)
+{
+  _useCompiledMap = value;
 }
\ No newline at end of file
@@ -47,6 +47,8 @@
 
 #include "CamelliaCellTools.h"
 
+#include "DataIO.h"
+
 #include "GlobalDofAssignment.h"
 
 #include "GDAMinimumRule.h"
@@ -67,6 +69,7 @@
 #include "ZoltanMeshPartitionPolicy.h"
 
 #include <algorithm>
+#include <fstream>
 
 using namespace Intrepid;
 using namespace Camellia;
@@ -74,6 +77,9 @@ using namespace std;
 
 map<int,int> Mesh::_emptyIntIntMap;
 
+const string Mesh::CHECKPOINT_TAG = "CamelliaMeshCheckpoint";
+const int Mesh::CHECKPOINT_VERSION = 1;
+
 Mesh::Mesh(MeshTopologyViewPtr meshTopology, VarFactoryPtr varFactory, vector<int> H1Order, int pToAddTest,
            map<int,int> trialOrderEnhancements, map<int,int> testOrderEnhancements,
            MeshPartitionPolicyPtr partitionPolicy, Epetra_CommPtr Comm) : DofInterpreter(Teuchos::rcp(this,false))
@@ -336,6 +342,55 @@ GlobalIndexType Mesh::activeCellOffset()
   return _gda->activeCellOffset();
 }
 
+void Mesh::addCellsMadeIrregularBy(CellPtr cell, map< CellTopologyKey, set<GlobalIndexType> > &irregularCellIDs)
+{
+  int edgeCount = cell->topology()->getEdgeCount();
+  static int edgeDim = 1;
+  for (int edgeOrdinal=0; edgeOrdinal < edgeCount; edgeOrdinal++)
+  {
+    int refBranchSize = cell->refinementBranchForSubcell(edgeDim, edgeOrdinal, _meshTopology).size();
+    
+    if (refBranchSize > 1)
+    {
+      // then there is at least one active 2-irregular cell constraining this edge
+      IndexType edgeEntityIndex = cell->entityIndex(edgeDim, edgeOrdinal);
+      pair<IndexType, unsigned> constrainingEntity = _meshTopology->getConstrainingEntity(edgeDim, edgeEntityIndex);
+      IndexType constrainingEntityIndex = constrainingEntity.first;
+      unsigned constrainingEntityDim = constrainingEntity.second;
+      std::vector< std::pair<IndexType,unsigned> > activeCellsForConstrainingEntity = _meshTopology->getActiveCellIndices(constrainingEntityDim, constrainingEntityIndex);
+      for (auto activeCellEntry : activeCellsForConstrainingEntity)
+      {
+        CellTopologyKey cellTopoKey = _meshTopology->getCell(activeCellEntry.first)->topology()->getKey();
+        irregularCellIDs[cellTopoKey].insert(activeCellEntry.first);
+      }
+    }
+  }
+  
+  // One other thing to check has to do with interior children (e.g. the middle triangle in a regular triangle refinement)
+  // If the parent of an active cell is an interior child, then all of its parent's neighbors should be refined if
+  // they aren't already.
+  // TODO: compare this with strategies in the literature.  (Particularly Leszek's.)
+  /* 
+   NOTE: this logic is not perfectly general.  In particular, it assumes that if the grandparent's neighbors *are*
+         refined, they are refined in a way that makes them compatible.  In the case e.g. of anisotropic refinements,
+         this need not be the case.  If a null refinement has made its way into the mesh, the same thing applies.
+   */
+  CellPtr parent = cell->getParent();
+  if ((parent != Teuchos::null) && parent->isInteriorChild())
+  {
+    CellPtr grandparent = parent->getParent();
+    int grandparentSideCount = grandparent->topology()->getSideCount();
+    for (int grandparentSideOrdinal=0; grandparentSideOrdinal < grandparentSideCount; grandparentSideOrdinal++)
+    {
+      CellPtr grandparentNeighbor = grandparent->getNeighbor(grandparentSideOrdinal, _meshTopology);
+      if ((grandparentNeighbor != Teuchos::null) && (!grandparentNeighbor->isParent(_meshTopology)))
+      {
+        irregularCellIDs[grandparentNeighbor->topology()->getKey()].insert(grandparentNeighbor->cellIndex());
+      }
+    }
+  }
+}
+
 vector< ElementPtr > Mesh::activeElements()
 {
   set< IndexType > activeCellIndices = _meshTopology->getActiveCellIndices();
@@ -487,6 +542,16 @@ void Mesh::enforceOneIrregularity(bool repartitionAndMigrate)
   int rank = Comm()->MyPID();
   bool meshIsNotRegular = true; // assume it's not regular and check elements
   bool meshChanged = false;
+
+  // we can restrict attention to the neighborhood of recent refinements if the mesh was regular before them, and
+  // they all went through this Mesh (the cell count tells us whether the MeshTopology has been refined elsewhere)
+  bool incremental = _useIncrementalRegularityEnforcement && _regularityEnforced
+                     && (_meshTopology->cellCount() == _cellCountAtRegularityEnforcement + _cellsCreatedSinceRegularityEnforcement);
+  set<GlobalIndexType> cellIDsToCheck;
+  if (incremental)
+  {
+    cellIDsToCheck = cellsAffectedByRefinementOf(_cellsRefinedSinceRegularityEnforcement);
+  }
   
   while (meshIsNotRegular)
   {
@@ -494,116 +559,94 @@ void Mesh::enforceOneIrregularity(bool repartitionAndMigrate)
     if (spaceDim == 1) return;
 
     map< Camellia::CellTopologyKey, set<GlobalIndexType> > irregularCellIDs; // key is CellTopology key
-    set< GlobalIndexType > activeCellIDs = _meshTopology->getActiveCellIndices();
-    set< GlobalIndexType >::iterator cellIDIt;
 
-    bool useSideIrregularityEnforcement = false; // this is the old way
-    if (useSideIrregularityEnforcement)
+    if (incremental)
     {
-      for (GlobalIndexType cellID : activeCellIDs)
+      const set<GlobalIndexType>* activeCellIDs = &_meshTopology->getActiveCellIndices();
+      for (GlobalIndexType cellID : cellIDsToCheck)
       {
-        CellPtr cell = _meshTopology->getCell(cellID);
-        int sideCount = cell->getSideCount();
-        for (int sideOrdinal=0; sideOrdinal < sideCount; sideOrdinal++)
-        {
-          pair<GlobalIndexType, unsigned> neighborInfo = cell->getNeighborInfo(sideOrdinal, _meshTopology);
+        if (activeCellIDs->find(cellID) == activeCellIDs->end()) continue;
+        addCellsMadeIrregularBy(_meshTopology->getCell(cellID), irregularCellIDs);
+      }
+    }
+    else
+    {
+      set< GlobalIndexType > activeCellIDs = _meshTopology->getActiveCellIndices();
 
-          if (neighborInfo.first != -1) // I have a neighbor
+      bool useSideIrregularityEnforcement = false; // this is the old way
+      if (useSideIrregularityEnforcement)
+      {
+        for (GlobalIndexType cellID : activeCellIDs)
+        {
+          CellPtr cell = _meshTopology->getCell(cellID);
+          int sideCount = cell->getSideCount();
+          for (int sideOrdinal=0; sideOrdinal < sideCount; sideOrdinal++)
           {
-            if (spaceDim > 1)
+            pair<GlobalIndexType, unsigned> neighborInfo = cell->getNeighborInfo(sideOrdinal, _meshTopology);
+
+            if (neighborInfo.first != -1) // I have a neighbor
             {
-              CellPtr neighbor = _meshTopology->getCell(neighborInfo.first);
-              RefinementBranch myRefinementBranch = cell->refinementBranchForSide(sideOrdinal, _meshTopology);
-              if (myRefinementBranch.size() > 1)
+              if (spaceDim > 1)
               {
-                // then *neighbor* is irregular
-                irregularCellIDs[neighbor->topology()->getKey()].insert(neighborInfo.first);
-  //              cout << neighborInfo.first << " is irregular.\n";
-                { // DEBUGGING:
-                  if (activeCellIDs.find(neighborInfo.first) == activeCellIDs.end())
-                  {
-                    _meshTopology->printAllEntitiesInBaseMeshTopology();
-                    // repeat for entering in the debugger before the exception is thrown
-                    cell->getNeighborInfo(sideOrdinal, _meshTopology);
+                CellPtr neighbor = _meshTopology->getCell(neighborInfo.first);
+                RefinementBranch myRefinementBranch = cell->refinementBranchForSide(sideOrdinal, _meshTopology);
+                if (myRefinementBranch.size() > 1)
+                {
+                  // then *neighbor* is irregular
+                  irregularCellIDs[neighbor->topology()->getKey()].insert(neighborInfo.first);
+    //              cout << neighborInfo.first << " is irregular.\n";
+                  { // DEBUGGING:
+                    if (activeCellIDs.find(neighborInfo.first) == activeCellIDs.end())
+                    {
+                      _meshTopology->printAllEntitiesInBaseMeshTopology();
+                      // repeat for entering in the debugger before the exception is thrown
+                      cell->getNeighborInfo(sideOrdinal, _meshTopology);
+                    }
                   }
+                  TEUCHOS_TEST_FOR_EXCEPTION(activeCellIDs.find(neighborInfo.first) == activeCellIDs.end(),
+                                             std::invalid_argument, "Internal error: 'irregular' cell is not active!");
                 }
-                TEUCHOS_TEST_FOR_EXCEPTION(activeCellIDs.find(neighborInfo.first) == activeCellIDs.end(),
-                                           std::invalid_argument, "Internal error: 'irregular' cell is not active!");
               }
             }
           }
         }
       }
-    }
-    else // new way: edge 1-irregularity enforcement
-    {
-      for (GlobalIndexType cellID : activeCellIDs)
+      else // new way: edge 1-irregularity enforcement
       {
-        CellPtr cell = _meshTopology->getCell(cellID);
-        int edgeCount = cell->topology()->getEdgeCount();
-        static int edgeDim = 1;
-        for (int edgeOrdinal=0; edgeOrdinal < edgeCount; edgeOrdinal++)
+        for (GlobalIndexType cellID : activeCellIDs)
         {
-          int refBranchSize = cell->refinementBranchForSubcell(edgeDim, edgeOrdinal, _meshTopology).size();
-          
-          if (refBranchSize > 1)
-          {
-            // then there is at least one active 2-irregular cell constraining this edge
-            IndexType edgeEntityIndex = cell->entityIndex(edgeDim, edgeOrdinal);
-            pair<IndexType, unsigned> constrainingEntity = _meshTopology->getConstrainingEntity(edgeDim, edgeEntityIndex);
-            IndexType constrainingEntityIndex = constrainingEntity.first;
-            unsigned constrainingEntityDim = constrainingEntity.second;
-            std::vector< std::pair<IndexType,unsigned> > activeCellsForConstrainingEntity = _meshTopology->getActiveCellIndices(constrainingEntityDim, constrainingEntityIndex);
-            for (auto activeCellEntry : activeCellsForConstrainingEntity)
-            {
-              CellTopologyKey cellTopoKey = _meshTopology->getCell(activeCellEntry.first)->topology()->getKey();
-              irregularCellIDs[cellTopoKey].insert(activeCellEntry.first);
-            }
-          }
-        }
-        
-        // One other thing to check has to do with interior children (e.g. the middle triangle in a regular triangle refinement)
-        // If the parent of an active cell is an interior child, then all of its parent's neighbors should be refined if
-        // they aren't already.
-        // TODO: compare this with strategies in the literature.  (Particularly Leszek's.)
-        /* 
-         NOTE: this logic is not perfectly general.  In particular, it assumes that if the grandparent's neighbors *are*
-               refined, they are refined in a way that makes them compatible.  In the case e.g. of anisotropic refinements,
-               this need not be the case.  If a null refinement has made its way into the mesh, the same thing applies.
-         */
-        CellPtr parent = cell->getParent();
-        if ((parent != Teuchos::null) && parent->isInteriorChild())
-        {
-          CellPtr grandparent = parent->getParent();
-          int grandparentSideCount = grandparent->topology()->getSideCount();
-          for (int grandparentSideOrdinal=0; grandparentSideOrdinal < grandparentSideCount; grandparentSideOrdinal++)
-          {
-            CellPtr grandparentNeighbor = grandparent->getNeighbor(grandparentSideOrdinal, _meshTopology);
-            if ((grandparentNeighbor != Teuchos::null) && (!grandparentNeighbor->isParent(_meshTopology)))
-            {
-              irregularCellIDs[grandparentNeighbor->topology()->getKey()].insert(grandparentNeighbor->cellIndex());
-            }
-          }
+          addCellsMadeIrregularBy(_meshTopology->getCell(cellID), irregularCellIDs);
         }
       }
     }
     
     if (irregularCellIDs.size() > 0)
     {
+      set<GlobalIndexType> refinedCellIDs;
       for (map< Camellia::CellTopologyKey, set<GlobalIndexType> >::iterator mapIt = irregularCellIDs.begin();
            mapIt != irregularCellIDs.end(); mapIt++)
       {
         Camellia::CellTopologyKey cellKey = mapIt->first;
         hRefine(mapIt->second, RefinementPattern::regularRefinementPattern(cellKey), false); // false: don't repartition and rebuild, yet.
+        refinedCellIDs.insert(mapIt->second.begin(), mapIt->second.end());
       }
       irregularCellIDs.clear();
       meshChanged = true;
+
+      // the next pass need only consider the cells around the refinement front
+      if (incremental) cellIDsToCheck = cellsAffectedByRefinementOf(refinedCellIDs);
     }
     else
     {
       meshIsNotRegular = false;
     }
   }
+
+  _regularityEnforced = true;
+  _cellCountAtRegularityEnforcement = _meshTopology->cellCount();
+  _cellsCreatedSinceRegularityEnforcement = 0;
+  _cellsRefinedSinceRegularityEnforcement.clear();
+
   if (meshChanged && repartitionAndMigrate)
   {
     // then repartition and migrate now
@@ -611,6 +654,31 @@ void Mesh::enforceOneIrregularity(bool repartitionAndMigrate)
   }
 }
 
+set<GlobalIndexType> Mesh::cellsAffectedByRefinementOf(const set<GlobalIndexType> &refinedCellIDs)
+{
+  // A refinement can only introduce irregularity in the new children (whose edges may be constrained by a coarser
+  // neighbor's edge two levels up) and, through the interior-child rule, in cells near the refined cell.  We take the
+  // children together with every active cell that touches a vertex of the refined cell.
+  set<GlobalIndexType> affectedCellIDs;
+  static const unsigned vertexDim = 0;
+  for (GlobalIndexType cellID : refinedCellIDs)
+  {
+    CellPtr cell = _meshTopology->getCell(cellID);
+    for (CellPtr child : cell->children())
+    {
+      affectedCellIDs.insert(child->cellIndex());
+    }
+    for (IndexType vertexIndex : cell->vertices())
+    {
+      for (auto activeCellEntry : _meshTopology->getActiveCellIndices(vertexDim, vertexIndex))
+      {
+        affectedCellIDs.insert(activeCellEntry.first);
+      }
+    }
+  }
+  return affectedCellIDs;
+}
+
 FieldContainer<double> Mesh::cellSideParities( ElementTypePtr elemTypePtr )
 {
   // old version (using lookup table)
@@ -904,7 +972,8 @@ void Mesh::hRefine(const set<GlobalIndexType> &cellIDs, Teuchos::RCP<RefinementP
   // gets refined.  For reasons I'm not entirely clear on.
   bool usingMaxRule = this->meshUsesMaximumRule();
   
-  GlobalIndexType nextCellID = writableMeshTopology->cellCount();
+  GlobalIndexType initialCellCount = writableMeshTopology->cellCount();
+  GlobalIndexType nextCellID = initialCellCount;
   for (cellIt = cellIDs.begin(); cellIt != cellIDs.end(); cellIt++)
   {
     GlobalIndexType cellID = *cellIt;
@@ -928,6 +997,13 @@ void Mesh::hRefine(const set<GlobalIndexType> &cellIDs, Teuchos::RCP<RefinementP
     }
   }
   
+  // track refinements so that enforceOneIrregularity() can restrict its search to their neighborhood
+  if (_regularityEnforced)
+  {
+    _cellsCreatedSinceRegularityEnforcement += writableMeshTopology->cellCount() - initialCellCount;
+    _cellsRefinedSinceRegularityEnforcement.insert(cellIDs.begin(), cellIDs.end());
+  }
+  
   if (!usingMaxRule)
   {
     // TODO: consider making GDA a refinementObserver, using that interface to send it the notification
@@ -1476,6 +1552,11 @@ void Mesh::setPartitionPolicy(  Teuchos::RCP< MeshPartitionPolicy > partitionPol
   _gda->setPartitionPolicy(partitionPolicy);
 }
 
+void Mesh::setUseIncrementalRegularityEnforcement(bool value)
+{
+  _useIncrementalRegularityEnforcement = value;
+}
+
 void Mesh::setUsePatchBasis( bool value )
 {
   // TODO: throw an exception if we've already been refined??
@@ -1712,6 +1793,127 @@ vector<double> Mesh::getCellOrientation(GlobalIndexType cellID)
   return orientation;
 }
 
+void Mesh::saveCheckpoint(string filename)
+{
+  // Unlike saveToHDF5(), which stores the root cells and the refinement history (so that loading replays each refinement
+  // through the Mesh), the checkpoint stores the refinement tree, H1 orders, and partitions directly.  See
+  // MeshFactory::loadFromCheckpoint().
+  TEUCHOS_TEST_FOR_EXCEPTION(meshUsesMaximumRule(), std::invalid_argument, "saveCheckpoint() requires a minimum-rule mesh");
+  TEUCHOS_TEST_FOR_EXCEPTION(_meshTopology->transformationFunction() != Teuchos::null, std::invalid_argument,
+                             "saveCheckpoint() does not support meshes with curved edges");
+  MeshTopology* meshTopo = dynamic_cast<MeshTopology*>(_meshTopology.get());
+  TEUCHOS_TEST_FOR_EXCEPTION(meshTopo == NULL, std::invalid_argument, "saveCheckpoint() requires a Mesh whose topology is a MeshTopology");
+
+  int commRank = Comm()->MyPID();
+  if (commRank == 0)
+  {
+    ofstream fout(filename.c_str(), ios::binary);
+    TEUCHOS_TEST_FOR_EXCEPTION(!fout.good(), std::invalid_argument, "Could not open " << filename << " for writing");
+    DataIO::writeBinaryTag(fout, CHECKPOINT_TAG, CHECKPOINT_VERSION);
+
+    DataIO::writeBinary(fout, (int) meshTopo->getDimension());
+    vector<int> initialH1Order = _gda->getInitialH1Order();
+    DataIO::writeBinary(fout, initialH1Order);
+    DataIO::writeBinary(fout, _gda->getTestOrderEnrichment());
+
+    vector<int> trialOrderEnhancementsVec, testOrderEnhancementsVec;
+    for (auto entry : getDofOrderingFactory().getTrialOrderEnhancements())
+    {
+      trialOrderEnhancementsVec.push_back(entry.first);
+      trialOrderEnhancementsVec.push_back(entry.second);
+    }
+    for (auto entry : getDofOrderingFactory().getTestOrderEnhancements())
+    {
+      testOrderEnhancementsVec.push_back(entry.first);
+      testOrderEnhancementsVec.push_back(entry.second);
+    }
+    DataIO::writeBinary(fout, trialOrderEnhancementsVec);
+    DataIO::writeBinary(fout, testOrderEnhancementsVec);
+
+    // root vertices, in vertex index order, so that the reader assigns the same vertex indices
+    const set<IndexType> &rootCellIndices = meshTopo->getRootCellIndices();
+    IndexType maxVertexIndex = 0;
+    for (IndexType rootCellIndex : rootCellIndices)
+    {
+      const vector<unsigned> &vertexIndices = meshTopo->getCell(rootCellIndex)->vertices();
+      maxVertexIndex = max(maxVertexIndex, (IndexType) *max_element(vertexIndices.begin(), vertexIndices.end()));
+    }
+    vector<double> rootVertices;
+    for (IndexType vertexIndex=0; vertexIndex <= maxVertexIndex; vertexIndex++)
+    {
+      const vector<double> &vertex = meshTopo->getVertex(vertexIndex);
+      rootVertices.insert(rootVertices.end(), vertex.begin(), vertex.end());
+    }
+    DataIO::writeBinary(fout, rootVertices);
+
+    DataIO::writeBinary(fout, (long long) rootCellIndices.size());
+    vector<CellPtr> cellsToVisit;
+    for (IndexType rootCellIndex : rootCellIndices)
+    {
+      CellPtr cell = meshTopo->getCell(rootCellIndex);
+      CellTopologyKey topoKey = cell->topology()->getKey();
+      DataIO::writeBinary(fout, (long long) rootCellIndex);
+      DataIO::writeBinary(fout, (int) topoKey.first);
+      DataIO::writeBinary(fout, (int) topoKey.second);
+      DataIO::writeBinary(fout, cell->vertices());
+      cellsToVisit.push_back(cell);
+    }
+
+    // refined cells, keyed by the index of their first child.  MeshTopology assigns consecutive indices to children,
+    // so refining in order of first child index reproduces the original cell (and entity) numbering.
+    map<IndexType, pair<IndexType, RefinementType>> refinements;
+    while (cellsToVisit.size() > 0)
+    {
+      CellPtr cell = cellsToVisit.back();
+      cellsToVisit.pop_back();
+      if (cell->numChildren() == 0) continue;
+      const vector<CellPtr> &children = cell->children();
+      RefinementType refType = RefinementHistory::refTypeForRefPattern(cell->refinementPattern());
+      refinements[children[0]->cellIndex()] = {cell->cellIndex(), refType};
+      cellsToVisit.insert(cellsToVisit.end(), children.begin(), children.end());
+    }
+    DataIO::writeBinary(fout, (long long) refinements.size());
+    for (auto refinement : refinements)
+    {
+      DataIO::writeBinary(fout, (long long) refinement.second.first);
+      DataIO::writeBinary(fout, (int) refinement.second.second);
+      DataIO::writeBinary(fout, (long long) refinement.first);
+    }
+    DataIO::writeBinary(fout, (long long) meshTopo->cellCount());
+
+    // p-refinements of active cells, as increments relative to the initial H1 order
+    vector<long long> pRefinedCellIDs;
+    vector<int> pIncrements;
+    for (IndexType cellID : meshTopo->getActiveCellIndices())
+    {
+      vector<int> H1Order = _gda->getH1Order(cellID);
+      int pIncrement = H1Order[0] - initialH1Order[0];
+      for (int pComponent=1; pComponent<H1Order.size(); pComponent++)
+      {
+        TEUCHOS_TEST_FOR_EXCEPTION(H1Order[pComponent] - initialH1Order[pComponent] != pIncrement, std::invalid_argument,
+                                   "saveCheckpoint() requires p-refinements to increase each H1 order component equally");
+      }
+      if (pIncrement == 0) continue;
+      pRefinedCellIDs.push_back(cellID);
+      pIncrements.push_back(pIncrement);
+    }
+    DataIO::writeBinary(fout, pRefinedCellIDs);
+    DataIO::writeBinary(fout, pIncrements);
+
+    int partitionCount = _gda->getPartitionCount();
+    DataIO::writeBinary(fout, partitionCount);
+    for (int partitionNumber=0; partitionNumber<partitionCount; partitionNumber++)
+    {
+      const set<GlobalIndexType> &cellIDs = _gda->cellsInPartition(partitionNumber);
+      DataIO::writeBinary(fout, vector<GlobalIndexType>(cellIDs.begin(),cellIDs.end()));
+    }
+    TEUCHOS_TEST_FOR_EXCEPTION(!fout.good(), std::invalid_argument, "Error while writing " << filename);
+    fout.close();
+  }
+  // ensure that the file is complete before any rank tries to read it
+  Comm()->Barrier();
+}
+
 
 #ifdef HAVE_EPETRAEXT_HDF5
 void Mesh::saveToHDF5(string filename)
@@ -1791,6 +1993,7 @@ void Mesh::saveToHDF5(string filename)
     vector<int> initialH1Order = globalDofAssignment()->getInitialH1Order();
 
     Epetra_SerialComm Comm;
+    std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
     EpetraExt::HDF5 hdf5(Comm);
     hdf5.Create(filename);
     hdf5.Write("Mesh", "vertexIndicesSize", vertexIndicesSize);
@@ -10,6 +10,7 @@
 
 #include "CamelliaCellTools.h"
 #include "CamelliaDebugUtility.h"
+#include "DataIO.h"
 #include "GlobalDofAssignment.h"
 #include "GnuPlotUtil.h"
 #include "MOABReader.h"
@@ -21,6 +22,8 @@
 #include <Epetra_SerialComm.h>
 #endif
 
+#include <fstream>
+
 using namespace Intrepid;
 using namespace Camellia;
 
@@ -38,6 +41,107 @@ static ParametricCurvePtr parametricRect(double width, double height, double x0,
 
 map<int,int> MeshFactory::_emptyIntIntMap;
 
+MeshPtr MeshFactory::loadFromCheckpoint(TBFPtr<double> bf, string filename, Epetra_CommPtr Comm)
+{
+  // every rank reads the (small) checkpoint file; the MeshTopology is replicated on each rank
+  ifstream fin(filename.c_str(), ios::binary);
+  TEUCHOS_TEST_FOR_EXCEPTION(!fin.good(), std::invalid_argument, "Could not open " << filename << " for reading");
+  int version = DataIO::readBinaryTag(fin, Mesh::CHECKPOINT_TAG);
+  TEUCHOS_TEST_FOR_EXCEPTION(version != Mesh::CHECKPOINT_VERSION, std::invalid_argument,
+                             "Unsupported mesh checkpoint version " << version << " in " << filename);
+
+  int spaceDim = DataIO::readBinary<int>(fin);
+  vector<int> H1Order = DataIO::readBinaryVector<int>(fin);
+  int deltaP = DataIO::readBinary<int>(fin);
+  vector<int> trialOrderEnhancementsVec = DataIO::readBinaryVector<int>(fin);
+  vector<int> testOrderEnhancementsVec = DataIO::readBinaryVector<int>(fin);
+  map<int, int> trialOrderEnhancements;
+  map<int, int> testOrderEnhancements;
+  for (int i=0; i < trialOrderEnhancementsVec.size()/2; i++) // two entries per var: varID, enhancement
+  {
+    trialOrderEnhancements[trialOrderEnhancementsVec[2*i]] = trialOrderEnhancementsVec[2*i+1];
+  }
+  for (int i=0; i < testOrderEnhancementsVec.size()/2; i++)
+  {
+    testOrderEnhancements[testOrderEnhancementsVec[2*i]] = testOrderEnhancementsVec[2*i+1];
+  }
+
+  MeshTopologyPtr meshTopo = Teuchos::rcp( new MeshTopology(spaceDim) );
+  vector<double> rootVertices = DataIO::readBinaryVector<double>(fin);
+  for (int vertexOrdinal=0; vertexOrdinal < rootVertices.size() / spaceDim; vertexOrdinal++)
+  {
+    vector<double> vertex(&rootVertices[vertexOrdinal*spaceDim], &rootVertices[vertexOrdinal*spaceDim] + spaceDim);
+    meshTopo->addVertex(vertex);
+  }
+
+  long long rootCellCount = DataIO::readBinary<long long>(fin);
+  for (long long rootCellOrdinal=0; rootCellOrdinal < rootCellCount; rootCellOrdinal++)
+  {
+    IndexType cellIndex = DataIO::readBinary<long long>(fin);
+    int keyFirst = DataIO::readBinary<int>(fin);
+    int keySecond = DataIO::readBinary<int>(fin);
+    CellTopoPtr cellTopo = CamelliaCellTools::cellTopoForKey(Camellia::CellTopologyKey(keyFirst,keySecond));
+    vector<unsigned> vertexIndices = DataIO::readBinaryVector<unsigned>(fin);
+    vector< vector<double> > cellVertices;
+    for (unsigned vertexIndex : vertexIndices)
+    {
+      cellVertices.push_back(meshTopo->getVertex(vertexIndex));
+    }
+    meshTopo->addCell(cellIndex, cellTopo, cellVertices);
+  }
+
+  // refine the topology directly, in the order of the first child cell index; no Mesh exists yet, so nothing else is notified
+  long long refinementCount = DataIO::readBinary<long long>(fin);
+  for (long long refinementOrdinal=0; refinementOrdinal < refinementCount; refinementOrdinal++)
+  {
+    IndexType parentCellIndex = DataIO::readBinary<long long>(fin);
+    RefinementType refType = (RefinementType) DataIO::readBinary<int>(fin);
+    IndexType firstChildCellIndex = DataIO::readBinary<long long>(fin);
+    CellTopoPtr cellTopo = meshTopo->getCell(parentCellIndex)->topology();
+    meshTopo->refineCell(parentCellIndex, RefinementHistory::refPatternForRefType(refType, cellTopo), firstChildCellIndex);
+  }
+  long long cellCount = DataIO::readBinary<long long>(fin);
+  TEUCHOS_TEST_FOR_EXCEPTION(cellCount != meshTopo->cellCount(), std::invalid_argument,
+                             "Restored mesh topology has " << meshTopo->cellCount() << " cells; checkpoint has " << cellCount);
+
+  vector<long long> pRefinedCellIDs = DataIO::readBinaryVector<long long>(fin);
+  vector<int> pIncrements = DataIO::readBinaryVector<int>(fin);
+  int partitionCount = DataIO::readBinary<int>(fin);
+  vector< set<GlobalIndexType> > partitions(partitionCount);
+  for (int partitionNumber=0; partitionNumber<partitionCount; partitionNumber++)
+  {
+    vector<GlobalIndexType> cellIDs = DataIO::readBinaryVector<GlobalIndexType>(fin);
+    partitions[partitionNumber].insert(cellIDs.begin(),cellIDs.end());
+  }
+  fin.close();
+
+  MeshPartitionPolicyPtr partitionPolicy = Teuchos::null; // null: use the Mesh default
+  MeshPtr mesh = Teuchos::rcp( new Mesh(meshTopo, bf, H1Order, deltaP, trialOrderEnhancements, testOrderEnhancements,
+                                        partitionPolicy, Comm) );
+
+  map<int, set<GlobalIndexType>> cellIDsForPIncrement;
+  for (int i=0; i<pRefinedCellIDs.size(); i++)
+  {
+    cellIDsForPIncrement[pIncrements[i]].insert(pRefinedCellIDs[i]);
+  }
+  bool repartitionAndRebuild = false; // we rebuild once, below, when we set the partitions
+  for (auto entry : cellIDsForPIncrement)
+  {
+    mesh->pRefine(entry.second, entry.first, repartitionAndRebuild);
+  }
+
+  if (partitionCount == mesh->Comm()->NumProc())
+  {
+    mesh->globalDofAssignment()->setPartitions(partitions);
+  }
+  else
+  {
+    // a different MPI rank count than the one that wrote the checkpoint: compute a new partition
+    mesh->globalDofAssignment()->repartitionAndMigrate();
+  }
+  return mesh;
+}
+
 #ifdef HAVE_EPETRAEXT_HDF5
 MeshPtr MeshFactory::loadFromHDF5(TBFPtr<double> bf, string filename)
 {
@@ -50,6 +154,7 @@ MeshPtr MeshFactory::loadFromHDF5(TBFPtr<double> bf, string filename)
 #else
   Epetra_SerialComm Comm;
 #endif
+  std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
   EpetraExt::HDF5 hdf5(Comm);
   hdf5.Open(filename);
   int vertexIndicesSize, topoKeysSize, verticesSize, trialOrderEnhancementsSize, testOrderEnhancementsSize, histArraySize, H1OrderSize;
@@ -14,13 +14,14 @@
 #include "InducedMeshPartitionPolicy.h"
 #include "MeshTools.h"
 #include "MPIWrapper.h"
+#include "SpaceFillingCurvePartitionPolicy.h"
 #include "ZoltanMeshPartitionPolicy.h"
 
 using namespace Intrepid;
 using namespace Camellia;
 using namespace std;
 
-MeshPartitionPolicy::MeshPartitionPolicy(Epetra_CommPtr Comm) : _Comm(Comm) {
+MeshPartitionPolicy::MeshPartitionPolicy(Epetra_CommPtr Comm) : _Comm(Comm), _imbalanceThreshold(0.0) {
   TEUCHOS_TEST_FOR_EXCEPTION(Comm == Teuchos::null, std::invalid_argument, "Comm may not be null!");
 }
 
@@ -29,6 +30,11 @@ Epetra_CommPtr& MeshPartitionPolicy::Comm()
   return _Comm;
 }
 
+double MeshPartitionPolicy::imbalanceThreshold() const
+{
+  return _imbalanceThreshold;
+}
+
 void MeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType numPartitions)
 {
   // default simply divides the active cells into equally-sized partitions, in the order listed in activeCells…
@@ -65,12 +71,22 @@ MeshPartitionPolicyPtr MeshPartitionPolicy::inducedPartitionPolicy(MeshPtr thisM
   return InducedMeshPartitionPolicy::inducedMeshPartitionPolicy(thisMesh, otherMesh, cellIDMap);
 }
 
+void MeshPartitionPolicy::setImbalanceThreshold(double threshold)
+{
+  _imbalanceThreshold = threshold;
+}
+
 MeshPartitionPolicyPtr MeshPartitionPolicy::standardPartitionPolicy(Epetra_CommPtr Comm)
 {
   MeshPartitionPolicyPtr partitionPolicy = Teuchos::rcp( new ZoltanMeshPartitionPolicy(Comm) );
   return partitionPolicy;
 }
 
+MeshPartitionPolicyPtr MeshPartitionPolicy::spaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm)
+{
+  return SpaceFillingCurvePartitionPolicy::spaceFillingCurvePartitionPolicy(Comm);
+}
+
 Teuchos_CommPtr& MeshPartitionPolicy::TeuchosComm()
 {
   if (_TeuchosComm == Teuchos::null)
@@ -39,6 +39,7 @@ void MeshTopology::init(unsigned spaceDim)
   _entityCellTopologyKeys = vector< vector< CellTopologyKey > >(numEntityDimensions);
 
   _gda = NULL;
+  _geometryVersion = 0;
 }
 
 MeshTopology::MeshTopology(unsigned spaceDim, vector<PeriodicBCPtr> periodicBCs)
@@ -2789,6 +2790,8 @@ FieldContainer<double> MeshTopology::physicalCellNodesForCell(unsigned int cellI
 
 void MeshTopology::refineCell(IndexType cellIndex, RefinementPatternPtr refPattern, IndexType firstChildCellIndex)
 {
+  _geometryVersion++;
+
   // TODO: worry about the case (currently unsupported in RefinementPattern) of children that do not share topology with the parent.  E.g. quad broken into triangles.  (3D has better examples.)
 
 //  { // DEBUGGING
@@ -3147,6 +3150,7 @@ void MeshTopology::setEdgeToCurveMap(const map< pair<IndexType, IndexType>, Para
     _transformationFunction = Teuchos::rcp(new MeshTransformationFunction(mesh, cellIDsGlobal));
   else
     _transformationFunction = Teuchos::null;
+  _geometryVersion++;
 }
 
 void MeshTopology::setGlobalDofAssignment(GlobalDofAssignment* gda)   // for cubature degree lookups
@@ -3181,6 +3185,11 @@ Teuchos::RCP<MeshTransformationFunction> MeshTopology::transformationFunction()
   return _transformationFunction;
 }
 
+unsigned long MeshTopology::geometryVersion()
+{
+  return _geometryVersion;
+}
+
 void MeshTopology::verticesForCell(FieldContainer<double>& vertices, GlobalIndexType cellID)
 {
   CellPtr cell = getCell(cellID);
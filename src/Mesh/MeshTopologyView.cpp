@@ -538,6 +538,11 @@ Teuchos::RCP<MeshTransformationFunction> MeshTopologyView::transformationFunctio
   return Teuchos::null; // pure MeshTopologyViews are defined to have straight-edge geometry only.
 }
 
+unsigned long MeshTopologyView::geometryVersion()
+{
+  return _meshTopo->geometryVersion();
+}
+
 // owningCellIndexForConstrainingEntity() copied from MeshTopology; once that's a subclass of MeshTopologyView, could possibly eliminate it in MeshTopology
 std::pair<IndexType,IndexType> MeshTopologyView::owningCellIndexForConstrainingEntity(unsigned d, IndexType constrainingEntityIndex)
 {
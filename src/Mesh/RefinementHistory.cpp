@@ -120,6 +120,12 @@ RefinementPatternPtr RefinementHistory::refPatternForRefType(RefinementType refT
 void RefinementHistory::hRefine(const set<GlobalIndexType> &cellIDs, Teuchos::RCP<RefinementPattern> refPattern)
 {
   if (cellIDs.size() == 0) return;
+  Refinement ref = make_pair(refTypeForRefPattern(refPattern), cellIDs);
+  _refinements.push_back(ref);
+}
+
+RefinementType RefinementHistory::refTypeForRefPattern(RefinementPatternPtr refPattern)
+{
   // figure out what type of refinement we have:
   int numChildren = refPattern->numChildren();
   int spaceDim = refPattern->verticesOnReferenceCell().dimension(1);
@@ -215,8 +221,7 @@ void RefinementHistory::hRefine(const set<GlobalIndexType> &cellIDs, Teuchos::RC
       TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "RefinementHistory does not yet support this h-refinement and spaceDim combination.");
     }
   }
-  Refinement ref = make_pair(refType, cellIDs);
-  _refinements.push_back(ref);
+  return refType;
 }
 
 void RefinementHistory::pRefine(const set<GlobalIndexType> &cellIDs)
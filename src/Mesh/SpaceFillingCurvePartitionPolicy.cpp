@@ -0,0 +1,222 @@
+//
+//  SpaceFillingCurvePartitionPolicy.cpp
+//  Camellia
+//
+
+#include "SpaceFillingCurvePartitionPolicy.h"
+
+#include "CellDataMigration.h"
+#include "GlobalDofAssignment.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Intrepid;
+using namespace Camellia;
+using namespace std;
+
+SpaceFillingCurvePartitionPolicy::SpaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm, CurveType curveType) : MeshPartitionPolicy(Comm)
+{
+  _curveType = curveType;
+}
+
+uint64_t SpaceFillingCurvePartitionPolicy::curveIndex(CurveType curveType, vector<uint32_t> X, int b)
+{
+  int n = X.size();
+  TEUCHOS_TEST_FOR_EXCEPTION(n * b > 64, std::invalid_argument, "too many bits requested for curve index");
+  if ((curveType == HILBERT) && (n > 1) && (b > 0))
+  {
+    // Skilling's algorithm (AIP Conf. Proc. 707, 2004): transform the coordinates into the "transposed" Hilbert index
+    uint32_t M = 1U << (b-1);
+    // inverse undo
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+      uint32_t P = Q - 1;
+      for (int i=0; i<n; i++)
+      {
+        if (X[i] & Q)
+        {
+          X[0] ^= P; // invert
+        }
+        else
+        {
+          uint32_t t = (X[0] ^ X[i]) & P; // exchange
+          X[0] ^= t;
+          X[i] ^= t;
+        }
+      }
+    }
+    // Gray encode
+    for (int i=1; i<n; i++)
+    {
+      X[i] ^= X[i-1];
+    }
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+      if (X[n-1] & Q) t ^= Q - 1;
+    }
+    for (int i=0; i<n; i++)
+    {
+      X[i] ^= t;
+    }
+  }
+  // interleave bits, most significant first.  (Without the transform above, this is the Morton index.)
+  uint64_t index = 0;
+  for (int bit=b-1; bit>=0; bit--)
+  {
+    for (int i=0; i<n; i++)
+    {
+      index = (index << 1) | ((X[i] >> bit) & 1U);
+    }
+  }
+  return index;
+}
+
+int SpaceFillingCurvePartitionPolicy::curveDimension(MeshTopologyViewPtr meshTopo)
+{
+  // curve is defined on at most three coordinates (for space-time meshes of spatial dimension 3, we ignore time)
+  return min((int)meshTopo->getDimension(), 3);
+}
+
+void SpaceFillingCurvePartitionPolicy::sortCellsByCurveIndex(CurveType curveType, MeshTopologyViewPtr meshTopo, const vector<double> &minCoords,
+                                                             const vector<double> &maxCoords, vector<GlobalIndexType> &cellIndices)
+{
+  int curveDim = minCoords.size();
+  int bitsPerDimension = min(32, 64 / curveDim);
+  double maxQuantized = (bitsPerDimension == 32) ? double(numeric_limits<uint32_t>::max()) : double((1ULL << bitsPerDimension) - 1);
+
+  vector< pair<uint64_t, GlobalIndexType> > keyedCells(cellIndices.size());
+  vector<uint32_t> X(curveDim);
+  for (int i=0; i<cellIndices.size(); i++)
+  {
+    vector<double> centroid = meshTopo->getCellCentroid(cellIndices[i]);
+    for (int d=0; d<curveDim; d++)
+    {
+      double width = maxCoords[d] - minCoords[d];
+      double x = (width > 0) ? (centroid[d] - minCoords[d]) / width : 0.0;
+      x = max(0.0, min(1.0, x));
+      X[d] = (uint32_t) (x * maxQuantized);
+    }
+    keyedCells[i] = {curveIndex(curveType, X, bitsPerDimension), cellIndices[i]};
+  }
+  std::sort(keyedCells.begin(), keyedCells.end());
+  for (int i=0; i<cellIndices.size(); i++)
+  {
+    cellIndices[i] = keyedCells[i].second;
+  }
+}
+
+vector<GlobalIndexType> SpaceFillingCurvePartitionPolicy::orderedActiveCells(MeshTopologyViewPtr meshTopo)
+{
+  const set<IndexType>* activeCells = &meshTopo->getActiveCellIndices();
+  const set<IndexType>* rootCells = &meshTopo->getRootCellIndices();
+
+  int curveDim = curveDimension(meshTopo);
+
+  // bounding box for the root cells' vertices: every descendant centroid lies within it
+  vector<double> minCoords(curveDim, numeric_limits<double>::max());
+  vector<double> maxCoords(curveDim, numeric_limits<double>::lowest());
+  for (IndexType rootCellIndex : *rootCells)
+  {
+    CellPtr cell = meshTopo->getCell(rootCellIndex);
+    for (IndexType vertexIndex : cell->vertices())
+    {
+      const vector<double>* vertex = &meshTopo->getVertex(vertexIndex);
+      for (int d=0; d<curveDim; d++)
+      {
+        minCoords[d] = min(minCoords[d], (*vertex)[d]);
+        maxCoords[d] = max(maxCoords[d], (*vertex)[d]);
+      }
+    }
+  }
+
+  auto sortByCurveIndex = [&] (vector<IndexType> &cellIndices)
+  {
+    sortCellsByCurveIndex(_curveType, meshTopo, minCoords, maxCoords, cellIndices);
+  };
+
+  vector<IndexType> rootCellIndices(rootCells->begin(), rootCells->end());
+  sortByCurveIndex(rootCellIndices);
+
+  vector<GlobalIndexType> orderedCells;
+  orderedCells.reserve(activeCells->size());
+
+  // depth-first traversal; the stack holds cells in reverse visiting order
+  vector<IndexType> cellStack(rootCellIndices.rbegin(), rootCellIndices.rend());
+  while (cellStack.size() > 0)
+  {
+    IndexType cellIndex = cellStack.back();
+    cellStack.pop_back();
+    if (activeCells->find(cellIndex) != activeCells->end())
+    {
+      orderedCells.push_back(cellIndex);
+      continue;
+    }
+    vector<IndexType> childIndices = meshTopo->getCell(cellIndex)->getChildIndices(meshTopo);
+    sortByCurveIndex(childIndices);
+    cellStack.insert(cellStack.end(), childIndices.rbegin(), childIndices.rend());
+  }
+
+  TEUCHOS_TEST_FOR_EXCEPTION(orderedCells.size() != activeCells->size(), std::invalid_argument,
+                             "Not every active cell was reached from the root cells");
+  return orderedCells;
+}
+
+void SpaceFillingCurvePartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType numPartitions)
+{
+  int rank = Comm()->MyPID();
+  GlobalDofAssignment* gda = mesh->globalDofAssignment().get();
+
+  // previous rank-local cells; these may include parents of newly refined cells, whose data we hold for the children
+  MeshTopologyViewPtr meshTopo = mesh->getTopology();
+  set<GlobalIndexType> previousCellIDs = gda->cellsInPartition(-1);
+  auto wasRankLocal = [&] (GlobalIndexType cellID) -> bool
+  {
+    CellPtr cell = meshTopo->getCell(cellID);
+    while (cell != Teuchos::null)
+    {
+      if (previousCellIDs.find(cell->cellIndex()) != previousCellIDs.end()) return true;
+      cell = cell->getParent();
+    }
+    return false;
+  };
+
+  vector<GlobalIndexType> orderedCells = orderedActiveCells(meshTopo);
+  int numActiveCells = orderedCells.size();
+  int chunkSize = numActiveCells / numPartitions;
+  int remainder = numActiveCells % numPartitions;
+
+  vector< set<GlobalIndexType> > partitions(numPartitions);
+  map<GlobalIndexType, int> newPartitionForCell;
+  int orderedCellOrdinal = 0;
+  for (int i=0; i<numPartitions; i++)
+  {
+    int chunkSizeWithRemainder = (i < remainder) ? chunkSize + 1 : chunkSize;
+    for (int j=0; j<chunkSizeWithRemainder; j++, orderedCellOrdinal++)
+    {
+      GlobalIndexType cellID = orderedCells[orderedCellOrdinal];
+      partitions[i].insert(cellID);
+      if (wasRankLocal(cellID)) newPartitionForCell[cellID] = i;
+    }
+  }
+
+  vector<GlobalIndexType> exportCellIDs;
+  vector<int> exportRanks;
+  for (auto entry : newPartitionForCell)
+  {
+    if (entry.second != rank)
+    {
+      exportCellIDs.push_back(entry.first);
+      exportRanks.push_back(entry.second);
+    }
+  }
+
+  gda->setPartitions(partitions);
+  CellDataMigration::migrate(mesh, exportCellIDs, exportRanks);
+}
+
+Teuchos::RCP<SpaceFillingCurvePartitionPolicy> SpaceFillingCurvePartitionPolicy::spaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm, CurveType curveType)
+{
+  return Teuchos::rcp( new SpaceFillingCurvePartitionPolicy(Comm, curveType) );
+}
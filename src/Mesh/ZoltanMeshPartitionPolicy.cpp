@@ -36,12 +36,14 @@ ZoltanMeshPartitionPolicy::ZoltanMeshPartitionPolicy(Epetra_CommPtr Comm) : Mesh
 //  cout << "ZoltanMeshPartitionPolicy: Defaulting to HSFC partitioner" << endl;
   _ZoltanPartitioner = partitionerName;
   _debug_level = debug_level;
+  _repartition = false;
 }
 ZoltanMeshPartitionPolicy::ZoltanMeshPartitionPolicy(Epetra_CommPtr Comm, string partitionerName) : MeshPartitionPolicy(Comm)
 {
   string debug_level = "0";
   _ZoltanPartitioner = partitionerName;
   _debug_level = debug_level;
+  _repartition = false;
 }
 
 void ZoltanMeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType numPartitions)
@@ -72,7 +74,19 @@ void ZoltanMeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType num
     
     if (mpiComm != NULL)
     {
-      Zoltan *zz = new Zoltan(mpiComm->Comm());
+      Zoltan *zz;
+      if (_repartition)
+      {
+        if (_zoltan == Teuchos::null)
+        {
+          _zoltan = Teuchos::rcp( new Zoltan(mpiComm->Comm()) );
+        }
+        zz = _zoltan.get();
+      }
+      else
+      {
+        zz = new Zoltan(mpiComm->Comm());
+      }
       if (zz == NULL)
       {
         cout << "ZoltanMeshPartititionPolicy: construction of new Zoltan object failed.\n";
@@ -108,6 +122,21 @@ void ZoltanMeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType num
       //  zz->Set_Param( "REFTREE_INITPATH", "CONNECTED"); // no SFC on coarse meshTopology
       zz->Set_Param( "RANDOM_MOVE_FRACTION", "1.0");    /* Zoltan "random" partition param */
 
+      if (_repartition)
+      {
+        // start from the existing partition, and reuse cuts from the previous call where the method supports it
+        zz->Set_Param( "LB_APPROACH", "REPARTITION");
+        zz->Set_Param( "KEEP_CUTS", "1");
+        if (_ZoltanPartitioner == "RCB")
+        {
+          zz->Set_Param( "RCB_REUSE", "1");
+        }
+      }
+      else
+      {
+        zz->Set_Param( "LB_APPROACH", "PARTITION");
+      }
+
       zz->Set_Param( "IMBALANCE_TOL", "1.1"); // the default is 1.1; measured as the max. load divided by the average load -- worth noting that this is sometimes clearly unattainable (if you have e.g. 5 elements and 4 MPI ranks, you will have an average load of 1.25, and a maximum load of at least 2), and even in such cases zoltan issues a warning.  If we wanted to eliminate such warnings, it would be easy enough to compute the best case as determined by the pigeonhole principle (assuming equal weights, as we have now), and take the more tolerant of the best case versus e.g. 1.1.  But if you think of the warning as simply saying hey your work is imbalanced, that's true, even if that's totally unavoidable.
 
       Mesh* myData = mesh;
@@ -246,7 +275,10 @@ void ZoltanMeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType num
 
       }//end else
 
-      delete zz;
+      if (!_repartition)
+      {
+        delete zz;
+      }
     }
 #endif
   }
@@ -265,6 +297,20 @@ void ZoltanMeshPartitionPolicy::partitionMesh(Mesh *mesh, PartitionIndexType num
   }
 }
 
+void ZoltanMeshPartitionPolicy::setUseRepartitioning(bool value)
+{
+  _repartition = value;
+  if (!_repartition)
+  {
+    _zoltan = Teuchos::null;
+  }
+}
+
+bool ZoltanMeshPartitionPolicy::useRepartitioning() const
+{
+  return _repartition;
+}
+
 //GlobalIndexType ZoltanMeshPartitionPolicy::getIndexOfGID(int myNode,FieldContainer<GlobalIndexType> &partitionedActiveCells,GlobalIndexType globalID){
 //  int maxPartitionSize = partitionedActiveCells.dimension(1);
 //  for (int i=0;i<maxPartitionSize;i++){
@@ -452,6 +452,19 @@ public:
       cout << "localStiffnessDeterminationFromTestsTime: " << localStiffnessDeterminationFromTestsTime << " seconds.\n";
     }
   }
+
+  virtual void localStiffnessMatrixAndLoads(FieldContainer<double> &localStiffness, FieldContainer<double> &loads,
+                                            IPPtr ip, BasisCachePtr ipBasisCache,
+                                            const vector<RHSPtr> &rhsList, BasisCachePtr basisCache) {
+    // no shared factorization here: compute each load separately (the stiffness matrix is recomputed each time)
+    Teuchos::Array<int> loadDim(2);
+    loadDim[0] = loads.dimension(1);
+    loadDim[1] = loads.dimension(2);
+    for (int rhsOrdinal=0; rhsOrdinal<rhsList.size(); rhsOrdinal++) {
+      FieldContainer<double> rhsVector(loadDim, &loads(rhsOrdinal,0,0)); // shallow copy
+      localStiffnessMatrixAndRHS(localStiffness, rhsVector, ip, ipBasisCache, rhsList[rhsOrdinal], basisCache);
+    }
+  }
 };
 
 Virtual::Virtual(int testEnrichment) {
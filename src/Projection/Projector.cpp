@@ -10,6 +10,7 @@
 #include "SerialDenseWrapper.h"
 #include "VarFactory.h"
 
+#include <algorithm>
 #include <stdlib.h>
 
 #include "Shards_CellTopology.hpp"
@@ -20,6 +21,7 @@
 
 #include "Intrepid_FieldContainer.hpp"
 // Teuchos includes
+#include "Teuchos_LAPACK.hpp"
 #include "Teuchos_RCP.hpp"
 
 using namespace Intrepid;
@@ -212,12 +214,17 @@ template <typename Scalar>
 void Projector<Scalar>::projectFunctionOntoBasisInterpolating(FieldContainer<Scalar> &basisCoefficients, TFunctionPtr<Scalar> fxn,
                                                               BasisPtr basis, BasisCachePtr domainBasisCache)
 {
-  basisCoefficients.initialize(0);
+  InterpolatingProjection projection(basis, domainBasisCache);
+  projection.apply(basisCoefficients, fxn, domainBasisCache);
+}
+
+template <typename Scalar>
+Projector<Scalar>::InterpolatingProjection::InterpolatingProjection(BasisPtr basis, BasisCachePtr domainBasisCache)
+{
+  _basis = basis;
   CellTopoPtr basisDomainTopo = basis->domainTopology();
   unsigned basisDomainDim = basisDomainTopo->getDimension();
 
-  TIPPtr<Scalar> ip;
-
   bool traceVar;
   unsigned sideOrdinal = -1;
   CellTopoPtr domainTopo;
@@ -240,28 +247,30 @@ void Projector<Scalar>::projectFunctionOntoBasisInterpolating(FieldContainer<Sca
     }
   }
   unsigned domainDim = domainTopo->getDimension();
-  
-  pair<TIPPtr<Scalar>, VarPtr> ipVarPair = IP::standardInnerProductForFunctionSpace(basis->functionSpace(), traceVar, domainDim);
-  ip = ipVarPair.first;
-  VarPtr v = ipVarPair.second;
 
-  TIPPtr<Scalar> ip_l2 = Teuchos::rcp( new TIP<Scalar> );
-  ip_l2->addTerm(v);
+  pair<TIPPtr<Scalar>, VarPtr> ipVarPair = IP::standardInnerProductForFunctionSpace(basis->functionSpace(), traceVar, domainDim);
+  _v = ipVarPair.second;
 
   // for now, make all projections use L^2... (having some issues with gradients and cell Jacobians--I think we need the restriction of the cell Jacobian to the subcell, e.g., and it's not clear how to do that...)
-  ip = ip_l2;
+  _ip = Teuchos::rcp( new TIP<Scalar> );
+  _ip->addTerm(_v);
+
+  // fake a DofOrdering
+  _dofOrdering = Teuchos::rcp( new DofOrdering(domainBasisCache->cellTopology()) );
+  if (domainBasisCache->isSideCache() && ((_v->varType()==FLUX) || (_v->varType()==TRACE)))
+  {
+    _dofOrdering->addEntry(_v->ID(), basis, _v->rank(), domainBasisCache->getSideIndex());
+  }
+  else
+  {
+    _dofOrdering->addEntry(_v->ID(), basis, _v->rank());
+  }
 
   FieldContainer<double> referenceDomainNodes(domainTopo->getVertexCount(),domainDim);
   CamelliaCellTools::refCellNodesForTopology(referenceDomainNodes, domainTopo);
 
   int basisCardinality = basis->getCardinality();
 
-  set<int> allDofs;
-  for (int i=0; i<basisCardinality; i++)
-  {
-    allDofs.insert(i);
-  }
-  
   BasisPtr continuousBasis;
   int startingDimensionForProjection; // 0 to start with vertices, e.g.
   if (Camellia::functionSpaceIsDiscontinuous(basis->functionSpace()))
@@ -274,25 +283,25 @@ void Projector<Scalar>::projectFunctionOntoBasisInterpolating(FieldContainer<Sca
     continuousBasis = basis;
     startingDimensionForProjection = 0;
   }
-  
-  basisCoefficients.initialize(0.0);
-  set<int> dofsForDomain;
+
   if (basisDomainDim == domainDim)
   {
-    dofsForDomain = allDofs;
+    for (int i=0; i<basisCardinality; i++)
+    {
+      _dofsForDomain.push_back(i);
+    }
   }
   else
   {
-    dofsForDomain = continuousBasis->dofOrdinalsForSide(sideOrdinal);
+    set<int> dofsForSide = continuousBasis->dofOrdinalsForSide(sideOrdinal);
+    _dofsForDomain.insert(_dofsForDomain.end(), dofsForSide.begin(), dofsForSide.end());
   }
-  
-  int numCells = basisCoefficients.dimension(0);
-  FieldContainer<Scalar> wholeBasisCoefficients(numCells, basisCardinality); // will include zeros for any coefficients belonging to other sides for a volume basis, e.g.
-  
+
+  _numCells = domainBasisCache->getPhysicalCubaturePoints().dimension(0);
+  Teuchos::LAPACK<int, Scalar> lapack;
+
   for (int d=startingDimensionForProjection; d<=domainDim; d++)
   {
-    TFunctionPtr<Scalar> projectionThusFar = BasisSumFunction::basisSumFunction(basis, wholeBasisCoefficients);
-    TFunctionPtr<Scalar> fxnToApproximate = fxn - projectionThusFar;
     int subcellCount = domainTopo->getSubcellCount(d);
     for (int subcord=0; subcord<subcellCount; subcord++)
     {
@@ -313,71 +322,135 @@ void Projector<Scalar>::projectFunctionOntoBasisInterpolating(FieldContainer<Sca
         else
           subcellDofOrdinals = continuousBasis->dofOrdinalsForSubcell(d, subcordBasis, 0);
       }
-        
-      if (subcellDofOrdinals.size() > 0)
+
+      if (subcellDofOrdinals.size() == 0) continue;
+
+      SubcellProjection subcellProjection;
+      subcellProjection.dim = d;
+      FieldContainer<double>* refCellPoints = &subcellProjection.refCellPoints;
+      FieldContainer<double>* cubatureWeightsSubcell = &subcellProjection.cubatureWeights; // allows us to integrate over the fine subcell even when domain is higher-dimensioned
+      if (d == 0)
       {
-        FieldContainer<double> refCellPoints;
-        FieldContainer<double> cubatureWeightsSubcell; // allows us to integrate over the fine subcell even when domain is higher-dimensioned
-        if (d == 0)
+        refCellPoints->resize(1,domainDim);
+        for (int d1=0; d1<domainDim; d1++)
         {
-          refCellPoints.resize(1,domainDim);
-          for (int d1=0; d1<domainDim; d1++)
-          {
-            refCellPoints(0,d1) = referenceDomainNodes(subcord,d1);
-          }
-          cubatureWeightsSubcell.resize(1);
-          cubatureWeightsSubcell(0) = 1.0;
+          (*refCellPoints)(0,d1) = referenceDomainNodes(subcord,d1);
+        }
+        cubatureWeightsSubcell->resize(1);
+        (*cubatureWeightsSubcell)(0) = 1.0;
+      }
+      else
+      {
+        CellTopoPtr subcellTopo = domainTopo->getSubcell(d, subcord);
+        BasisCachePtr subcellCache = Teuchos::rcp( new BasisCache(subcellTopo, domainBasisCache->cubatureDegree(), false) );
+        int numPoints = subcellCache->getRefCellPoints().dimension(0);
+        refCellPoints->resize(numPoints,domainDim);
+        *cubatureWeightsSubcell = subcellCache->getCubatureWeights();
+
+        if (d == domainDim)
+        {
+          *refCellPoints = subcellCache->getRefCellPoints();
         }
         else
         {
-          CellTopoPtr subcellTopo = domainTopo->getSubcell(d, subcord);
-//          Teuchos::RCP<Cubature<double> > subcellCubature = cubFactory.create(subcellTopo, domainBasisCache->cubatureDegree());
-          BasisCachePtr subcellCache = Teuchos::rcp( new BasisCache(subcellTopo, domainBasisCache->cubatureDegree(), false) );
-          int numPoints = subcellCache->getRefCellPoints().dimension(0);
-          refCellPoints.resize(numPoints,domainDim);
-          cubatureWeightsSubcell = subcellCache->getCubatureWeights();
-
-          if (d == domainDim)
+          CamelliaCellTools::mapToReferenceSubcell(*refCellPoints, subcellCache->getRefCellPoints(), d,
+              subcord, domainTopo);
+        }
+      }
+      domainBasisCache->setRefCellPoints(*refCellPoints, *cubatureWeightsSubcell, domainBasisCache->cubatureDegree());
+
+      FieldContainer<Scalar> gramMatrix(_numCells,basisCardinality,basisCardinality);
+      _ip->computeInnerProductMatrix(gramMatrix, _dofOrdering, domainBasisCache);
+
+      vector<int>* dofOrdinals = &subcellProjection.dofOrdinals;
+      *dofOrdinals = subcellDofOrdinals;
+      std::sort(dofOrdinals->begin(), dofOrdinals->end());
+      int numDofs = dofOrdinals->size();
+      subcellProjection.choleskyFactors.resize(_numCells,numDofs,numDofs);
+      subcellProjection.coupling.resize(_numCells,numDofs,basisCardinality);
+      subcellProjection.factored.resize(_numCells);
+      for (int cellOrdinal=0; cellOrdinal<_numCells; cellOrdinal++)
+      {
+        for (int i=0; i<numDofs; i++)
+        {
+          for (int j=0; j<numDofs; j++)
           {
-            refCellPoints = subcellCache->getRefCellPoints();
+            subcellProjection.choleskyFactors(cellOrdinal,i,j) = gramMatrix(cellOrdinal,(*dofOrdinals)[i],(*dofOrdinals)[j]);
           }
-          else
+          for (int j=0; j<basisCardinality; j++)
           {
-            CamelliaCellTools::mapToReferenceSubcell(refCellPoints, subcellCache->getRefCellPoints(), d,
-                subcord, domainTopo);
+            subcellProjection.coupling(cellOrdinal,i,j) = gramMatrix(cellOrdinal,(*dofOrdinals)[i],j);
           }
         }
-        domainBasisCache->setRefCellPoints(refCellPoints, cubatureWeightsSubcell, domainBasisCache->cubatureDegree());
-        TIPPtr<Scalar> ipForProjection = (d==0) ? ip_l2 : ip; // just use values at vertices (ignore derivatives)
-        set<int> dofsToSkip = allDofs;
-        for (auto dofOrdinal : subcellDofOrdinals)
+        int info;
+        lapack.POTRF('L', numDofs, &subcellProjection.choleskyFactors(cellOrdinal,0,0), numDofs, &info);
+        subcellProjection.factored[cellOrdinal] = (info == 0);
+        if (info != 0)
         {
-          dofsToSkip.erase(dofOrdinal);
+          cout << "WARNING: in Projector, Cholesky factorization of the Gram matrix returned result code " << info << endl;
         }
-        FieldContainer<Scalar> newBasisCoefficients;
-        projectFunctionOntoBasis(newBasisCoefficients, fxnToApproximate, basis, domainBasisCache, ipForProjection, v, dofsToSkip);
-        for (int cellOrdinal=0; cellOrdinal<newBasisCoefficients.dimension(0); cellOrdinal++)
+      }
+      _subcellProjections.push_back(subcellProjection);
+    }
+  }
+}
+
+template <typename Scalar>
+void Projector<Scalar>::InterpolatingProjection::apply(FieldContainer<Scalar> &basisCoefficients, TFunctionPtr<Scalar> fxn,
+                                                       BasisCachePtr domainBasisCache)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(! fxn.get(), std::invalid_argument, "fxn cannot be null!");
+  TEUCHOS_TEST_FOR_EXCEPTION(fxn->rank() != _basis->rangeRank(), std::invalid_argument, "Function rank must agree with basis rank");
+
+  int basisCardinality = _basis->getCardinality();
+  FieldContainer<Scalar> wholeBasisCoefficients(_numCells, basisCardinality); // will include zeros for any coefficients belonging to other sides for a volume basis, e.g.
+  FieldContainer<Scalar> projectionThusFar; // coefficients determined by the lower-dimensional subcells
+  FieldContainer<Scalar> ipVector(_numCells, basisCardinality);
+  Teuchos::LAPACK<int, Scalar> lapack;
+
+  int currentDim = -1;
+  for (const SubcellProjection &subcellProjection : _subcellProjections)
+  {
+    if (subcellProjection.dim != currentDim)
+    {
+      projectionThusFar = wholeBasisCoefficients;
+      currentDim = subcellProjection.dim;
+    }
+    domainBasisCache->setRefCellPoints(subcellProjection.refCellPoints, subcellProjection.cubatureWeights,
+                                       domainBasisCache->cubatureDegree());
+    ipVector.initialize(0.0);
+    _ip->computeInnerProductVector(ipVector, _v, fxn, _dofOrdering, domainBasisCache);
+
+    // load for (fxn - projectionThusFar), restricted to the subcell's dofs
+    int numDofs = subcellProjection.dofOrdinals.size();
+    FieldContainer<Scalar> rhs(numDofs);
+    for (int cellOrdinal=0; cellOrdinal<_numCells; cellOrdinal++)
+    {
+      if (!subcellProjection.factored[cellOrdinal]) continue; // leave these coefficients at zero
+      for (int i=0; i<numDofs; i++)
+      {
+        Scalar value = ipVector(cellOrdinal,subcellProjection.dofOrdinals[i]);
+        for (int j=0; j<basisCardinality; j++)
         {
-          for (auto dofOrdinal : subcellDofOrdinals)
-          {
-            wholeBasisCoefficients(cellOrdinal,dofOrdinal) = newBasisCoefficients(cellOrdinal,dofOrdinal);
-//            cout << "Assigned dofOrdinal " << dofOrdinal << " " << " coefficient " << newBasisCoefficients(cellOrdinal,dofOrdinal);
-//            cout << " (subcord,d) = (" << subcord << "," << d << ")" << endl;
-          }
+          value -= subcellProjection.coupling(cellOrdinal,i,j) * projectionThusFar(cellOrdinal,j);
         }
+        rhs(i) = value;
       }
-      else
+      int info;
+      lapack.POTRS('L', numDofs, 1, &subcellProjection.choleskyFactors(cellOrdinal,0,0), numDofs, &rhs(0), numDofs, &info);
+      for (int i=0; i<numDofs; i++)
       {
-//        cout << "no dof ordinals found for subcell " << subcord << " of dimension " << d << endl;
+        wholeBasisCoefficients(cellOrdinal,subcellProjection.dofOrdinals[i]) = rhs(i);
       }
     }
   }
-  
+
   // now, copy out values corresponding to dofsForDomain into the provided basisCoefficients container
-  for (int cellOrdinal = 0; cellOrdinal < numCells; cellOrdinal++)
+  basisCoefficients.resize(_numCells, _dofsForDomain.size());
+  for (int cellOrdinal = 0; cellOrdinal < _numCells; cellOrdinal++)
   {
     int ordinalInBasisCoefficients = 0;
-    for (auto dofOrdinal : dofsForDomain)
+    for (auto dofOrdinal : _dofsForDomain)
     {
       basisCoefficients(cellOrdinal,ordinalInBasisCoefficients) = wholeBasisCoefficients(cellOrdinal,dofOrdinal);
       ordinalInBasisCoefficients++;
@@ -534,13 +534,43 @@ namespace Camellia
     stiffness.initialize(0.0);
     basisCache->setCellSideParities(cellSideParities);
     
+    // if cubature phasing is enabled (see BasisCache::setCubaturePhaseCacheSize()), accumulate the volume integrals
+    // over chunks of cubature points, and then integrate the boundary terms
+    int totalBasisCardinality = elemType->trialOrderPtr->getTotalBasisCardinality() + elemType->testOrderPtr->getTotalBasisCardinality();
+    int maxPointsPerPhase = basisCache->maxPointsPerCubaturePhaseForCache(totalBasisCardinality);
+    if (maxPointsPerPhase != -1)
+    {
+      basisCache->setMaxPointsPerCubaturePhase(maxPointsPerPhase);
+      for (int phase=0; phase < basisCache->getCubaturePhaseCount(); phase++)
+      {
+        basisCache->setCubaturePhase(phase);
+        for (TBilinearTerm<Scalar> bt : _terms)
+        {
+          TLinearTermPtr<Scalar> trialTerm = bt.first;
+          TLinearTermPtr<Scalar> testTerm = bt.second;
+          if (rowMajor)
+            testTerm->integrateVolumePart(stiffness, elemType->testOrderPtr, trialTerm, elemType->trialOrderPtr, basisCache);
+          else
+            trialTerm->integrateVolumePart(stiffness, elemType->trialOrderPtr, testTerm, elemType->testOrderPtr, basisCache);
+        }
+      }
+      basisCache->setMaxPointsPerCubaturePhase(-1); // end phasing; all points are restored only if later needed (side caches are not phased)
+    }
+    
     for (typename vector< TBilinearTerm<Scalar> >:: iterator btIt = _terms.begin();
          btIt != _terms.end(); btIt++)
     {
       TBilinearTerm<Scalar> bt = *btIt;
       TLinearTermPtr<Scalar> trialTerm = btIt->first;
       TLinearTermPtr<Scalar> testTerm = btIt->second;
-      if (rowMajor)
+      if (maxPointsPerPhase != -1)
+      {
+        if (rowMajor)
+          testTerm->integrateBoundaryPart(stiffness, elemType->testOrderPtr, trialTerm, elemType->trialOrderPtr, basisCache);
+        else
+          trialTerm->integrateBoundaryPart(stiffness, elemType->trialOrderPtr, testTerm, elemType->testOrderPtr, basisCache);
+      }
+      else if (rowMajor)
       {
         testTerm->integrate(stiffness, elemType->testOrderPtr,
                             trialTerm,  elemType->trialOrderPtr, basisCache);
@@ -994,6 +1024,19 @@ namespace Camellia
   {
     return _jumpTerms;
   }
+
+  template <typename Scalar>
+  void TBF<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+  {
+    for (const vector< TBilinearTerm<Scalar> >* terms : {&_terms, &_jumpTerms})
+    {
+      for (const TBilinearTerm<Scalar> &term : *terms)
+      {
+        term.first->importOffRankCellData(basisCaches);
+        term.second->importOffRankCellData(basisCaches);
+      }
+    }
+  }
   
   template <typename Scalar>
   TIPPtr<Scalar> TBF<Scalar>::l2Norm()
@@ -1009,8 +1052,9 @@ namespace Camellia
   }
   
   template <typename Scalar>
-  void TBF<Scalar>::localStiffnessMatrixAndRHS(FieldContainer<Scalar> &localStiffness, FieldContainer<Scalar> &rhsVector,
-                                               TIPPtr<Scalar> ip, BasisCachePtr ipBasisCache, TRHSPtr<Scalar> rhs, BasisCachePtr basisCache)
+  void TBF<Scalar>::localStiffnessMatrixAndLoads(FieldContainer<Scalar> &localStiffness, FieldContainer<Scalar> &loads,
+                                                 TIPPtr<Scalar> ip, BasisCachePtr ipBasisCache,
+                                                 const vector< TRHSPtr<Scalar> > &rhsList, BasisCachePtr basisCache)
   {
     double testMatrixAssemblyTime = 0, localStiffnessDeterminationTime = 0;
     double rhsDeterminationTime = 0;
@@ -1045,6 +1089,13 @@ namespace Camellia
         cout << "localStiffness should have dimensions (C,numTrialFields,numTrialFields).\n";
         TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "localStiffness should have dimensions (C,numTrialFields,numTrialFields).");
       }
+      int numRHS = rhsList.size();
+      TEUCHOS_TEST_FOR_EXCEPTION((loads.rank() != 3) || (loads.dimension(0) != numRHS) || (loads.dimension(1) != numCells)
+                                 || (loads.dimension(2) != numTrialDofs), std::invalid_argument,
+                                 "loads should have dimensions (numRHS,C,numTrialFields).");
+      Teuchos::Array<int> loadDim(2);
+      loadDim[0] = numCells;
+      loadDim[1] = numTrialDofs;
       
       if (printTimings)
       {
@@ -1081,7 +1132,11 @@ namespace Camellia
         }
         
         timer.ResetStartTime();
-        rhs->integrateAgainstStandardBasis(rhsVector, testOrder, basisCache);
+        for (int rhsOrdinal=0; rhsOrdinal<numRHS; rhsOrdinal++)
+        {
+          FieldContainer<Scalar> rhsVector(loadDim, &loads(rhsOrdinal,0,0)); // shallow copy
+          rhsList[rhsOrdinal]->integrateAgainstStandardBasis(rhsVector, testOrder, basisCache);
+        }
         rhsDeterminationTime += timer.ElapsedTime();
       }
       else if (_optimalTestSolver == FACTORED_CHOLESKY)
@@ -1117,11 +1172,18 @@ namespace Camellia
         ip->computeInnerProductMatrix(ipMatrix, testOrder, ipBasisCache);
         timeG = timer.ElapsedTime();
         
-        FieldContainer<Scalar> rhsEnriched(numCells,numTestDofs);
-        rhs->integrateAgainstStandardBasis(rhsEnriched,testOrder,basisCache);
+        FieldContainer<Scalar> rhsEnriched(numRHS,numCells,numTestDofs);
+        Teuchos::Array<int> rhsEnrichedDim(2);
+        rhsEnrichedDim[0] = numCells;
+        rhsEnrichedDim[1] = numTestDofs;
+        for (int rhsOrdinal=0; rhsOrdinal<numRHS; rhsOrdinal++)
+        {
+          FieldContainer<Scalar> rhsEnrichedForOrdinal(rhsEnrichedDim, &rhsEnriched(rhsOrdinal,0,0)); // shallow copy
+          rhsList[rhsOrdinal]->integrateAgainstStandardBasis(rhsEnrichedForOrdinal,testOrder,basisCache);
+        }
         
         Teuchos::Array<int> localRHSEnrichedDim(2);
-        localRHSEnrichedDim[0] = rhsEnriched.dimension(1);
+        localRHSEnrichedDim[0] = numTestDofs;
         localRHSEnrichedDim[1] = 1;
         
         Teuchos::Array<int> localRHSDim(2);
@@ -1137,10 +1199,22 @@ namespace Camellia
           FieldContainer<Scalar> cellIPMatrix(localIPDim, &ipMatrix(cellIndex,0,0));
           FieldContainer<Scalar> cellStiffnessEnriched(localStiffnessEnrichedDim, &stiffnessEnriched(cellIndex,0,0));
           FieldContainer<Scalar> cellStiffness(localStiffnessDim, &localStiffness(cellIndex,0,0));
-          FieldContainer<Scalar> cellRHSEnriched(localRHSEnrichedDim, &rhsEnriched(cellIndex,0));
-          FieldContainer<Scalar> cellRHS(localRHSDim, &rhsVector(cellIndex,0));
+          FieldContainer<Scalar> cellRHSEnriched(localRHSEnrichedDim, &rhsEnriched(0,cellIndex,0));
+          FieldContainer<Scalar> cellRHS(localRHSDim, &loads(0,cellIndex,0));
 
           result = factoredCholeskySolve(cellIPMatrix, cellStiffnessEnriched, cellRHSEnriched, cellStiffness, cellRHS);
+
+          // factoredCholeskySolve() leaves the Cholesky factor L in cellIPMatrix and L^-1 B in cellStiffnessEnriched;
+          // each further load costs one triangular solve and one matrix-vector product
+          for (int rhsOrdinal=1; rhsOrdinal<numRHS; rhsOrdinal++)
+          {
+            FieldContainer<Scalar> cellLoadEnriched(localRHSEnrichedDim, &rhsEnriched(rhsOrdinal,cellIndex,0));
+            FieldContainer<Scalar> cellLoad(localRHSDim, &loads(rhsOrdinal,cellIndex,0));
+            Teuchos::BLAS<int, double> blas;
+            blas.TRSM(Teuchos::LEFT_SIDE, Teuchos::LOWER_TRI, Teuchos::NO_TRANS, Teuchos::NON_UNIT_DIAG, numTestDofs, 1, 1.0,
+                      &cellIPMatrix[0], numTestDofs, &cellLoadEnriched[0], numTestDofs);
+            SerialDenseWrapper::multiply(cellLoad, cellStiffnessEnriched, cellLoadEnriched, 'N', 'N');
+          }
         }
       }
       else
@@ -1162,7 +1236,11 @@ namespace Camellia
         }
         
         timer.ResetStartTime();
-        rhs->integrateAgainstOptimalTests(rhsVector, optTestCoeffs, testOrder, basisCache);
+        for (int rhsOrdinal=0; rhsOrdinal<numRHS; rhsOrdinal++)
+        {
+          FieldContainer<Scalar> rhsVector(loadDim, &loads(rhsOrdinal,0,0)); // shallow copy
+          rhsList[rhsOrdinal]->integrateAgainstOptimalTests(rhsVector, optTestCoeffs, testOrder, basisCache);
+        }
         rhsDeterminationTime += timer.ElapsedTime();
       }
       
@@ -1189,6 +1267,20 @@ namespace Camellia
     }
   }
   
+  template <typename Scalar>
+  void TBF<Scalar>::localStiffnessMatrixAndRHS(FieldContainer<Scalar> &localStiffness, FieldContainer<Scalar> &rhsVector,
+                                               TIPPtr<Scalar> ip, BasisCachePtr ipBasisCache, TRHSPtr<Scalar> rhs, BasisCachePtr basisCache)
+  {
+    // view rhsVector as a single load
+    Teuchos::Array<int> loadsDim(3);
+    loadsDim[0] = 1;
+    loadsDim[1] = rhsVector.dimension(0);
+    loadsDim[2] = rhsVector.dimension(1);
+    FieldContainer<Scalar> loads(loadsDim, &rhsVector[0]); // shallow copy
+    vector< TRHSPtr<Scalar> > rhsList(1, rhs);
+    TBF<Scalar>::localStiffnessMatrixAndLoads(localStiffness, loads, ip, ipBasisCache, rhsList, basisCache);
+  }
+  
   template <typename Scalar>
   TIPPtr<Scalar> TBF<Scalar>::naiveNorm(int spaceDim)
   {
@@ -227,28 +227,36 @@ void TIP<Scalar>::computeInnerProductMatrix(FieldContainer<Scalar> &innerProduct
 
     innerProduct.initialize(0.0);
 
-//    int totalBasisCardinality = dofOrdering->getTotalBasisCardinality();
-    // want to fit all basis values in 256K with a little room to spare -- 32768 doubles would be no room to spare
-    // 256K is the size of Sandy Bridge's L2 cache.  Blue Gene Q has 32 MB shared L2 cache, so maybe there we could go bigger
-    // (fitting within L1 is likely a non-starter for 3D DPG)
-//    int maxValuesAllowed = 30000;
-//    int maxPointsPerPhase = std::max(2, maxValuesAllowed / totalBasisCardinality); // minimally, compute 2 points at once
-
-//    basisCache->setMaxPointsPerCubaturePhase(maxPointsPerPhase);
-//    basisCache->setMaxPointsPerCubaturePhase(-1); // old behavior
-
-//    for (int phase=0; phase < basisCache->getCubaturePhaseCount(); phase++) {
-//      basisCache->setCubaturePhase(phase);
-    for (typename vector< TLinearTermPtr<Scalar> >:: iterator ltIt = _linearTerms.begin();
-         ltIt != _linearTerms.end(); ltIt++)
+    // if cubature phasing is enabled (see BasisCache::setCubaturePhaseCacheSize()), walk through the cubature points in
+    // chunks small enough that each chunk's basis values stay in cache, accumulating the volume integrals as we go
+    int maxPointsPerPhase = basisCache->maxPointsPerCubaturePhaseForCache(dofOrdering->getTotalBasisCardinality());
+    if (maxPointsPerPhase == -1)
     {
-      TLinearTermPtr<Scalar> lt = *ltIt;
-      // integrate lt against itself
-      lt->integrate(innerProduct,dofOrdering,lt,dofOrdering,basisCache,basisCache->isSideCache());
+      for (typename vector< TLinearTermPtr<Scalar> >:: iterator ltIt = _linearTerms.begin();
+           ltIt != _linearTerms.end(); ltIt++)
+      {
+        TLinearTermPtr<Scalar> lt = *ltIt;
+        // integrate lt against itself
+        lt->integrate(innerProduct,dofOrdering,lt,dofOrdering,basisCache,basisCache->isSideCache());
+      }
+    }
+    else
+    {
+      basisCache->setMaxPointsPerCubaturePhase(maxPointsPerPhase);
+      for (int phase=0; phase < basisCache->getCubaturePhaseCount(); phase++)
+      {
+        basisCache->setCubaturePhase(phase);
+        for (TLinearTermPtr<Scalar> lt : _linearTerms)
+        {
+          lt->integrateVolumePart(innerProduct,dofOrdering,lt,dofOrdering,basisCache);
+        }
+      }
+      basisCache->setMaxPointsPerCubaturePhase(-1); // end phasing; all points are restored only if later needed (side caches are not phased)
+      for (TLinearTermPtr<Scalar> lt : _linearTerms)
+      {
+        lt->integrateBoundaryPart(innerProduct,dofOrdering,lt,dofOrdering,basisCache);
+      }
     }
-//    }
-
-//    basisCache->setMaxPointsPerCubaturePhase(-1); // infinite (BasisCache doesn't yet properly support phased *side* caches)
 
     bool enforceNumericalSymmetry = false;
     if (enforceNumericalSymmetry)
@@ -20,6 +20,7 @@
 
 #include "Epetra_CrsMatrix.h"
 #include "Intrepid_FunctionSpaceTools.hpp"
+#include <Teuchos_BLAS.hpp>
 #include <Teuchos_GlobalMPISession.hpp>
 
 namespace Camellia
@@ -38,12 +39,78 @@ bool linearSummandIsBoundaryValueOnly(TLinearSummand<Scalar> &ls)
   return boundaryOnlyFunction || (ls.second->varType()==FLUX) || (ls.second->varType()==TRACE) || opInvolvesNormal;
 }
 
+// Computes gram(c,i,j) = sum_p w(c,p) * values(c,i,p,...) * values(c,j,p,...) with a rank-k update (SYRK), which
+// does half the work of a general matrix-matrix product.  values should not have cubature weights applied; on
+// return, it holds the values scaled by sqrt(w).  Returns false, leaving both containers untouched, if any weight
+// is negative (as can happen with some cubature rules); the caller should then integrate in the usual way.
+bool symmetricGramMatrix(Intrepid::FieldContainer<double> &gram, Intrepid::FieldContainer<double> &values,
+                         const Intrepid::FieldContainer<double> &weightedMeasures)
+{
+  for (int i=0; i<weightedMeasures.size(); i++)
+  {
+    if (weightedMeasures[i] < 0) return false;
+  }
+  int numCells = values.dimension(0);
+  int numFields = values.dimension(1);
+  int numPoints = values.dimension(2);
+  if (values.size() == 0)
+  {
+    gram.initialize(0.0);
+    return true;
+  }
+  int valuesPerPoint = values.size() / (numCells * numFields * numPoints); // product of any tensor dimensions
+  int valuesPerField = numPoints * valuesPerPoint;
+
+  for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+  {
+    for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+    {
+      double sqrtWeight = sqrt(weightedMeasures(cellOrdinal,pointOrdinal));
+      for (int fieldOrdinal=0; fieldOrdinal<numFields; fieldOrdinal++)
+      {
+        double* value = &values[(cellOrdinal * numFields + fieldOrdinal) * valuesPerField + pointOrdinal * valuesPerPoint];
+        for (int i=0; i<valuesPerPoint; i++)
+        {
+          value[i] *= sqrtWeight;
+        }
+      }
+    }
+  }
+
+  Teuchos::BLAS<int, double> blas;
+  for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+  {
+    // in column-major terms, the cell's values are a (valuesPerField x numFields) matrix X; we want X^T X
+    double* cellValues = &values[cellOrdinal * numFields * valuesPerField];
+    double* cellGram = &gram(cellOrdinal,0,0);
+    blas.SYRK(Teuchos::UPPER_TRI, Teuchos::TRANS, numFields, valuesPerField, 1.0, cellValues, valuesPerField, 0.0, cellGram, numFields);
+    // the column-major upper triangle is the row-major lower triangle; copy it to the row-major upper triangle
+    for (int i=0; i<numFields; i++)
+    {
+      for (int j=i+1; j<numFields; j++)
+      {
+        cellGram[i*numFields+j] = cellGram[j*numFields+i];
+      }
+    }
+  }
+  return true;
+}
+
 template<typename Scalar>
 const vector< TLinearSummand<Scalar> > & TLinearTerm<Scalar>::summands() const
 {
   return _summands;
 }
 
+template<typename Scalar>
+void TLinearTerm<Scalar>::importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches)
+{
+  for (const TLinearSummand<Scalar> &summand : _summands)
+  {
+    summand.first->importOffRankCellData(basisCaches);
+  }
+}
+
 template<typename Scalar>
 TLinearTerm<Scalar>::TLinearTerm()
 {
@@ -453,8 +520,9 @@ void TLinearTerm<Scalar>::integrate(Epetra_CrsMatrix* valuesCrsMatrix, Intrepid:
     }
   }
 
-  bool symmetric = false; // turning off a so far buggy attempt at optimization
-  //  bool symmetric = (u.get()==v.get()) && (uOrdering.get() == vOrdering.get());
+  // when integrating a term against itself, each off-diagonal block is computed once and also used for its transpose,
+  // and the diagonal blocks are computed with a symmetric rank-k update
+  bool symmetric = (u.get()==v.get()) && (uOrdering.get() == vOrdering.get());
 
   // values has dimensions (numCells, uFields, vFields)
   int numPoints = basisCache->getPhysicalCubaturePoints().dimension(1);
@@ -577,7 +645,11 @@ void TLinearTerm<Scalar>::integrate(Epetra_CrsMatrix* valuesCrsMatrix, Intrepid:
 
       Intrepid::FieldContainer<double> miniMatrix( numCells, uBasisCardinality, vBasisCardinality );
 
-      Intrepid::FunctionSpaceTools::integrate<double>(miniMatrix,uValues,vValues,Intrepid::COMP_BLAS);
+      bool diagonalBlock = symmetric && (uOrdinal == vOrdinal);
+      if (!diagonalBlock || !symmetricGramMatrix(miniMatrix, vValues, basisCache->getWeightedMeasures()))
+      {
+        Intrepid::FunctionSpaceTools::integrate<double>(miniMatrix,uValues,vValues,Intrepid::COMP_BLAS);
+      }
 
       //      cout << "uValues:" << endl << uValues;
       //      cout << "vValues:" << endl << vValues;
@@ -599,7 +671,7 @@ void TLinearTerm<Scalar>::integrate(Epetra_CrsMatrix* valuesCrsMatrix, Intrepid:
               int vDofIndex = vDofIndices[j];
               double value = miniMatrix(k,i,j); // separate line for debugger inspection
               valuesFC(k,uDofIndex,vDofIndex) += value;
-              if ((symmetric) && (uOrdinal != vOrdinal))    // pretty sure this point is where the bug in symmetric accumulation comes in.  Pretty sure we'll get some double-accumulation.  I'm not sure how to fix it just yet, though.
+              if ((symmetric) && (uOrdinal != vOrdinal))
               {
                 valuesFC(k,vDofIndex,uDofIndex) += value;
               }
@@ -617,13 +689,26 @@ void TLinearTerm<Scalar>::integrate(Epetra_CrsMatrix* valuesCrsMatrix, Intrepid:
         }
         for (int j=0; j < vBasisCardinality; j++)
         {
-          vDofIndicesFC[j] = vDofIndicesFC[j];
+          vDofIndicesFC[j] = vDofIndices[j];
         }
         for (int i=0; i < uBasisCardinality; i++)
         {
           int uDofIndex = uDofIndices[i];
           valuesCrsMatrix->SumIntoGlobalValues(uDofIndex, vBasisCardinality, &miniMatrix(0,i,0), &vDofIndicesFC[0]);
         }
+        if ((symmetric) && (uOrdinal != vOrdinal))
+        {
+          // transpose block
+          for (int j=0; j < vBasisCardinality; j++)
+          {
+            int vDofIndex = vDofIndices[j];
+            for (int i=0; i < uBasisCardinality; i++)
+            {
+              double value = miniMatrix(0,i,j);
+              valuesCrsMatrix->SumIntoGlobalValues(vDofIndex, 1, &value, &uDofIndicesFC[i]);
+            }
+          }
+        }
       }
     }
   }
@@ -726,6 +811,39 @@ void TLinearTerm<Scalar>::integrate(Epetra_CrsMatrix *valuesCrsMatrix, Intrepid:
   }
 }
 
+template<typename Scalar>
+void TLinearTerm<Scalar>::integrateVolumePart(Intrepid::FieldContainer<Scalar> &values, DofOrderingPtr thisOrdering,
+                                              TLinearTermPtr<Scalar> otherTerm, DofOrderingPtr otherOrdering,
+                                              BasisCachePtr basisCache)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(basisCache->isSideCache(), std::invalid_argument, "integrateVolumePart() requires a volume basisCache");
+  TLinearTermPtr<Scalar> thisNonBoundaryOnly = this->getNonBoundaryOnlyPart();
+  // preserve pointer equality for terms integrated against themselves, so that the symmetric integration is used
+  TLinearTermPtr<Scalar> otherNonBoundaryOnly = (otherTerm.get() == this) ? thisNonBoundaryOnly : otherTerm->getNonBoundaryOnlyPart();
+  integrate(values, otherNonBoundaryOnly, otherOrdering, thisNonBoundaryOnly, thisOrdering, basisCache);
+}
+
+template<typename Scalar>
+void TLinearTerm<Scalar>::integrateBoundaryPart(Intrepid::FieldContainer<Scalar> &values, DofOrderingPtr thisOrdering,
+                                                TLinearTermPtr<Scalar> otherTerm, DofOrderingPtr otherOrdering,
+                                                BasisCachePtr basisCache)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(basisCache->isSideCache(), std::invalid_argument, "integrateBoundaryPart() requires a volume basisCache");
+  TLinearTermPtr<Scalar> thisPtr = Teuchos::rcp( this, false );
+  TLinearTermPtr<Scalar> thisBoundaryOnly = this->getBoundaryOnlyPart();
+  TLinearTermPtr<Scalar> otherBoundaryOnly = otherTerm->getBoundaryOnlyPart();
+  TLinearTermPtr<Scalar> otherNonBoundaryOnly = otherTerm->getNonBoundaryOnlyPart();
+
+  // as in integrate(): (u + du, v + dv) - (u,v) = (u + du, dv) + (du, v)
+  int numSides = basisCache->cellTopology()->getSideCount();
+  for (int sideIndex=0; sideIndex<numSides; sideIndex++)
+  {
+    BasisCachePtr sideCache = basisCache->getSideBasisCache(sideIndex);
+    integrate(values, otherBoundaryOnly, otherOrdering, thisPtr, thisOrdering, sideCache);
+    integrate(values, otherNonBoundaryOnly, otherOrdering, thisBoundaryOnly, thisOrdering, sideCache);
+  }
+}
+
 // integrate this against otherTerm, where otherVar == fxn
 template<typename Scalar>
 void TLinearTerm<Scalar>::integrate(Intrepid::FieldContainer<Scalar> &values, DofOrderingPtr thisOrdering,
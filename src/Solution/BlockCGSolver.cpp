@@ -0,0 +1,81 @@
+//
+//  BlockCGSolver.cpp
+//  Camellia
+//
+
+#include "BlockCGSolver.h"
+
+#include <BelosBlockCGSolMgr.hpp>
+#include <BelosEpetraAdapter.hpp>
+
+using namespace Camellia;
+using namespace std;
+
+BlockCGSolver::BlockCGSolver(int maxIters, double tol, Teuchos::RCP<Epetra_Operator> preconditioner)
+{
+  _maxIters = maxIters;
+  _tol = tol;
+  _printToConsole = false;
+  _preconditioner = preconditioner;
+  _iterationCount = 0;
+}
+
+int BlockCGSolver::iterationCount() const
+{
+  return _iterationCount;
+}
+
+void BlockCGSolver::setPreconditioner(Teuchos::RCP<Epetra_Operator> preconditioner)
+{
+  _preconditioner = preconditioner;
+}
+
+void BlockCGSolver::setPrintToConsole(bool printToConsole)
+{
+  _printToConsole = printToConsole;
+}
+
+double BlockCGSolver::getTolerance()
+{
+  return _tol;
+}
+
+void BlockCGSolver::setTolerance(double tol)
+{
+  _tol = tol;
+}
+
+int BlockCGSolver::solve()
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(_stiffnessMatrix.get() == NULL, std::invalid_argument, "stiffness matrix is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_lhs.get() == NULL, std::invalid_argument, "lhs is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_rhs.get() == NULL, std::invalid_argument, "rhs is unset.");
+
+  using namespace Teuchos;
+  typedef Epetra_MultiVector MV;
+  typedef Epetra_Operator OP;
+  typedef Belos::LinearProblem<double, MV, OP> BelosProblem;
+
+  RCP<BelosProblem> problem = rcp( new BelosProblem(_stiffnessMatrix, _lhs, _rhs) );
+  if (_preconditioner != Teuchos::null)
+  {
+    // EpetraPrecOp applies the preconditioner via ApplyInverse()
+    problem->setLeftPrec(rcp( new Belos::EpetraPrecOp(_preconditioner) ));
+  }
+  problem->setProblem();
+
+  RCP<ParameterList> solverParams = parameterList();
+  solverParams->set("Block Size", _rhs->NumVectors());
+  solverParams->set("Maximum Iterations", _maxIters);
+  solverParams->set("Convergence Tolerance", _tol);
+  if (_printToConsole)
+  {
+    solverParams->set("Verbosity", Belos::Errors + Belos::Warnings + Belos::FinalSummary);
+  }
+
+  Belos::BlockCGSolMgr<double, MV, OP> solver(problem, solverParams);
+  Belos::ReturnType belosResult = solver.solve();
+  _iterationCount = solver.getNumIters();
+
+  return (belosResult == Belos::Converged) ? 0 : 1;
+}
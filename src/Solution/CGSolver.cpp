@@ -23,6 +23,11 @@ void CGSolver::setPrintToConsole(bool printToConsole)
   _printToConsole = printToConsole;
 }
 
+double CGSolver::getTolerance()
+{
+  return _tol;
+}
+
 void CGSolver::setTolerance(double tol)
 {
   _tol = tol;
@@ -44,6 +49,9 @@ int CGSolver::solve()
 //    cout << "Condition number estimate: " << condest << endl;
 //  }
 
+  // AztecOO solves for a single vector
+  TEUCHOS_TEST_FOR_EXCEPTION(_rhs->NumVectors() > 1, std::invalid_argument, "CGSolver does not support multiple right-hand sides; use BlockCGSolver");
+
   Epetra_LinearProblem problem(_stiffnessMatrix.get(), _lhs.get(), _rhs.get());
   AztecOO solver(problem);
 
@@ -0,0 +1,347 @@
+//
+//  CellBlockSmoother.cpp
+//  Camellia
+//
+
+#include "CellBlockSmoother.h"
+
+#include "Teuchos_LAPACK.hpp"
+
+using namespace Camellia;
+using namespace std;
+
+CellBlockSmoother::CellBlockSmoother(Epetra_CrsMatrix* matrix, MeshPtr mesh, Teuchos::RCP<DofInterpreter> dofInterpreter,
+                                     RelaxationType relaxationType)
+{
+  _matrix = matrix;
+  _mesh = mesh;
+  _dofInterpreter = dofInterpreter;
+  _relaxationType = relaxationType;
+  _maxBlockSize = 0;
+  _useSinglePrecision = false;
+  determineBlocks();
+}
+
+void CellBlockSmoother::determineBlocks()
+{
+  const Epetra_Map* rowMap = &_matrix->RowMap();
+  int numMyRows = rowMap->NumMyElements();
+
+  _blockForRowLID.assign(numMyRows, -1);
+  _blockOffsets.assign(1, 0);
+  _blockRowLIDs.clear();
+  _blockRowLIDs.reserve(numMyRows);
+
+  auto closeBlock = [this] () -> void
+  {
+    int blockSize = _blockRowLIDs.size() - _blockOffsets.back();
+    if (blockSize == 0) return;
+    _maxBlockSize = max(_maxBlockSize, blockSize);
+    _blockOffsets.push_back(_blockRowLIDs.size());
+  };
+
+  for (GlobalIndexType cellID : _mesh->cellIDsInPartition())
+  {
+    int blockOrdinal = _blockOffsets.size() - 1;
+    set<GlobalIndexType> globalDofIndices = _dofInterpreter->globalDofIndicesForCell(cellID);
+    for (GlobalIndexType globalDofIndex : globalDofIndices)
+    {
+      int LID = rowMap->LID((GlobalIndexTypeToCast)globalDofIndex);
+      if ((LID < 0) || (_blockForRowLID[LID] != -1)) continue; // not ours, or already claimed by an earlier cell
+      _blockForRowLID[LID] = blockOrdinal;
+      _blockRowLIDs.push_back(LID);
+    }
+    closeBlock();
+  }
+
+  // any rows not associated with a rank-local cell (e.g., Lagrange constraints) are treated pointwise
+  for (int LID=0; LID<numMyRows; LID++)
+  {
+    if (_blockForRowLID[LID] != -1) continue;
+    _blockForRowLID[LID] = _blockOffsets.size() - 1;
+    _blockRowLIDs.push_back(LID);
+    closeBlock();
+  }
+
+  const Epetra_Map* colMap = &_matrix->ColMap();
+  int numMyCols = colMap->NumMyElements();
+  _rowLIDForColLID.resize(numMyCols);
+  for (int colLID=0; colLID<numMyCols; colLID++)
+  {
+    _rowLIDForColLID[colLID] = rowMap->LID(colMap->GID(colLID));
+  }
+}
+
+int CellBlockSmoother::Compute()
+{
+  int numBlocks = NumBlocks();
+  _factorOffsets.resize(numBlocks+1);
+  _factorOffsets[0] = 0;
+  for (int blockOrdinal=0; blockOrdinal<numBlocks; blockOrdinal++)
+  {
+    int blockSize = _blockOffsets[blockOrdinal+1] - _blockOffsets[blockOrdinal];
+    _factorOffsets[blockOrdinal+1] = _factorOffsets[blockOrdinal] + blockSize * blockSize;
+  }
+  _factors.resize(_factorOffsets[numBlocks]);
+  _pivots.resize(_blockRowLIDs.size());
+  _isCholesky.resize(numBlocks);
+
+  vector<int> positionInBlock(_blockForRowLID.size(), -1);
+
+  auto gatherBlock = [&] (int blockOrdinal) -> void
+  {
+    int offset = _blockOffsets[blockOrdinal];
+    int blockSize = _blockOffsets[blockOrdinal+1] - offset;
+    double* blockValues = &_factors[_factorOffsets[blockOrdinal]];
+    for (int i=0; i<blockSize*blockSize; i++) blockValues[i] = 0.0;
+
+    for (int i=0; i<blockSize; i++)
+    {
+      int numEntries;
+      double* values;
+      int* colIndices;
+      _matrix->ExtractMyRowView(_blockRowLIDs[offset+i], numEntries, values, colIndices);
+      for (int k=0; k<numEntries; k++)
+      {
+        int rowLID = _rowLIDForColLID[colIndices[k]];
+        if (rowLID < 0) continue;
+        int j = positionInBlock[rowLID];
+        if (j < 0) continue;
+        blockValues[i + j * blockSize] = values[k]; // column-major
+      }
+    }
+  };
+
+  Teuchos::LAPACK<int, double> lapack;
+  int err = 0;
+  for (int blockOrdinal=0; blockOrdinal<numBlocks; blockOrdinal++)
+  {
+    int offset = _blockOffsets[blockOrdinal];
+    int blockSize = _blockOffsets[blockOrdinal+1] - offset;
+    for (int i=0; i<blockSize; i++)
+    {
+      positionInBlock[_blockRowLIDs[offset+i]] = i;
+    }
+
+    gatherBlock(blockOrdinal);
+    double* blockValues = &_factors[_factorOffsets[blockOrdinal]];
+    int info;
+    lapack.POTRF('L', blockSize, blockValues, blockSize, &info);
+    _isCholesky[blockOrdinal] = (info == 0);
+    if (info != 0)
+    {
+      // block is not positive definite; fall back on LU
+      gatherBlock(blockOrdinal);
+      lapack.GETRF(blockSize, blockSize, blockValues, blockSize, &_pivots[offset], &info);
+      if (info != 0) err = -1; // singular block
+    }
+
+    for (int i=0; i<blockSize; i++)
+    {
+      positionInBlock[_blockRowLIDs[offset+i]] = -1;
+    }
+  }
+  if (err != 0)
+  {
+    cout << "WARNING: CellBlockSmoother encountered a singular diagonal block.\n";
+  }
+  if (_useSinglePrecision)
+  {
+    // factors were computed in double precision; keep only their single-precision rounding
+    _factorsSingle.assign(_factors.begin(), _factors.end());
+    vector<double>().swap(_factors);
+  }
+  else
+  {
+    vector<float>().swap(_factorsSingle);
+  }
+  return err;
+}
+
+void CellBlockSmoother::solveBlock(int blockOrdinal, double* values, int numVectors, float* singleWork) const
+{
+  int offset = _blockOffsets[blockOrdinal];
+  int blockSize = _blockOffsets[blockOrdinal+1] - offset;
+  int info;
+  if (_useSinglePrecision)
+  {
+    Teuchos::LAPACK<int, float> lapack;
+    const float* factor = &_factorsSingle[_factorOffsets[blockOrdinal]];
+    int valueCount = blockSize * numVectors;
+    for (int i=0; i<valueCount; i++) singleWork[i] = (float)values[i];
+    if (_isCholesky[blockOrdinal])
+    {
+      lapack.POTRS('L', blockSize, numVectors, factor, blockSize, singleWork, blockSize, &info);
+    }
+    else
+    {
+      lapack.GETRS('N', blockSize, numVectors, factor, blockSize, &_pivots[offset], singleWork, blockSize, &info);
+    }
+    for (int i=0; i<valueCount; i++) values[i] = singleWork[i];
+    return;
+  }
+  Teuchos::LAPACK<int, double> lapack;
+  const double* factor = &_factors[_factorOffsets[blockOrdinal]];
+  if (_isCholesky[blockOrdinal])
+  {
+    lapack.POTRS('L', blockSize, numVectors, factor, blockSize, values, blockSize, &info);
+  }
+  else
+  {
+    lapack.GETRS('N', blockSize, numVectors, factor, blockSize, &_pivots[offset], values, blockSize, &info);
+  }
+}
+
+int CellBlockSmoother::NumBlocks() const
+{
+  return _blockOffsets.size() - 1;
+}
+
+long long CellBlockSmoother::factorStorageBytes() const
+{
+  return _factors.size() * sizeof(double) + _factorsSingle.size() * sizeof(float);
+}
+
+void CellBlockSmoother::setUseSinglePrecision(bool value)
+{
+  _useSinglePrecision = value;
+}
+
+int CellBlockSmoother::ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  int numVectors = X.NumVectors();
+  if (Y.NumVectors() != numVectors) return -1;
+  TEUCHOS_TEST_FOR_EXCEPTION(_factorOffsets.size() != _blockOffsets.size(), std::invalid_argument, "Compute() must be called before ApplyInverse()");
+
+  int numBlocks = NumBlocks();
+  vector<double> work(_maxBlockSize * numVectors);
+  vector<float> singleWork(_useSinglePrecision ? _maxBlockSize * numVectors : 0);
+
+  if (_relaxationType == BLOCK_JACOBI)
+  {
+    // blocks are disjoint, and each block reads its X entries before writing its Y entries, so X and Y may alias
+    double** xValues = X.Pointers();
+    double** yValues = Y.Pointers();
+    for (int blockOrdinal=0; blockOrdinal<numBlocks; blockOrdinal++)
+    {
+      int offset = _blockOffsets[blockOrdinal];
+      int blockSize = _blockOffsets[blockOrdinal+1] - offset;
+      const int* rowLIDs = &_blockRowLIDs[offset];
+      for (int v=0; v<numVectors; v++)
+      {
+        for (int i=0; i<blockSize; i++)
+        {
+          work[i + v * blockSize] = xValues[v][rowLIDs[i]];
+        }
+      }
+      solveBlock(blockOrdinal, &work[0], numVectors, singleWork.data());
+      for (int v=0; v<numVectors; v++)
+      {
+        for (int i=0; i<blockSize; i++)
+        {
+          yValues[v][rowLIDs[i]] = work[i + v * blockSize];
+        }
+      }
+    }
+    return 0;
+  }
+
+  // symmetric Gauss-Seidel: Y is updated in place, so we need our own copy of X if they alias
+  Teuchos::RCP<Epetra_MultiVector> Xcopy;
+  double** xValues = X.Pointers();
+  if (X.Values() == Y.Values())
+  {
+    Xcopy = Teuchos::rcp( new Epetra_MultiVector(X) );
+    xValues = Xcopy->Pointers();
+  }
+  Y.PutScalar(0.0);
+  double** yValues = Y.Pointers();
+
+  auto relaxBlock = [&] (int blockOrdinal) -> void
+  {
+    int offset = _blockOffsets[blockOrdinal];
+    int blockSize = _blockOffsets[blockOrdinal+1] - offset;
+    const int* rowLIDs = &_blockRowLIDs[offset];
+    for (int i=0; i<blockSize; i++)
+    {
+      int numEntries;
+      double* values;
+      int* colIndices;
+      _matrix->ExtractMyRowView(rowLIDs[i], numEntries, values, colIndices);
+      for (int v=0; v<numVectors; v++)
+      {
+        double residual = xValues[v][rowLIDs[i]];
+        for (int k=0; k<numEntries; k++)
+        {
+          int rowLID = _rowLIDForColLID[colIndices[k]];
+          if ((rowLID < 0) || (_blockForRowLID[rowLID] == blockOrdinal)) continue;
+          residual -= values[k] * yValues[v][rowLID];
+        }
+        work[i + v * blockSize] = residual;
+      }
+    }
+    solveBlock(blockOrdinal, &work[0], numVectors, singleWork.data());
+    for (int v=0; v<numVectors; v++)
+    {
+      for (int i=0; i<blockSize; i++)
+      {
+        yValues[v][rowLIDs[i]] = work[i + v * blockSize];
+      }
+    }
+  };
+
+  for (int blockOrdinal=0; blockOrdinal<numBlocks; blockOrdinal++)
+  {
+    relaxBlock(blockOrdinal);
+  }
+  for (int blockOrdinal=numBlocks-1; blockOrdinal>=0; blockOrdinal--)
+  {
+    relaxBlock(blockOrdinal);
+  }
+  return 0;
+}
+
+int CellBlockSmoother::SetUseTranspose(bool UseTranspose)
+{
+  return -1; // not supported
+}
+
+int CellBlockSmoother::Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  return -1; // not supported
+}
+
+double CellBlockSmoother::NormInf() const
+{
+  return 0.0;
+}
+
+const char * CellBlockSmoother::Label() const
+{
+  return "Camellia cell block smoother";
+}
+
+bool CellBlockSmoother::UseTranspose() const
+{
+  return false;
+}
+
+bool CellBlockSmoother::HasNormInf() const
+{
+  return false;
+}
+
+const Epetra_Comm & CellBlockSmoother::Comm() const
+{
+  return _matrix->Comm();
+}
+
+const Epetra_Map & CellBlockSmoother::OperatorDomainMap() const
+{
+  return _matrix->OperatorDomainMap();
+}
+
+const Epetra_Map & CellBlockSmoother::OperatorRangeMap() const
+{
+  return _matrix->OperatorRangeMap();
+}
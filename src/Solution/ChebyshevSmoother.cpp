@@ -0,0 +1,153 @@
+//
+//  ChebyshevSmoother.cpp
+//  Camellia
+//
+
+#include "ChebyshevSmoother.h"
+
+#include "Epetra_MultiVector.h"
+
+using namespace Camellia;
+using namespace std;
+
+ChebyshevSmoother::ChebyshevSmoother(Epetra_CrsMatrix* matrix, Teuchos::RCP<Epetra_Operator> diagonalInverse, int degree,
+                                     double eigenvalueRatio, double maxEigenvalue)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(degree < 1, std::invalid_argument, "Chebyshev degree must be at least 1");
+  TEUCHOS_TEST_FOR_EXCEPTION(eigenvalueRatio <= 1.0, std::invalid_argument, "eigenvalueRatio must be greater than 1");
+  _matrix = matrix;
+  _diagonalInverse = diagonalInverse;
+  _degree = degree;
+  _eigenvalueRatio = eigenvalueRatio;
+  _maxEigenvalue = maxEigenvalue;
+  _powerIterations = 10;
+}
+
+int ChebyshevSmoother::Compute()
+{
+  if (_maxEigenvalue <= 0.0)
+  {
+    _maxEigenvalue = estimateMaxEigenvalue(_powerIterations);
+  }
+  return (_maxEigenvalue > 0.0) ? 0 : -1;
+}
+
+double ChebyshevSmoother::estimateMaxEigenvalue(int numIterations)
+{
+  Epetra_MultiVector x(_matrix->RowMap(), 1), Ax(_matrix->RowMap(), 1), DinvAx(_matrix->RowMap(), 1);
+  x.Random();
+  double norm;
+  x.Norm2(&norm);
+  x.Scale(1.0 / norm);
+
+  double lambda = 0.0;
+  for (int i=0; i<numIterations; i++)
+  {
+    _matrix->Apply(x, Ax);
+    _diagonalInverse->ApplyInverse(Ax, DinvAx);
+    DinvAx.Norm2(&norm);
+    if (norm == 0.0) break;
+    lambda = norm; // x has unit norm
+    x.Scale(1.0 / norm, DinvAx);
+  }
+  return 1.1 * lambda; // power iteration underestimates; overestimating is much less harmful than underestimating
+}
+
+double ChebyshevSmoother::maxEigenvalue() const
+{
+  return _maxEigenvalue;
+}
+
+Teuchos::RCP<Epetra_Operator> ChebyshevSmoother::getDiagonalInverse() const
+{
+  return _diagonalInverse;
+}
+
+void ChebyshevSmoother::setPowerIterations(int numIterations)
+{
+  _powerIterations = numIterations;
+}
+
+int ChebyshevSmoother::ApplyInverse(const Epetra_MultiVector& B, Epetra_MultiVector& X) const
+{
+  // Chebyshev iteration with zero initial guess (Saad, Iterative Methods for Sparse Linear Systems, Algorithm 12.1)
+  TEUCHOS_TEST_FOR_EXCEPTION(_maxEigenvalue <= 0.0, std::invalid_argument, "Compute() must be called before ApplyInverse()");
+  int numVectors = B.NumVectors();
+  if (X.NumVectors() != numVectors) return -1;
+
+  double lambdaMax = _maxEigenvalue;
+  double lambdaMin = _maxEigenvalue / _eigenvalueRatio;
+  double theta = (lambdaMax + lambdaMin) / 2.0;
+  double delta = (lambdaMax - lambdaMin) / 2.0;
+  double sigma = theta / delta;
+  double rho = 1.0 / sigma;
+
+  Epetra_MultiVector r(B); // copy, so that B and X may alias
+  Epetra_MultiVector z(B.Map(), numVectors), d(B.Map(), numVectors), Ad(B.Map(), numVectors);
+
+  int err = _diagonalInverse->ApplyInverse(r, z);
+  if (err != 0) return err;
+  d.Scale(1.0 / theta, z);
+  X.PutScalar(0.0);
+
+  for (int k=1; k<=_degree; k++)
+  {
+    X.Update(1.0, d, 1.0);
+    if (k == _degree) break;
+
+    _matrix->Apply(d, Ad);
+    r.Update(-1.0, Ad, 1.0);
+    err = _diagonalInverse->ApplyInverse(r, z);
+    if (err != 0) return err;
+
+    double rhoNew = 1.0 / (2.0 * sigma - rho);
+    d.Update(2.0 * rhoNew / delta, z, rhoNew * rho);
+    rho = rhoNew;
+  }
+  return 0;
+}
+
+int ChebyshevSmoother::SetUseTranspose(bool UseTranspose)
+{
+  return -1; // not supported
+}
+
+int ChebyshevSmoother::Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  return -1; // not supported
+}
+
+double ChebyshevSmoother::NormInf() const
+{
+  return 0.0;
+}
+
+const char * ChebyshevSmoother::Label() const
+{
+  return "Camellia Chebyshev smoother";
+}
+
+bool ChebyshevSmoother::UseTranspose() const
+{
+  return false;
+}
+
+bool ChebyshevSmoother::HasNormInf() const
+{
+  return false;
+}
+
+const Epetra_Comm & ChebyshevSmoother::Comm() const
+{
+  return _matrix->Comm();
+}
+
+const Epetra_Map & ChebyshevSmoother::OperatorDomainMap() const
+{
+  return _matrix->OperatorDomainMap();
+}
+
+const Epetra_Map & ChebyshevSmoother::OperatorRangeMap() const
+{
+  return _matrix->OperatorRangeMap();
+}
@@ -571,12 +571,12 @@ void CondensedDofInterpreter<Scalar>::initializeGlobalDofIndices()
   _interpretedFluxDofIndices.clear();
   _interpretedToGlobalDofIndexMap.clear();
 
-  PartitionIndexType rank = Teuchos::GlobalMPISession::getRank();
+  PartitionIndexType rank = _mesh->Comm()->MyPID();
   set<GlobalIndexType> cellsForFluxStorage = _mesh->globalDofAssignment()->cellsInPartition(rank);
   cellsForFluxStorage.insert(_offRankCellsToInclude.begin(),_offRankCellsToInclude.end());
   map<GlobalIndexType, IndexType> partitionLocalFluxMap = interpretedFluxMapForPartition(rank, cellsForFluxStorage);
 
-  int numRanks = Teuchos::GlobalMPISession::getNProc();
+  int numRanks = _mesh->Comm()->NumProc();
   FieldContainer<GlobalIndexTypeToCast> fluxDofCountForRank(numRanks);
 
   _myGlobalDofIndexCount = partitionLocalFluxMap.size();
@@ -671,9 +671,9 @@ set<GlobalIndexType> CondensedDofInterpreter<Scalar>::globalDofIndicesForPartiti
   if (rank == -1)
   {
     // default to current partition, just as Mesh does.
-    rank = Teuchos::GlobalMPISession::getRank();
+    rank = _mesh->Comm()->MyPID();
   }
-  if (rank == Teuchos::GlobalMPISession::getRank())
+  if (rank == _mesh->Comm()->MyPID())
   {
     set<GlobalIndexType> myGlobalDofIndices;
     GlobalIndexType nextOffset = _myGlobalDofIndexOffset + _myGlobalDofIndexCount;
@@ -695,7 +695,7 @@ void CondensedDofInterpreter<Scalar>::interpretLocalBasisCoefficients(GlobalInde
     FieldContainer<Scalar> &globalCoefficients, FieldContainer<GlobalIndexType> &globalDofIndices)
 {
   // NOTE: cellID MUST belong to this partition, or have been included in "offRankCellsToInclude" constructor argument
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
   if ((_offRankCellsToInclude.find(cellID) == _offRankCellsToInclude.end()) && (_mesh->partitionForCellID(cellID) != rank))
   {
     cout << "cellID " << cellID << " does not belong to partition " << rank;
@@ -793,7 +793,7 @@ void CondensedDofInterpreter<Scalar>::interpretLocalData(GlobalIndexType cellID,
     FieldContainer<GlobalIndexType> &globalDofIndices)
 {
   // NOTE: cellID MUST belong to this partition, or have been included in "offRankCellsToInclude" constructor argument
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
   if ((_offRankCellsToInclude.find(cellID) == _offRankCellsToInclude.end()) && (_mesh->partitionForCellID(cellID) != rank))
   {
     cout << "cellID " << cellID << " does not belong to partition " << rank;
@@ -14,6 +14,8 @@
 #include "GlobalDofAssignment.h"
 #include "BasisSumFunction.h"
 #include "CamelliaCellTools.h"
+#include "CellBlockSmoother.h"
+#include "ChebyshevSmoother.h"
 #include "CondensedDofInterpreter.h"
 #include "CubatureFactory.h"
 #include "GDAMinimumRule.h"
@@ -161,6 +163,12 @@ void GMGOperator::computeCoarseStiffnessMatrix(Epetra_CrsMatrix *fineStiffnessMa
 {
   narrate("computeCoarseStiffnessMatrix");
   int globalColCount = fineStiffnessMatrix->NumGlobalCols();
+  if ((_P.get() == NULL) && (_P_single != Teuchos::null))
+  {
+    // the double-precision operator was released after its single-precision copy was made (see setUpSinglePrecisionOperators());
+    // the Galerkin product then uses the rounded entries, which are the ones the grid transfers apply
+    _P = _P_single->toDoublePrecision();
+  }
   if (_P.get() == NULL)
   {
     constructProlongationOperator();
@@ -354,7 +362,8 @@ void GMGOperator::computeCoarseStiffnessMatrix(Epetra_CrsMatrix *fineStiffnessMa
 void GMGOperator::computeResidual(const Epetra_MultiVector& Y, Epetra_MultiVector& res, Epetra_MultiVector& A_Y) const
 {
   Epetra_Time timer(Comm());
-  int err = _fineStiffnessMatrix->Apply(Y, A_Y);
+  int err;
+  err = _fineStiffnessMatrix->Apply(Y, A_Y);
   if (err != 0)
   {
     cout << "_fineStiffnessMatrix->Apply returned non-zero error code " << err << endl;
@@ -785,6 +794,7 @@ Teuchos::RCP<Epetra_CrsMatrix> GMGOperator::constructProlongationOperator()
                                              _finePartitionMap, coarseMap, _fineMesh, _coarseMesh);
   }
 
+  _P_single = Teuchos::null; // stale; rebuilt by setUpSinglePrecisionOperators()
   _timeProlongationOperatorConstruction = prolongationTimer.ElapsedTime();
   
   ostringstream prolongationTimingReport;
@@ -922,6 +932,32 @@ GlobalIndexType GMGOperator::getCoarseCellID(GlobalIndexType fineCellID) const
   return ancestor->cellIndex();
 }
 
+double GMGOperator::getChebyshevMaxEigenvalue() const
+{
+  return _chebyshevMaxEigenvalue;
+}
+
+bool GMGOperator::getUseSinglePrecision() const
+{
+  return _useSinglePrecision;
+}
+
+long long GMGOperator::getStorageBytes() const
+{
+  long long bytes = 0;
+  if (_P != Teuchos::null)
+    bytes += (long long) _P->NumMyNonzeros() * (sizeof(double) + sizeof(int));
+  if (_P_single != Teuchos::null)
+    bytes += (long long) _P_single->NumMyNonzeros() * (sizeof(float) + sizeof(int));
+
+  Teuchos::RCP<Epetra_Operator> smoother = _smoother;
+  ChebyshevSmoother* chebyshevSmoother = dynamic_cast<ChebyshevSmoother*>(smoother.get());
+  if (chebyshevSmoother != NULL) smoother = chebyshevSmoother->getDiagonalInverse();
+  CellBlockSmoother* cellBlockSmoother = dynamic_cast<CellBlockSmoother*>(smoother.get());
+  if (cellBlockSmoother != NULL) bytes += cellBlockSmoother->factorStorageBytes();
+  return bytes;
+}
+
 Teuchos::RCP<GMGOperator> GMGOperator::getCoarseOperator()
 {
   return _coarseOperator;
@@ -1736,7 +1772,10 @@ int GMGOperator::ApplyInverseCoarseOperator(const Epetra_MultiVector &res, Epetr
     cout << res;
     res.Comm().Barrier();
   }
-  _P->Multiply(!_fineCoarseRolesSwapped, res, *coarseRHSVector);
+  if (_P_single != Teuchos::null)
+    _P_single->Multiply(!_fineCoarseRolesSwapped, res, *coarseRHSVector);
+  else
+    _P->Multiply(!_fineCoarseRolesSwapped, res, *coarseRHSVector);
   if (printVerboseOutput) cout << "finished _P->Multiply(!_fineCoarseRolesSwapped, X, *coarseRHSVector);\n";
   if (_debugMode)
   {
@@ -1792,7 +1831,10 @@ int GMGOperator::ApplyInverseCoarseOperator(const Epetra_MultiVector &res, Epetr
   if (printVerboseOutput) cout << "calling _P->Multiply(_fineCoarseRolesSwapped, *coarseLHSVector, Y)\n";
   narrate("multiply _P * coarseLHSVector");
 
-  _P->Multiply(_fineCoarseRolesSwapped, *coarseLHSVector, Y);
+  if (_P_single != Teuchos::null)
+    _P_single->Multiply(_fineCoarseRolesSwapped, *coarseLHSVector, Y);
+  else
+    _P->Multiply(_fineCoarseRolesSwapped, *coarseLHSVector, Y);
   if (printVerboseOutput) cout << "finished _P->Multiply(_fineCoarseRolesSwapped, *coarseLHSVector, Y)\n";
   _timeMapCoarseToFine += timer.ElapsedTime();
   
@@ -1907,11 +1949,15 @@ const Epetra_Map & GMGOperator::OperatorRangeMap() const
 
 int GMGOperator::prolongationColCount() const
 {
+  if (_P == Teuchos::null)
+    return _fineCoarseRolesSwapped ? _P_single->RangeMap().NumGlobalElements() : _P_single->DomainMap().NumGlobalElements();
   return _fineCoarseRolesSwapped ? _P->NumGlobalRows() : _P->NumGlobalCols();
 }
 
 int GMGOperator::prolongationRowCount() const
 {
+  if (_P == Teuchos::null)
+    return _fineCoarseRolesSwapped ? _P_single->DomainMap().NumGlobalElements() : _P_single->RangeMap().NumGlobalElements();
   return _fineCoarseRolesSwapped ? _P->NumGlobalCols() : _P->NumGlobalRows();
 }
 
@@ -1932,6 +1978,13 @@ TimeStatistics GMGOperator::getStatistics(double timeValue) const
   return stats;
 }
 
+void GMGOperator::refreshSmoother(Epetra_CrsMatrix *fineStiffness)
+{
+  _fineStiffnessMatrix = fineStiffness;
+  setUpSmoother(fineStiffness);
+  setUpSinglePrecisionOperators();
+}
+
 void GMGOperator::reportTimings(StatisticChoice whichStat) const
 {
   reportTimings(whichStat,false);
@@ -2060,6 +2113,18 @@ void GMGOperator::setCoarseSolver(SolverPtr coarseSolver)
   _coarseSolver = coarseSolver;
 }
 
+void GMGOperator::setChebyshevDegree(int degree)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(degree < 1, std::invalid_argument, "Chebyshev degree must be at least 1");
+  _chebyshevDegree = degree;
+}
+
+void GMGOperator::setChebyshevEigenvalueRatio(double ratio)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(ratio <= 1.0, std::invalid_argument, "Chebyshev eigenvalue ratio must be greater than 1");
+  _chebyshevEigenvalueRatio = ratio;
+}
+
 void GMGOperator::setDebugMode(bool value)
 {
   _debugMode = value;
@@ -2081,14 +2146,17 @@ void GMGOperator::setFineCoarseRolesSwapped(bool value)
     _fineCoarseRolesSwapped = value;
     // force reconstruction of _P, if it has already been computed:
     _P = Teuchos::null;
+    _P_single = Teuchos::null;
   }
 }
 
 void GMGOperator::setFineStiffnessMatrix(Epetra_CrsMatrix *fineStiffness)
 {
   _fineStiffnessMatrix = fineStiffness;
+  _chebyshevMaxEigenvalue = -1.0; // new matrix: spectral estimate must be recomputed
   computeCoarseStiffnessMatrix(fineStiffness);
   setUpSmoother(fineStiffness);
+  setUpSinglePrecisionOperators();
   
   if (_coarseOperator != Teuchos::null)
   {
@@ -2192,6 +2260,46 @@ void GMGOperator::setUpSmoother(Epetra_CrsMatrix *fineStiffnessMatrix)
   case NONE:
     _smoother = Teuchos::null;
     return;
+  case CAMELLIA_BLOCK_JACOBI:
+  case CAMELLIA_BLOCK_SYMMETRIC_GAUSS_SEIDEL:
+  {
+    // native smoother: gathers, factors, and applies the cell diagonal blocks without going through Ifpack
+    CellBlockSmoother::RelaxationType relaxationType = (choice == CAMELLIA_BLOCK_JACOBI) ? CellBlockSmoother::BLOCK_JACOBI
+                                                                                         : CellBlockSmoother::BLOCK_SYMMETRIC_GAUSS_SEIDEL;
+    Teuchos::RCP<CellBlockSmoother> cellBlockSmoother = Teuchos::rcp( new CellBlockSmoother(fineStiffnessMatrix, _fineMesh, _fineDofInterpreter,
+                                                                                             relaxationType) );
+    cellBlockSmoother->setUseSinglePrecision(_useSinglePrecision);
+    int err = cellBlockSmoother->Compute();
+    if (err != 0)
+    {
+      cout << "WARNING: In GMGOperator, CellBlockSmoother::Compute() returned with err " << err << endl;
+    }
+    _smoother = cellBlockSmoother;
+    _timeSetUpSmoother = smootherSetupTimer.ElapsedTime();
+    return;
+  }
+  case CHEBYSHEV:
+  {
+    Teuchos::RCP<CellBlockSmoother> blockJacobi = Teuchos::rcp( new CellBlockSmoother(fineStiffnessMatrix, _fineMesh, _fineDofInterpreter,
+                                                                                       CellBlockSmoother::BLOCK_JACOBI) );
+    blockJacobi->setUseSinglePrecision(_useSinglePrecision);
+    int err = blockJacobi->Compute();
+    if (err != 0)
+    {
+      cout << "WARNING: In GMGOperator, CellBlockSmoother::Compute() returned with err " << err << endl;
+    }
+    Teuchos::RCP<ChebyshevSmoother> chebyshevSmoother = Teuchos::rcp( new ChebyshevSmoother(fineStiffnessMatrix, blockJacobi, _chebyshevDegree,
+                                                                                             _chebyshevEigenvalueRatio, _chebyshevMaxEigenvalue) );
+    err = chebyshevSmoother->Compute();
+    if (err != 0)
+    {
+      cout << "WARNING: In GMGOperator, ChebyshevSmoother::Compute() returned with err " << err << endl;
+    }
+    _chebyshevMaxEigenvalue = chebyshevSmoother->maxEigenvalue();
+    _smoother = chebyshevSmoother;
+    _timeSetUpSmoother = smootherSetupTimer.ElapsedTime();
+    return;
+  }
   case POINT_JACOBI:
   {
     List.set("relaxation: type", "Jacobi");
@@ -2448,6 +2556,33 @@ void GMGOperator::setUpSmoother(Epetra_CrsMatrix *fineStiffnessMatrix)
   _timeSetUpSmoother = smootherSetupTimer.ElapsedTime();
 }
 
+void GMGOperator::setUpSinglePrecisionOperators()
+{
+  if (!_useSinglePrecision)
+  {
+    _P_single = Teuchos::null;
+    return;
+  }
+  // _P_single is nulled whenever _P is reconstructed, so refreshSmoother() (which does not touch _P) keeps the existing copy
+  if ((_P_single == Teuchos::null) && (_P != Teuchos::null)) _P_single = Teuchos::rcp( new SinglePrecisionCrsMatrix(*_P) );
+  if ((_P_single != Teuchos::null) && !_keepDoublePrecisionProlongation) _P = Teuchos::null;
+}
+
+void GMGOperator::setKeepDoublePrecisionProlongation(bool value)
+{
+  _keepDoublePrecisionProlongation = value;
+}
+
+void GMGOperator::setUseSinglePrecision(bool value)
+{
+  _useSinglePrecision = value;
+  if (!_useSinglePrecision && (_P == Teuchos::null))
+  {
+    // the double-precision operator was released; rather than promote the rounded copy, reconstruct it on the next setup
+    _P_single = Teuchos::null;
+  }
+}
+
 void GMGOperator::setUseSchwarzDiagonalWeight(bool value)
 {
   _useSchwarzDiagonalWeight = value;
@@ -2466,6 +2601,12 @@ std::string GMGOperator::smootherString(SmootherChoice choice)
       return "Ifpack additive Schwarz";
     case CAMELLIA_ADDITIVE_SCHWARZ:
       return "Camellia additive Schwarz";
+    case CAMELLIA_BLOCK_JACOBI:
+      return "Camellia block Jacobi";
+    case CAMELLIA_BLOCK_SYMMETRIC_GAUSS_SEIDEL:
+      return "Camellia block symmetric Gauss-Seidel";
+    case CHEBYSHEV:
+      return "Chebyshev";
     case NONE:
       return "None";
     case BLOCK_JACOBI:
@@ -2491,6 +2632,7 @@ void GMGOperator::setUseHierarchicalNeighborsForSchwarz(bool value)
 
 Teuchos::RCP<Epetra_CrsMatrix> GMGOperator::getProlongationOperator()
 {
+  if ((_P == Teuchos::null) && (_P_single != Teuchos::null)) return _P_single->toDoublePrecision();
   return _P;
 }
 
@@ -9,6 +9,7 @@
 #include "GDAMinimumRule.h"
 #include "GMGSolver.h"
 #include "MPIWrapper.h"
+#include "PipelinedCGSolver.h"
 
 #include "AztecOO.h"
 #include <BelosEpetraAdapter.hpp>
@@ -367,6 +368,11 @@ void GMGSolver::setPrintToConsole(bool printToConsole)
   _printToConsole = printToConsole;
 }
 
+double GMGSolver::getTolerance()
+{
+  return _tol;
+}
+
 void GMGSolver::setTolerance(double tol)
 {
   _tol = tol;
@@ -388,11 +394,38 @@ int GMGSolver::solve(bool buildCoarseStiffness)
 {
   int rank = Teuchos::GlobalMPISession::getRank();
   
+  Epetra_Time solveTimer(_finePartitionMap.Comm());
+  _timeSetupLastSolve = 0;
+  
   bool useBelos = false; // new option, under development (otherwise, use Aztec)
   
   int solveResult;
   
-  if (useBelos)
+  if (_usePipelinedCG && _useCG)
+  {
+    if (buildCoarseStiffness)
+    {
+      updatePreconditioner(_stiffnessMatrix.get());
+    }
+    PipelinedCGSolver pipelinedCG(_maxIters, _tol, _gmgOperator);
+    pipelinedCG.setPrintToConsole(_azOutput > 0);
+    if (_azConvergenceOption == AZ_rhs)
+      pipelinedCG.setResidualScaling(PipelinedCGSolver::RHS_NORM);
+    else if (_azConvergenceOption == AZ_r0)
+      pipelinedCG.setResidualScaling(PipelinedCGSolver::INITIAL_RESIDUAL_NORM);
+    else if (_azConvergenceOption == AZ_noscaled)
+      pipelinedCG.setResidualScaling(PipelinedCGSolver::NO_SCALING);
+    else
+      TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "pipelined CG supports only the AZ_rhs, AZ_r0, and AZ_noscaled convergence options");
+    pipelinedCG.setProblem(_stiffnessMatrix, _lhs, _rhs);
+    solveResult = pipelinedCG.solve();
+    _iterationCount = pipelinedCG.iterationCount();
+    if ((solveResult == 1) && !_returnErrorIfMaxItersReached)
+    {
+      solveResult = 0;
+    }
+  }
+  else if (useBelos)
   {
     using namespace Teuchos;
     typedef Epetra_MultiVector MV;
@@ -407,7 +440,7 @@ int GMGSolver::solve(bool buildCoarseStiffness)
     
     if (buildCoarseStiffness)
     {
-      _gmgOperator->setFineStiffnessMatrix(_stiffnessMatrix.get());
+      updatePreconditioner(_stiffnessMatrix.get());
     }
     
     RCP<ParameterList> solverParams = parameterList();
@@ -494,6 +527,9 @@ int GMGSolver::solve(bool buildCoarseStiffness)
   }
   else
   {
+    // AztecOO solves for a single vector
+    TEUCHOS_TEST_FOR_EXCEPTION(_rhs->NumVectors() > 1, std::invalid_argument,
+                               "GMGSolver's AztecOO path does not support multiple right-hand sides; enable pipelined CG, or use BlockCGSolver with the GMGOperator as preconditioner");
     Epetra_LinearProblem problem(_stiffnessMatrix.get(), _lhs.get(), _rhs.get());
     AztecOO solver(problem);
 
@@ -517,7 +553,7 @@ int GMGSolver::solve(bool buildCoarseStiffness)
 
     if (buildCoarseStiffness)
     {
-      _gmgOperator->setFineStiffnessMatrix(A);
+      updatePreconditioner(A);
     }
 
     solver.SetAztecOption(AZ_scaling, AZ_none);
@@ -608,9 +644,63 @@ int GMGSolver::solve(bool buildCoarseStiffness)
   
   _iterationCountLog.push_back(_iterationCount);
 
+  if (buildCoarseStiffness && (_preconditionerReuse != REBUILD_EVERY_SOLVE))
+  {
+    if (_solvesSincePreconditionerBuild == 0)
+    {
+      _iterationCountAfterPreconditionerBuild = _iterationCount;
+    }
+    else if (_iterationCount > _rebuildIterationGrowthFactor * max(_iterationCountAfterPreconditionerBuild, 1))
+    {
+      // the lagged preconditioner has degraded; rebuild on next solve
+      _solvesSincePreconditionerBuild = -1;
+    }
+  }
+  
+  _timeSolveLastSolve = solveTimer.ElapsedTime() - _timeSetupLastSolve;
+  _timeSolve += _timeSolveLastSolve;
+
   return solveResult;
 }
 
+void GMGSolver::updatePreconditioner(Epetra_CrsMatrix *A)
+{
+  Epetra_Time setupTimer(_finePartitionMap.Comm());
+  
+  bool rebuild = (_preconditionerReuse == REBUILD_EVERY_SOLVE) || (_solvesSincePreconditionerBuild < 0)
+                 || (_solvesSincePreconditionerBuild >= _maxPreconditionerReuseCount);
+  if (rebuild)
+  {
+    _gmgOperator->setFineStiffnessMatrix(A);
+    _solvesSincePreconditionerBuild = 0;
+    _preconditionerBuildCount++;
+    _preconditionerStiffnessMatrix = _stiffnessMatrix;
+  }
+  else
+  {
+    if (_preconditionerReuse == REUSE_COARSE_HIERARCHY)
+    {
+      _gmgOperator->refreshSmoother(A);
+      _preconditionerStiffnessMatrix = _stiffnessMatrix;
+    }
+    // for REUSE_HIERARCHY, _preconditionerStiffnessMatrix keeps the matrix the finest smoother refers to alive
+    _solvesSincePreconditionerBuild++;
+  }
+  
+  _timeSetupLastSolve = setupTimer.ElapsedTime();
+  _timeSetup += _timeSetupLastSolve;
+}
+
+void GMGSolver::forcePreconditionerRebuild()
+{
+  _solvesSincePreconditionerBuild = -1;
+}
+
+int GMGSolver::getPreconditionerBuildCount() const
+{
+  return _preconditionerBuildCount;
+}
+
 void GMGSolver::setAztecConvergenceOption(int value)
 {
   _azConvergenceOption = value;
@@ -632,6 +722,15 @@ void GMGSolver::setExportFullOperatorsOnSolve(bool exportOnSolve, string path)
   _pathForExport = path;
 }
 
+void GMGSolver::setPreconditionerReuse(PreconditionerReuse choice, int maxReuseCount, double iterationGrowthFactor)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(maxReuseCount < 0, std::invalid_argument, "maxReuseCount must be non-negative");
+  TEUCHOS_TEST_FOR_EXCEPTION(iterationGrowthFactor < 1.0, std::invalid_argument, "iterationGrowthFactor must be at least 1");
+  _preconditionerReuse = choice;
+  _maxPreconditionerReuseCount = maxReuseCount;
+  _rebuildIterationGrowthFactor = iterationGrowthFactor;
+}
+
 void GMGSolver::setPrintIterationCount(bool value)
 {
   _printIterationCountIfNoAzOutput = value;
@@ -652,7 +751,33 @@ void GMGSolver::setSmootherType(GMGOperator::SmootherChoice smootherType)
   }
 }
 
+void GMGSolver::setUseSinglePrecision(bool value)
+{
+  Teuchos::RCP<GMGOperator> op = _gmgOperator;
+  while (op != Teuchos::null)
+  {
+    op->setUseSinglePrecision(value);
+    op = op->getCoarseOperator();
+  }
+  forcePreconditionerRebuild(); // the stored hierarchy was built with the old precision
+}
+
 void GMGSolver::setUseConjugateGradient(bool value)
 {
   _useCG = value;
 }
+
+void GMGSolver::setUsePipelinedConjugateGradient(bool value)
+{
+  _usePipelinedCG = value;
+}
+
+std::map<string, double> GMGSolver::timingReport() const
+{
+  map<string, double> reportValues;
+  reportValues["setup"] = _timeSetup;
+  reportValues["solve"] = _timeSolve;
+  reportValues["setup (last)"] = _timeSetupLastSolve;
+  reportValues["solve (last)"] = _timeSolveLastSolve;
+  return reportValues;
+}
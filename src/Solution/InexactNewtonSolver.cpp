@@ -0,0 +1,130 @@
+//
+//  InexactNewtonSolver.cpp
+//  Camellia
+//
+
+#include "InexactNewtonSolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Camellia;
+using namespace std;
+
+InexactNewtonSolver::InexactNewtonSolver(SolverPtr iterativeSolver, double minForcingTerm, double maxForcingTerm)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(iterativeSolver == Teuchos::null, std::invalid_argument, "iterativeSolver must not be null");
+  TEUCHOS_TEST_FOR_EXCEPTION((minForcingTerm <= 0) || (minForcingTerm > maxForcingTerm) || (maxForcingTerm >= 1.0),
+                             std::invalid_argument, "forcing terms must satisfy 0 < minForcingTerm <= maxForcingTerm < 1");
+  _solver = iterativeSolver;
+  _minForcingTerm = minForcingTerm;
+  _maxForcingTerm = maxForcingTerm;
+  _gamma = 0.9;
+  _alpha = 2.0;
+  _targetResidualNorm = 0.0;
+  _useForcingTerms = true;
+  _toleranceModified = false;
+  _originalTolerance = 0.0;
+  reset();
+}
+
+double InexactNewtonSolver::forcingTerm() const
+{
+  return _forcingTerm;
+}
+
+double InexactNewtonSolver::initialResidualNorm() const
+{
+  return _initialResidualNorm;
+}
+
+double InexactNewtonSolver::residualNorm() const
+{
+  return _residualNorm;
+}
+
+void InexactNewtonSolver::reset()
+{
+  _stepCount = 0;
+  _forcingTerm = _maxForcingTerm;
+  _residualNorm = -1;
+  _previousResidualNorm = -1;
+  _initialResidualNorm = -1;
+}
+
+void InexactNewtonSolver::restoreTolerance()
+{
+  if (!_toleranceModified) return;
+  _solver->setTolerance(_originalTolerance);
+  _toleranceModified = false;
+}
+
+void InexactNewtonSolver::setForcingParameters(double gamma, double alpha)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION((gamma <= 0) || (gamma > 1), std::invalid_argument, "gamma must be in (0,1]");
+  TEUCHOS_TEST_FOR_EXCEPTION((alpha <= 1) || (alpha > 2), std::invalid_argument, "alpha must be in (1,2]");
+  _gamma = gamma;
+  _alpha = alpha;
+}
+
+void InexactNewtonSolver::setTargetResidualNorm(double targetResidualNorm)
+{
+  _targetResidualNorm = targetResidualNorm;
+}
+
+void InexactNewtonSolver::setUseForcingTerms(bool value)
+{
+  _useForcingTerms = value;
+}
+
+int InexactNewtonSolver::solve()
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(_stiffnessMatrix.get() == NULL, std::invalid_argument, "stiffness matrix is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_lhs.get() == NULL, std::invalid_argument, "lhs is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_rhs.get() == NULL, std::invalid_argument, "rhs is unset.");
+
+  // the load vector of the Newton increment system is the discrete residual at the current iterate
+  vector<double> columnNorms(_rhs->NumVectors());
+  _rhs->Norm2(&columnNorms[0]);
+  _previousResidualNorm = _residualNorm;
+  _residualNorm = *max_element(columnNorms.begin(), columnNorms.end());
+  if (_stepCount == 0) _initialResidualNorm = _residualNorm;
+
+  updateForcingTerm();
+  _stepCount++;
+
+  _solver->setProblem(_stiffnessMatrix, _lhs, _rhs);
+  if (_useForcingTerms)
+  {
+    if (!_toleranceModified)
+    {
+      _originalTolerance = _solver->getTolerance();
+      _toleranceModified = true;
+    }
+    _solver->setTolerance(_forcingTerm);
+  }
+  return _solver->solve();
+}
+
+void InexactNewtonSolver::updateForcingTerm()
+{
+  if ((_stepCount == 0) || (_previousResidualNorm <= 0))
+  {
+    _forcingTerm = _maxForcingTerm;
+    return;
+  }
+  double previousForcingTerm = _forcingTerm;
+  double eta = _gamma * pow(_residualNorm / _previousResidualNorm, _alpha);
+
+  // safeguard: don't let eta drop abruptly if the previous forcing term was large
+  double safeguard = _gamma * pow(previousForcingTerm, _alpha);
+  if (safeguard > 0.1) eta = max(eta, safeguard);
+  eta = min(eta, _maxForcingTerm);
+
+  // don't solve far more accurately than is required to reach the target nonlinear residual
+  if ((_targetResidualNorm > 0) && (_residualNorm > 0))
+  {
+    eta = min(_maxForcingTerm, max(eta, 0.5 * _targetResidualNorm / _residualNorm));
+  }
+  _forcingTerm = max(eta, _minForcingTerm);
+}
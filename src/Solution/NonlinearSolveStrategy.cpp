@@ -17,6 +17,31 @@ NonlinearSolveStrategy::NonlinearSolveStrategy(TSolutionPtr<double> backgroundFl
   _stepSize = stepSize;
   _relativeEnergyTolerance = relativeEnergyTolerance;
   _usePicardIteration = false; // Newton-Raphson by default
+  _useInexactNewton = false;
+  _convergenceTest = ENERGY_ERROR_CHANGE;
+  _relativeResidualTolerance = 1e-8;
+  _maxIterations = -1;
+}
+
+void NonlinearSolveStrategy::setConvergenceTest(ConvergenceTest test, double relativeResidualTolerance)
+{
+  _convergenceTest = test;
+  _relativeResidualTolerance = relativeResidualTolerance;
+}
+
+void NonlinearSolveStrategy::setMaxIterations(int maxIterations)
+{
+  _maxIterations = maxIterations;
+}
+
+void NonlinearSolveStrategy::setSolver(SolverPtr solver)
+{
+  _solver = solver;
+}
+
+void NonlinearSolveStrategy::setUseInexactNewton(bool value)
+{
+  _useInexactNewton = value;
 }
 
 void NonlinearSolveStrategy::setUsePicardIteration(bool value)
@@ -26,40 +51,85 @@ void NonlinearSolveStrategy::setUsePicardIteration(bool value)
 
 void NonlinearSolveStrategy::solve(bool printToConsole)
 {
+  TEUCHOS_TEST_FOR_EXCEPTION(_useInexactNewton && (_solver == Teuchos::null), std::invalid_argument,
+                             "inexact Newton requires an iterative solver; call setSolver() first");
+
   Teuchos::RCP< Mesh > mesh = _solution->mesh();
 
   vector< Teuchos::RCP< Element > > activeElements = mesh->activeElements();
   vector< Teuchos::RCP< Element > >::iterator activeElemIt;
 
+  // the wrapper records the Newton load vector norm (our residual surrogate); it sets the forcing terms only for inexact Newton
+  Teuchos::RCP<InexactNewtonSolver> newtonSolver;
+  SolverPtr linearSolver = _solver;
+  if (_useInexactNewton || (_convergenceTest == RESIDUAL_NORM))
+  {
+    if (linearSolver == Teuchos::null) linearSolver = Solver::getDirectSolver();
+    newtonSolver = Teuchos::rcp( new InexactNewtonSolver(linearSolver) );
+    newtonSolver->setUseForcingTerms(_useInexactNewton);
+    linearSolver = newtonSolver;
+  }
+
   int i = 0;
   double prevError = 0.0;
   bool converged = false;
   while (!converged)   // while energy error has not stabilized
   {
+    if ((_maxIterations >= 0) && (i >= _maxIterations))
+    {
+      if (printToConsole) cout << "NonlinearSolveStrategy: reached max iterations (" << _maxIterations << ") without converging.\n";
+      break;
+    }
 
-    _solution->solve(false);
-
-    double totalErrorSquareRoot = _solution->energyErrorTotal();
-    double totalError = totalErrorSquareRoot * totalErrorSquareRoot; // NVR 9-17-14: this is the energy error squared.  Is that what we want??
+    if (linearSolver == Teuchos::null)
+      _solution->solve(false);
+    else
+      _solution->solve(linearSolver);
 
-    double relErrorDiff = abs(totalError-prevError)/max(totalError,prevError);
-    if (printToConsole)
+    if (_convergenceTest == ENERGY_ERROR_CHANGE)
     {
-      cout << "on iter = " << i  << ", relative change in energy error is " << relErrorDiff;
-      if (abs(relErrorDiff - 1.0) < 0.1)   // for large rel. error, print more detail...
+      double totalErrorSquareRoot = _solution->energyErrorTotal();
+      double totalError = totalErrorSquareRoot * totalErrorSquareRoot; // NVR 9-17-14: this is the energy error squared.  Is that what we want??
+
+      double relErrorDiff = abs(totalError-prevError)/max(totalError,prevError);
+      if (printToConsole)
       {
-        cout << "\t(totalError: " << totalError << "; prevError: " << prevError << ")";
+        cout << "on iter = " << i  << ", relative change in energy error is " << relErrorDiff;
+        if (abs(relErrorDiff - 1.0) < 0.1)   // for large rel. error, print more detail...
+        {
+          cout << "\t(totalError: " << totalError << "; prevError: " << prevError << ")";
+        }
+        cout << endl;
       }
-      cout << endl;
-    }
 
-    if (relErrorDiff < _relativeEnergyTolerance)
-    {
-      converged = true;
+      if (relErrorDiff < _relativeEnergyTolerance)
+      {
+        converged = true;
+      }
+      else
+      {
+        prevError = totalError; // reset previous error and continue
+      }
     }
     else
     {
-      prevError = totalError; // reset previous error and continue
+      // residual at the iterate the increment was computed from
+      double initialResidual = newtonSolver->initialResidualNorm();
+      double relativeResidual = (initialResidual > 0) ? newtonSolver->residualNorm() / initialResidual : 0.0;
+      if (printToConsole)
+      {
+        cout << "on iter = " << i << ", relative residual is " << relativeResidual;
+        if (_useInexactNewton) cout << "; linear tolerance " << newtonSolver->forcingTerm();
+        cout << endl;
+      }
+      if (i == 0)
+      {
+        newtonSolver->setTargetResidualNorm(_relativeResidualTolerance * initialResidual);
+      }
+      if (relativeResidual <= _relativeResidualTolerance)
+      {
+        converged = true; // the iterate is converged; we still accumulate the (small) increment below
+      }
     }
 
     if ( ! _usePicardIteration )
@@ -75,4 +145,5 @@ void NonlinearSolveStrategy::solve(bool printToConsole)
     i++;
   }
 
+  if (newtonSolver != Teuchos::null) newtonSolver->restoreTolerance();
 }
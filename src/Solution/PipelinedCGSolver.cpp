@@ -0,0 +1,254 @@
+//
+//  PipelinedCGSolver.cpp
+//  Camellia
+//
+
+#include "PipelinedCGSolver.h"
+
+#ifdef HAVE_MPI
+#include "Epetra_MpiComm.h"
+#endif
+
+#include <cmath>
+
+using namespace Camellia;
+using namespace std;
+
+namespace
+{
+  // sums a few values across ranks; with MPI, the reduction proceeds in the background between start() and wait()
+  class NonblockingSum
+  {
+    const Epetra_Comm* _comm;
+    int _count;
+    double _localValues[3], _globalValues[3];
+#ifdef HAVE_MPI
+    const Epetra_MpiComm* _mpiComm;
+    MPI_Request _request;
+#endif
+  public:
+    NonblockingSum(const Epetra_Comm &comm) : _comm(&comm), _count(0)
+    {
+#ifdef HAVE_MPI
+      _mpiComm = dynamic_cast<const Epetra_MpiComm*>(&comm);
+#endif
+    }
+
+    void start(const double* localValues, int count)
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(count > 3, std::invalid_argument, "NonblockingSum supports at most 3 values");
+      _count = count;
+      for (int i=0; i<count; i++) _localValues[i] = localValues[i];
+#ifdef HAVE_MPI
+      if (_mpiComm != NULL)
+      {
+        MPI_Iallreduce(_localValues, _globalValues, count, MPI_DOUBLE, MPI_SUM, _mpiComm->Comm(), &_request);
+        return;
+      }
+#endif
+      _comm->SumAll(_localValues, _globalValues, count);
+    }
+
+    void wait(double* globalValues)
+    {
+#ifdef HAVE_MPI
+      if (_mpiComm != NULL) MPI_Wait(&_request, MPI_STATUS_IGNORE);
+#endif
+      for (int i=0; i<_count; i++) globalValues[i] = _globalValues[i];
+    }
+  };
+
+  double localDot(const Epetra_Vector &a, const Epetra_Vector &b)
+  {
+    const double* aValues = a.Values();
+    const double* bValues = b.Values();
+    int length = a.MyLength();
+    double sum = 0.0;
+    for (int i=0; i<length; i++)
+    {
+      sum += aValues[i] * bValues[i];
+    }
+    return sum;
+  }
+}
+
+PipelinedCGSolver::PipelinedCGSolver(int maxIters, double tol, Teuchos::RCP<Epetra_Operator> preconditioner)
+{
+  _maxIters = maxIters;
+  _tol = tol;
+  _residualScaling = RHS_NORM;
+  _printToConsole = false;
+  _residualReplacementInterval = 50;
+  _preconditioner = preconditioner;
+  _iterationCount = 0;
+  _residualReplacementCount = 0;
+}
+
+int PipelinedCGSolver::iterationCount() const
+{
+  return _iterationCount;
+}
+
+int PipelinedCGSolver::residualReplacementCount() const
+{
+  return _residualReplacementCount;
+}
+
+void PipelinedCGSolver::setPreconditioner(Teuchos::RCP<Epetra_Operator> preconditioner)
+{
+  _preconditioner = preconditioner;
+}
+
+void PipelinedCGSolver::setPrintToConsole(bool printToConsole)
+{
+  _printToConsole = printToConsole;
+}
+
+void PipelinedCGSolver::setResidualReplacementInterval(int interval)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(interval < 0, std::invalid_argument, "interval must be non-negative");
+  _residualReplacementInterval = interval;
+}
+
+void PipelinedCGSolver::setResidualScaling(ResidualScaling scaling)
+{
+  _residualScaling = scaling;
+}
+
+double PipelinedCGSolver::getTolerance()
+{
+  return _tol;
+}
+
+void PipelinedCGSolver::setTolerance(double tol)
+{
+  _tol = tol;
+}
+
+int PipelinedCGSolver::solve()
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(_stiffnessMatrix.get() == NULL, std::invalid_argument, "stiffness matrix is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_lhs.get() == NULL, std::invalid_argument, "lhs is unset.");
+  TEUCHOS_TEST_FOR_EXCEPTION(_rhs.get() == NULL, std::invalid_argument, "rhs is unset.");
+
+  _iterationCount = 0;
+  _residualReplacementCount = 0;
+  int result = 0;
+  for (int j=0; j<_rhs->NumVectors(); j++)
+  {
+    Epetra_Vector b(View, *_rhs, j);
+    Epetra_Vector x(View, *_lhs, j);
+    int vectorResult = solve(b, x);
+    if (vectorResult != 0) result = vectorResult;
+  }
+  return result;
+}
+
+int PipelinedCGSolver::solve(const Epetra_Vector &b, Epetra_Vector &x)
+{
+  // notation follows Ghysels and Vanroose: u = M r, w = A u, m = M w, n = A m, and s, q, z track A p, M s, A q.
+  const Epetra_BlockMap &map = b.Map();
+  Epetra_Vector r(map), u(map), w(map), m(map), n(map), p(map), s(map), q(map), z(map);
+
+  Epetra_CrsMatrix* A = _stiffnessMatrix.get();
+  auto applyPreconditioner = [this] (const Epetra_Vector &in, Epetra_Vector &out) -> void
+  {
+    if (_preconditioner == Teuchos::null)
+      out.Update(1.0, in, 0.0);
+    else
+      _preconditioner->ApplyInverse(in, out);
+  };
+  auto replaceResidual = [&] () -> void
+  {
+    A->Apply(x, r);
+    r.Update(1.0, b, -1.0);
+    applyPreconditioner(r, u);
+    A->Apply(u, w);
+  };
+
+  int rank = b.Comm().MyPID();
+  double bNorm;
+  b.Norm2(&bNorm);
+  if (bNorm == 0.0)
+  {
+    x.PutScalar(0.0);
+    return 0;
+  }
+
+  replaceResidual();
+
+  NonblockingSum sum(b.Comm());
+  double gammaOld = 0.0, alphaOld = 0.0;
+  double residualScale = (_residualScaling == RHS_NORM) ? bNorm : 1.0; // for INITIAL_RESIDUAL_NORM, set on the first iteration
+  for (int iteration=0; ; iteration++)
+  {
+    double localValues[3] = {localDot(r,u), localDot(w,u), localDot(r,r)};
+    sum.start(localValues, 3);
+
+    // while the reduction is in flight: these depend only on w
+    applyPreconditioner(w, m);
+    A->Apply(m, n);
+
+    double globalValues[3];
+    sum.wait(globalValues);
+    double gamma = globalValues[0], delta = globalValues[1], residualNorm = sqrt(globalValues[2]);
+    if ((iteration == 0) && (_residualScaling == INITIAL_RESIDUAL_NORM))
+    {
+      if (residualNorm == 0.0) return 0; // the initial guess solves the system
+      residualScale = residualNorm;
+    }
+
+    bool converged = (residualNorm <= _tol * residualScale);
+    if (converged || (iteration == _maxIters))
+    {
+      _iterationCount = max(_iterationCount, iteration);
+      if (_printToConsole && (rank == 0))
+      {
+        cout << "PipelinedCGSolver: " << (converged ? "converged" : "reached max iterations") << " after " << iteration;
+        cout << " iterations; scaled residual = " << residualNorm / residualScale << endl;
+      }
+      return converged ? 0 : 1;
+    }
+
+    double alpha, beta;
+    if (iteration == 0)
+    {
+      beta = 0.0;
+      alpha = gamma / delta;
+    }
+    else
+    {
+      beta = gamma / gammaOld;
+      alpha = gamma / (delta - beta * gamma / alphaOld);
+    }
+    if (!(alpha > 0.0) || !std::isfinite(alpha))
+    {
+      if (_printToConsole && (rank == 0)) cout << "PipelinedCGSolver: breakdown at iteration " << iteration << " (is the operator SPD?)\n";
+      _iterationCount = max(_iterationCount, iteration);
+      return -1;
+    }
+
+    z.Update(1.0, n, beta);
+    q.Update(1.0, m, beta);
+    s.Update(1.0, w, beta);
+    p.Update(1.0, u, beta);
+
+    x.Update( alpha, p, 1.0);
+    r.Update(-alpha, s, 1.0);
+    u.Update(-alpha, q, 1.0);
+    w.Update(-alpha, z, 1.0);
+
+    gammaOld = gamma;
+    alphaOld = alpha;
+
+    if ((_residualReplacementInterval > 0) && ((iteration + 1) % _residualReplacementInterval == 0))
+    {
+      // replace the recursively updated vectors by their definitions, so that rounding errors do not accumulate
+      replaceResidual();
+      A->Apply(p, s);
+      applyPreconditioner(s, q);
+      A->Apply(q, z);
+      _residualReplacementCount++;
+    }
+  }
+}
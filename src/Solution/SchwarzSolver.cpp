@@ -24,6 +24,11 @@ void SchwarzSolver::setPrintToConsole(bool printToConsole)
   _printToConsole = printToConsole;
 }
 
+double SchwarzSolver::getTolerance()
+{
+  return _tol;
+}
+
 void SchwarzSolver::setTolerance(double tol)
 {
   _tol = tol;
@@ -0,0 +1,164 @@
+//
+//  SinglePrecisionCrsMatrix.cpp
+//  Camellia
+//
+
+#include "SinglePrecisionCrsMatrix.h"
+
+using namespace Camellia;
+using namespace std;
+
+SinglePrecisionCrsMatrix::SinglePrecisionCrsMatrix(const Epetra_CrsMatrix &matrix)
+  : _rowMap(matrix.RowMap()), _colMap(matrix.ColMap()), _domainMap(matrix.DomainMap()), _rangeMap(matrix.RangeMap())
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(!matrix.Filled(), std::invalid_argument, "SinglePrecisionCrsMatrix requires a fill-completed matrix");
+  if (matrix.Importer() != NULL) _importer = Teuchos::rcp( new Epetra_Import(*matrix.Importer()) );
+  if (matrix.Exporter() != NULL) _exporter = Teuchos::rcp( new Epetra_Export(*matrix.Exporter()) );
+
+  int numMyRows = matrix.NumMyRows();
+  _rowOffsets.resize(numMyRows+1);
+  _rowOffsets[0] = 0;
+  _colIndices.reserve(matrix.NumMyNonzeros());
+  _values.reserve(matrix.NumMyNonzeros());
+  for (int rowLID=0; rowLID<numMyRows; rowLID++)
+  {
+    int numEntries;
+    double* values;
+    int* colIndices;
+    matrix.ExtractMyRowView(rowLID, numEntries, values, colIndices);
+    for (int k=0; k<numEntries; k++)
+    {
+      _colIndices.push_back(colIndices[k]);
+      _values.push_back((float)values[k]);
+    }
+    _rowOffsets[rowLID+1] = _colIndices.size();
+  }
+}
+
+int SinglePrecisionCrsMatrix::Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  return Multiply(false, X, Y);
+}
+
+const Epetra_Map & SinglePrecisionCrsMatrix::DomainMap() const
+{
+  return _domainMap;
+}
+
+int SinglePrecisionCrsMatrix::Multiply(bool transA, const Epetra_MultiVector& X, Epetra_MultiVector& Y) const
+{
+  int numVectors = X.NumVectors();
+  if (Y.NumVectors() != numVectors) return -1;
+  int numMyRows = _rowOffsets.size() - 1;
+
+  if (!transA)
+  {
+    // import X into the column map, form local rows, export to the range map
+    Teuchos::RCP<Epetra_MultiVector> importedX, rowY;
+    const Epetra_MultiVector* Xcol = &X;
+    Epetra_MultiVector* Yrow = &Y;
+    if (_importer != Teuchos::null)
+    {
+      importedX = Teuchos::rcp( new Epetra_MultiVector(_colMap, numVectors) );
+      importedX->Import(X, *_importer, ::Insert);
+      Xcol = importedX.get();
+    }
+    if (_exporter != Teuchos::null)
+    {
+      rowY = Teuchos::rcp( new Epetra_MultiVector(_rowMap, numVectors) );
+      Yrow = rowY.get();
+    }
+
+    double** xValues = Xcol->Pointers();
+    double** yValues = Yrow->Pointers();
+    for (int v=0; v<numVectors; v++)
+    {
+      const double* x = xValues[v];
+      double* y = yValues[v];
+      for (int rowLID=0; rowLID<numMyRows; rowLID++)
+      {
+        double sum = 0.0;
+        for (int k=_rowOffsets[rowLID]; k<_rowOffsets[rowLID+1]; k++)
+        {
+          sum += (double)_values[k] * x[_colIndices[k]];
+        }
+        y[rowLID] = sum;
+      }
+    }
+
+    if (_exporter != Teuchos::null)
+    {
+      Y.PutScalar(0.0);
+      Y.Export(*Yrow, *_exporter, ::Add);
+    }
+  }
+  else
+  {
+    // reverse the communication pattern: bring X into the row map, scatter into the column map, and sum into the domain map
+    Teuchos::RCP<Epetra_MultiVector> importedX, colY;
+    const Epetra_MultiVector* Xrow = &X;
+    Epetra_MultiVector* Ycol = &Y;
+    if (_exporter != Teuchos::null)
+    {
+      importedX = Teuchos::rcp( new Epetra_MultiVector(_rowMap, numVectors) );
+      importedX->Import(X, *_exporter, ::Insert);
+      Xrow = importedX.get();
+    }
+    if (_importer != Teuchos::null)
+    {
+      colY = Teuchos::rcp( new Epetra_MultiVector(_colMap, numVectors) );
+      Ycol = colY.get();
+    }
+    Ycol->PutScalar(0.0);
+
+    double** xValues = Xrow->Pointers();
+    double** yValues = Ycol->Pointers();
+    for (int v=0; v<numVectors; v++)
+    {
+      const double* x = xValues[v];
+      double* y = yValues[v];
+      for (int rowLID=0; rowLID<numMyRows; rowLID++)
+      {
+        double xValue = x[rowLID];
+        if (xValue == 0.0) continue;
+        for (int k=_rowOffsets[rowLID]; k<_rowOffsets[rowLID+1]; k++)
+        {
+          y[_colIndices[k]] += (double)_values[k] * xValue;
+        }
+      }
+    }
+
+    if (_importer != Teuchos::null)
+    {
+      Y.PutScalar(0.0);
+      Y.Export(*Ycol, *_importer, ::Add);
+    }
+  }
+  return 0;
+}
+
+int SinglePrecisionCrsMatrix::NumMyNonzeros() const
+{
+  return _values.size();
+}
+
+const Epetra_Map & SinglePrecisionCrsMatrix::RangeMap() const
+{
+  return _rangeMap;
+}
+
+Teuchos::RCP<Epetra_CrsMatrix> SinglePrecisionCrsMatrix::toDoublePrecision() const
+{
+  int numMyRows = _rowOffsets.size() - 1;
+  Teuchos::RCP<Epetra_CrsMatrix> matrix = Teuchos::rcp( new Epetra_CrsMatrix(::Copy, _rowMap, _colMap, 0) );
+  vector<double> rowValues;
+  for (int rowLID=0; rowLID<numMyRows; rowLID++)
+  {
+    int start = _rowOffsets[rowLID], numEntries = _rowOffsets[rowLID+1] - start;
+    if (numEntries == 0) continue;
+    rowValues.assign(_values.begin() + start, _values.begin() + start + numEntries);
+    matrix->InsertMyValues(rowLID, numEntries, &rowValues[0], const_cast<int*>(&_colIndices[start]));
+  }
+  matrix->FillComplete(_domainMap, _rangeMap);
+  return matrix;
+}
@@ -58,6 +58,7 @@
 #ifdef HAVE_MPI
 #include "Epetra_MpiDistributor.h"
 #endif
+#include "Epetra_Import.h"
 #include "Epetra_SerialDistributor.h"
 #include "Epetra_Time.h"
 
@@ -73,6 +74,8 @@
 // Shards includes
 #include "Shards_CellTopology.hpp"
 
+#include "Teuchos_BLAS.hpp"
+
 #include "ml_epetra_utils.h"
 //#include "ml_common.h"
 #include "ml_epetra_preconditioner.h"
@@ -88,6 +91,7 @@
 #include "CamelliaCellTools.h"
 #include "CondensedDofInterpreter.h"
 #include "CubatureFactory.h"
+#include "DataIO.h"
 #include "Function.h"
 #include "IP.h"
 #include "GlobalDofAssignment.h"
@@ -144,6 +148,53 @@ void TSolution<Scalar>::setCubatureEnrichmentDegree(int value)
 static const int MAX_BATCH_SIZE_IN_BYTES = 3*1024*1024; // 3 MB
 static const int MIN_BATCH_SIZE_IN_CELLS = 1; // overrides the above, if it results in too-small batches
 
+// Determines which of a cell's global dofs have BCs imposed, and eliminates them from the cell's interpreted stiffness: lift is
+// set to the product of the BC columns with the BC values, and then the BC rows and columns are zeroed.  Callers subtract lift
+// from each of the cell's loads using liftBCsFromLoad().
+template <typename Scalar>
+static void eliminateBCsFromStiffness(FieldContainer<Scalar> &stiffness, const FieldContainer<GlobalIndexType> &globalDofIndices,
+                                      const map<GlobalIndexType,Scalar> &bcValues, vector<int> &bcOrdinals, vector<Scalar> &lift)
+{
+  int numDofs = globalDofIndices.size();
+  bcOrdinals.clear();
+  lift.assign(numDofs, 0.0);
+  for (int dofOrdinal=0; dofOrdinal<numDofs; dofOrdinal++)
+  {
+    auto bcEntry = bcValues.find(globalDofIndices[dofOrdinal]);
+    if (bcEntry == bcValues.end()) continue;
+    bcOrdinals.push_back(dofOrdinal);
+    Scalar bcValue = bcEntry->second;
+    if (bcValue == 0.0) continue;
+    for (int i=0; i<numDofs; i++)
+    {
+      lift[i] += stiffness(i,dofOrdinal) * bcValue;
+    }
+  }
+  for (int bcOrdinal : bcOrdinals)
+  {
+    for (int i=0; i<numDofs; i++)
+    {
+      stiffness(i,bcOrdinal) = 0.0;
+      stiffness(bcOrdinal,i) = 0.0;
+    }
+  }
+}
+
+// Subtracts lift from load, and zeroes the entries for BC dofs; the owner of each BC dof sets its value after global assembly.
+template <typename Scalar>
+static void liftBCsFromLoad(FieldContainer<Scalar> &load, const vector<int> &bcOrdinals, const vector<Scalar> &lift)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(load.size() != lift.size(), std::invalid_argument, "load size does not match lift size");
+  for (int i=0; i<lift.size(); i++)
+  {
+    load[i] -= lift[i];
+  }
+  for (int bcOrdinal : bcOrdinals)
+  {
+    load[bcOrdinal] = 0.0;
+  }
+}
+
 // copy constructor:
 template <typename Scalar>
 TSolution<Scalar>::TSolution(const TSolution<Scalar> &soln) : Narrator("Solution")
@@ -164,6 +215,7 @@ TSolution<Scalar>::TSolution(const TSolution<Scalar> &soln) : Narrator("Solution
   _writeRHSToMatrixMarketFile = false;
   _cubatureEnrichmentDegree = soln.cubatureEnrichmentDegree();
   _zmcsAsLagrangeMultipliers = soln.getZMCsAsGlobalLagrange();
+  _eliminateBCsDuringAssembly = soln.eliminatesBCsDuringAssembly();
 }
 
 template <typename Scalar>
@@ -223,6 +275,7 @@ void TSolution<Scalar>::initialize()
   _zmcsAsLagrangeMultipliers = true; // default -- when false, it's user's / Solver's responsibility to enforce ZMCs
   _zmcsAsRankOneUpdate = false; // I believe this works, but it's slow!
   _zmcRho = -1; // default value: stabilization parameter for zero-mean constraints
+  _eliminateBCsDuringAssembly = false;
 }
 
 template <typename Scalar>
@@ -1019,7 +1072,8 @@ void TSolution<Scalar>::initializeStiffnessAndLoad()
   int maxRowSize = 0; // will cause more mallocs during insertion into the CrsMatrix, but will minimize the amount of memory allocated now.
   
   _globalStiffMatrix = Teuchos::rcp(new Epetra_FECrsMatrix(::Copy, partMap, maxRowSize));
-  _rhsVector = Teuchos::rcp(new Epetra_FEVector(partMap));
+  int numLoads = _loadRHSs.empty() ? 1 : _loadRHSs.size();
+  _rhsVector = Teuchos::rcp(new Epetra_FEVector(partMap, numLoads));
 }
 
 template <typename Scalar>
@@ -1053,6 +1107,65 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
   double testMatrixAssemblyTime = 0, testMatrixInversionTime = 0, localStiffnessDeterminationFromTestsTime = 0;
   double localStiffnessInterpretationTime = 0, rhsIntegrationAgainstOptimalTestsTime = 0, filterApplicationTime = 0;
 
+  int numLoads = _rhsVector->NumVectors();
+  TEUCHOS_TEST_FOR_EXCEPTION((numLoads > 1) && (_loadRHSs.size() != numLoads), std::invalid_argument,
+                             "_rhsVector has multiple columns, but these do not correspond to the RHS list");
+  TEUCHOS_TEST_FOR_EXCEPTION((numLoads > 1) && (_filter.get() != NULL), std::invalid_argument,
+                             "local stiffness matrix filters are not supported when assembling multiple loads");
+
+  // when eliminating BCs during assembly, we determine the BC values for every dof seen by our cells up front
+  map<GlobalIndexType,Scalar> bcValues;
+  double bcDeterminationTime = 0;
+  if (_eliminateBCsDuringAssembly)
+  {
+    subTimer.ResetStartTime();
+    TEUCHOS_TEST_FOR_EXCEPTION(_mesh->bilinearForm()->getJumpTerms().size() > 0, std::invalid_argument,
+                               "eliminating BCs during assembly is not supported for bilinear forms with jump terms");
+    for (int trialID : getZeroMeanConstraints())
+    {
+      TEUCHOS_TEST_FOR_EXCEPTION(_bc->bcsImposed(trialID) || _bc->singlePointBC(trialID), std::invalid_argument,
+                                 "eliminating BCs during assembly is not supported for variables with both BCs and zero-mean constraints");
+    }
+    determineBCValuesForRankLocalCells(bcValues);
+    bcDeterminationTime = subTimer.ElapsedTime();
+  }
+  vector<int> bcOrdinals; // cell-local ordinals of the BC dofs, used when eliminating BCs during assembly
+  vector<Scalar> bcLift;
+
+  // one BasisCache per element type, spanning all our cells of that type; these serve as the prototypes for the batches below.
+  // First, we use them to import, in one collective step, any off-rank data the forms' functions need on our cells (e.g.
+  // coefficients of a previous solution partitioned differently than this one).  Every rank must make this call.
+  vector<BasisCachePtr> elementTypeBasisCaches;
+  for (ElementTypePtr elemTypePtr : elementTypes)
+  {
+    vector<GlobalIndexType> cellIDsForType = _mesh->cellIDsOfType(rank, elemTypePtr);
+    if (cellIDsForType.size() == 0)
+    {
+      elementTypeBasisCaches.push_back(Teuchos::null);
+      continue;
+    }
+    BasisCachePtr typeBasisCache = BasisCache::basisCacheForCell(_mesh,cellIDsForType[0],false,_cubatureEnrichmentDegree);
+    typeBasisCache->setCellIDs(cellIDsForType);
+    elementTypeBasisCaches.push_back(typeBasisCache);
+  }
+  vector<BasisCachePtr> importBasisCaches;
+  for (BasisCachePtr typeBasisCache : elementTypeBasisCaches)
+  {
+    if (typeBasisCache != Teuchos::null) importBasisCaches.push_back(typeBasisCache);
+  }
+  if (_bf != Teuchos::null)
+    _bf->importOffRankCellData(importBasisCaches);
+  else
+    _mesh->bilinearForm()->importOffRankCellData(importBasisCaches);
+  for (TRHSPtr<Scalar> loadRHS : _loadRHSs)
+  {
+    loadRHS->linearTerm()->importOffRankCellData(importBasisCaches);
+  }
+  if (_loadRHSs.empty() && (_rhs != Teuchos::null))
+  {
+    _rhs->linearTerm()->importOffRankCellData(importBasisCaches);
+  }
+
   //  cout << "Computing local matrices" << endl;
   for (elemTypeIt = elementTypes.begin(); elemTypeIt != elementTypes.end(); elemTypeIt++)
   {
@@ -1067,7 +1180,7 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
     if (totalCellsForType == 0) continue;
     // if we get here, there is at least one, so we find a sample cellID to help us set up prototype BasisCaches:
     GlobalIndexType sampleCellID = _mesh->cellID(elemTypePtr, 0, rank);
-    BasisCachePtr basisCache = BasisCache::basisCacheForCell(_mesh,sampleCellID,false,_cubatureEnrichmentDegree);
+    BasisCachePtr basisCache = elementTypeBasisCaches[elemTypeIt - elementTypes.begin()];
     BasisCachePtr ipBasisCache = BasisCache::basisCacheForCell(_mesh,sampleCellID,true,_cubatureEnrichmentDegree);
 
     DofOrderingPtr trialOrderingPtr = elemTypePtr->trialOrderPtr;
@@ -1111,9 +1224,20 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
       ipBasisCache->setCellSideParities(cellSideParities); // I don't anticipate these being needed, though
 
       Intrepid::FieldContainer<Scalar> localStiffness(numCells,numTrialDofs,numTrialDofs);
-      Intrepid::FieldContainer<Scalar> localRHSVector(numCells,numTrialDofs);
+      Intrepid::FieldContainer<Scalar> localLoads(numLoads,numCells,numTrialDofs);
+      Teuchos::Array<int> localRHSVectorDim(2);
+      localRHSVectorDim[0] = numCells;
+      localRHSVectorDim[1] = numTrialDofs;
+      Intrepid::FieldContainer<Scalar> localRHSVector(localRHSVectorDim,&localLoads(0,0,0)); // shallow copy: the first load
 
-      if (_bf != Teuchos::null)
+      if (!_loadRHSs.empty())
+      {
+        if (_bf != Teuchos::null)
+          _bf->localStiffnessMatrixAndLoads(localStiffness, localLoads, _ip, ipBasisCache, _loadRHSs, basisCache);
+        else
+          _mesh->bilinearForm()->localStiffnessMatrixAndLoads(localStiffness, localLoads, _ip, ipBasisCache, _loadRHSs, basisCache);
+      }
+      else if (_bf != Teuchos::null)
         _bf->localStiffnessMatrixAndRHS(localStiffness, localRHSVector, _ip, ipBasisCache, _rhs, basisCache);
       else
         _mesh->bilinearForm()->localStiffnessMatrixAndRHS(localStiffness, localRHSVector, _ip, ipBasisCache, _rhs, basisCache);
@@ -1142,6 +1266,8 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
       Intrepid::FieldContainer<Scalar> interpretedStiffness;
       Intrepid::FieldContainer<Scalar> interpretedRHS;
 
+      Intrepid::FieldContainer<GlobalIndexType> loadGlobalDofIndices; // for loads beyond the first
+
       Teuchos::Array<int> dim;
 
       for (int cellIndex=0; cellIndex<numCells; cellIndex++)
@@ -1152,6 +1278,12 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
 
         _dofInterpreter->interpretLocalData(cellID, cellStiffness, cellRHS, interpretedStiffness, interpretedRHS, globalDofIndices);
 
+        if (_eliminateBCsDuringAssembly)
+        {
+          eliminateBCsFromStiffness(interpretedStiffness, globalDofIndices, bcValues, bcOrdinals, bcLift);
+          liftBCsFromLoad(interpretedRHS, bcOrdinals, bcLift);
+        }
+
         // cast whatever the global index type is to a type that Epetra supports
         globalDofIndices.dimensions(dim);
         globalDofIndicesCast.resize(dim);
@@ -1164,6 +1296,24 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
         globalStiffness->InsertGlobalValues(globalDofIndices.size(),&globalDofIndicesCast(0),
                                             globalDofIndices.size(),&globalDofIndicesCast(0),&interpretedStiffness[0]);
         _rhsVector->SumIntoGlobalValues(globalDofIndices.size(),&globalDofIndicesCast(0),&interpretedRHS[0]);
+
+        for (int loadOrdinal=1; loadOrdinal<numLoads; loadOrdinal++)
+        {
+          Intrepid::FieldContainer<Scalar> cellLoad(localRHSDim,&localLoads(loadOrdinal,cellIndex,0)); // shallow copy
+          _dofInterpreter->interpretLocalData(cellID, cellLoad, interpretedRHS, loadGlobalDofIndices);
+          if (_eliminateBCsDuringAssembly)
+          {
+            liftBCsFromLoad(interpretedRHS, bcOrdinals, bcLift); // loads share the stiffness's global dof ordering
+          }
+
+          loadGlobalDofIndices.dimensions(dim);
+          globalDofIndicesCast.resize(dim);
+          for (int dofOrdinal = 0; dofOrdinal < loadGlobalDofIndices.size(); dofOrdinal++)
+          {
+            globalDofIndicesCast[dofOrdinal] = loadGlobalDofIndices[dofOrdinal];
+          }
+          _rhsVector->SumIntoGlobalValues(loadGlobalDofIndices.size(),&globalDofIndicesCast(0),&interpretedRHS[0],loadOrdinal);
+        }
       }
       localStiffnessInterpretationTime += subTimer.ElapsedTime();
 
@@ -1179,7 +1329,34 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
         cout << "filterApplicationTime: " << filterApplicationTime << " seconds.\n";*/
   }
 
-  double timeLocalStiffness = timer.ElapsedTime();
+  // BC rows and columns were zeroed in the cell contributions; each owned BC dof gets a 1 on the diagonal
+  Intrepid::FieldContainer<GlobalIndexTypeToCast> ownedBCGlobalIndices;
+  Intrepid::FieldContainer<Scalar> ownedBCGlobalValues;
+  if (_eliminateBCsDuringAssembly)
+  {
+    subTimer.ResetStartTime();
+    int numOwnedBCs = 0;
+    for (auto bcEntry : bcValues)
+    {
+      if (myGlobalIndicesSet.find(bcEntry.first) != myGlobalIndicesSet.end()) numOwnedBCs++;
+    }
+    ownedBCGlobalIndices.resize(numOwnedBCs);
+    ownedBCGlobalValues.resize(numOwnedBCs);
+    int ownedBCOrdinal = 0;
+    Scalar one = 1.0;
+    for (auto bcEntry : bcValues)
+    {
+      if (myGlobalIndicesSet.find(bcEntry.first) == myGlobalIndicesSet.end()) continue;
+      GlobalIndexTypeToCast globalIndex = bcEntry.first;
+      ownedBCGlobalIndices(ownedBCOrdinal) = globalIndex;
+      ownedBCGlobalValues(ownedBCOrdinal) = bcEntry.second;
+      globalStiffness->InsertGlobalValues(1,&globalIndex,1,&globalIndex,&one);
+      ownedBCOrdinal++;
+    }
+    bcDeterminationTime += subTimer.ElapsedTime();
+  }
+
+  double timeLocalStiffness = timer.ElapsedTime() - bcDeterminationTime;
   //  cout << "Done computing local matrices" << endl;
   Epetra_Vector timeLocalStiffnessVector(timeMap);
   timeLocalStiffnessVector[0] = timeLocalStiffness;
@@ -1235,10 +1412,21 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
         _dofInterpreter->interpretLocalData(cellIDs[cellIndex], dummyLocalStiffness, localLHS, dummyInterpretedStiffness,
                                             interpretedLHS, interpretedGlobalDofIndices);
 
+        Scalar constraintRHS = rhs(cellIndex);
         for (int i=0; i<interpretedLHS.size(); i++)
         {
           if (interpretedLHS(i) != 0.0)
           {
+            if (_eliminateBCsDuringAssembly)
+            {
+              auto bcEntry = bcValues.find(interpretedGlobalDofIndices(i));
+              if (bcEntry != bcValues.end())
+              {
+                // eliminated: lift into the constraint's RHS
+                constraintRHS -= interpretedLHS(i) * bcEntry->second;
+                continue;
+              }
+            }
             globalDofIndices(nnz) = interpretedGlobalDofIndices(i);
             nonzeroValues(nnz) = interpretedLHS(i);
             nnz++;
@@ -1260,7 +1448,10 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
         // insert column:
         globalStiffness->InsertGlobalValues(nnz+1,&globalDofIndices(0),1,&globalRowIndex,
                                             &nonzeroValues(0));
-        _rhsVector->ReplaceGlobalValues(1,&globalRowIndex,&rhs(cellIndex));
+        for (int loadOrdinal=0; loadOrdinal<numLoads; loadOrdinal++)
+        {
+          _rhsVector->ReplaceGlobalValues(1,&globalRowIndex,&constraintRHS,loadOrdinal);
+        }
 
         localRowIndex++;
       }
@@ -1387,9 +1578,17 @@ void TSolution<Scalar>::populateStiffnessAndLoad()
 
   timer.ResetStartTime();
 
-  imposeBCs();
+  if (_eliminateBCsDuringAssembly)
+  {
+    // the matrix already has the BCs eliminated; all that remains is to set the BC values in the vectors
+    imposeBCValuesOnVectors(ownedBCGlobalIndices, ownedBCGlobalValues);
+  }
+  else
+  {
+    imposeBCs();
+  }
 
-  double timeBCImposition = timer.ElapsedTime();
+  double timeBCImposition = timer.ElapsedTime() + bcDeterminationTime;
   Epetra_Vector timeBCImpositionVector(timeMap);
   timeBCImpositionVector[0] = timeBCImposition;
 
@@ -1537,10 +1736,62 @@ int TSolution<Scalar>::solve(TSolverPtr<Scalar> solver)
   return solveSuccess;
 }
 
+template <typename Scalar>
+int TSolution<Scalar>::solve(TSolverPtr<Scalar> solver, const vector< TRHSPtr<Scalar> > &rhsList, vector< TSolutionPtr<Scalar> > &solutions)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(rhsList.size() == 0, std::invalid_argument, "rhsList must be non-empty");
+  TEUCHOS_TEST_FOR_EXCEPTION(_oldDofInterpreter.get() != NULL, std::invalid_argument,
+                             "solving for multiple loads is not supported with static condensation");
+  TEUCHOS_TEST_FOR_EXCEPTION(_filter.get() != NULL, std::invalid_argument,
+                             "solving for multiple loads is not supported with local stiffness matrix filters");
+
+  int numLoads = rhsList.size();
+  Epetra_Map partMap = getPartitionMap();
+
+  // this Solution's own coefficients are left intact; the multi-load solve uses a zero initial guess for each load
+  Teuchos::RCP<Epetra_FEVector> lhsVector = _lhsVector;
+  Teuchos::RCP<Epetra_FEVector> rhsVector = _rhsVector;
+  _lhsVector = Teuchos::rcp(new Epetra_FEVector(partMap,numLoads,true));
+
+  _loadRHSs = rhsList;
+  initializeStiffnessAndLoad();
+  setProblem(solver);
+  applyDGJumpTerms();
+  populateStiffnessAndLoad();
+  _loadRHSs.clear();
+
+  int solveSuccess = solveWithPrepopulatedStiffnessAndLoad(solver);
+
+  solutions.resize(numLoads);
+  for (int loadOrdinal=0; loadOrdinal<numLoads; loadOrdinal++)
+  {
+    TSolutionPtr<Scalar> solution = Teuchos::rcp( new TSolution<Scalar>(_bf, _mesh, _bc, rhsList[loadOrdinal], _ip) );
+    solution->_dofInterpreter = _dofInterpreter;
+    solution->_lagrangeConstraints = _lagrangeConstraints;
+    solution->_cubatureEnrichmentDegree = _cubatureEnrichmentDegree;
+    solution->_zmcsAsLagrangeMultipliers = _zmcsAsLagrangeMultipliers;
+    solution->_globalStiffMatrix = _globalStiffMatrix;
+    solution->_lhsVector = Teuchos::rcp(new Epetra_FEVector(partMap,1));
+    solution->_lhsVector->Update(1.0, *(*_lhsVector)(loadOrdinal), 0.0);
+    solution->importSolution();
+    solutions[loadOrdinal] = solution;
+  }
+
+  _lhsVector = lhsVector;
+  _rhsVector = rhsVector;
+
+  if (_reportTimingResults )
+  {
+    reportTimings();
+  }
+
+  return solveSuccess;
+}
+
 template <typename Scalar>
 void TSolution<Scalar>::reportTimings()
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
 
   if (rank == 0)
   {
@@ -1654,7 +1905,7 @@ void TSolution<Scalar>::importSolution()
 //  cout << "on rank " << rank << ", finished interpretation\n";
   double timeDistributeSolution = timer.ElapsedTime();
 
-  int numProcs = Teuchos::GlobalMPISession::getNProc();
+  int numProcs = Comm->NumProc();
   int indexBase = 0;
   Epetra_Map timeMap(numProcs,indexBase,*Comm);
   Epetra_Vector timeDistributeSolutionVector(timeMap);
@@ -1746,6 +1997,14 @@ void TSolution<Scalar>::importSolutionForOffRankCells(std::set<GlobalIndexType>
     }
 
     Intrepid::FieldContainer<Scalar>* solnCoeffs = &_solutionForCellIDGlobal[cellID];
+    if (solnCoeffs->size() == 0)
+    {
+      // no solution yet on this cell (e.g., a background solution that has not been solved for); the requestor expects a full
+      // set of coefficients, so we send zeros
+      sizes[cellOrdinal] = _mesh->getElementType(cellID)->trialOrderPtr->totalDofs();
+      dataToExport.insert(dataToExport.end(), sizes[cellOrdinal], 0.0);
+      continue;
+    }
     sizes[cellOrdinal] = solnCoeffs->size();
     for (int dofOrdinal=0; dofOrdinal < solnCoeffs->size(); dofOrdinal++)
     {
@@ -1791,6 +2050,22 @@ void TSolution<Scalar>::importSolutionForOffRankCells(std::set<GlobalIndexType>
   if (importedData != 0 ) delete [] importedData;
 }
 
+template <typename Scalar>
+void TSolution<Scalar>::importSolutionForOffRankCells(const std::vector<BasisCachePtr> &basisCaches)
+{
+  // the BasisCaches may belong to another mesh (e.g., assembly of a form with this solution as background); we can only supply
+  // data for cells that are active in ours
+  std::set<GlobalIndexType> cellIDs;
+  for (BasisCachePtr basisCache : basisCaches)
+  {
+    for (GlobalIndexType cellID : basisCache->cellIDs())
+    {
+      if (_mesh->cellIsActive(cellID)) cellIDs.insert(cellID);
+    }
+  }
+  importSolutionForOffRankCells(cellIDs);
+}
+
 template <typename Scalar>
 void TSolution<Scalar>::importGlobalSolution()
 {
@@ -1826,7 +2101,7 @@ void TSolution<Scalar>::importGlobalSolution()
   }
   double timeDistributeSolution = timer.ElapsedTime();
 
-  int numProcs = Teuchos::GlobalMPISession::getNProc();
+  int numProcs = Comm->NumProc();
   int indexBase = 0;
   Epetra_Map timeMap(numProcs,indexBase,*Comm);
   Epetra_Vector timeDistributeSolutionVector(timeMap);
@@ -1854,7 +2129,7 @@ template <typename Scalar>
 void TSolution<Scalar>::imposeBCs()
 {
   narrate("imposeBCs()");
-  int rank     = Teuchos::GlobalMPISession::getRank();
+  int rank     = _mesh->Comm()->MyPID();
 
   Intrepid::FieldContainer<GlobalIndexType> bcGlobalIndices;
   Intrepid::FieldContainer<Scalar> bcGlobalValues;
@@ -1878,36 +2153,26 @@ void TSolution<Scalar>::imposeBCs()
 //  cout << "bcGlobalIndices:" << endl << bcGlobalIndices;
   //  cout << "bcGlobalValues:" << endl << bcGlobalValues;
 
-  Epetra_MultiVector v(partMap,1);
+  // when assembling multiple loads, the same BC values apply to each
+  int numLoads = _rhsVector->NumVectors();
+  Epetra_MultiVector v(partMap,numLoads);
   v.PutScalar(0.0);
   for (int i = 0; i < numBCs; i++)
   {
-    v.ReplaceGlobalValue(bcGlobalIndicesCast(i), 0, bcGlobalValues(i));
+    for (int loadOrdinal=0; loadOrdinal<numLoads; loadOrdinal++)
+    {
+      v.ReplaceGlobalValue(bcGlobalIndicesCast(i), loadOrdinal, bcGlobalValues(i));
+    }
   }
 
-  Epetra_MultiVector rhsDirichlet(partMap,1);
+  Epetra_MultiVector rhsDirichlet(partMap,numLoads);
   _globalStiffMatrix->Apply(v,rhsDirichlet);
 
   // Update right-hand side
   _rhsVector->Update(-1.0,rhsDirichlet,1.0);
 
-  if (numBCs == 0)
-  {
-    //cout << "Solution: Warning: Imposing no BCs." << endl;
-  }
-  else
-  {
-    int err = _rhsVector->ReplaceGlobalValues(numBCs,&bcGlobalIndicesCast(0),&bcGlobalValues(0));
-    if (err != 0)
-    {
-      cout << "ERROR: rhsVector.ReplaceGlobalValues(): some indices non-local...\n";
-    }
-    err = _lhsVector->ReplaceGlobalValues(numBCs,&bcGlobalIndicesCast(0),&bcGlobalValues(0));
-    if (err != 0)
-    {
-      cout << "ERROR: rhsVector.ReplaceGlobalValues(): some indices non-local...\n";
-    }
-  }
+  imposeBCValuesOnVectors(bcGlobalIndicesCast, bcGlobalValues);
+
   // Zero out rows and columns of stiffness matrix corresponding to Dirichlet edges
   //  and add one to diagonal.
   Intrepid::FieldContainer<int> bcLocalIndices(bcGlobalIndices.dimension(0));
@@ -1926,11 +2191,88 @@ void TSolution<Scalar>::imposeBCs()
 }
 
 
+template <typename Scalar>
+void TSolution<Scalar>::determineBCValuesForRankLocalCells(map<GlobalIndexType,Scalar> &bcValues)
+{
+  // Boundary::bcsToImpose() only finds the BC dofs reached through this rank's boundary sides.  A rank-local cell may also see a
+  // BC dof that belongs to no boundary side on this rank -- e.g., a triangle touching the boundary at a vertex, or a cell constrained
+  // by a hanging node on a coarse boundary edge.  So we communicate the BC flags and values through the owned map, and import them
+  // onto the map of all global dofs seen by our cells.
+  Intrepid::FieldContainer<GlobalIndexType> bcGlobalIndices;
+  Intrepid::FieldContainer<Scalar> bcGlobalValues;
+  _mesh->boundary().bcsToImpose(bcGlobalIndices,bcGlobalValues,*(_bc.get()), _dofInterpreter.get());
+
+  Epetra_Map partMap = getPartitionMap();
+  Epetra_FEVector bcFlagsOwned(partMap), bcValuesOwned(partMap);
+  double one = 1.0;
+  for (int i=0; i<bcGlobalIndices.size(); i++)
+  {
+    GlobalIndexTypeToCast globalIndex = bcGlobalIndices[i];
+    double value = bcGlobalValues[i];
+    bcFlagsOwned.SumIntoGlobalValues(1, &globalIndex, &one);
+    bcValuesOwned.SumIntoGlobalValues(1, &globalIndex, &value);
+  }
+  bcFlagsOwned.GlobalAssemble();
+  bcValuesOwned.GlobalAssemble();
+
+  set<GlobalIndexType> cellGlobalIndices;
+  for (GlobalIndexType cellID : _mesh->cellIDsInPartition())
+  {
+    set<GlobalIndexType> globalIndicesForCell = _dofInterpreter->globalDofIndicesForCell(cellID);
+    cellGlobalIndices.insert(globalIndicesForCell.begin(), globalIndicesForCell.end());
+  }
+  vector<GlobalIndexTypeToCast> cellGlobalIndicesCast(cellGlobalIndices.begin(), cellGlobalIndices.end());
+  GlobalIndexTypeToCast* cellGlobalIndicesPtr = (cellGlobalIndicesCast.size() > 0) ? &cellGlobalIndicesCast[0] : NULL;
+  Epetra_Map overlapMap(-1, cellGlobalIndicesCast.size(), cellGlobalIndicesPtr, partMap.IndexBase(), partMap.Comm());
+
+  Epetra_Import importer(overlapMap, partMap);
+  Epetra_Vector bcFlags(overlapMap), bcValuesOverlap(overlapMap);
+  bcFlags.Import(bcFlagsOwned, importer, Insert);
+  bcValuesOverlap.Import(bcValuesOwned, importer, Insert);
+
+  bcValues.clear();
+  for (int lid=0; lid<overlapMap.NumMyElements(); lid++)
+  {
+    if (bcFlags[lid] > 0)
+    {
+      // each rank that found the BC contributed the same value; average the contributions
+      bcValues[overlapMap.GID(lid)] = bcValuesOverlap[lid] / bcFlags[lid];
+    }
+  }
+}
+
+template <typename Scalar>
+void TSolution<Scalar>::imposeBCValuesOnVectors(Intrepid::FieldContainer<GlobalIndexTypeToCast> &bcGlobalIndices,
+                                                Intrepid::FieldContainer<Scalar> &bcGlobalValues)
+{
+  int numBCs = bcGlobalIndices.size();
+  if (numBCs == 0)
+  {
+    //cout << "Solution: Warning: Imposing no BCs." << endl;
+    return;
+  }
+  // when assembling multiple loads, the same BC values apply to each
+  int numLoads = _rhsVector->NumVectors();
+  for (int loadOrdinal=0; loadOrdinal<numLoads; loadOrdinal++)
+  {
+    int err = _rhsVector->ReplaceGlobalValues(numBCs,&bcGlobalIndices(0),&bcGlobalValues(0),loadOrdinal);
+    if (err != 0)
+    {
+      cout << "ERROR: rhsVector.ReplaceGlobalValues(): some indices non-local...\n";
+    }
+    err = _lhsVector->ReplaceGlobalValues(numBCs,&bcGlobalIndices(0),&bcGlobalValues(0),loadOrdinal);
+    if (err != 0)
+    {
+      cout << "ERROR: rhsVector.ReplaceGlobalValues(): some indices non-local...\n";
+    }
+  }
+}
+
 template <typename Scalar>
 void TSolution<Scalar>::imposeZMCsUsingLagrange()
 {
   narrate("imposeZMCsUsingLagrange()");
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
 
   if (_zmcsAsRankOneUpdate)
   {
@@ -2086,7 +2428,7 @@ double TSolution<Scalar>::globalCondEstLastSolve()
 template <typename Scalar>
 void TSolution<Scalar>::integrateBasisFunctions(Intrepid::FieldContainer<GlobalIndexTypeToCast> &globalIndices, Intrepid::FieldContainer<Scalar> &values, int trialID)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
 
   // only supports scalar-valued field bases right now...
   int sideIndex = VOLUME_INTERIOR_SIDE_ORDINAL; // field variables only
@@ -2165,7 +2507,7 @@ void TSolution<Scalar>::integrateBasisFunctions(Intrepid::FieldContainer<GlobalI
 template <typename Scalar>
 void TSolution<Scalar>::integrateBasisFunctions(Intrepid::FieldContainer<Scalar> &values, ElementTypePtr elemTypePtr, int trialID)
 {
-  int rank = Teuchos::GlobalMPISession::getRank();
+  int rank = _mesh->Comm()->MyPID();
   vector<GlobalIndexType> cellIDs = _mesh->globalDofAssignment()->cellIDsOfElementType(rank,elemTypePtr);
 
   int numCellsOfType = cellIDs.size();
@@ -2420,7 +2762,7 @@ double TSolution<Scalar>::energyErrorTotal()
   {
     energyErrorSquared += (cellEnergyIt->second) * (cellEnergyIt->second);
   }
-  energyErrorSquared = MPIWrapper::sum(energyErrorSquared);
+  energyErrorSquared = MPIWrapper::sum(*_mesh->Comm(), energyErrorSquared);
   return sqrt(energyErrorSquared);
 }
 
@@ -2449,8 +2791,8 @@ const map<GlobalIndexType,double> & TSolution<Scalar>::globalEnergyError()
     globalCellEnergyErrors[lid] = rankLocalEnergy->find(cellID)->second;
     globalCellIDs[lid] = cellID;
   }
-  MPIWrapper::entryWiseSum(globalCellIDs);
-  MPIWrapper::entryWiseSum(globalCellEnergyErrors);
+  MPIWrapper::entryWiseSum(*_mesh->Comm(), globalCellIDs);
+  MPIWrapper::entryWiseSum(*_mesh->Comm(), globalCellEnergyErrors);
 
   for (int cellOrdinal=0; cellOrdinal<cellCount; cellOrdinal++)
   {
@@ -2726,6 +3068,51 @@ void TSolution<Scalar>::solutionValues(Intrepid::FieldContainer<Scalar> &values,
   }
   int spaceDim = basisCache->getSpaceDim();
   int numPoints = basisCache->getPhysicalCubaturePoints().dimension(1);
+
+  auto getTransformedValues = [&] (BasisPtr basis) -> Teuchos::RCP<const Intrepid::FieldContainer<Scalar> >
+  {
+    if (weightForCubature)
+    {
+      if (forceVolumeCoords)
+        return basisCache->getVolumeBasisCache()->getTransformedWeightedValues(basis,op,sideIndex,true);
+      else
+        return basisCache->getTransformedWeightedValues(basis, op);
+    }
+    else
+    {
+      if (forceVolumeCoords)
+        return basisCache->getVolumeBasisCache()->getTransformedValues(basis, op, sideIndex, true);
+      else
+        return basisCache->getTransformedValues(basis, op);
+    }
+  };
+
+  // fast path: when the cells with data share an element type (the usual case, since BasisCaches are built per element type),
+  // gather their coefficients into one contiguous (C,F) container, and apply them with one dense matrix-vector product per cell.
+  int coefficientSideIndex = fluxOrTrace ? sideIndex : VOLUME_INTERIOR_SIDE_ORDINAL;
+  Intrepid::FieldContainer<Scalar> coefficients;
+  ElementTypePtr elemType = gatherCoefficients(coefficients, cellIDs, trialID, coefficientSideIndex);
+  if (elemType != Teuchos::null)
+  {
+    if (coefficients.size() == 0) return; // no basis for trialID on this side; values are zero
+    BasisPtr basis = elemType->trialOrderPtr->getBasis(trialID, coefficientSideIndex);
+    Teuchos::RCP<const Intrepid::FieldContainer<Scalar> > transformedValues = getTransformedValues(basis);
+
+    int numFields = coefficients.dimension(1);
+    int valuesPerCell = (numCells > 0) ? values.size() / numCells : 0;
+    if ((transformedValues->dimension(0) == numCells) && (transformedValues->size() == numCells * numFields * valuesPerCell))
+    {
+      // transformedValues for each cell, viewed as a column-major (valuesPerCell x numFields) matrix, times that cell's coefficients
+      Teuchos::BLAS<int, Scalar> blas;
+      for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+      {
+        blas.GEMV(Teuchos::NO_TRANS, valuesPerCell, numFields, 1.0, &(*transformedValues)[cellOrdinal * numFields * valuesPerCell],
+                  valuesPerCell, &coefficients(cellOrdinal,0), 1, 0.0, &values[cellOrdinal * valuesPerCell], 1);
+      }
+      return;
+    }
+  }
+
   for (int cellIndex = 0; cellIndex < numCells; cellIndex++)
   {
     GlobalIndexType cellID = cellIDs[cellIndex];
@@ -2740,7 +3127,7 @@ void TSolution<Scalar>::solutionValues(Intrepid::FieldContainer<Scalar> &values,
     }
     else
     {
-      int rank = Teuchos::GlobalMPISession::getRank();
+      int rank = _mesh->Comm()->MyPID();
 //      cout << "In TSolution<Scalar>::solutionValues() on rank " << rank << ", data for cellID " << cellID << " found; container size is " << _solutionForCellIDGlobal[cellID].size() << endl;
     }
 
@@ -2761,29 +3148,7 @@ void TSolution<Scalar>::solutionValues(Intrepid::FieldContainer<Scalar> &values,
 
     int basisCardinality = basis->getCardinality();
 
-    Teuchos::RCP<const Intrepid::FieldContainer<Scalar> > transformedValues;
-    if (weightForCubature)
-    {
-      if (forceVolumeCoords)
-      {
-        transformedValues = basisCache->getVolumeBasisCache()->getTransformedWeightedValues(basis,op,sideIndex,true);
-      }
-      else
-      {
-        transformedValues = basisCache->getTransformedWeightedValues(basis, op);
-      }
-    }
-    else
-    {
-      if (forceVolumeCoords)
-      {
-        transformedValues = basisCache->getVolumeBasisCache()->getTransformedValues(basis, op, sideIndex, true);
-      }
-      else
-      {
-        transformedValues = basisCache->getTransformedValues(basis, op);
-      }
-    }
+    Teuchos::RCP<const Intrepid::FieldContainer<Scalar> > transformedValues = getTransformedValues(basis);
 
 //    cout << "solnCoeffs:\n" << *solnCoeffs;
 
@@ -3021,7 +3386,7 @@ void TSolution<Scalar>::solutionValues(Intrepid::FieldContainer<Scalar> &values,
     }
     // for the (P,D) version of this method, when the cell containing the point is off-rank, we have 0s.
     // We sum entrywise to get the missing values.
-    MPIWrapper::entryWiseSum(values);
+    MPIWrapper::entryWiseSum(*_mesh->Comm(), values);
   } // end (P,D)
 }
 
@@ -3309,6 +3674,54 @@ void TSolution<Scalar>::basisCoeffsForTrialOrder(Intrepid::FieldContainer<Scalar
   }
 }
 
+template <typename Scalar>
+ElementTypePtr TSolution<Scalar>::gatherCoefficients(Intrepid::FieldContainer<Scalar> &coefficients, const vector<GlobalIndexType> &cellIDs,
+                                                     int trialID, int sideIndex)
+{
+  int numCells = cellIDs.size();
+  vector<const Intrepid::FieldContainer<Scalar>*> cellCoefficients(numCells, NULL);
+  ElementTypePtr elemType;
+  for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+  {
+    GlobalIndexType cellID = cellIDs[cellOrdinal];
+    auto solnEntry = _solutionForCellIDGlobal.find(cellID);
+    if (solnEntry == _solutionForCellIDGlobal.end()) continue; // no data for cell: coefficients will be zero
+
+    ElementTypePtr cellElemType = _mesh->getElementType(cellID);
+    if (elemType == Teuchos::null)
+      elemType = cellElemType;
+    else if (elemType.get() != cellElemType.get())
+      return Teuchos::null;
+
+    if (solnEntry->second.size() == elemType->trialOrderPtr->totalDofs())
+      cellCoefficients[cellOrdinal] = &solnEntry->second;
+  }
+  if (elemType == Teuchos::null) return Teuchos::null;
+
+  DofOrderingPtr trialOrder = elemType->trialOrderPtr;
+  if (!trialOrder->hasBasisEntry(trialID, sideIndex))
+  {
+    coefficients = Intrepid::FieldContainer<Scalar>();
+    return elemType;
+  }
+
+  const vector<int>* dofIndices = &trialOrder->getDofIndices(trialID, sideIndex);
+  int numFields = dofIndices->size();
+  coefficients.resize(numCells, numFields);
+  coefficients.initialize(0.0);
+  for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+  {
+    const Intrepid::FieldContainer<Scalar>* cellCoeffs = cellCoefficients[cellOrdinal];
+    if (cellCoeffs == NULL) continue;
+    Scalar* coefficient = &coefficients(cellOrdinal,0);
+    for (int dofOrdinal=0; dofOrdinal<numFields; dofOrdinal++)
+    {
+      coefficient[dofOrdinal] = (*cellCoeffs)[(*dofIndices)[dofOrdinal]];
+    }
+  }
+  return elemType;
+}
+
 template <typename Scalar>
 void TSolution<Scalar>::solnCoeffsForCellID(Intrepid::FieldContainer<Scalar> &solnCoeffs, GlobalIndexType cellID, int trialID, int sideIndex)
 {
@@ -3330,7 +3743,7 @@ void TSolution<Scalar>::solnCoeffsForCellID(Intrepid::FieldContainer<Scalar> &so
 template <typename Scalar>
 const Intrepid::FieldContainer<Scalar>& TSolution<Scalar>::allCoefficientsForCellID(GlobalIndexType cellID, bool warnAboutOffRankImports)
 {
-  int myRank                    = Teuchos::GlobalMPISession::getRank();
+  int myRank                    = _mesh->Comm()->MyPID();
   PartitionIndexType cellRank   = _mesh->globalDofAssignment()->partitionForCellID(cellID);
 
   bool cellIsRankLocal = (cellRank == myRank);
@@ -4484,6 +4897,83 @@ void TSolution<Scalar>::writeToFile(const string &filePath)
   fout.close();
 }
 
+template <typename Scalar>
+string TSolution<Scalar>::checkpointFileNameForRank(string checkpointPrefix, int rank)
+{
+  ostringstream fileName;
+  fileName << checkpointPrefix << ".soln.ckpt." << rank;
+  return fileName.str();
+}
+
+template <typename Scalar>
+void TSolution<Scalar>::saveCheckpoint(string checkpointPrefix)
+{
+  _mesh->saveCheckpoint(checkpointPrefix + ".mesh.ckpt");
+
+  // each rank writes the local coefficients for the cells it owns
+  Epetra_CommPtr Comm = _mesh->Comm();
+  string fileName = checkpointFileNameForRank(checkpointPrefix, Comm->MyPID());
+  ofstream fout(fileName.c_str(), ios::binary);
+  TEUCHOS_TEST_FOR_EXCEPTION(!fout.good(), std::invalid_argument, "Could not open " << fileName << " for writing");
+  DataIO::writeBinaryTag(fout, "CamelliaSolutionCheckpoint", 1);
+  DataIO::writeBinary(fout, Comm->NumProc());
+
+  const set<GlobalIndexType>* myCellIDs = &_mesh->globalDofAssignment()->cellsInPartition(-1);
+  DataIO::writeBinary(fout, (long long) myCellIDs->size());
+  for (GlobalIndexType cellID : *myCellIDs)
+  {
+    vector<Scalar> coefficientsVector; // empty if no coefficients have been set for the cell
+    auto coefficientsEntry = _solutionForCellIDGlobal.find(cellID);
+    if ((coefficientsEntry != _solutionForCellIDGlobal.end()) && (coefficientsEntry->second.size() > 0))
+    {
+      const Intrepid::FieldContainer<Scalar>* coefficients = &coefficientsEntry->second;
+      coefficientsVector.insert(coefficientsVector.end(), &(*coefficients)[0], &(*coefficients)[0] + coefficients->size());
+    }
+    DataIO::writeBinary(fout, (long long) cellID);
+    DataIO::writeBinary(fout, coefficientsVector);
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(!fout.good(), std::invalid_argument, "Error while writing " << fileName);
+  fout.close();
+}
+
+template <typename Scalar>
+TSolutionPtr<Scalar> TSolution<Scalar>::loadFromCheckpoint(TBFPtr<Scalar> bf, string checkpointPrefix, Epetra_CommPtr Comm)
+{
+  MeshPtr mesh = MeshFactory::loadFromCheckpoint(bf, checkpointPrefix + ".mesh.ckpt", Comm);
+  TSolutionPtr<Scalar> solution = TSolution<Scalar>::solution(bf, mesh);
+
+  // the local coefficients are stored per rank, so we require the partitioning used when the checkpoint was written
+  int rank = mesh->Comm()->MyPID();
+  string fileName = checkpointFileNameForRank(checkpointPrefix, rank);
+  ifstream fin(fileName.c_str(), ios::binary);
+  TEUCHOS_TEST_FOR_EXCEPTION(!fin.good(), std::invalid_argument, "Could not open " << fileName << " for reading");
+  int version = DataIO::readBinaryTag(fin, "CamelliaSolutionCheckpoint");
+  TEUCHOS_TEST_FOR_EXCEPTION(version != 1, std::invalid_argument, "Unsupported solution checkpoint version " << version << " in " << fileName);
+  int numProcs = DataIO::readBinary<int>(fin);
+  TEUCHOS_TEST_FOR_EXCEPTION(numProcs != mesh->Comm()->NumProc(), std::invalid_argument,
+                             "Solution checkpoint was written with " << numProcs << " MPI ranks; loading requires the same number");
+
+  long long cellCount = DataIO::readBinary<long long>(fin);
+  for (long long cellOrdinal=0; cellOrdinal<cellCount; cellOrdinal++)
+  {
+    GlobalIndexType cellID = DataIO::readBinary<long long>(fin);
+    vector<Scalar> coefficientsVector = DataIO::readBinaryVector<Scalar>(fin);
+    TEUCHOS_TEST_FOR_EXCEPTION(mesh->partitionForCellID(cellID) != rank, std::invalid_argument,
+                               "cell " << cellID << " in " << fileName << " does not belong to rank " << rank);
+    if (coefficientsVector.size() == 0) continue;
+    Intrepid::FieldContainer<Scalar> coefficients(coefficientsVector.size());
+    for (int i=0; i<coefficientsVector.size(); i++)
+    {
+      coefficients[i] = coefficientsVector[i];
+    }
+    solution->_solutionForCellIDGlobal[cellID] = coefficients;
+  }
+  fin.close();
+
+  solution->setGlobalSolutionFromCellLocalCoefficients();
+  return solution;
+}
+
 #ifdef HAVE_EPETRAEXT_HDF5
 template <typename Scalar>
 void TSolution<Scalar>::save(string meshAndSolutionPrefix)
@@ -4516,6 +5006,7 @@ void TSolution<Scalar>::saveToHDF5(string filename)
 
   Epetra_CommPtr Comm = _mesh->Comm();
   
+  std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
   EpetraExt::HDF5 hdf5(*Comm);
   hdf5.Create(filename);
   if (_lhsVector == Teuchos::null)
@@ -4534,6 +5025,7 @@ void TSolution<Scalar>::loadFromHDF5(string filename)
   
   Epetra_CommPtr Comm = _mesh->Comm();
 
+  std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
   EpetraExt::HDF5 hdf5(*Comm);
   hdf5.Open(filename);
   Epetra_MultiVector *lhsVec;
@@ -4653,6 +5145,18 @@ double TSolution<Scalar>::zeroMeanConstraintRho()
   return _zmcRho;
 }
 
+template <typename Scalar>
+void TSolution<Scalar>::setEliminateBCsDuringAssembly(bool value)
+{
+  _eliminateBCsDuringAssembly = value;
+}
+
+template <typename Scalar>
+bool TSolution<Scalar>::eliminatesBCsDuringAssembly() const
+{
+  return _eliminateBCsDuringAssembly;
+}
+
 template <typename Scalar>
 bool TSolution<Scalar>::usesCondensedSolve() const
 {
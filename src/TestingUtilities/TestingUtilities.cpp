@@ -1,6 +1,8 @@
 #include "TestingUtilities.h"
 #include "ElementType.h"
 #include "Element.h"
+#include "MeshFactory.h"
+#include "PoissonFormulation.h"
 #include "RHS.h"
 
 using namespace Intrepid;
@@ -21,6 +23,27 @@ void TestingUtilities::initializeSolnCoeffs(TSolutionPtr<double> solution)
   }
 }
 
+TSolutionPtr<double> TestingUtilities::poissonSolutionWithStiffness(int spaceDim, int cellCount, int H1Order)
+{
+  bool useConformingTraces = true;
+  PoissonFormulation form(spaceDim, useConformingTraces);
+  vector<double> dimensions(spaceDim,1.0);
+  vector<int> elementCounts(spaceDim,cellCount);
+  int delta_k = 1;
+  MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+
+  RHSPtr rhs = RHS::rhs();
+  rhs->addTerm(1.0 * form.q());
+  BCPtr bc = BC::bc();
+  bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+  TSolutionPtr<double> solution = Solution::solution(mesh, bc, rhs, form.bf()->graphNorm());
+
+  solution->initializeLHSVector();
+  solution->initializeStiffnessAndLoad();
+  solution->populateStiffnessAndLoad();
+  return solution;
+}
+
 // checks if dof has a BC applied to it
 bool TestingUtilities::isBCDof(GlobalIndexType globalDofIndex, TSolutionPtr<double> solution)
 {
@@ -102,6 +102,10 @@ public:
   
   const std::vector< TBilinearTerm<Scalar> > & getJumpTerms() const;
 
+  // ! Collective: imports off-rank data (e.g., background-flow coefficients) needed by the terms' weights to evaluate on the
+  // ! cells of the BasisCaches.
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
+
   static int factoredCholeskySolve(Intrepid::FieldContainer<Scalar> &ipMatrix, Intrepid::FieldContainer<Scalar> &stiffnessEnriched,
                                    Intrepid::FieldContainer<Scalar> &rhsEnriched, Intrepid::FieldContainer<Scalar> &stiffness,
                                    Intrepid::FieldContainer<Scalar> &rhs);
@@ -110,6 +114,13 @@ public:
                                           TIPPtr<Scalar> ip, BasisCachePtr ipBasisCache,
                                           TRHSPtr<Scalar> rhs,  BasisCachePtr basisCache);
 
+  // ! computes the local stiffness matrix together with a local load vector for each entry of rhsList; loads should have dimensions
+  // ! (numRHS, numCells, numTrialDofs).  The Gram matrix factorization (or the optimal test weights) is computed once and shared by all loads.
+  // ! Subclasses that override localStiffnessMatrixAndRHS() should override this as well.
+  virtual void localStiffnessMatrixAndLoads(Intrepid::FieldContainer<Scalar> &localStiffness, Intrepid::FieldContainer<Scalar> &loads,
+                                            TIPPtr<Scalar> ip, BasisCachePtr ipBasisCache,
+                                            const std::vector< TRHSPtr<Scalar> > &rhsList, BasisCachePtr basisCache);
+
   // ! returns a list of test variables from VarFactory that do not enter the bilinear form
   std::vector<VarPtr> missingTestVars();
   
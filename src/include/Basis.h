@@ -107,6 +107,11 @@ public:
   virtual int rangeDimension() const;
   virtual int rangeRank() const;
 
+  // human-readable description of the basis; two bases with the same displayString() should have identical values.
+  // The default gives the basis type, degree, and conformity; subclasses that wrap other bases (or that have a
+  // choice of nodal points) include that information as well.
+  virtual std::string displayString() const;
+
   virtual void getValues(ArrayScalar &values, const ArrayScalar &refPoints, Intrepid::EOperator operatorType) const = 0;
 
   virtual void CHECK_VALUES_ARGUMENTS(const ArrayScalar &values, const ArrayScalar &refPoints, Intrepid::EOperator operatorType) const;
@@ -121,6 +126,7 @@ template<class Scalar, class ArrayScalar> class IntrepidBasisWrapper : public Ba
 private:
   Teuchos::RCP< Intrepid::Basis<Scalar,ArrayScalar> > _intrepidBasis;
   Teuchos::RCP< Camellia::Basis<Scalar,ArrayScalar> > _continuousBasis; // continuous version of the same basis, if this basis is discontinuous
+  mutable std::string _displayString; // computed on first request; includes the Intrepid basis's nodal points, when it has them
 protected:
   void initializeTags() const;
 public:
@@ -133,6 +139,8 @@ public:
   virtual bool isNodal() const;      // true for the Intrepid bases
 
   virtual std::set<int> dofOrdinalsForSide(int sideOrdinal) const;
+
+  std::string displayString() const;
   
   void getValues(ArrayScalar &values, const ArrayScalar &refPoints, Intrepid::EOperator operatorType) const;
 };
@@ -65,6 +65,8 @@ namespace Camellia
 class BasisCache
 {
 private:
+  static int _cubaturePhaseCacheSize; // in bytes; 0 means no phasing (see static setter, below)
+
   IndexType _numCells;
   int _spaceDim;
   bool _isSideCache;
@@ -73,12 +75,15 @@ private:
   int _maxPointsPerCubaturePhase; // default: -1 (infinite)
   int _cubaturePhase; // index of the cubature phase; defaults to 0
   int _cubaturePhaseCount; // how many phases to get through all the points
+  bool _allCubPointsRestorePending; // phasing has ended, but _cubPoints still holds the last phase's points (see restoreAllCubaturePoints())
   std::vector<int> _phasePointOrdinalOffsets;
 
   MeshPtr _mesh;
   Intrepid::FieldContainer<double> _cubPoints, _cubWeights;
   Intrepid::FieldContainer<double> _allCubPoints, _allCubWeights; // when using phased cubature points, these store the whole set
 
+  void restoreAllCubaturePoints(); // called lazily by accessors that need the whole set of points after phasing has ended
+
   Intrepid::FieldContainer<double> _cellJacobian;
   Intrepid::FieldContainer<double> _cellJacobInv;
   Intrepid::FieldContainer<double> _cellJacobDet;
@@ -222,9 +227,16 @@ public:
   int cubatureDegree();
 
   int getCubaturePhaseCount();
+  // ! setMaxPointsPerCubaturePhase(-1) ends phasing.  The whole set of points is restored lazily, when an accessor next
+  // ! needs it, so that geometry is not recomputed for all points between phased element batches.
   void setMaxPointsPerCubaturePhase(int maxPoints);
   void setCubaturePhase(int phaseOrdinal);
 
+  // ! Returns the number of cubature points per phase for which transformed basis values of the given total cardinality
+  // ! fit in the size set by setCubaturePhaseCacheSize(), or -1 if phasing is disabled, unnecessary (all points fit), or
+  // ! unsupported for this cache (side and space-time caches are not phased).
+  int maxPointsPerCubaturePhaseForCache(int totalBasisCardinality);
+
   MeshPtr mesh();
   void setMesh(MeshPtr mesh);
 
@@ -283,6 +295,12 @@ public:
   void setTransformationFunction(TFunctionPtr<double> fxn, bool composeWithMeshTransformation = true);
 
   // static convenience constructors:
+  // ! Sets the cache size (in bytes) targeted by cubature phasing during element integration (BF::stiffnessMatrix() and
+  // ! IP::computeInnerProductMatrix()).  0, the default, disables phasing: the size is not detected automatically, so callers
+  // ! that want phasing must set it -- typically to the per-core L2 cache size (e.g., 256 KB on many x86 processors).
+  static void setCubaturePhaseCacheSize(int cacheSizeInBytes);
+  static int cubaturePhaseCacheSize();
+
   static BasisCachePtr parametric1DCache(int cubatureDegree);
   static BasisCachePtr parametricQuadCache(int cubatureDegree);
   static BasisCachePtr parametricQuadCache(int cubatureDegree, const Intrepid::FieldContainer<double> &refCellPoints, int sideCacheIndex=-1);
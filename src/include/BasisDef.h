@@ -5,6 +5,10 @@
 //  Created by Nathan Roberts on 3/22/13.
 //
 //
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
 #include "Teuchos_TestForException.hpp"
 
 #include "Intrepid_Basis.hpp"
@@ -99,6 +103,16 @@ int Basis<Scalar,ArrayScalar>::getDegree() const
   return this->_basisDegree;
 }
 
+template<class Scalar, class ArrayScalar>
+std::string Basis<Scalar,ArrayScalar>::displayString() const
+{
+  std::ostringstream str;
+  str << typeid(*this).name() << "(degree " << this->getDegree();
+  if (this->isConforming()) str << ", conforming";
+  str << ")";
+  return str.str();
+}
+
 template<class Scalar, class ArrayScalar>
 int Basis<Scalar, ArrayScalar>::getDofOrdinal(const int subcDim,
     const int subcOrd,
@@ -653,6 +667,31 @@ Teuchos::RCP< Intrepid::Basis<Scalar,ArrayScalar> > IntrepidBasisWrapper<Scalar,
     }
   }
   
+template<class Scalar, class ArrayScalar>
+std::string IntrepidBasisWrapper<Scalar,ArrayScalar>::displayString() const
+{
+  if (_displayString.size() == 0)
+  {
+    std::ostringstream str;
+    str << typeid(*_intrepidBasis).name() << "(degree " << _intrepidBasis->getDegree();
+    // nodal bases of the same type and degree can still differ in their choice of points (equispaced vs. spectral, e.g.)
+    const Intrepid::DofCoordsInterface<ArrayScalar>* nodalBasis = dynamic_cast<const Intrepid::DofCoordsInterface<ArrayScalar>*>(_intrepidBasis.get());
+    if (nodalBasis != NULL)
+    {
+      ArrayScalar dofCoords(this->_basisCardinality, this->_domainTopology->getDimension());
+      nodalBasis->getDofCoords(dofCoords);
+      str << "; points" << std::setprecision(12);
+      for (int i=0; i<dofCoords.size(); i++)
+      {
+        str << " " << dofCoords[i];
+      }
+    }
+    str << ")";
+    _displayString = str.str();
+  }
+  return _displayString;
+}
+
 template<class Scalar, class ArrayScalar>
 void IntrepidBasisWrapper<Scalar,ArrayScalar>::getValues(ArrayScalar &values, const ArrayScalar &refPoints, Intrepid::EOperator operatorType) const
 {
@@ -70,6 +70,19 @@ private:
   typedef pair<PermutedRefinedBasisPairDomainOrdinals, FieldOps> TermTracedCacheKey;
   map<TermTracedCacheKey, SubBasisReconciliationWeights> _termsTraced;
   
+  // persistent weights, shared by all BasisReconciliation instances.  Keys are built from basis identity, refinement branch
+  // geometry, and permutation (see persistentKey()), so that they are meaningful across runs.
+  static bool _usePersistentWeights;
+  static std::map< std::string, SubBasisReconciliationWeights > _persistentWeights;
+  static int _persistentWeightsHitCount;
+  static const unsigned PERSISTENT_WEIGHTS_VERSION;
+
+  static std::string basisIdentity(Camellia::Basis<>* basis);
+  static std::string refinementBranchIdentity(const RefinementBranch &refinements);
+  static std::string persistentKey(unsigned subcellDimension, BasisPtr finerBasis, unsigned finerBasisSubcellOrdinal,
+                                   const RefinementBranch &refinements, BasisPtr coarserBasis, unsigned coarserBasisSubcellOrdinal,
+                                   unsigned vertexNodePermutation);
+
   static Intrepid::FieldContainer<double> filterBasisValues(const Intrepid::FieldContainer<double> &basisValues, std::set<int> &filter);
 
   static SubBasisReconciliationWeights filterToInclude(std::set<int> &rowOrdinals, std::set<int> &colOrdinals, const SubBasisReconciliationWeights &weights);
@@ -153,6 +166,27 @@ public:
 
   static unsigned minimumSubcellDimension(BasisPtr basis); // for continuity enforcement
 
+  // ! Reads subcell reconciliation weights written by savePersistentWeights() into the process-wide persistent store, and
+  // ! enables recording of newly computed weights.  Returns false (leaving the store unchanged) if the file does not exist
+  // ! or was written with a different format version.  Every rank may read the same file; it is only read.
+  static bool loadPersistentWeights(const std::string &fileName);
+  
+  // ! Writes the process-wide persistent store (weights loaded or computed while persistence was enabled) to a binary file.
+  static void savePersistentWeights(const std::string &fileName);
+  
+  // ! When true, subcell reconciliation weights are looked up in, and recorded to, the process-wide persistent store.  Default is false.
+  static void setUsePersistentWeights(bool value);
+  
+  // ! Number of entries in the process-wide persistent store.
+  static int persistentWeightsCount();
+  
+  // ! Number of times constrainedWeights() has found its weights in the persistent store instead of computing them, since the
+  // ! store was last cleared.
+  static int persistentWeightsHitCount();
+  
+  // ! Empties the process-wide persistent store, and resets the hit count.
+  static void clearPersistentWeights();
+
 public:
   // !! this method exposed publicly primarily for testing purposes.
   static void mapFineSubcellPointsToCoarseDomain(Intrepid::FieldContainer<double> &coarseDomainPoints, const Intrepid::FieldContainer<double> &fineSubcellPoints,
@@ -0,0 +1,52 @@
+//
+//  BlockCGSolver.h
+//  Camellia
+//
+
+#ifndef Camellia_BlockCGSolver_h
+#define Camellia_BlockCGSolver_h
+
+#include "Solver.h"
+
+#include "Epetra_Operator.h"
+
+namespace Camellia
+{
+  //! BlockCGSolver: preconditioned block conjugate gradients for SPD systems with several right-hand sides.
+  /*!
+   Wraps Belos's block CG solver manager.  All columns of the RHS multi-vector are iterated on together: each iteration applies
+   the operator and the preconditioner to a block of vectors at once, and the Krylov space built for one right-hand side is
+   shared by the others, so that solving for k loads typically takes considerably fewer than k times the iterations (and
+   operator applications) of separate CG solves.  When the RHS has a single column, this reduces to standard preconditioned CG.
+
+   Convergence is declared when each column satisfies ||r_j|| <= tol * ||b_j||.  The initial guess is taken from the LHS vector.
+   The preconditioner, if provided, is applied through its ApplyInverse() method.
+   */
+  class BlockCGSolver : public Solver
+  {
+    int _maxIters;
+    double _tol;
+    bool _printToConsole;
+    Teuchos::RCP<Epetra_Operator> _preconditioner;
+
+    int _iterationCount; // for the last call to solve()
+  public:
+    BlockCGSolver(int maxIters, double tol, Teuchos::RCP<Epetra_Operator> preconditioner = Teuchos::null);
+
+    //! Returns the number of block iterations taken by the last call to solve().
+    int iterationCount() const;
+
+    //! Sets the preconditioner, which is applied through its ApplyInverse() method.
+    void setPreconditioner(Teuchos::RCP<Epetra_Operator> preconditioner);
+
+    void setPrintToConsole(bool printToConsole);
+
+    void setTolerance(double tol);
+    double getTolerance();
+
+    //! Returns 0 if all right-hand sides converged, and 1 otherwise.
+    int solve();
+  };
+}
+
+#endif
@@ -47,6 +47,8 @@
 
 #include "DofInterpreter.h"
 
+#include "Projector.h"
+
 #include "Epetra_Map.h"
 
 namespace Camellia
@@ -57,6 +59,49 @@ class Boundary
 
   MeshPtr _mesh;
   bool _imposeSingletonBCsOnThisRank; // this only governs singleton BCs which don't specify a vertex number.  Otherwise, the rule is that a singleton BC is imposed on the rank that owns the active cell of least ID that contains the vertex.
+
+  // rank-local boundary sides, grouped by element type and side ordinal so that BC functions can be projected for
+  // all the cells in a group at once.  For each group we keep just the cell nodes and side parities, and, per trial ID,
+  // the interpolating projection onto the side basis (with its Gram matrices factored) and each cell's map from side
+  // coefficients to constrained global dofs.  A new BC function therefore costs only the load vectors, back-substitutions,
+  // and small matrix-vector products.  The groups are rebuilt by buildLookupTables(), or when the rank-local cells, their
+  // types, the mesh transformation function, or the topology's geometry version change; the global dof maps are also
+  // rebuilt when a different DofInterpreter (or global dof count) is seen.
+  struct BoundarySideProjection
+  {
+    Teuchos::RCP<Projector<double>::InterpolatingProjection> projection;
+    std::vector<std::vector<GlobalIndexType>> globalDofIndices; // for each cell in the group
+    std::vector<Intrepid::FieldContainer<double>> localToGlobal; // for each cell: (globalDofOrdinal, sideDofOrdinal)
+  };
+  struct BoundarySideBatch
+  {
+    ElementTypePtr elemType;
+    unsigned sideOrdinal;
+    std::vector<GlobalIndexType> cellIDs;
+    Intrepid::FieldContainer<double> physicalCellNodes; // (cell, node, dim)
+    Intrepid::FieldContainer<double> cellSideParities;  // (cell, side)
+    std::map<int, BoundarySideProjection> projections;  // keys are trial IDs
+  };
+  std::vector<BoundarySideBatch> _boundarySideBatches;
+  std::set<GlobalIndexType> _boundarySideBatchCellIDs;
+  FunctionPtr _boundarySideBatchTransformationFunction;
+  unsigned long _boundarySideBatchGeometryVersion;
+  bool _boundarySideBatchesBuilt;
+  DofInterpreter* _boundarySideBatchDofInterpreter;
+  GlobalIndexType _boundarySideBatchGlobalDofCount;
+
+  void buildBoundarySideBatches();
+  bool boundarySideBatchesAreValid();
+  BasisCachePtr sideBasisCacheForBatch(const BoundarySideBatch &batch); // built on demand, not retained
+
+  // projects the Dirichlet BCs on each batch of boundary sides, and interprets the result as global coefficients
+  template <typename Scalar>
+  void dirichletBCsToImpose(std::map<GlobalIndexType,Scalar> &globalDofIndicesAndValues, TBC<Scalar> &bc, DofInterpreter* dofInterpreter);
+
+  // imposes single-point BCs on the specified cell; pairs in singletons are (trialID, vertexOrdinalInCell)
+  template <typename Scalar>
+  void singletonBCsToImpose(std::map<GlobalIndexType,Scalar> &globalDofIndicesAndValues, TBC<Scalar> &bc, GlobalIndexType cellID,
+                            std::set<std::pair<int, unsigned>> &singletons, DofInterpreter* dofInterpreter);
 public:
   Boundary();
   void setMesh(MeshPtr mesh);
@@ -23,6 +23,7 @@ public:
   void setPrintToConsole(bool printToConsole);
   int solve();
   void setTolerance(double tol);
+  double getTolerance();
 };
 }
 
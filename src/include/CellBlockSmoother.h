@@ -0,0 +1,91 @@
+//
+//  CellBlockSmoother.h
+//  Camellia
+//
+
+#ifndef Camellia_CellBlockSmoother_h
+#define Camellia_CellBlockSmoother_h
+
+#include "TypeDefs.h"
+
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Operator.h"
+
+#include "DofInterpreter.h"
+#include "Mesh.h"
+
+namespace Camellia
+{
+  //! CellBlockSmoother: block relaxation whose blocks are the (locally owned) degrees of freedom of each rank-local cell.
+  /*!
+   Each locally owned row of the matrix is assigned to exactly one block: the first rank-local cell whose degrees of freedom
+   include it.  Rows that belong to no rank-local cell form singleton blocks.  On Compute(), the diagonal blocks are gathered
+   directly from the Epetra_CrsMatrix rows into contiguous storage and factored in a single pass (Cholesky where possible,
+   LU otherwise); ApplyInverse() then applies the block inverses with LAPACK triangular solves, handling all vectors of the
+   multivector at once.  The local row indices of each block are precomputed, so no maps are consulted during application.
+
+   The symmetric Gauss-Seidel variant performs a forward and a backward block sweep using only the rank-local columns of the
+   matrix (i.e., it is processor-block Gauss-Seidel, as in Ifpack).
+
+   When single precision is requested, the blocks are factored in double precision and the factors are then stored (and the
+   triangular solves performed) in single precision, halving the memory traffic of the block solves.  Residuals and vectors
+   remain in double precision.
+   */
+  class CellBlockSmoother : public Epetra_Operator
+  {
+  public:
+    enum RelaxationType
+    {
+      BLOCK_JACOBI,
+      BLOCK_SYMMETRIC_GAUSS_SEIDEL
+    };
+  private:
+    Epetra_CrsMatrix* _matrix;
+    MeshPtr _mesh;
+    Teuchos::RCP<DofInterpreter> _dofInterpreter;
+    RelaxationType _relaxationType;
+
+    std::vector<int> _blockOffsets;   // entries for block b are in [_blockOffsets[b], _blockOffsets[b+1]) of _blockRowLIDs and _pivots
+    std::vector<int> _blockRowLIDs;   // local row indices of each block, used to gather and scatter vector entries
+    std::vector<int> _factorOffsets;  // the factored block b occupies [_factorOffsets[b], _factorOffsets[b+1]) of _factors
+    std::vector<double> _factors;     // column-major factored diagonal blocks
+    std::vector<float> _factorsSingle; // used in place of _factors when _useSinglePrecision is true
+    std::vector<int> _pivots;         // LU pivots (used only for blocks that are not positive definite)
+    std::vector<bool> _isCholesky;    // true if block b was factored with Cholesky, false if LU
+    std::vector<int> _blockForRowLID;
+    std::vector<int> _rowLIDForColLID; // -1 for columns that are not locally owned rows
+    int _maxBlockSize;
+    bool _useSinglePrecision;
+
+    void determineBlocks();
+    void solveBlock(int blockOrdinal, double* values, int numVectors, float* singleWork) const;
+  public:
+    CellBlockSmoother(Epetra_CrsMatrix* matrix, MeshPtr mesh, Teuchos::RCP<DofInterpreter> dofInterpreter,
+                      RelaxationType relaxationType = BLOCK_JACOBI);
+
+    //! Gathers and factors the diagonal blocks.  Must be called before ApplyInverse(), and again if the matrix values change.
+    int Compute();
+
+    int NumBlocks() const;
+
+    //! Bytes used to store the factored blocks (single- or double-precision, as requested).
+    long long factorStorageBytes() const;
+
+    //! If true, factors are stored and applied in single precision.  Takes effect on the next call to Compute().  Default: false.
+    void setUseSinglePrecision(bool value);
+
+    // Epetra_Operator interface
+    int SetUseTranspose(bool UseTranspose);
+    int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+    int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+    double NormInf() const;
+    const char * Label() const;
+    bool UseTranspose() const;
+    bool HasNormInf() const;
+    const Epetra_Comm & Comm() const;
+    const Epetra_Map & OperatorDomainMap() const;
+    const Epetra_Map & OperatorRangeMap() const;
+  };
+}
+
+#endif
@@ -19,6 +19,12 @@ public:
   static int dataSize(Mesh* mesh, GlobalIndexType cellID);
   static void packData(Mesh* mesh, GlobalIndexType cellID, bool packParentDofs, char *dataBuffer, int size);
   static void unpackData(Mesh* mesh, GlobalIndexType cellID, const char *dataBuffer, int size);
+
+  // ! Sends the registered solution data for each of exportCellIDs to the corresponding rank in exportRanks, and
+  // ! unpacks the data received from other ranks.  Must be called on all ranks in mesh->Comm(), after the new partitions
+  // ! have been set.  (Partition policies that use Zoltan migrate the data through Zoltan instead.)
+  // ! Returns the number of bytes sent from this rank.
+  static int migrate(Mesh* mesh, const std::vector<GlobalIndexType> &exportCellIDs, const std::vector<int> &exportRanks);
 };
 }
 
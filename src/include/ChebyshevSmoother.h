@@ -0,0 +1,69 @@
+//
+//  ChebyshevSmoother.h
+//  Camellia
+//
+
+#ifndef Camellia_ChebyshevSmoother_h
+#define Camellia_ChebyshevSmoother_h
+
+#include "TypeDefs.h"
+
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Operator.h"
+
+namespace Camellia
+{
+  //! ChebyshevSmoother: polynomial smoother for A, preconditioned by a (block) diagonal operator D.
+  /*!
+   ApplyInverse() applies p(D^{-1} A) D^{-1}, where p is the Chebyshev polynomial of the specified degree that is smallest on
+   the interval [lambdaMax / eigenvalueRatio, lambdaMax], lambdaMax being an estimate for the largest eigenvalue of D^{-1} A.
+   The estimate is computed by a few power iterations on Compute() (unless one is provided), and may be reused when the matrix
+   changes only slightly.  Application requires only matrix-vector products and applications of D^{-1}, so there is no
+   sweep order, and none of the rank-dependent ordering of a parallel Gauss-Seidel smoother.  The smoother does still depend
+   on the partition when D does: a cell-block diagonal, for instance, only couples the dofs owned by each rank, so changing
+   the number of MPI ranks (or the partition) changes D, and with it the smoother's action.
+
+   D is supplied as an Epetra_Operator whose ApplyInverse() applies D^{-1} (e.g., a CellBlockSmoother in BLOCK_JACOBI mode).
+   */
+  class ChebyshevSmoother : public Epetra_Operator
+  {
+    Epetra_CrsMatrix* _matrix;
+    Teuchos::RCP<Epetra_Operator> _diagonalInverse;
+    int _degree;
+    double _eigenvalueRatio;
+    double _maxEigenvalue; // -1 until computed
+    int _powerIterations;
+  public:
+    ChebyshevSmoother(Epetra_CrsMatrix* matrix, Teuchos::RCP<Epetra_Operator> diagonalInverse, int degree = 3,
+                      double eigenvalueRatio = 30.0, double maxEigenvalue = -1.0);
+
+    //! Estimates the largest eigenvalue of D^{-1} A, if no estimate has been provided.
+    int Compute();
+
+    //! Estimates the largest eigenvalue of D^{-1} A using the specified number of power iterations.  The estimate is padded by 10 percent.
+    double estimateMaxEigenvalue(int numIterations);
+
+    //! Returns the estimate for the largest eigenvalue of D^{-1} A (-1 if none has been computed).
+    double maxEigenvalue() const;
+
+    //! Returns the operator that applies D^{-1}.
+    Teuchos::RCP<Epetra_Operator> getDiagonalInverse() const;
+
+    //! Sets the number of power iterations used by Compute() (default: 10).
+    void setPowerIterations(int numIterations);
+
+    // Epetra_Operator interface
+    int SetUseTranspose(bool UseTranspose);
+    int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+    int ApplyInverse(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+    double NormInf() const;
+    const char * Label() const;
+    bool UseTranspose() const;
+    bool HasNormInf() const;
+    const Epetra_Comm & Comm() const;
+    const Epetra_Map & OperatorDomainMap() const;
+    const Epetra_Map & OperatorRangeMap() const;
+  };
+}
+
+#endif
@@ -11,6 +11,11 @@
 
 #include "Teuchos_TestForException.hpp"
 
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace Camellia
 {
 class DataIO
@@ -122,6 +127,66 @@ public:
     fout.close();
   }
 
+  // HDF5 is not thread-safe, and HDF5Exporter may write from a background thread.  Every HDF5 call in Camellia should be made
+  // while holding this (process-wide) lock.
+  static std::recursive_mutex &hdf5Mutex()
+  {
+    static std::recursive_mutex mutex;
+    return mutex;
+  }
+
+  // binary I/O for checkpoint files.  Values are written in the native byte order and type sizes of the writing
+  // machine, so checkpoints should be read on the same platform that wrote them.
+  template<typename T>
+  static void writeBinary(std::ostream &out, const T &value)
+  {
+    out.write((const char*) &value, sizeof(T));
+  }
+
+  template<typename T>
+  static void writeBinary(std::ostream &out, const std::vector<T> &values)
+  {
+    writeBinary(out, (long long) values.size());
+    if (values.size() > 0) out.write((const char*) &values[0], values.size() * sizeof(T));
+  }
+
+  template<typename T>
+  static T readBinary(std::istream &in)
+  {
+    T value;
+    in.read((char*) &value, sizeof(T));
+    TEUCHOS_TEST_FOR_EXCEPTION(!in.good(), std::invalid_argument, "unexpected end of binary data");
+    return value;
+  }
+
+  template<typename T>
+  static std::vector<T> readBinaryVector(std::istream &in)
+  {
+    long long size = readBinary<long long>(in);
+    TEUCHOS_TEST_FOR_EXCEPTION(size < 0, std::invalid_argument, "invalid vector size in binary data");
+    std::vector<T> values(size);
+    if (size > 0)
+    {
+      in.read((char*) &values[0], size * sizeof(T));
+      TEUCHOS_TEST_FOR_EXCEPTION(!in.good(), std::invalid_argument, "unexpected end of binary data");
+    }
+    return values;
+  }
+
+  static void writeBinaryTag(std::ostream &out, const std::string &tag, int version)
+  {
+    out.write(tag.c_str(), tag.size());
+    writeBinary(out, version);
+  }
+
+  // ! reads a tag written by writeBinaryTag(), throwing if the tag does not match; returns the version
+  static int readBinaryTag(std::istream &in, const std::string &tag)
+  {
+    std::string tagRead(tag.size(), ' ');
+    in.read(&tagRead[0], tag.size());
+    TEUCHOS_TEST_FOR_EXCEPTION(!in.good() || (tagRead != tag), std::invalid_argument, "binary data does not begin with " << tag);
+    return readBinary<int>(in);
+  }
 };
 }
 
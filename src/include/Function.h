@@ -73,6 +73,10 @@ public:
   virtual TFunctionPtr<Scalar> grad(int numComponents=-1);
 
   virtual void importCellData(std::vector<GlobalIndexType> cellIDs) {}
+  // ! Collective: imports whatever off-rank data is needed to evaluate on the cells of the BasisCaches (e.g., every element-type
+  // ! batch of an assembly) in one step.  The default calls importCellData() with those cells; composite functions forward to
+  // ! their operands.
+  virtual void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
 
   // inverse() presently unused: and unclear how useful...
   //  virtual TFunctionPtr<Scalar> inverse();
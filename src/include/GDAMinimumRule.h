@@ -125,6 +125,11 @@ class GDAMinimumRule : public GlobalDofAssignment
   map< GlobalIndexType, SubCellDofIndexInfo> _globalDofIndicesForCellCache; // (cellID --> SubCellDofIndexInfo) -- this has a lot of overlap in its data with the _ownedGlobalDofIndicesCache; could save some memory by only storing the difference
   map< pair<GlobalIndexType,pair<int,unsigned>>, set<GlobalIndexType>> _fittableGlobalIndicesCache; // keys: (cellID,(varID,sideOrdinal))
   
+  bool _useIncrementalRebuild = true;
+  bool _lookupsBuilt = false; // once true, rebuildLookups() may retain cached constraints for cells away from recent mesh changes
+  bool _fullRebuildRequired = false; // set when a mesh change is not tracked in _cellsChangedSinceRebuild (e.g. h-unrefinement)
+  set<GlobalIndexType> _cellsChangedSinceRebuild; // h-refined parents and p-refined cells (with their ancestors)
+  
   vector<unsigned> allBasisDofOrdinalsVector(int basisCardinality);
 
   static string annotatedEntityToString(AnnotatedEntity &entity);
@@ -136,6 +141,8 @@ class GDAMinimumRule : public GlobalDofAssignment
   typedef pair< IndexType, unsigned > CellPair;
   CellPair cellContainingEntityWithLeastH1Order(int d, IndexType entityIndex);
   
+  set<GlobalIndexType> cellsAffectedByChangesTo(const set<GlobalIndexType> &changedCellIDs);
+  
   AnnotatedEntity* getConstrainingEntityInfo(GlobalIndexType cellID, CellConstraints &cellConstraints, VarPtr var, int d, int scord);
   void getConstrainingEntityInfo(GlobalIndexType cellID, CellConstraints &cellConstraints, VarPtr var, int d, int scord,
                                  AnnotatedEntity* &constrainingInfo, OwnershipInfo* &ownershipInfo, bool &spaceOnlyConstraint);
@@ -183,6 +190,11 @@ public:
   // ! Default is false.  Checking constraint consistency is useful for debugging purposes, though.
   void setCheckConstraintConsistency(bool value);
   
+  // ! Default is true.  When true, rebuildLookups() following a local refinement recomputes constraints and owned dofs only
+  // ! for active cells within two vertex-neighbor layers of the refined cells; other cells keep their cached values, and
+  // ! only their global dof offsets are updated.  A full rebuild is done after h-unrefinement or when cascading constraints are allowed.
+  void setUseIncrementalRebuild(bool value);
+  
   GlobalDofAssignmentPtr deepCopy();
 
   void didHRefine(const set<GlobalIndexType> &parentCellIDs);
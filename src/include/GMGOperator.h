@@ -16,6 +16,7 @@
 #include "LocalDofMapper.h"
 #include "Mesh.h"
 #include "RefinementPattern.h"
+#include "SinglePrecisionCrsMatrix.h"
 #include "Solution.h"
 #include "Solver.h"
 
@@ -48,6 +49,9 @@ public:
     BLOCK_SYMMETRIC_GAUSS_SEIDEL,
     IFPACK_ADDITIVE_SCHWARZ,
     CAMELLIA_ADDITIVE_SCHWARZ,
+    CAMELLIA_BLOCK_JACOBI,                // native cell-block Jacobi (see CellBlockSmoother)
+    CAMELLIA_BLOCK_SYMMETRIC_GAUSS_SEIDEL, // native cell-block symmetric Gauss-Seidel (see CellBlockSmoother)
+    CHEBYSHEV,                            // Chebyshev polynomial smoother, preconditioned by cell-block Jacobi (see ChebyshevSmoother)
     NONE
   };
   
@@ -110,6 +114,11 @@ private:
   MultigridStrategy _multigridStrategy;
   Teuchos::RCP<Epetra_CrsMatrix> _P; // prolongation operator
 
+  bool _useSinglePrecision = false;
+  bool _keepDoublePrecisionProlongation = false; // when false, _P is released once _P_single exists
+  Teuchos::RCP<SinglePrecisionCrsMatrix> _P_single; // single-precision copy of _P used for grid transfers when _useSinglePrecision is true
+  void setUpSinglePrecisionOperators();
+
   Teuchos::RCP<Epetra_Operator> _smoother;
   double _smootherWeight;
   int _smootherApplicationCount; // default to 1, but 2 may often be a better choice (especially when doing more than 2 levels)
@@ -324,6 +333,31 @@ public:
   void setSmootherType(SmootherChoice smootherType);
   void setSmootherOverlap(int overlap);
 
+  // ! Sets the polynomial degree of the smoother, if CHEBYSHEV is the smoother choice.  Default = 3.
+  void setChebyshevDegree(int degree);
+  // ! Sets the ratio of the largest to the smallest eigenvalue targeted by the smoother, if CHEBYSHEV is the smoother choice.  Default = 30.
+  void setChebyshevEigenvalueRatio(double ratio);
+  // ! Returns the estimate of the largest eigenvalue of the block-Jacobi-preconditioned fine matrix used by the Chebyshev smoother (-1 if none).
+  // ! The estimate is recomputed by setFineStiffnessMatrix(), and reused by refreshSmoother().
+  double getChebyshevMaxEigenvalue() const;
+
+  // ! When true, the prolongation operator and the factors of the native block smoothers are stored and applied in single precision;
+  // ! vectors, the level matrices, and the coarsest solve remain in double precision.  Takes effect on the next call to
+  // ! setFineStiffnessMatrix().  Default = false.
+  // ! Unless setKeepDoublePrecisionProlongation(true) is called, the double-precision prolongation operator is released once its
+  // ! single-precision copy exists; later Galerkin products use the rounded entries, which are the ones applied in the grid transfers.
+  // ! The coarse matrices are not copied to single precision: the coarser levels' smoothers factor them and the coarsest solve
+  // ! applies them in double precision, so a copy would add to the storage rather than reduce it.
+  void setUseSinglePrecision(bool value);
+  bool getUseSinglePrecision() const;
+
+  // ! Bytes used on this level to store the prolongation operator (values and column indices) and the factors of a native block
+  // ! smoother.  The level's matrix is not counted: it belongs to the caller (finest level) or to the next finer level.
+  long long getStorageBytes() const;
+
+  // ! When true, the double-precision prolongation operator is retained alongside its single-precision copy.  Default = false.
+  void setKeepDoublePrecisionProlongation(bool value);
+
   // ! Computed as 1/(1+N), where N = max #neighbors of any cell's overlap region.
   double computeSchwarzSmootherWeight();
   // ! smoother weight is applied to each application of the smoother. Default = 1.0
@@ -355,7 +389,8 @@ public:
   //! Computes an Epetra_CrsMatrix representation of this operator.  Note that this can be an expensive operation, and is primarily intended for testing.
   Teuchos::RCP<Epetra_CrsMatrix> getMatrixRepresentation();
   
-  //! Returns the prolongation operator (an Epetra_CrsMatrix).
+  //! Returns the prolongation operator (an Epetra_CrsMatrix).  If the double-precision operator has been released in favor of its
+  //! single-precision copy, a new double-precision matrix is constructed from the copy.
   Teuchos::RCP<Epetra_CrsMatrix> getProlongationOperator(); // prolongation operator
 
   //! Constructs and returns an Epetra_CrsMatrix for the smoother.  Note that this can be an expensive operation.  Primarily intended for testing.
@@ -370,6 +405,10 @@ public:
   //! Set the fine stiffness matrix; calls computeCoarseStiffnessMatrix() and setUpSmoother()
   void setFineStiffnessMatrix(Epetra_CrsMatrix* fineStiffnessMatrix);
 
+  //! Set the fine stiffness matrix and rebuild this level's smoother, leaving the coarse stiffness matrix and coarse operators unchanged.
+  //! Useful when the fine matrix has changed only slightly since the last call to setFineStiffnessMatrix() (e.g., between Newton steps).
+  void refreshSmoother(Epetra_CrsMatrix* fineStiffnessMatrix);
+
   //! Returns the coarse operator applied in the coarse solve.
   Teuchos::RCP<GMGOperator> getCoarseOperator();
   
@@ -401,6 +440,10 @@ public:
 private:
   SmootherChoice _smootherType;
   int _smootherOverlap;
+
+  int _chebyshevDegree = 3;
+  double _chebyshevEigenvalueRatio = 30.0;
+  double _chebyshevMaxEigenvalue = -1.0; // cached estimate for this level; -1 when it must be (re)computed
   bool _fineCoarseRolesSwapped;
 
   FactorType _schwarzBlockFactorizationType;
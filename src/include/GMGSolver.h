@@ -20,6 +20,16 @@ namespace Camellia
 {
 class GMGSolver : public Solver, public Narrator
 {
+public:
+  // ! Determines when the multigrid preconditioner is rebuilt on solve().  Reuse pays off when the fine matrix changes little
+  // ! between solves, as between Newton iterations or time steps.
+  enum PreconditionerReuse
+  {
+    REBUILD_EVERY_SOLVE,    // recompute coarse matrices, coarse factorizations, and smoothers on each solve() (the default)
+    REUSE_HIERARCHY,        // keep the whole preconditioner, including the finest smoother, fixed between rebuilds
+    REUSE_COARSE_HIERARCHY  // keep prolongation, coarse matrices, and coarse solves fixed, but refresh the finest smoother on each solve()
+  };
+private:
   int _maxIters;
   bool _printToConsole;
   double _tol;
@@ -37,6 +47,7 @@ class GMGSolver : public Solver, public Narrator
   int _azOutput;
 
   bool _useCG; // otherwise, will use GMRES
+  bool _usePipelinedCG = false; // if true (and _useCG is true), use PipelinedCGSolver instead of AztecOO
 
   // info about the last call to solve()
   double _condest; // -1 if none exists
@@ -48,6 +59,19 @@ class GMGSolver : public Solver, public Narrator
 
   std::vector< int > _iterationCountLog; // each time solve() is called, we push_back the number of iterations we run
 
+  PreconditionerReuse _preconditionerReuse = REBUILD_EVERY_SOLVE;
+  int _maxPreconditionerReuseCount = 10; // number of solves after a rebuild that may reuse the hierarchy
+  double _rebuildIterationGrowthFactor = 1.5; // rebuild once the iteration count exceeds this multiple of the count right after a rebuild
+  int _solvesSincePreconditionerBuild = -1; // -1 indicates that the next solve() should rebuild
+  int _iterationCountAfterPreconditionerBuild = -1;
+  int _preconditionerBuildCount = 0;
+  Teuchos::RCP<Epetra_CrsMatrix> _preconditionerStiffnessMatrix; // the matrix the reused hierarchy was built from; held so that the smoother's reference stays valid
+
+  // timing info: totals over the life of the object, and values for the last call to solve()
+  double _timeSetup = 0, _timeSolve = 0, _timeSetupLastSolve = 0, _timeSolveLastSolve = 0;
+
+  void updatePreconditioner(Epetra_CrsMatrix* A);
+
   int solve(bool rebuildCoarseStiffness);
   
   static Teuchos::RCP<GMGOperator> gmgOperatorFromMeshSequence(const std::vector<MeshPtr> &meshesCoarseToFine, SolutionPtr fineSolution,
@@ -76,6 +100,7 @@ public:
   void setComputeConditionNumberEstimate(bool value);
 
   void setTolerance(double tol);
+  double getTolerance();
 
   Teuchos::RCP<GMGOperator> gmgOperator()
   {
@@ -90,13 +115,34 @@ public:
 
   void setUseConjugateGradient(bool value); // otherwise will use GMRES
 
+  // ! If true, CG iterations use PipelinedCGSolver, which overlaps its single global reduction per iteration with the application of the
+  // ! preconditioner and the operator.  Requires conjugate gradients (see setUseConjugateGradient()).  Default = false.
+  void setUsePipelinedConjugateGradient(bool value);
+
   void setPrintIterationCount(bool value);
   
   void setReturnErrorIfMaxItersReached(bool value);
 
   void setSmootherType(GMGOperator::SmootherChoice smootherType);
+
+  // ! Applies GMGOperator::setUseSinglePrecision() to every level of the hierarchy.  The Krylov iteration itself remains in double precision.
+  void setUseSinglePrecision(bool value);
   
   vector<int> getIterationCountLog();
+
+  // ! Sets the preconditioner reuse policy.  When reusing, the hierarchy is rebuilt after maxReuseCount solves, or after a solve whose
+  // ! iteration count exceeds iterationGrowthFactor times the count of the first solve following the last rebuild.
+  void setPreconditionerReuse(PreconditionerReuse choice, int maxReuseCount = 10, double iterationGrowthFactor = 1.5);
+
+  // ! Requests that the next call to solve() rebuild the full preconditioner, regardless of the reuse policy.
+  void forcePreconditionerRebuild();
+
+  // ! Returns the number of times the full preconditioner has been built by solve().
+  int getPreconditionerBuildCount() const;
+
+  // ! Returns setup (preconditioner construction) and solve (Krylov iteration) times, in seconds: totals as "setup" and "solve",
+  // ! and values for the last call to solve() as "setup (last)" and "solve (last)".
+  std::map<string, double> timingReport() const;
   
   static std::vector<MeshPtr> meshesForMultigrid(MeshPtr fineMesh, int kCoarse, int delta_k);
   
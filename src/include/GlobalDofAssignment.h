@@ -31,7 +31,19 @@ namespace Camellia
 {
 class GlobalDofAssignment : public DofInterpreter
 {
+public:
+  // ! Order in which the cells within each partition are listed (by ElementType) and assigned partition-local dofs.
+  // ! CELL_ID_ORDERING is the default.  The other orderings put nearby cells near each other, so that assembly batches
+  // ! touch nearby global rows and the assembled matrix has a smaller bandwidth.
+  enum CellOrdering
+  {
+    CELL_ID_ORDERING,
+    SPACE_FILLING_CURVE_ORDERING,   // Hilbert curve through the cell centroids
+    REVERSE_CUTHILL_MCKEE_ORDERING  // RCM on the partition-local cell adjacency graph
+  };
+private:
   GlobalIndexType _activeCellOffset; // among active cells, an offset to allow the current partition to identify unique cell indices
+  CellOrdering _cellOrdering;
 protected:
   map< GlobalIndexType, vector<int> > _cellSideParitiesForCellID;
 
@@ -59,6 +71,13 @@ protected:
 
   unsigned _numPartitions;
 
+  bool _hasBeenPartitioned; // false until the first call to setPartitions(); until then, all active cells are on rank 0
+
+  // statistics for the most recent call to repartitionAndMigrate()
+  bool _lastRepartitionSkipped;
+  GlobalIndexType _lastRepartitionMigratedCellCount; // sum over all ranks
+  long long _lastRepartitionMigratedBytes;            // sum over all ranks
+
   vector< TSolutionPtr<double> > _registeredSolutions; // solutions that should be modified upon refinement (by subclasses--maximum rule has to worry about cell side upgrades, whereas minimum rule does not, so there's not a great way to do this in the abstract superclass.)
 
   void assignInitialElementType( GlobalIndexType cellID ); // this is the "natural" element type, before side modifications for constraints (when using maximum rule)
@@ -70,6 +89,13 @@ protected:
   void projectParentCoefficientsOntoUnsetChildren();
   virtual void rebuildLookups() = 0;
 
+  // ! Returns the cells in the specified partition, in the order determined by the CellOrdering setting.  Subclasses need
+  // ! only order the local partition; the cells of other partitions may be listed in cellID order.
+  vector<GlobalIndexType> orderedCellsInPartition(PartitionIndexType partitionNumber);
+
+  // ! Rebuilds registered solutions' global vectors (and condensed dof maps) after the global dof numbering has changed.
+  void reinitializeRegisteredSolutions();
+
   // private constructor for subclass's implementation of deepCopy()
   GlobalDofAssignment( GlobalDofAssignment& otherGDA );
 public:
@@ -101,6 +127,10 @@ public:
   virtual vector< ElementTypePtr > elementTypes(PartitionIndexType partitionNumber);
   virtual void setElementType(GlobalIndexType cellID, ElementTypePtr elem);
 
+  CellOrdering getCellOrdering() const;
+  // ! Sets the cell ordering and rebuilds the partition lookups (global dof numbering will change).  Presently honored by the minimum rule.
+  void setCellOrdering(CellOrdering cellOrdering);
+
   DofOrderingFactoryPtr getDofOrderingFactory();
   ElementTypeFactory & getElementTypeFactory();
   
@@ -163,9 +193,19 @@ public:
   virtual PartitionIndexType partitionForGlobalDofIndex( GlobalIndexType globalDofIndex ) = 0;
 
   MeshPartitionPolicyPtr getPartitionPolicy();
+
+  // ! Maximum partition size divided by average partition size for the current partitions.  Returns -1 if the partitions do not cover the active cells.
+  double partitionImbalance();
   
   void repartitionAndMigrate();
 
+  // ! True if the last repartitionAndMigrate() kept the existing partition because its imbalance was under the partition policy's threshold
+  bool lastRepartitionSkipped() const;
+  // ! Number of cells that changed rank during the last repartitionAndMigrate() (summed over all ranks)
+  GlobalIndexType lastRepartitionMigratedCellCount() const;
+  // ! Bytes of cell data (registered solution coefficients) packed for migration during the last repartitionAndMigrate() (summed over all ranks)
+  long long lastRepartitionMigratedBytes() const;
+
   void registerSolution(TSolutionPtr<double> solution);
   vector<TSolutionPtr<double>> getRegisteredSolutions();
   void unregisterSolution(TSolutionPtr<double> solution);
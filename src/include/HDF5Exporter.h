@@ -20,15 +20,47 @@
 
 #include "Teuchos_XMLObject.hpp"
 
-#include <string>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace Camellia
 {
 class HDF5Exporter
 {
+public:
+  enum OutputMode
+  {
+    FILE_PER_RANK, // each rank writes its own HDF5 and XMF file for each export
+    SHARED_FILE    // all ranks write collectively to one HDF5 file per export; geometry is written only when it changes
+  };
 private:
+  // records where the geometry (points and connectivity) for the most recent SHARED_FILE export lives
+  struct ExportedGeometry
+  {
+    std::string h5FilePath; // relative to the output directory; empty if no geometry has been written
+    MeshTopologyViewPtr meshTopo;
+    unsigned long geometryVersion; // meshTopo->geometryVersion() when the geometry was written
+    std::vector< std::pair<GlobalIndexType, int> > cellNum1DPts; // rank-local cells and their sampling
+  };
+
+  // the rank-local output from one export: HDF5 datasets, followed by text (XMF) files
+  struct PendingWrite
+  {
+    std::string h5FilePath; // empty if there is no HDF5 file to write
+    std::vector<int> conns;
+    std::vector<double> points;
+    std::vector<std::string> valueNames;
+    std::vector< std::vector<double> > values;
+    std::vector< std::pair<std::string, std::string> > textFiles; // (path, contents)
+
+    size_t sizeInBytes() const;
+  };
+
   std::string _dirName;
   std::string _dirSuperPath;
   MeshPtr _mesh;
@@ -40,6 +72,26 @@ private:
   Teuchos::XMLObject _traceGrids;
   set<double> _fieldTimeVals;
   set<double> _traceTimeVals;
+  OutputMode _outputMode;
+  ExportedGeometry _fieldGeometry;
+  ExportedGeometry _traceGeometry;
+
+  // asynchronous writes: exportFunction() evaluates into a PendingWrite, and _writerThread does the I/O
+  bool _asynchronous;
+  size_t _maxBufferedBytes;
+  size_t _bufferedBytes; // total size of writes queued or in progress
+  std::deque<PendingWrite> _pendingWrites;
+  bool _writeInProgress;
+  bool _stopWriter;
+  std::string _writeError; // what() from the first failed asynchronous write, if any
+  std::thread _writerThread;
+  std::mutex _writeMutex;
+  std::condition_variable _writeCondition;
+
+  void enqueueWrite(PendingWrite &&pendingWrite);
+  static void performWrite(const PendingWrite &pendingWrite);
+  void stopWriterThread();
+  void writerLoop();
 
   void getPoints(Intrepid::FieldContainer<double> &points, CellTopoPtr cellTopo, int num1DPts);
 public:
@@ -49,6 +101,31 @@ public:
   {
     _mesh = mesh;
   }
+
+  // ! SHARED_FILE mode writes one HDF5 file per export (collectively, on the mesh's communicator), and a single
+  // ! XDMF grid per time value.  Points and connectivity are only written when the exported cells or their
+  // ! sampling, or the mesh topology's geometry version, have changed since the previous export; otherwise the XDMF
+  // ! refers to the earlier file.
+  OutputMode getOutputMode() const;
+  void setOutputMode(OutputMode mode);
+
+  // ! When asynchronous writes are enabled, export methods return once the values have been evaluated; the file
+  // ! writes happen on a background thread, so they overlap subsequent computation.  At most maxBufferedBytes of
+  // ! evaluated output is held in memory; an export that would exceed this waits for earlier writes to finish.
+  // ! SHARED_FILE exports are collective, and are always written synchronously.  All HDF5 calls in Camellia, including
+  // ! those made by writer threads, are serialized through DataIO::hdf5Mutex(); code that calls HDF5 directly while
+  // ! asynchronous exports may be running must hold that lock.
+  // ! With parallel HDF5, the writer thread's HDF5 calls may make MPI calls while the calling thread makes its own.  If MPI
+  // ! has been initialized with a thread level below MPI_THREAD_MULTIPLE, asynchronous writes are therefore not enabled: a
+  // ! warning is printed, and exports remain synchronous.
+  void setAsynchronousWrites(bool asynchronous, size_t maxBufferedBytes = 256 * 1024 * 1024);
+  bool asynchronousWrites() const;
+
+  // ! False if MPI has been initialized with a thread level below MPI_THREAD_MULTIPLE (see setAsynchronousWrites()).
+  static bool asynchronousWritesSupported();
+
+  // ! Blocks until all queued writes have completed.  Throws if any of them failed.
+  void flush();
   typedef std::map<int, int> map_int_int;
   void exportFunction(TFunctionPtr<double> function, std::string functionName="function", double timeVal=0,
                       unsigned int defaultNum1DPts=4, map_int_int cellIDToNum1DPts=map_int_int(),
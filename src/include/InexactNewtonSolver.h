@@ -0,0 +1,78 @@
+//
+//  InexactNewtonSolver.h
+//  Camellia
+//
+
+#ifndef Camellia_InexactNewtonSolver_h
+#define Camellia_InexactNewtonSolver_h
+
+#include "Solver.h"
+
+namespace Camellia
+{
+  //! InexactNewtonSolver: wraps an iterative solver, choosing its tolerance for each Newton step by the Eisenstat-Walker rule.
+  /*!
+   Each call to solve() is taken to be a new Newton step, and the norm of the assembled load vector (the discrete nonlinear
+   residual at the current iterate) is recorded.  The linear solve for step k is then carried out to relative tolerance
+
+     eta_k = gamma * (||F_k|| / ||F_{k-1}||)^alpha,
+
+   ("choice 2" of Eisenstat and Walker, "Choosing the forcing terms in an inexact Newton method", SIAM J. Sci. Comput., 1996),
+   safeguarded so that eta_k does not drop abruptly while the previous forcing term was large, and clamped to
+   [minForcingTerm, maxForcingTerm].  Early Newton steps, where the increment is far from the final one anyway, are thus solved
+   loosely; the tolerance tightens as the Newton iteration converges.  If a target nonlinear residual is set, eta_k is also kept
+   from dropping much below what is needed to reach it, to avoid oversolving on the last step.
+
+   Call reset() at the start of each nonlinear solve (e.g., each time step), and restoreTolerance() at the end of it: the wrapped
+   solver's tolerance is otherwise left at the last forcing term used.  With setUseForcingTerms(false), the wrapper only records
+   residual norms, and leaves the wrapped solver's tolerance alone.
+   */
+  class InexactNewtonSolver : public Solver
+  {
+    SolverPtr _solver;
+    double _gamma, _alpha;
+    double _minForcingTerm, _maxForcingTerm;
+    double _targetResidualNorm;
+
+    int _stepCount;
+    double _forcingTerm, _residualNorm, _previousResidualNorm, _initialResidualNorm;
+
+    bool _useForcingTerms;
+    bool _toleranceModified;
+    double _originalTolerance; // wrapped solver's tolerance before we first changed it
+
+    void updateForcingTerm();
+  public:
+    InexactNewtonSolver(SolverPtr iterativeSolver, double minForcingTerm = 1e-10, double maxForcingTerm = 0.9);
+
+    //! The forcing term (relative linear tolerance) used in the most recent solve().
+    double forcingTerm() const;
+
+    //! The norm of the load vector seen by the first solve() since reset().
+    double initialResidualNorm() const;
+
+    //! The norm of the load vector seen by the most recent solve(): a cheap surrogate for the nonlinear residual.
+    double residualNorm() const;
+
+    //! Clears the residual history; the next solve() is treated as the first Newton step.
+    void reset();
+
+    //! Restores the wrapped solver's tolerance to its value before the first forcing term was applied.
+    void restoreTolerance();
+
+    //! Sets the parameters in eta_k = gamma * (||F_k|| / ||F_{k-1}||)^alpha.  Defaults: gamma = 0.9, alpha = 2.
+    void setForcingParameters(double gamma, double alpha);
+
+    //! Sets the residual norm at which the nonlinear iteration will stop (0 to disable the oversolving safeguard, the default).
+    void setTargetResidualNorm(double targetResidualNorm);
+
+    //! If false, solve() records residual norms but does not set the wrapped solver's tolerance (default: true).
+    void setUseForcingTerms(bool value);
+
+    //! Records the residual norm, sets the wrapped solver's tolerance to the new forcing term (if forcing terms are in use), and
+    //! solves with the wrapped solver.
+    int solve();
+  };
+}
+
+#endif
@@ -95,6 +95,10 @@ public:
                 bool applyCubatureWeights = false);
 
   TFunctionPtr<Scalar> evaluate(const Teuchos::map< int, TFunctionPtr<Scalar>> &varFunctions);
+
+  // ! Collective: imports off-rank data (e.g., solution coefficients) needed by the weights to evaluate on the cells of the
+  // ! BasisCaches; see TFunction::importOffRankCellData().
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
   TFunctionPtr<Scalar> evaluate(const Teuchos::map< int, TFunctionPtr<Scalar>> &varFunctions, bool boundaryPart);
 
   TLinearTermPtr<Scalar> getBoundaryOnlyPart();
@@ -112,6 +116,13 @@ public:
                  TLinearTermPtr<Scalar> otherTerm, VarPtr otherVarID, TFunctionPtr<Scalar> fxn,
                  BasisCachePtr basisCache, bool forceBoundaryTerm = false);
 
+  // the volume and boundary contributions to integrate(values, thisDofOrdering, otherTerm, otherDofOrdering, basisCache),
+  // computed separately so that the volume part can be accumulated over cubature phases (see BasisCache::setCubaturePhase())
+  void integrateVolumePart(Intrepid::FieldContainer<Scalar> &values, DofOrderingPtr thisDofOrdering,
+                           TLinearTermPtr<Scalar> otherTerm, DofOrderingPtr otherDofOrdering, BasisCachePtr basisCache);
+  void integrateBoundaryPart(Intrepid::FieldContainer<Scalar> &values, DofOrderingPtr thisDofOrdering,
+                             TLinearTermPtr<Scalar> otherTerm, DofOrderingPtr otherDofOrdering, BasisCachePtr basisCache);
+
   // CrsMatrix versions (for the two-LT (matrix) variants of integrate)
   void integrate(Epetra_CrsMatrix *values, DofOrderingPtr thisDofOrdering,
                  TLinearTermPtr<double> otherTerm, DofOrderingPtr otherDofOrdering,
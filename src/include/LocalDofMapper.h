@@ -53,6 +53,21 @@ class LocalDofMapper   // maps a whole trial ordering
   map<pair<int,int>, Teuchos::RCP<LocalDofMapper>> _localDofMapperForVarIDAndSide;
   
   std::map<int, GlobalIndexType> _permutationMap; // lazily computed, returned by getPermutationMap for LDMs that are permuation maps.
+
+  // compiled form of the local-to-global operator: for each local dof, the global ordinals it maps to and the corresponding weights.
+  // Stored column-wise (compressed by local dof) so that mapping a vector or matrix involves no map lookups or temporaries.
+  struct CompiledMap
+  {
+    vector<int> localOffsets; // size dofCount + 1; entries for local dof i are in [localOffsets[i], localOffsets[i+1])
+    vector<unsigned> globalOrdinals;
+    vector<double> weights;
+  };
+  CompiledMap _compiledMap[2]; // index is fittableGlobalDofsOnly; lazily computed on first matrix mapping
+  bool _compiledMapIsValid[2] = {false, false};
+  bool _useCompiledMap = true;
+
+  unsigned localDofCount();
+  const CompiledMap &compiledMap(bool fittableGlobalDofsOnly);
 public:
   LocalDofMapper(DofOrderingPtr dofOrdering, map< int, BasisMap > volumeMaps,
                  set<GlobalIndexType> fittableGlobalDofOrdinalsInVolume,
@@ -72,6 +87,13 @@ public:
   void mapLocalDataSide(const Intrepid::FieldContainer<double> &localData, Intrepid::FieldContainer<double> &mappedData, bool fittableGlobalDofsOnly, int sideOrdinal);
   void mapLocalDataVolume(const Intrepid::FieldContainer<double> &localData, Intrepid::FieldContainer<double> &mappedData, bool fittableGlobalDofsOnly);
 
+  //! Returns true if the compiled (column-compressed) form of the map has been built for the specified fittableGlobalDofsOnly value.
+  //! The compiled form is built on the first call to mapLocalData() with matrix data, and is subsequently used for vector data as well.
+  bool isCompiled(bool fittableGlobalDofsOnly) const;
+
+  //! Sets whether mapLocalData() may use the compiled form.  (Intended for testing; default is true.)
+  void setUseCompiledMap(bool value);
+
   //! Returns true if the action of the LocalDofMapper is equivalent to a relabeling of the local dofs as global dofs (i.e. it is one-to-one and all weights are unity.)
   bool isPermutation() const;
   
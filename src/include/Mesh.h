@@ -138,6 +138,17 @@ class Mesh : public RefinementObserver, public DofInterpreter
 
   vector< Teuchos::RCP<RefinementObserver> > _registeredObservers; // meshes that should be modified upon refinement (must differ from this only in bilinearForm; must have identical geometry & cellIDs)
 
+  // bookkeeping for incremental 1-irregularity enforcement: cells h-refined through this Mesh since the last enforcement, and
+  // a topology cell count to detect refinements made elsewhere (in which case we fall back to checking every active cell)
+  bool _useIncrementalRegularityEnforcement = true;
+  bool _regularityEnforced = false;
+  IndexType _cellCountAtRegularityEnforcement = 0;
+  IndexType _cellsCreatedSinceRegularityEnforcement = 0;
+  set<GlobalIndexType> _cellsRefinedSinceRegularityEnforcement;
+
+  void addCellsMadeIrregularBy(CellPtr cell, map< CellTopologyKey, set<GlobalIndexType> > &irregularCellIDs);
+  set<GlobalIndexType> cellsAffectedByRefinementOf(const set<GlobalIndexType> &refinedCellIDs);
+
   map<IndexType, GlobalIndexType> getGlobalVertexIDs(const Intrepid::FieldContainer<double> &vertexCoordinates);
 
   ElementPtr addElement(const vector<IndexType> & vertexIndices, ElementTypePtr elemType);
@@ -187,6 +198,13 @@ public:
   // ! Constructor for a single-element mesh extracted from an existing mesh
   Mesh(MeshPtr mesh, GlobalIndexType cellID, Epetra_CommPtr Comm);
   
+  // ! Writes the refinement tree, H1 orders, and partitions to a binary file, from rank 0.  Unlike saveToHDF5(),
+  // ! the checkpoint can be loaded without replaying the refinement history; see MeshFactory::loadFromCheckpoint().
+  // ! Must be called on all ranks.  Curvilinear and maximum-rule meshes are not supported.
+  void saveCheckpoint(string filename);
+  static const string CHECKPOINT_TAG;
+  static const int CHECKPOINT_VERSION;
+
 #ifdef HAVE_EPETRAEXT_HDF5
   void saveToHDF5(string filename);
 #endif
@@ -247,8 +265,14 @@ public:
   vector<int> cellTensorPolyOrder(GlobalIndexType cellID);
 
   //! This should probably be renamed "enforceRegularityRules" and then made more general to enforce whatever rules are appropriate for the mesh.
+  //! If regularity was enforced before, and all refinements since went through this Mesh, only the cells near those refinements are
+  //! checked (see setUseIncrementalRegularityEnforcement()); otherwise, every active cell is checked.
   void enforceOneIrregularity(bool repartitionAndMigrate = true);
 
+  //! When true (the default), enforceOneIrregularity() starts from the cells refined since its last call and follows the front
+  //! of refinements it triggers, so that its cost scales with the number of refined cells rather than with the mesh size.
+  void setUseIncrementalRegularityEnforcement(bool value);
+
   vector<double> getCellCentroid(GlobalIndexType cellID);
 
   // commented out because unused
@@ -25,6 +25,10 @@ class MeshFactory
   static map<int,int> _emptyIntIntMap; // just defined here to implement a default argument to constructor (there's likely a better way)
 public:
   // These versions are all deprecated, new versions should take in a VarFactoryPtr instead of BFPtr
+  // ! Loads a mesh written by Mesh::saveCheckpoint().  The MeshTopology is rebuilt directly from the stored refinement tree,
+  // ! and global dof lookups are built once, so the cost does not depend on the length of the refinement history.  If
+  // ! the number of MPI ranks matches that at the time of writing, the saved partitions are used.
+  static MeshPtr loadFromCheckpoint(TBFPtr<double> bf, string filename, Epetra_CommPtr Comm = Teuchos::null);
 #ifdef HAVE_EPETRAEXT_HDF5
   static MeshPtr loadFromHDF5(TBFPtr<double> bf, string filename);
 #endif
@@ -18,6 +18,7 @@ class MeshPartitionPolicy
 {
   Epetra_CommPtr _Comm;
   Teuchos_CommPtr _TeuchosComm; // lazily initialized from _Comm
+  double _imbalanceThreshold; // repartitionAndMigrate() keeps the existing partition if its imbalance does not exceed this
 public:
   MeshPartitionPolicy(Epetra_CommPtr Comm);
   
@@ -26,8 +27,15 @@ public:
   virtual Epetra_CommPtr& Comm();
   virtual Teuchos_CommPtr& TeuchosComm();
 
+  // ! Imbalance is measured as the maximum partition size divided by the average partition size.  When repartitioning
+  // ! after a refinement, if the existing partition (with children assigned to their parents' ranks) has imbalance at or
+  // ! below the threshold, the partition is kept and no cells are migrated.  The default threshold, 0, means that we always repartition.
+  double imbalanceThreshold() const;
+  void setImbalanceThreshold(double threshold);
+
   static MeshPartitionPolicyPtr standardPartitionPolicy(Epetra_CommPtr Comm); // aims to balance across all MPI ranks; present implementation uses Zoltan
 //  static MeshPartitionPolicyPtr oneRankPartitionPolicy(int rank=0); // all cells belong to the rank specified
+  static MeshPartitionPolicyPtr spaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm); // Hilbert ordering through the refinement hierarchy; no Zoltan call
   static MeshPartitionPolicyPtr inducedPartitionPolicy(MeshPtr inducedMesh, MeshPtr inducingMesh); // for two meshes that have the same cell indices, uses inducingMesh to define partitioning
   static MeshPartitionPolicyPtr inducedPartitionPolicy(MeshPtr inducedMesh, MeshPtr inducingMesh, const std::map<GlobalIndexType,GlobalIndexType> &cellIDMap);
 };
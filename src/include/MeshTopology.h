@@ -67,6 +67,8 @@ class MeshTopology : public MeshTopologyView
   map< pair<IndexType, IndexType>, ParametricCurvePtr > _edgeToCurveMap;
   Teuchos::RCP<MeshTransformationFunction> _transformationFunction; // for dealing with those curves
 
+  unsigned long _geometryVersion; // incremented whenever cells are refined or the edge curves change
+
   map< pair<unsigned,unsigned>, CellTopoPtr > _knownTopologies; // (shards key, tensorial degree) -> topo.  Might want to move this to a CellTopoFactory, but it is fairly simple
 
   //  set<IndexType> activeDescendants(IndexType d, IndexType entityIndex);
@@ -237,6 +239,9 @@ public:
   // (will be transitioning from having MeshTransformationFunction talk to Mesh to having it talk to MeshTopology)
   Teuchos::RCP<MeshTransformationFunction> transformationFunction();
 
+  // ! Returns a counter that is incremented whenever a cell is refined or the edge-to-curve map is set; clients that cache cell geometry may compare against it to detect staleness.
+  unsigned long geometryVersion();
+
   // ! This method exposed for the sake of tests
   vector< pair<IndexType,unsigned> > getConstrainingSideAncestry(IndexType sideEntityIndex);   // pair: first is the sideEntityIndex of the ancestor; second is the refinementIndex of the refinement to get from parent to child (see _parentEntities and _childEntities)
 
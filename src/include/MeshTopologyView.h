@@ -96,6 +96,9 @@ namespace Camellia {
     virtual Intrepid::FieldContainer<double> physicalCellNodesForCell(unsigned cellIndex, bool includeCellDimension = false);
     
     virtual Teuchos::RCP<MeshTransformationFunction> transformationFunction();
+
+    // ! Returns the geometry version of the underlying MeshTopology; see MeshTopology::geometryVersion().
+    virtual unsigned long geometryVersion();
     
     virtual std::pair<IndexType,IndexType> owningCellIndexForConstrainingEntity(unsigned d, unsigned constrainingEntityIndex);
     
@@ -46,6 +46,29 @@ class MeshTransferFunction : public TFunction<double>, public RefinementObserver
 
   std::map<CellSide, unsigned> _permutationForNewMeshCellSide; // permutation goes from cell side in _newMesh to that in _originalMesh
 
+  // points in an active side of _newMesh that lie in one active side of _originalMesh
+  struct OriginalMeshPoints
+  {
+    CellSide originalCellSide;
+    std::vector<int> pointOrdinals;  // ordinals of the points in the _newMesh side
+    BasisCachePtr sideBasisCache;    // side cache on _originalMesh, with reference points set to the points' locations
+  };
+
+  // cached location of an active side of _newMesh in _originalMesh; the points are located on first use in values(), and again
+  // whenever the reference points requested on the side change.
+  struct TransferLocation
+  {
+    CellSide newMeshAncestralCellSide, originalMeshAncestralCellSide;
+    unsigned newMeshAncestralCellSidePermutation;
+    Intrepid::FieldContainer<double> refCellPoints; // points (in the active _newMesh side) located by originalMeshPoints
+    std::vector<OriginalMeshPoints> originalMeshPoints;
+  };
+
+  // keys are active cell sides in _newMesh; entries are dropped when a cell they refer to is refined in either mesh
+  std::map<CellSide, TransferLocation> _transferLocations;
+
+  TransferLocation & transferLocation(const CellSide &newMeshActiveCellSide);
+  void locatePoints(TransferLocation &location, const CellSide &newMeshActiveCellSide, const Intrepid::FieldContainer<double> &refCellPoints);
   void rebuildMaps();
 public:
   MeshTransferFunction(TFunctionPtr<double> originalFunction, MeshPtr originalMesh, MeshPtr newMesh, double interface_t);
@@ -65,8 +88,11 @@ public:
     return _originalToNewMap;
   }
 
-  // RefinementObserver method:
+  // RefinementObserver methods:
+  void didHRefine(MeshTopologyPtr meshTopology, const std::set<GlobalIndexType> &cellIDs, RefinementPatternPtr refPattern);
+  void didHUnrefine(MeshTopologyPtr meshTopology, const std::set<GlobalIndexType> &cellIDs);
   void didRepartition(MeshTopologyPtr meshTopology);
+  void pRefine(const std::set<GlobalIndexType> &cellIDs);
 
   ~MeshTransferFunction();
 };
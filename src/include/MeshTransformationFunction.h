@@ -8,6 +8,8 @@
 
 #include "TypeDefs.h"
 
+#include <functional>
+
 #include "Function.h"
 #include "Mesh.h"
 
@@ -20,10 +22,31 @@ namespace Camellia
 {
 class MeshTransformationFunction : public TFunction<double>
 {
+public:
+  // ! Geometry of one curved cell at a particular set of reference points (volume or side cubature), as computed by BasisCache.
+  // ! Containers are empty until the corresponding quantity has been computed.
+  struct CurvedCellGeometry
+  {
+    Intrepid::FieldContainer<double> physicalCellNodes;   // (N,D): the straight-edge nodes the geometry was computed from
+    Intrepid::FieldContainer<double> refPoints;           // (P,D)
+    Intrepid::FieldContainer<double> physicalPoints;      // (P,D)
+    Intrepid::FieldContainer<double> jacobian;            // (P,D,D)
+    Intrepid::FieldContainer<double> jacobianDeterminant; // (P)
+    Intrepid::FieldContainer<double> jacobianInverse;     // (P,D,D)
+  };
+private:
   map< GlobalIndexType, TFunctionPtr<double> > _cellTransforms; // cellID --> cell transformation function
   Camellia::EOperator _op;
   MeshPtr _mesh;
   int _maxPolynomialDegree;
+
+  bool _cachesGeometry;
+  // cellID --> sideOrdinal --> hash of reference points --> geometry.  Keying on the points themselves lets point sets of the
+  // same size (e.g. successive cubature phases) coexist rather than evicting one another.
+  map< GlobalIndexType, map< int, map< size_t, CurvedCellGeometry > > > _curvedCellGeometry;
+  static const int MAX_POINT_SETS_PER_SIDE = 64; // bounds the cache when a cell is evaluated at many distinct point sets
+
+  void clearCurvedCellGeometry(const set<GlobalIndexType> &cellIDs);
 protected:
   MeshTransformationFunction(MeshPtr mesh, map< GlobalIndexType, TFunctionPtr<double> > cellTransforms, Camellia::EOperator op);
 public:
@@ -35,6 +58,20 @@ public:
 
   void values(Intrepid::FieldContainer<double> &values, BasisCachePtr basisCache);
 
+  // ! Returns the cached geometry for the specified curved cell at the specified reference points, creating an empty entry if
+  // ! none matches the points and straight-edge nodes.  Returns NULL if the cell is not curved or geometry caching is disabled.
+  // ! Entries are discarded when the cell is refined or its geometric order changes.
+  CurvedCellGeometry* curvedCellGeometry(GlobalIndexType cellID, int sideOrdinal,
+                                         const Intrepid::FieldContainer<double> &physicalCellNodes, int cellOrdinal,
+                                         const Intrepid::FieldContainer<double> &refPoints);
+
+  // ! number of cached curved-cell geometry entries
+  int curvedCellGeometryCount();
+
+  // ! Enable/disable caching of curved-cell geometry (enabled by default).  Disabling clears the cache.
+  void setCachesGeometry(bool value);
+  bool cachesGeometry();
+
   bool mapRefCellPointsUsingExactGeometry(Intrepid::FieldContainer<double> &cellPoints, const Intrepid::FieldContainer<double> &refCellPoints, GlobalIndexType cellID);
 
   TFunctionPtr<double> dx();
@@ -9,18 +9,46 @@
 #ifndef Camellia_NonlinearSolveStrategy_h
 #define Camellia_NonlinearSolveStrategy_h
 
+#include "InexactNewtonSolver.h"
 #include "NonlinearStepSize.h"
 
 namespace Camellia
 {
 class NonlinearSolveStrategy
 {
+public:
+  enum ConvergenceTest
+  {
+    ENERGY_ERROR_CHANGE, // relative change in the energy error of the increment (requires an energy error computation per step)
+    RESIDUAL_NORM        // norm of the assembled Newton load vector, relative to its initial value (essentially free)
+  };
+private:
   Teuchos::RCP<NonlinearStepSize> _stepSize;
   TSolutionPtr<double> _backgroundFlow, _solution;
   double _relativeEnergyTolerance;
   bool _usePicardIteration; // instead of Newton-Raphson (will just do background = new at each step)
+
+  SolverPtr _solver; // if null, a direct solver is used
+  bool _useInexactNewton;
+  ConvergenceTest _convergenceTest;
+  double _relativeResidualTolerance;
+  int _maxIterations;
 public:
   NonlinearSolveStrategy(TSolutionPtr<double> backgroundFlow, TSolutionPtr<double> solution, Teuchos::RCP<NonlinearStepSize> stepSize, double relativeEnergyTolerance);
+
+  // ! Sets the test used to stop the nonlinear iteration.  Default: ENERGY_ERROR_CHANGE, with relativeEnergyTolerance.
+  // ! For RESIDUAL_NORM, the iteration stops when the Newton load vector norm has been reduced by the factor relativeResidualTolerance.
+  void setConvergenceTest(ConvergenceTest test, double relativeResidualTolerance = 1e-8);
+
+  // ! Caps the number of nonlinear iterations (default: no cap).
+  void setMaxIterations(int maxIterations);
+
+  // ! Sets the solver used for each linear solve.
+  void setSolver(SolverPtr solver);
+
+  // ! When true, the linear solves use Eisenstat-Walker forcing terms as tolerances (see InexactNewtonSolver); requires an iterative solver.
+  void setUseInexactNewton(bool value);
+
   void setUsePicardIteration(bool value);
   void solve(bool printToConsole=false);
 };
@@ -0,0 +1,80 @@
+//
+//  PipelinedCGSolver.h
+//  Camellia
+//
+
+#ifndef Camellia_PipelinedCGSolver_h
+#define Camellia_PipelinedCGSolver_h
+
+#include "Solver.h"
+
+#include "Epetra_Operator.h"
+#include "Epetra_Vector.h"
+
+namespace Camellia
+{
+  //! PipelinedCGSolver: preconditioned conjugate gradients with a single, nonblocking global reduction per iteration.
+  /*!
+   Implements the pipelined CG method of Ghysels and Vanroose ("Hiding global synchronization latency in the preconditioned
+   conjugate gradient algorithm", Parallel Computing, 2014).  Standard CG requires two blocking reductions per iteration; here the
+   three inner products needed by an iteration, (r,u), (w,u), and (r,r), are combined into one MPI_Iallreduce, which is in flight
+   while the preconditioner and the operator are applied.  The price is a few extra vector updates and somewhat weaker numerical
+   stability: the recursively updated residual drifts from the true residual b - A x.  To limit this, the auxiliary vectors
+   are periodically recomputed from the current iterate (residual replacement); the interval is set by
+   setResidualReplacementInterval().
+
+   Convergence is declared when ||r|| <= tol * s, in the Euclidean norm of the recursively updated residual, where the scaling s is
+   ||b|| by default (AztecOO's AZ_rhs), ||r_0|| (AZ_r0), or 1 (AZ_noscaled); see setResidualScaling().  The initial guess is taken
+   from the LHS vector.  If no preconditioner is provided, the identity is used.
+   */
+  class PipelinedCGSolver : public Solver
+  {
+  public:
+    enum ResidualScaling
+    {
+      RHS_NORM,              // ||b||, as AZ_rhs
+      INITIAL_RESIDUAL_NORM, // ||b - A x_0||, as AZ_r0
+      NO_SCALING             // absolute tolerance, as AZ_noscaled
+    };
+  private:
+    int _maxIters;
+    double _tol;
+    ResidualScaling _residualScaling;
+    bool _printToConsole;
+    int _residualReplacementInterval;
+    Teuchos::RCP<Epetra_Operator> _preconditioner;
+
+    int _iterationCount;      // for the last call to solve(); the max over all right-hand sides
+    int _residualReplacementCount;
+
+    int solve(const Epetra_Vector &b, Epetra_Vector &x);
+  public:
+    PipelinedCGSolver(int maxIters, double tol, Teuchos::RCP<Epetra_Operator> preconditioner = Teuchos::null);
+
+    //! Returns the number of iterations taken by the last call to solve().
+    int iterationCount() const;
+
+    //! Returns the number of residual replacements performed during the last call to solve().
+    int residualReplacementCount() const;
+
+    //! Sets the preconditioner, which is applied through its ApplyInverse() method.
+    void setPreconditioner(Teuchos::RCP<Epetra_Operator> preconditioner);
+
+    //! When true, rank 0 reports convergence, the maximum iteration count being reached, and breakdowns.  Default: false.
+    void setPrintToConsole(bool printToConsole);
+
+    //! Recompute the residual and auxiliary vectors from the current iterate every interval iterations (0 to disable).  Default: 50.
+    void setResidualReplacementInterval(int interval);
+
+    //! Sets the quantity the tolerance is relative to.  Default: RHS_NORM.
+    void setResidualScaling(ResidualScaling scaling);
+
+    void setTolerance(double tol);
+    double getTolerance();
+
+    //! Returns 0 if converged, 1 if the maximum iteration count was reached, and -1 if a breakdown (e.g., non-SPD operator) was detected.
+    int solve();
+  };
+}
+
+#endif
@@ -30,6 +30,7 @@ public:
   bool boundaryValueOnly();
   void setOverrideMeshCheck(bool value, bool dontWarn=false);
   void importCellData(std::vector<GlobalIndexType> cells);
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
   void values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache);
   static map<int, TFunctionPtr<Scalar> > functionMap( vector< VarPtr > varPtrs, TSolutionPtr<Scalar> soln);
   string displayString();
@@ -23,6 +23,7 @@ public:
   ProductFunction(TFunctionPtr<Scalar> f1, TFunctionPtr<Scalar> f2);
   void values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache);
   virtual bool boundaryValueOnly();
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
 
   TFunctionPtr<Scalar> f1();
   TFunctionPtr<Scalar> f2();
@@ -24,6 +24,38 @@ public:
 
   static void projectFunctionOntoBasisInterpolating(Intrepid::FieldContainer<Scalar> &basisCoefficients,
       TFunctionPtr<Scalar> fxn, BasisPtr basis, BasisCachePtr domainBasisCache);
+
+  //! The operator applied by projectFunctionOntoBasisInterpolating(), for a fixed basis and fixed cells.
+  /*!
+   The interpolating projection determines the vertex dofs, then the edge dofs, and so on, each by an L^2 projection of
+   what the lower-dimensional subcells left unresolved.  The Gram matrices involved depend only on the basis and on the
+   cell geometry, so the constructor computes and factors them once; apply() computes only the load vectors.
+   */
+  class InterpolatingProjection
+  {
+    struct SubcellProjection
+    {
+      int dim;
+      Intrepid::FieldContainer<double> refCellPoints, cubatureWeights;
+      std::vector<int> dofOrdinals; // ascending
+      Intrepid::FieldContainer<Scalar> choleskyFactors; // (cell, dof, dof)
+      Intrepid::FieldContainer<Scalar> coupling; // (cell, dof, basisOrdinal): the Gram matrix rows for dofOrdinals
+      std::vector<bool> factored; // false for cells whose Gram matrix was not SPD
+    };
+    BasisPtr _basis;
+    TIPPtr<Scalar> _ip;
+    VarPtr _v;
+    DofOrderingPtr _dofOrdering;
+    int _numCells;
+    std::vector<int> _dofsForDomain;
+    std::vector<SubcellProjection> _subcellProjections;
+  public:
+    InterpolatingProjection(BasisPtr basis, BasisCachePtr domainBasisCache);
+
+    //! Projects fxn onto the basis.  domainBasisCache must be for the cells (and side) the operator was constructed with;
+    //! its reference points are reset.
+    void apply(Intrepid::FieldContainer<Scalar> &basisCoefficients, TFunctionPtr<Scalar> fxn, BasisCachePtr domainBasisCache);
+  };
 };
 
 extern template class Projector<double>;
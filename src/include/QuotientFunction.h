@@ -21,6 +21,7 @@ public:
   QuotientFunction(TFunctionPtr<Scalar> f, TFunctionPtr<Scalar> scalarDivisor);
   void values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache);
   virtual bool boundaryValueOnly();
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
   TFunctionPtr<Scalar> dx();
   TFunctionPtr<Scalar> dy();
   TFunctionPtr<Scalar> dz();
@@ -47,6 +47,7 @@ public:
 #endif
 
   static RefinementPatternPtr refPatternForRefType(RefinementType refType, CellTopoPtr cellTopo);
+  static RefinementType refTypeForRefPattern(RefinementPatternPtr refPattern); // inverse of refPatternForRefType()
 };
 }
 
@@ -24,6 +24,7 @@ public:
   void setPrintToConsole(bool printToConsole);
   int solve();
   void setTolerance(double tol);
+  double getTolerance();
 };
 }
 
@@ -31,7 +31,7 @@ class SimpleMLSolver : public Solver
   int _maxIters;
 public:
   SimpleMLSolver(bool saveFactorization, double residualTolerance, int maxIterations);
-  int solve();
+  int solve(); // AztecOO-based: solves for a single right-hand side
   int resolve();
   // void setProblem(Teuchos::RCP< Epetra_LinearProblem > problem);
 };
@@ -32,6 +32,7 @@ public:
   // for reasons of efficiency, may want to implement div() and grad() as well
 
   void importCellData(std::vector<GlobalIndexType> cellIDs);
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
 
   std::string displayString();
   bool boundaryValueOnly();
@@ -0,0 +1,55 @@
+//
+//  SinglePrecisionCrsMatrix.h
+//  Camellia
+//
+
+#ifndef Camellia_SinglePrecisionCrsMatrix_h
+#define Camellia_SinglePrecisionCrsMatrix_h
+
+#include "TypeDefs.h"
+
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Export.h"
+#include "Epetra_Import.h"
+#include "Epetra_Map.h"
+#include "Epetra_MultiVector.h"
+
+namespace Camellia
+{
+  //! SinglePrecisionCrsMatrix: a copy of a fill-completed Epetra_CrsMatrix whose values are stored in single precision.
+  /*!
+   Intended for operators that are applied many times per solve but whose entries need not be known to full precision
+   (e.g., multigrid prolongation operators and coarse-level matrices used in residual computations).  The local rows are
+   stored in a compact CSR layout with float values; vectors remain Epetra_MultiVectors in double precision, and the products
+   are accumulated in double precision.  Communication uses the source matrix's column and row maps, so that Multiply() has
+   the same semantics (including the transpose) as Epetra_CrsMatrix::Multiply().
+   */
+  class SinglePrecisionCrsMatrix
+  {
+    Epetra_Map _rowMap, _colMap, _domainMap, _rangeMap;
+    Teuchos::RCP<Epetra_Import> _importer; // domain map to column map; null when these agree
+    Teuchos::RCP<Epetra_Export> _exporter; // row map to range map; null when these agree
+
+    std::vector<int> _rowOffsets; // entries for local row i are in [_rowOffsets[i], _rowOffsets[i+1])
+    std::vector<int> _colIndices; // local column indices
+    std::vector<float> _values;
+  public:
+    SinglePrecisionCrsMatrix(const Epetra_CrsMatrix &matrix);
+
+    //! Y = A * X.  X must be distributed according to DomainMap(), Y according to RangeMap().
+    int Apply(const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+
+    //! Y = A * X, or Y = A^T * X if transA is true; mirrors Epetra_CrsMatrix::Multiply().  X and Y may not alias.
+    int Multiply(bool transA, const Epetra_MultiVector& X, Epetra_MultiVector& Y) const;
+
+    int NumMyNonzeros() const;
+
+    //! Returns a new, fill-completed Epetra_CrsMatrix with the same structure and maps, holding the single-precision values.
+    Teuchos::RCP<Epetra_CrsMatrix> toDoublePrecision() const;
+
+    const Epetra_Map & DomainMap() const;
+    const Epetra_Map & RangeMap() const;
+  };
+}
+
+#endif
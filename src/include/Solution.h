@@ -86,6 +86,7 @@ private:
   Teuchos::RCP<DofInterpreter> _oldDofInterpreter; // the one saved when we turn on condensed solve
   TBFPtr<Scalar> _bf;
   TRHSPtr<Scalar> _rhs;
+  std::vector< TRHSPtr<Scalar> > _loadRHSs; // when non-empty, populateStiffnessAndLoad() assembles one load vector column per entry
   TIPPtr<Scalar> _ip;
   Teuchos::RCP<LocalStiffnessMatrixFilter> _filter;
   Teuchos::RCP<LagrangeConstraints> _lagrangeConstraints;
@@ -122,6 +123,7 @@ private:
   bool _writeRHSToMatrixMarketFile;
   bool _zmcsAsRankOneUpdate;
   bool _zmcsAsLagrangeMultipliers;
+  bool _eliminateBCsDuringAssembly;
 
   std::string _matrixFilePath;
   std::string _rhsFilePath;
@@ -132,8 +134,16 @@ private:
 
   static double conditionNumberEstimate( Epetra_LinearProblem & problem );
 
+  static std::string checkpointFileNameForRank(std::string checkpointPrefix, int rank);
+
   void setGlobalSolutionFromCellLocalCoefficients();
 
+  // ! Determines the BC values for every global dof seen by the rank-local cells, including dofs whose BCs are found on other ranks.
+  void determineBCValuesForRankLocalCells(std::map<GlobalIndexType,Scalar> &bcValues);
+
+  void imposeBCValuesOnVectors(Intrepid::FieldContainer<GlobalIndexTypeToCast> &bcGlobalIndices,
+                               Intrepid::FieldContainer<Scalar> &bcGlobalValues);
+
   void gatherSolutionData(); // get all solution data onto every node (not what we should do in the end)
 protected:
   Intrepid::FieldContainer<Scalar> solutionForElementTypeGlobal(ElementTypePtr elemType); // probably should be deprecated…
@@ -185,6 +195,10 @@ public:
   int solveWithPrepopulatedStiffnessAndLoad(TSolverPtr<Scalar> solver, bool callResolveInstead = false);
   void importSolution(); // imports for all rank-local cellIDs
   void importSolutionForOffRankCells(std::set<GlobalIndexType> cellIDs);
+  // ! Collective: imports, in a single communication step, the coefficients for the off-rank cells referenced by any of the
+  // ! BasisCaches (e.g., all the element-type batches for an upcoming assembly).  Cells not active in this solution's mesh are
+  // ! skipped.  populateStiffnessAndLoad() calls this, through TFunction::importOffRankCellData(), for solutions its forms use.
+  void importSolutionForOffRankCells(const std::vector<BasisCachePtr> &basisCaches);
   void importGlobalSolution(); // imports (and interprets!) global solution.  NOT scalable.
 
   int solve();
@@ -193,6 +207,12 @@ public:
 
   int solve( TSolverPtr<Scalar> solver );
 
+  // ! Solves for several loads against one stiffness matrix.  The stiffness matrix is assembled once, along with a load vector for each
+  // ! entry in rhsList (local Gram factorizations are shared by the loads), and the loads are passed to solver together as the columns of
+  // ! one multi-vector, so that a direct solver factors once and performs k cheap solves.  On return, solutions[i] holds the solution
+  // ! for rhsList[i]; this Solution's own coefficients and RHS are left unchanged.  Not supported with static condensation or filters.
+  int solve( TSolverPtr<Scalar> solver, const std::vector< TRHSPtr<Scalar> > &rhsList, std::vector< TSolutionPtr<Scalar> > &solutions );
+
   void addSolution(TSolutionPtr<Scalar> soln, double weight, bool allowEmptyCells = false, bool replaceBoundaryTerms=false); // thisSoln += weight * soln
 
   void addSolution(TSolutionPtr<Scalar> soln, double weight, set<int> varsToAdd, bool allowEmptyCells = false); // thisSoln += weight * soln
@@ -216,6 +236,13 @@ public:
   void solutionValues(Intrepid::FieldContainer<Scalar> &values, int trialID, BasisCachePtr basisCache,
                       bool weightForCubature = false, Camellia::EOperator op = OP_VALUE);
 
+  // ! Gathers the coefficients for trialID (on sideIndex, for fluxes and traces) on the specified cells into the contiguous (C,F)
+  // ! container coefficients, in the order of trialID's basis.  The cells that have solution data must share an element type,
+  // ! which is returned; cells without data get zero coefficients.  Returns null, leaving coefficients untouched, if no cell has
+  // ! data or the element types differ.  If trialID has no basis on sideIndex, coefficients is left empty.
+  ElementTypePtr gatherCoefficients(Intrepid::FieldContainer<Scalar> &coefficients, const std::vector<GlobalIndexType> &cellIDs,
+                                    int trialID, int sideIndex=VOLUME_INTERIOR_SIDE_ORDINAL);
+
   void solnCoeffsForCellID(Intrepid::FieldContainer<Scalar> &solnCoeffs, GlobalIndexType cellID, int trialID, int sideIndex=VOLUME_INTERIOR_SIDE_ORDINAL);
   void setSolnCoeffsForCellID(Intrepid::FieldContainer<Scalar> &solnCoeffsToSet, GlobalIndexType cellID, int trialID, int sideIndex=VOLUME_INTERIOR_SIDE_ORDINAL);
   void setSolnCoeffsForCellID(Intrepid::FieldContainer<Scalar> &solnCoeffsToSet, GlobalIndexType cellID);
@@ -306,6 +333,12 @@ public:
   void readFromFile(const std::string &filePath);
   void writeToFile(const std::string &filePath);
 
+  // ! Writes the mesh checkpoint (see Mesh::saveCheckpoint()) along with a file per MPI rank containing the local
+  // ! coefficients for the cells the rank owns.  Must be called on all ranks.
+  void saveCheckpoint(std::string checkpointPrefix);
+  // ! Loads a mesh and solution written by saveCheckpoint(); requires the same number of MPI ranks as the writer.
+  static TSolutionPtr<Scalar> loadFromCheckpoint(TBFPtr<Scalar> bf, std::string checkpointPrefix, Epetra_CommPtr Comm = Teuchos::null);
+
 #ifdef HAVE_EPETRAEXT_HDF5
   void save(std::string meshAndSolutionPrefix);
   static TSolutionPtr<Scalar> load(TBFPtr<Scalar> bf, std::string meshAndSolutionPrefix);
@@ -357,6 +390,13 @@ public:
   void setUseCondensedSolve(bool value, std::set<GlobalIndexType> offRankCellsToInclude = std::set<GlobalIndexType>());
 
   bool usesCondensedSolve() const;
+
+  // ! When true, populateStiffnessAndLoad() eliminates the Dirichlet BCs from each cell's contribution before inserting it into
+  // ! the global system, instead of calling imposeBCs() on the assembled matrix.  The result is the same (symmetric) system, obtained
+  // ! without the global matrix-vector product and the row/column zeroing pass.  Not supported for bilinear forms with DG jump terms,
+  // ! or when zero-mean constraints are imposed on a variable that also has BCs.  Defaults to false.
+  void setEliminateBCsDuringAssembly(bool value);
+  bool eliminatesBCsDuringAssembly() const;
   
   void writeStatsToFile(const std::string &filePath, int precision=4);
 
@@ -94,6 +94,20 @@ public:
   {
     
   }
+  // sets the relative residual tolerance for iterative solvers; direct solvers ignore this
+  virtual void setTolerance(double tol)
+  {
+    
+  }
+  // the relative residual tolerance for iterative solvers; direct solvers return 0
+  virtual double getTolerance()
+  {
+    return 0.0;
+  }
+  // lhs and rhs may have several columns (one per load).  The direct solvers factor the matrix once and then solve for every
+  // column, so that k loads cost one factorization plus k triangular solves; BlockCGSolver and PipelinedCGSolver also solve
+  // every column.  The AztecOO-based solvers (CGSolver, GMGSolver's default path) solve a single vector, and throw if
+  // given several columns.
   virtual int solve() = 0; // solve with an error code response
   virtual int resolve()
   {
@@ -0,0 +1,59 @@
+//
+//  SpaceFillingCurvePartitionPolicy.h
+//  Camellia
+//
+
+#ifndef Camellia_SpaceFillingCurvePartitionPolicy_h
+#define Camellia_SpaceFillingCurvePartitionPolicy_h
+
+#include "MeshPartitionPolicy.h"
+
+#include <cstdint>
+
+namespace Camellia
+{
+  //! SpaceFillingCurvePartitionPolicy: partitions a mesh by ordering the active cells along a space-filling curve,
+  //! and then dividing the ordered cells into contiguous chunks of equal size.
+
+  /*!
+   Root cells are ordered by the curve index of their centroids.  Refined cells are then visited depth-first through
+   the refinement hierarchy, with the children of each parent also ordered by curve index.  Siblings are therefore
+   contiguous in the ordering, so that children tend to land on their parent's rank, and partitions are spatially
+   compact.  Every rank computes the same ordering from the (replicated) MeshTopology, so that no communication is
+   required to determine the partition; registered solution data is migrated using CellDataMigration.
+   */
+  class SpaceFillingCurvePartitionPolicy : public MeshPartitionPolicy
+  {
+  public:
+    enum CurveType
+    {
+      HILBERT,
+      MORTON
+    };
+  private:
+    CurveType _curveType;
+  public:
+    SpaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm, CurveType curveType = HILBERT);
+
+    // ! Returns the active cells in meshTopo, in the order they are visited by the curve.
+    std::vector<GlobalIndexType> orderedActiveCells(MeshTopologyViewPtr meshTopo);
+
+    void partitionMesh(Mesh *mesh, PartitionIndexType numPartitions);
+
+    // ! Returns the index along the curve of the point with the given quantized coordinates, each of which must be less than 2^bitsPerDimension.
+    // ! Requires bitsPerDimension * coordinates.size() <= 64.
+    static uint64_t curveIndex(CurveType curveType, std::vector<uint32_t> coordinates, int bitsPerDimension);
+
+    // ! The number of coordinates on which the curve is defined: the mesh dimension, up to 3 (for space-time meshes of spatial dimension 3, time is ignored).
+    static int curveDimension(MeshTopologyViewPtr meshTopo);
+
+    // ! Sorts cellIndices by the curve index of the cell centroids, quantized within the box [minCoords, maxCoords] (whose
+    // ! size is curveDimension(meshTopo)).  Ties are broken by cell index.
+    static void sortCellsByCurveIndex(CurveType curveType, MeshTopologyViewPtr meshTopo, const std::vector<double> &minCoords,
+                                      const std::vector<double> &maxCoords, std::vector<GlobalIndexType> &cellIndices);
+
+    static Teuchos::RCP<SpaceFillingCurvePartitionPolicy> spaceFillingCurvePartitionPolicy(Epetra_CommPtr Comm, CurveType curveType = HILBERT);
+  };
+}
+
+#endif
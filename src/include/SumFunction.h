@@ -35,6 +35,7 @@ public:
 
   void values(Intrepid::FieldContainer<Scalar> &values, BasisCachePtr basisCache);
   bool boundaryValueOnly();
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
 
   string displayString();
 };
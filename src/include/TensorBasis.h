@@ -62,6 +62,10 @@ public:
    */
   int getDegree() const;
 
+  /** \brief Returns a description built from the display strings of the spatial and temporal bases.
+   */
+  std::string displayString() const;
+
   /** \brief  Given a vector of basis ordinal choices (one for each tensorial rank), returns the ordinal of the corresponding
               basis function in the tensor basis.
 
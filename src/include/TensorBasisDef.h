@@ -98,6 +98,12 @@ int TensorBasis<Scalar,ArrayScalar>::getDegree() const
   return max(_spatialBasis->getDegree(), _temporalBasis->getDegree());
 }
 
+template<class Scalar, class ArrayScalar>
+std::string TensorBasis<Scalar,ArrayScalar>::displayString() const
+{
+  return "TensorBasis(" + _spatialBasis->displayString() + " x " + _temporalBasis->displayString() + ")";
+}
+
 template<class Scalar, class ArrayScalar>
 const Teuchos::RCP< Camellia::Basis<Scalar, ArrayScalar> > TensorBasis<Scalar, ArrayScalar>::getSpatialBasis() const
 {
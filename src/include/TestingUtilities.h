@@ -64,6 +64,10 @@ public:
   //  static void getFieldFluxDofInds(MeshPtr mesh, map<int,set<int> > &localFluxInds, map<int,set<int> > &localFieldInds);
 
 
+  // Poisson with unit forcing and zero Dirichlet data on phi_hat, graph norm, on a uniform mesh of the unit square/cube;
+  // stiffness and load are assembled, so the matrix and RHS are ready for solver tests.
+  static TSolutionPtr<double> poissonSolutionWithStiffness(int spaceDim, int cellCount, int H1Order);
+
   static TSolutionPtr<double> makeNullSolution(MeshPtr mesh)
   {
     BCPtr nullBC = Teuchos::rcp((BC*)NULL);
@@ -29,6 +29,7 @@ public:
 
   int getCardinality() const;
   int getDegree() const;
+  std::string displayString() const;
 
   int getDofOrdinalFromComponentDofOrdinal(int componentDofOrdinal, int componentIndex) const;
   void getVectorizedValues(ArrayScalar& outputValues, const ArrayScalar & componentOutputValues,
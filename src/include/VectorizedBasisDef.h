@@ -31,6 +31,14 @@ int VectorizedBasis<Scalar,ArrayScalar>::getCardinality() const
   return _componentBasis->getCardinality() * _numComponents;
 }
 
+template<class Scalar, class ArrayScalar>
+std::string VectorizedBasis<Scalar,ArrayScalar>::displayString() const
+{
+  std::ostringstream str;
+  str << "VectorizedBasis(" << _numComponents << " x " << _componentBasis->displayString() << ")";
+  return str.str();
+}
+
 template<class Scalar, class ArrayScalar>
 const Teuchos::RCP< Basis<Scalar, ArrayScalar> > VectorizedBasis<Scalar, ArrayScalar>::getComponentBasis() const
 {
@@ -41,6 +41,8 @@ public:
 
   bool isZero();
 
+  void importOffRankCellData(const std::vector<BasisCachePtr> &basisCaches);
+
   virtual ~VectorizedFunction() { }
 };
 }
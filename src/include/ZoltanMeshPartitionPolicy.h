@@ -24,6 +24,9 @@ private:
   string _ZoltanPartitioner; // default to block
   string _debug_level;
 
+  bool _repartition; // if true, ask Zoltan to minimize migration relative to the existing partition
+  Teuchos::RCP<Zoltan> _zoltan; // kept between calls when _repartition is true, so that Zoltan can reuse its cuts
+
   //helper functions for query functions
   //  int getNextActiveIndex(Intrepid::FieldContainer<int> &partitionedActiveCells);
   //  static GlobalIndexType getIndexOfGID(int myNode, Intrepid::FieldContainer<GlobalIndexType> &partitionedActiveCells,GlobalIndexType globalID);
@@ -70,6 +73,11 @@ public:
   ZoltanMeshPartitionPolicy(Epetra_CommPtr Comm);
   ZoltanMeshPartitionPolicy(Epetra_CommPtr Comm, string partitionerName);
   virtual void partitionMesh(Mesh *mesh, PartitionIndexType numPartitions);
+
+  // ! When set, Zoltan is invoked with LB_APPROACH = REPARTITION, and the Zoltan object (along with its cuts) is
+  // ! retained between calls, so that successive partitions move as few cells as possible.  Off by default.
+  void setUseRepartitioning(bool value);
+  bool useRepartitioning() const;
 };
 }
 
@@ -11,6 +11,7 @@
 #include "Function.h"
 #include "HDF5Exporter.h"
 #include "MeshFactory.h"
+#include "ParametricCurve.h"
 #include "SpaceTimeHeatFormulation.h"
 #include "TypeDefs.h"
 
@@ -72,6 +73,92 @@ void testSpaceTimeTraceBCFunction(int spaceDim, Teuchos::FancyOStream &out, bool
   }
 }
   
+  // checks the batched projection in Boundary::bcsToImpose() against the per-cell variant
+  void checkBatchedBCsMatchPerCell(MeshPtr mesh, BCPtr bc, DofInterpreter* dofInterpreter, Teuchos::FancyOStream &out, bool &success)
+  {
+    Intrepid::FieldContainer<GlobalIndexType> bcGlobalIndices;
+    Intrepid::FieldContainer<double> bcGlobalValues;
+    mesh->boundary().bcsToImpose(bcGlobalIndices, bcGlobalValues, *bc, dofInterpreter);
+
+    map<GlobalIndexType,double> expectedValues;
+    set<pair<int, unsigned>> noSingletons;
+    for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+    {
+      mesh->boundary().bcsToImpose(expectedValues, *bc, cellID, noSingletons, dofInterpreter);
+    }
+
+    TEST_EQUALITY(bcGlobalIndices.size(), expectedValues.size());
+    double tol = 1e-14;
+    for (int i=0; i<bcGlobalIndices.size(); i++)
+    {
+      if (expectedValues.find(bcGlobalIndices[i]) == expectedValues.end())
+      {
+        out << "Dof Index " << bcGlobalIndices[i] << " not found in per-cell BC values.\n";
+        success = false;
+        continue;
+      }
+      double diff = abs(expectedValues[bcGlobalIndices[i]] - bcGlobalValues[i]);
+      if (diff > tol)
+      {
+        success = false;
+        out << "batched value != per-cell value (" << bcGlobalValues[i] << " != " << expectedValues[bcGlobalIndices[i]] << ")\n";
+      }
+    }
+  }
+
+  void testBatchedCoefficientsMatchPerCell(int spaceDim, Teuchos::FancyOStream &out, bool &success)
+  {
+    bool conformingTraces = true;
+    PoissonFormulation form(spaceDim,conformingTraces);
+
+    int H1Order = 3, delta_k = 1;
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), vector<double>(spaceDim,1.0), vector<int>(spaceDim,2), H1Order, delta_k);
+    // h-refine a corner cell, so that some boundary sides are constrained by hanging nodes
+    mesh->hRefine(vector<GlobalIndexType>{0});
+
+    FunctionPtr x = Function::xn(1), y = Function::yn(1);
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::matchingX(0.0) | SpatialFilter::matchingY(0.0), x * y + 1);
+    SolutionPtr soln = Solution::solution(form.bf(), mesh, bc);
+    checkBatchedBCsMatchPerCell(mesh, bc, soln->getDofInterpreter().get(), out, success);
+
+    // new BC values on the same mesh: the cached batches get reused
+    BCPtr otherBC = BC::bc();
+    otherBC->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), x * x - y);
+    checkBatchedBCsMatchPerCell(mesh, otherBC, soln->getDofInterpreter().get(), out, success);
+
+    // p-refinement changes element types, so the batches must be rebuilt
+    mesh->pRefine(vector<GlobalIndexType>{*mesh->getActiveCellIDs().rbegin()});
+    soln = Solution::solution(form.bf(), mesh, otherBC);
+    checkBatchedBCsMatchPerCell(mesh, otherBC, soln->getDofInterpreter().get(), out, success);
+
+    if (spaceDim != 2) return;
+
+    // curving a boundary edge changes the geometry without changing cells or element types; the batches must be rebuilt
+    const double PI  = 3.141592653589793238462;
+    map< pair<GlobalIndexType,GlobalIndexType>, ParametricCurvePtr > edgeToCurveMap;
+    for (GlobalIndexType cellID : mesh->getActiveCellIDs())
+    {
+      vector<unsigned> vertices = mesh->vertexIndicesForCell(cellID);
+      for (int vertexOrdinal=0; vertexOrdinal<vertices.size(); vertexOrdinal++)
+      {
+        unsigned v0 = vertices[vertexOrdinal], v1 = vertices[(vertexOrdinal+1)%vertices.size()];
+        Intrepid::FieldContainer<double> x0 = mesh->vertexCoordinates(v0), x1 = mesh->vertexCoordinates(v1);
+        if ((x0(1) != 0.0) || (x1(1) != 0.0)) continue;
+        // circular arc through the edge's endpoints, bulging downward
+        double halfLength = abs(x1(0) - x0(0)) / 2.0, xMid = (x0(0) + x1(0)) / 2.0;
+        ParametricCurvePtr arc = ParametricCurve::circularArc(halfLength * sqrt(2.0), xMid, halfLength, 5.0 * PI / 4.0, 7.0 * PI / 4.0);
+        if (x0(0) > x1(0)) arc = ParametricCurve::reverse(arc);
+        edgeToCurveMap[{v0,v1}] = arc;
+        break;
+      }
+      if (edgeToCurveMap.size() > 0) break;
+    }
+    TEST_EQUALITY(edgeToCurveMap.size(), 1);
+    mesh->setEdgeToCurveMap(edgeToCurveMap);
+    checkBatchedBCsMatchPerCell(mesh, otherBC, soln->getDofInterpreter().get(), out, success);
+  }
+
   void testTagCoefficientsMatchLegacy(int spaceDim, bool useFieldBCs, Teuchos::FancyOStream &out, bool &success)
   {
     // test that the coefficients determined for a BC object that uses the new tag-based BCs
@@ -157,6 +244,12 @@ void testSpaceTimeTraceBCFunction(int spaceDim, Teuchos::FancyOStream &out, bool
     }
   }
 
+  TEUCHOS_UNIT_TEST( BC, BatchedCoefficientsMatchPerCell_2D )
+  {
+    int spaceDim = 2;
+    testBatchedCoefficientsMatchPerCell(spaceDim, out, success);
+  }
+
   TEUCHOS_UNIT_TEST( BC, FieldBCsMinRule_1D)
   {
     int spaceDim = 1;
@@ -13,6 +13,8 @@
 #include "BasisSumFunction.h"
 #include "CamelliaCellTools.h"
 #include "CellTopology.h"
+#include "GlobalDofAssignment.h"
+#include "IP.h"
 #include "MeshFactory.h"
 #include "PoissonFormulation.h"
 #include "SerialDenseWrapper.h"
@@ -730,4 +732,63 @@ TEUCHOS_UNIT_TEST( BasisCache, SetRefCellPointsSpaceTimeSide )
     FieldContainer<double> valuesActual = *basisCache->getTransformedValues(basis, op);
     TEST_COMPARE_FLOATING_ARRAYS(values, valuesActual, 1e-13);
   }
+
+  TEUCHOS_UNIT_TEST( BasisCache, CubaturePhasingMatchesUnphased )
+  {
+    // Gram and stiffness matrices computed in cubature phases should match those computed all at once
+    int spaceDim = 2;
+    bool conformingTraces = false;
+    PoissonFormulation form(spaceDim, conformingTraces);
+    BFPtr bf = form.bf();
+    IPPtr ip = bf->graphNorm();
+
+    int H1Order = 4;
+    MeshPtr mesh = MeshFactory::rectilinearMesh(bf, {1.0,2.0}, {1,1}, H1Order);
+    GlobalIndexType cellID = 0;
+    const set<GlobalIndexType>* myCells = &mesh->cellIDsInPartition();
+    if (myCells->find(cellID) == myCells->end()) return;
+
+    ElementTypePtr elemType = mesh->getElementType(cellID);
+    int numTestDofs = elemType->testOrderPtr->totalDofs();
+    int numTrialDofs = elemType->trialOrderPtr->totalDofs();
+    FieldContainer<double> cellSideParities = mesh->globalDofAssignment()->cellSideParitiesForCell(cellID);
+
+    FieldContainer<double> gramExpected(1,numTestDofs,numTestDofs), gramActual(1,numTestDofs,numTestDofs);
+    FieldContainer<double> stiffnessExpected(1,numTestDofs,numTrialDofs), stiffnessActual(1,numTestDofs,numTrialDofs);
+
+    bool testVsTest = true;
+    BasisCachePtr ipBasisCache = BasisCache::basisCacheForCell(mesh, cellID, testVsTest);
+    BasisCachePtr basisCache = BasisCache::basisCacheForCell(mesh, cellID);
+    TEST_EQUALITY(basisCache->maxPointsPerCubaturePhaseForCache(numTrialDofs + numTestDofs), -1); // phasing is off by default
+    ip->computeInnerProductMatrix(gramExpected, elemType->testOrderPtr, ipBasisCache);
+    bf->stiffnessMatrix(stiffnessExpected, elemType, cellSideParities, basisCache);
+
+    // a tiny cache size forces the minimum of 2 points per phase
+    BasisCache::setCubaturePhaseCacheSize(1);
+    ipBasisCache = BasisCache::basisCacheForCell(mesh, cellID, testVsTest);
+    basisCache = BasisCache::basisCacheForCell(mesh, cellID);
+    TEST_EQUALITY(basisCache->maxPointsPerCubaturePhaseForCache(numTrialDofs + numTestDofs), 2);
+    ip->computeInnerProductMatrix(gramActual, elemType->testOrderPtr, ipBasisCache);
+    bf->stiffnessMatrix(stiffnessActual, elemType, cellSideParities, basisCache);
+    // a second phased integration on the same cache starts from the pending (not yet restored) state
+    FieldContainer<double> stiffnessRepeated(1,numTestDofs,numTrialDofs);
+    bf->stiffnessMatrix(stiffnessRepeated, elemType, cellSideParities, basisCache);
+    BasisCache::setCubaturePhaseCacheSize(0);
+
+    // all cubature points should be restored (on demand) after phased integration
+    TEST_EQUALITY(basisCache->getCubaturePhaseCount(), 1);
+    TEST_EQUALITY(basisCache->getCubatureWeights().dimension(0), BasisCache::basisCacheForCell(mesh, cellID)->getCubatureWeights().dimension(0));
+    TEST_EQUALITY(basisCache->getRefCellPoints().dimension(0), BasisCache::basisCacheForCell(mesh, cellID)->getRefCellPoints().dimension(0));
+
+    double tol = 1e-12;
+    for (int i=0; i<gramExpected.size(); i++)
+    {
+      TEST_COMPARE(std::abs(gramExpected[i] - gramActual[i]), <, tol);
+    }
+    for (int i=0; i<stiffnessExpected.size(); i++)
+    {
+      TEST_COMPARE(std::abs(stiffnessExpected[i] - stiffnessActual[i]), <, tol);
+      TEST_COMPARE(std::abs(stiffnessExpected[i] - stiffnessRepeated[i]), <, tol);
+    }
+  }
 } // namespace
@@ -15,6 +15,7 @@
 #include "CamelliaTestingHelpers.h"
 #include "CellTopology.h"
 #include "doubleBasisConstruction.h"
+#include "Intrepid_HGRAD_QUAD_Cn_FEM.hpp"
 #include "LinearTerm.h"
 #include "MeshFactory.h"
 #include "SerialDenseWrapper.h"
@@ -2666,6 +2667,89 @@ TEUCHOS_UNIT_TEST( BasisReconciliation, MapFineSubcellPointsToCoarseSubcell_Inte
           coarseDomainDim, coarseDomainOrdinalInRefinementRoot, coarseSubcellPermutation, out, success);
 }
 
+TEUCHOS_UNIT_TEST( BasisReconciliation, PersistentWeightsRoundTrip )
+{
+  BasisReconciliation::clearPersistentWeights();
+  BasisReconciliation::setUsePersistentWeights(true);
+  
+  int fineOrder = 3, coarseOrder = 2;
+  BasisPtr fineBasis = Camellia::intrepidQuadHGRAD(fineOrder);
+  BasisPtr coarseBasis = Camellia::intrepidQuadHGRAD(coarseOrder);
+  RefinementBranch refinements = makeRefinementBranch(RefinementPattern::regularRefinementPatternQuad(), {0,0});
+  unsigned edgeDim = 1, fineEdgeOrdinal = 0, coarseEdgeOrdinal = 0, permutation = 0;
+  unsigned spaceDim = 2, cellOrdinal = 0;
+  
+  BasisReconciliation br;
+  SubBasisReconciliationWeights edgeWeights = br.constrainedWeights(edgeDim, fineBasis, fineEdgeOrdinal, refinements,
+                                                                    coarseBasis, coarseEdgeOrdinal, permutation);
+  SubBasisReconciliationWeights volumeWeights = br.constrainedWeights(spaceDim, fineBasis, cellOrdinal, refinements,
+                                                                      coarseBasis, cellOrdinal, permutation);
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsCount(), 2);
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsHitCount(), 0); // computed, not found
+  
+  string fileName = "BasisReconciliationPersistentWeightsTest.bin";
+  BasisReconciliation::savePersistentWeights(fileName);
+  BasisReconciliation::clearPersistentWeights();
+  TEST_ASSERT(BasisReconciliation::loadPersistentWeights(fileName));
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsCount(), 2);
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsHitCount(), 0);
+  
+  // a fresh instance should find the weights in the persistent store
+  BasisReconciliation loadedBR;
+  SubBasisReconciliationWeights loadedEdgeWeights = loadedBR.constrainedWeights(edgeDim, fineBasis, fineEdgeOrdinal, refinements,
+                                                                                coarseBasis, coarseEdgeOrdinal, permutation);
+  SubBasisReconciliationWeights loadedVolumeWeights = loadedBR.constrainedWeights(spaceDim, fineBasis, cellOrdinal, refinements,
+                                                                                  coarseBasis, cellOrdinal, permutation);
+  TEST_ASSERT(BasisReconciliation::equalWeights(edgeWeights, loadedEdgeWeights));
+  TEST_ASSERT(BasisReconciliation::equalWeights(volumeWeights, loadedVolumeWeights));
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsCount(), 2);
+  // both lookups should have been served by the loaded weights; none recomputed
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsHitCount(), 2);
+  
+  TEST_ASSERT(!BasisReconciliation::loadPersistentWeights("NonexistentBasisReconciliationWeights.bin"));
+  
+  remove(fileName.c_str());
+  BasisReconciliation::clearPersistentWeights();
+  BasisReconciliation::setUsePersistentWeights(false);
+}
+
+TEUCHOS_UNIT_TEST( BasisReconciliation, PersistentWeightsDistinguishNodalPoints )
+{
+  // two bases of the same type, degree, function space, and cardinality, which differ only in their nodal points,
+  // must not share persistent weights
+  BasisReconciliation::clearPersistentWeights();
+  BasisReconciliation::setUsePersistentWeights(true);
+
+  int fineOrder = 4, coarseOrder = 2;
+  int spaceDim = 2, scalarRank = 0;
+  BasisPtr spectralBasis = Camellia::intrepidQuadHGRAD(fineOrder);
+  typedef Intrepid::Basis_HGRAD_QUAD_Cn_FEM<double, Intrepid::FieldContainer<double> > IntrepidQuadBasis;
+  BasisPtr equispacedBasis = Teuchos::rcp( new IntrepidBasisWrapper<>( Teuchos::rcp( new IntrepidQuadBasis(fineOrder,Intrepid::POINTTYPE_EQUISPACED) ),
+                                                                      spaceDim, scalarRank, Camellia::FUNCTION_SPACE_HGRAD) );
+  BasisPtr coarseBasis = Camellia::intrepidQuadHGRAD(coarseOrder);
+  TEST_EQUALITY(spectralBasis->getCardinality(), equispacedBasis->getCardinality());
+  TEST_ASSERT(spectralBasis->displayString() != equispacedBasis->displayString());
+
+  RefinementBranch refinements = makeRefinementBranch(RefinementPattern::regularRefinementPatternQuad(), {0,0});
+  unsigned cellOrdinal = 0, permutation = 0;
+
+  BasisReconciliation spectralBR;
+  spectralBR.constrainedWeights(spaceDim, spectralBasis, cellOrdinal, refinements, coarseBasis, cellOrdinal, permutation);
+  BasisReconciliation equispacedBR;
+  SubBasisReconciliationWeights equispacedWeights = equispacedBR.constrainedWeights(spaceDim, equispacedBasis, cellOrdinal, refinements,
+                                                                                    coarseBasis, cellOrdinal, permutation);
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsCount(), 2);
+  TEST_EQUALITY(BasisReconciliation::persistentWeightsHitCount(), 0);
+
+  BasisReconciliation::clearPersistentWeights();
+  BasisReconciliation::setUsePersistentWeights(false);
+
+  BasisReconciliation expectedBR;
+  SubBasisReconciliationWeights expectedWeights = expectedBR.constrainedWeights(spaceDim, equispacedBasis, cellOrdinal, refinements,
+                                                                                coarseBasis, cellOrdinal, permutation);
+  TEST_ASSERT(BasisReconciliation::equalWeights(equispacedWeights, expectedWeights));
+}
+
 TEUCHOS_UNIT_TEST(BasisReconciliation, p)
 {
   // copied from DPGTests's BasisReconciliationTests::testP()
@@ -0,0 +1,64 @@
+//
+//  BlockCGSolverTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "BlockCGSolver.h"
+#include "CellBlockSmoother.h"
+#include "CGSolver.h"
+#include "Solution.h"
+#include "TestingUtilities.h"
+
+using namespace Camellia;
+
+namespace
+{
+  TEUCHOS_UNIT_TEST( BlockCGSolver, MultipleLoadsMatchDirectSolve )
+  {
+    int spaceDim = 2, cellCount = 3, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Teuchos::RCP<Epetra_CrsMatrix> A = solution->getStiffnessMatrix();
+
+    int numLoads = 3;
+    Teuchos::RCP<Epetra_MultiVector> b = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), numLoads) );
+    b->Random();
+    Teuchos::RCP<Epetra_MultiVector> xDirect = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), numLoads) );
+    SolverPtr directSolver = Solver::getDirectSolver();
+    directSolver->setProblem(A, xDirect, b);
+    directSolver->solve();
+
+    Teuchos::RCP<CellBlockSmoother> blockJacobi = Teuchos::rcp( new CellBlockSmoother(A.get(), solution->mesh(), solution->getDofInterpreter()) );
+    blockJacobi->Compute();
+
+    for (bool usePreconditioner : {false, true})
+    {
+      BlockCGSolver solver(5000, 1e-10);
+      if (usePreconditioner) solver.setPreconditioner(blockJacobi);
+
+      Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), numLoads) );
+      solver.setProblem(A, x, b);
+      TEST_EQUALITY(solver.solve(), 0);
+      out << "preconditioned = " << usePreconditioner << ": " << solver.iterationCount() << " block iterations" << endl;
+
+      for (int j=0; j<numLoads; j++)
+      {
+        Epetra_Vector xj(View, *x, j);
+        Epetra_Vector xDirect_j(View, *xDirect, j);
+        double xDirectNorm;
+        xDirect_j.NormInf(&xDirectNorm);
+        xj.Update(-1.0, xDirect_j, 1.0);
+        double diffNorm;
+        xj.NormInf(&diffNorm);
+        TEST_COMPARE(diffNorm, <, 1e-6 * xDirectNorm);
+      }
+    }
+
+    // CGSolver is AztecOO-based, and solves for a single vector only
+    CGSolver aztecSolver(5000, 1e-10);
+    Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), numLoads) );
+    aztecSolver.setProblem(A, x, b);
+    TEST_THROW(aztecSolver.solve(), std::invalid_argument);
+  }
+} // namespace
@@ -0,0 +1,111 @@
+//
+//  CellBlockSmootherTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "CamelliaTestingHelpers.h"
+#include "CellBlockSmoother.h"
+#include "Solution.h"
+#include "TestingUtilities.h"
+
+using namespace Camellia;
+
+namespace
+{
+  void testSingleCellIsExactInverse(CellBlockSmoother::RelaxationType relaxationType, Teuchos::FancyOStream &out, bool &success)
+  {
+    // with a single cell, there is just one block, so the smoother should invert the matrix exactly
+    int spaceDim = 2, cellCount = 1, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Epetra_CrsMatrix* A = solution->getStiffnessMatrix().get();
+
+    CellBlockSmoother smoother(A, solution->mesh(), solution->getDofInterpreter(), relaxationType);
+    int err = smoother.Compute();
+    TEST_EQUALITY(err, 0);
+
+    int numVectors = 2;
+    Epetra_MultiVector X(A->RowMap(), numVectors), AX(A->RowMap(), numVectors), Y(A->RowMap(), numVectors);
+    X.Random();
+    A->Apply(X, AX);
+    smoother.ApplyInverse(AX, Y);
+
+    double tol = 1e-10;
+    for (int v=0; v<numVectors; v++)
+    {
+      for (int LID=0; LID<A->RowMap().NumMyElements(); LID++)
+      {
+        TEST_COMPARE(abs(Y[v][LID] - X[v][LID]), <, tol);
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( CellBlockSmoother, BlockJacobiPreservesSymmetry )
+  {
+    // M = D^{-1} for symmetric D, so (M x, y) = (x, M y)
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Epetra_CrsMatrix* A = solution->getStiffnessMatrix().get();
+
+    CellBlockSmoother smoother(A, solution->mesh(), solution->getDofInterpreter(), CellBlockSmoother::BLOCK_JACOBI);
+    smoother.Compute();
+    TEST_COMPARE(smoother.NumBlocks(), >=, solution->mesh()->cellIDsInPartition().size());
+
+    Epetra_MultiVector x(A->RowMap(), 1), y(A->RowMap(), 1), Mx(A->RowMap(), 1), My(A->RowMap(), 1);
+    x.Random();
+    y.Random();
+    smoother.ApplyInverse(x, Mx);
+    smoother.ApplyInverse(y, My);
+
+    double Mx_dot_y, x_dot_My;
+    Mx.Dot(y, &Mx_dot_y);
+    x.Dot(My, &x_dot_My);
+    double tol = 1e-12;
+    TEST_FLOATING_EQUALITY(Mx_dot_y, x_dot_My, tol);
+  }
+
+  TEUCHOS_UNIT_TEST( CellBlockSmoother, SinglePrecisionMatchesDouble )
+  {
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Epetra_CrsMatrix* A = solution->getStiffnessMatrix().get();
+
+    vector<CellBlockSmoother::RelaxationType> relaxationTypes = {CellBlockSmoother::BLOCK_JACOBI, CellBlockSmoother::BLOCK_SYMMETRIC_GAUSS_SEIDEL};
+    for (CellBlockSmoother::RelaxationType relaxationType : relaxationTypes)
+    {
+      CellBlockSmoother doubleSmoother(A, solution->mesh(), solution->getDofInterpreter(), relaxationType);
+      CellBlockSmoother singleSmoother(A, solution->mesh(), solution->getDofInterpreter(), relaxationType);
+      singleSmoother.setUseSinglePrecision(true);
+      doubleSmoother.Compute();
+      singleSmoother.Compute();
+
+      int numVectors = 2;
+      Epetra_MultiVector X(A->RowMap(), numVectors), Y_double(A->RowMap(), numVectors), Y_single(A->RowMap(), numVectors);
+      X.Random();
+      doubleSmoother.ApplyInverse(X, Y_double);
+      singleSmoother.ApplyInverse(X, Y_single);
+
+      vector<double> doubleNorms(numVectors);
+      Y_double.NormInf(&doubleNorms[0]);
+      Y_single.Update(-1.0, Y_double, 1.0);
+      vector<double> diffNorms(numVectors);
+      Y_single.NormInf(&diffNorms[0]);
+      double relTol = 1e-3; // single precision carries about 7 digits; block condition numbers cost a few of them
+      for (int v=0; v<numVectors; v++)
+      {
+        TEST_COMPARE(diffNorms[v], <, relTol * doubleNorms[v]);
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( CellBlockSmoother, SingleCellIsExactInverse_Jacobi )
+  {
+    testSingleCellIsExactInverse(CellBlockSmoother::BLOCK_JACOBI, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( CellBlockSmoother, SingleCellIsExactInverse_SymmetricGaussSeidel )
+  {
+    testSingleCellIsExactInverse(CellBlockSmoother::BLOCK_SYMMETRIC_GAUSS_SEIDEL, out, success);
+  }
+} // namespace
@@ -0,0 +1,80 @@
+//
+//  ChebyshevSmootherTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "CellBlockSmoother.h"
+#include "ChebyshevSmoother.h"
+#include "Solution.h"
+#include "TestingUtilities.h"
+
+using namespace Camellia;
+
+namespace
+{
+  double energyNorm(Epetra_CrsMatrix* A, const Epetra_MultiVector &x)
+  {
+    Epetra_MultiVector Ax(x.Map(), 1);
+    A->Apply(x, Ax);
+    double value;
+    x.Dot(Ax, &value);
+    return sqrt(value);
+  }
+
+  TEUCHOS_UNIT_TEST( ChebyshevSmoother, ReducesErrorInEnergyNorm )
+  {
+    int spaceDim = 2, cellCount = 4, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Epetra_CrsMatrix* A = solution->getStiffnessMatrix().get();
+
+    Teuchos::RCP<CellBlockSmoother> blockJacobi = Teuchos::rcp( new CellBlockSmoother(A, solution->mesh(), solution->getDofInterpreter()) );
+    blockJacobi->Compute();
+
+    for (int degree=1; degree<=4; degree++)
+    {
+      ChebyshevSmoother smoother(A, blockJacobi, degree);
+      smoother.Compute();
+      TEST_COMPARE(smoother.maxEigenvalue(), >, 0.0);
+
+      // the error propagation operator I - M A should be a contraction in the energy norm
+      Epetra_MultiVector e(A->RowMap(), 1), Ae(A->RowMap(), 1), MAe(A->RowMap(), 1);
+      e.Random();
+      A->Apply(e, Ae);
+      smoother.ApplyInverse(Ae, MAe);
+      Epetra_MultiVector newError(e);
+      newError.Update(-1.0, MAe, 1.0);
+
+      double initialNorm = energyNorm(A, e);
+      double finalNorm = energyNorm(A, newError);
+      out << "degree " << degree << ": energy norm of error reduced from " << initialNorm << " to " << finalNorm << endl;
+      TEST_COMPARE(finalNorm, <, initialNorm);
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( ChebyshevSmoother, IsSymmetric )
+  {
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Epetra_CrsMatrix* A = solution->getStiffnessMatrix().get();
+
+    Teuchos::RCP<CellBlockSmoother> blockJacobi = Teuchos::rcp( new CellBlockSmoother(A, solution->mesh(), solution->getDofInterpreter()) );
+    blockJacobi->Compute();
+    int degree = 3;
+    ChebyshevSmoother smoother(A, blockJacobi, degree);
+    smoother.Compute();
+
+    Epetra_MultiVector x(A->RowMap(), 1), y(A->RowMap(), 1), Mx(A->RowMap(), 1), My(A->RowMap(), 1);
+    x.Random();
+    y.Random();
+    smoother.ApplyInverse(x, Mx);
+    smoother.ApplyInverse(y, My);
+
+    double Mx_dot_y, x_dot_My;
+    Mx.Dot(y, &Mx_dot_y);
+    x.Dot(My, &x_dot_My);
+    double tol = 1e-10;
+    TEST_FLOATING_EQUALITY(Mx_dot_y, x_dot_My, tol);
+  }
+} // namespace
@@ -1219,6 +1219,99 @@ namespace
     testCoarseBasisEqualsWeightedFineBasis(mesh, out, success);
   }
   
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, CellOrderingHangingNode )
+  {
+    // reordering cells within the partition should change only the numbering of the dofs
+    int spaceDim = 2;
+    int H1Order = 2;
+    int irregularity = 1;
+    bool useConformingTraces = true;
+    MeshPtr mesh = poissonIrregularMesh(spaceDim, irregularity, H1Order, useConformingTraces);
+    GDAMinimumRule* minRule = dynamic_cast<GDAMinimumRule*> (mesh->globalDofAssignment().get());
+    GlobalIndexType globalDofCount = mesh->numGlobalDofs();
+    
+    vector<GlobalDofAssignment::CellOrdering> orderings = {GlobalDofAssignment::SPACE_FILLING_CURVE_ORDERING,
+                                                           GlobalDofAssignment::REVERSE_CUTHILL_MCKEE_ORDERING};
+    for (GlobalDofAssignment::CellOrdering ordering : orderings)
+    {
+      minRule->setCellOrdering(ordering);
+      TEST_EQUALITY(mesh->numGlobalDofs(), globalDofCount);
+      
+      // every rank-local cell should be listed exactly once among the element types
+      set<GlobalIndexType> listedCellIDs;
+      int rank = mesh->Comm()->MyPID();
+      for (ElementTypePtr elemType : minRule->elementTypes(rank))
+      {
+        for (GlobalIndexType cellID : minRule->cellIDsOfElementType(rank, elemType))
+        {
+          TEST_ASSERT(listedCellIDs.find(cellID) == listedCellIDs.end());
+          listedCellIDs.insert(cellID);
+        }
+      }
+      TEST_ASSERT(listedCellIDs == minRule->cellsInPartition(-1));
+      
+      testContiguousGlobalDofNumbering(minRule, out, success);
+      testCoarseBasisEqualsWeightedFineBasis(mesh, out, success);
+    }
+  }
+  
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, CellOrderingReducesProfile )
+  {
+    // refining the cells of a uniform mesh in a scattered order scatters the children's cellIDs, so that cellID ordering
+    // numbers neighboring cells' dofs far apart; both the SFC and the RCM orderings should reduce the matrix profile
+    int spaceDim = 2;
+    int H1Order = 2;
+    bool useConformingTraces = true;
+    MeshPtr mesh = poissonUniformMesh(spaceDim, 4, H1Order, useConformingTraces);
+    vector<GlobalIndexType> refinementOrder = {5, 12, 0, 15, 9, 3, 14, 6, 10, 1, 13, 7, 2, 11, 4, 8};
+    for (GlobalIndexType cellID : refinementOrder)
+    {
+      mesh->hRefine(vector<GlobalIndexType>{cellID});
+    }
+    GDAMinimumRule* minRule = dynamic_cast<GDAMinimumRule*> (mesh->globalDofAssignment().get());
+    int rank = mesh->Comm()->MyPID();
+    
+    // the profile, restricted to our own dofs (whose numbering the ordering controls): the sum over our cells of the
+    // distance between the least and greatest owned global dof indices seen by the cell
+    auto ownedProfile = [&] () -> double
+    {
+      set<GlobalIndexType> ownedDofs = minRule->globalDofIndicesForPartition(rank);
+      double profile = 0;
+      for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+      {
+        set<GlobalIndexType> cellDofs = minRule->globalDofIndicesForCell(cellID);
+        GlobalIndexType minDof = -1, maxDof = 0;
+        for (GlobalIndexType dof : cellDofs)
+        {
+          if (ownedDofs.find(dof) == ownedDofs.end()) continue;
+          minDof = min(minDof, dof);
+          maxDof = max(maxDof, dof);
+        }
+        if (maxDof >= minDof) profile += maxDof - minDof;
+      }
+      return profile;
+    };
+    
+    double cellIDProfile = ownedProfile();
+    vector<GlobalDofAssignment::CellOrdering> orderings = {GlobalDofAssignment::SPACE_FILLING_CURVE_ORDERING,
+                                                           GlobalDofAssignment::REVERSE_CUTHILL_MCKEE_ORDERING};
+    for (GlobalDofAssignment::CellOrdering ordering : orderings)
+    {
+      minRule->setCellOrdering(ordering);
+      double profile = ownedProfile();
+      if (mesh->cellIDsInPartition().size() > 4)
+      {
+        TEST_COMPARE(profile, <, cellIDProfile);
+      }
+      else
+      {
+        TEST_COMPARE(profile, <=, cellIDProfile);
+      }
+    }
+    minRule->setCellOrdering(GlobalDofAssignment::CELL_ID_ORDERING);
+    TEST_EQUALITY(ownedProfile(), cellIDProfile);
+  }
+  
   TEUCHOS_UNIT_TEST( GDAMinimumRule, CheckConstraintsPoisson3DUniform )
   {
     MeshPtr mesh = poisson3DUniformMesh();
@@ -1249,6 +1342,51 @@ namespace
     testSubcellConstraintIsAncestor(mesh, out, success);
   }
   
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, CompiledDofMapperMatchesUncompiled )
+  {
+    // the compiled local-to-global operator should reproduce the SubBasisDofMapper walk, including on constrained cells
+    int spaceDim = 2;
+    int H1Order = 2;
+    int irregularity = 1;
+    bool useConformingTraces = true;
+    MeshPtr mesh = poissonIrregularMesh(spaceDim, irregularity, H1Order, useConformingTraces);
+    GDAMinimumRule* minRule = dynamic_cast<GDAMinimumRule*> (mesh->globalDofAssignment().get());
+
+    double tol = 1e-13;
+    for (GlobalIndexType cellID : minRule->cellsInPartition(-1))
+    {
+      CellConstraints constraints = minRule->getCellConstraints(cellID);
+      LocalDofMapperPtr dofMapper = minRule->getDofMapper(cellID, constraints);
+      int localDofCount = mesh->getElementType(cellID)->trialOrderPtr->totalDofs();
+
+      FieldContainer<double> localMatrix(localDofCount,localDofCount);
+      FieldContainer<double> localVector(localDofCount);
+      for (int i=0; i<localDofCount; i++)
+      {
+        localVector(i) = sin(i + 1.0);
+        for (int j=0; j<localDofCount; j++)
+        {
+          localMatrix(i,j) = cos(i + 2.0 * j);
+        }
+      }
+
+      for (bool fittableGlobalDofsOnly : {false, true})
+      {
+        dofMapper->setUseCompiledMap(false);
+        FieldContainer<double> expectedMatrix = dofMapper->mapLocalData(localMatrix, fittableGlobalDofsOnly);
+        FieldContainer<double> expectedVector = dofMapper->mapLocalData(localVector, fittableGlobalDofsOnly);
+
+        dofMapper->setUseCompiledMap(true);
+        FieldContainer<double> actualMatrix = dofMapper->mapLocalData(localMatrix, fittableGlobalDofsOnly);
+        TEST_ASSERT(dofMapper->isCompiled(fittableGlobalDofsOnly));
+        FieldContainer<double> actualVector = dofMapper->mapLocalData(localVector, fittableGlobalDofsOnly);
+
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA_ABSTOLTOO(expectedMatrix, actualMatrix, tol, tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA_ABSTOLTOO(expectedVector, actualVector, tol, tol);
+      }
+    }
+  }
+
   TEUCHOS_UNIT_TEST( GDAMinimumRule, ContiguousGlobalDofNumberingComplexSpaceTimeMesh )
   {
     bool useConformingTraces = true;
@@ -1287,6 +1425,99 @@ namespace
     TEST_EQUALITY(numVertices, globalDofCount);
   }
   
+  // alternating h- and p-refinements of the cells containing refinementPoints; after each, the incremental rebuild should
+  // number the dofs exactly as a full rebuild does.  With more than one rank, the comparison is made on each rank's cells, and
+  // mismatches are summed over all ranks.
+  void testIncrementalRebuildMatchesFullRebuild(int spaceDim, int meshWidth, const FieldContainer<double> &refinementPoints,
+                                                bool testCoarseBasis, Teuchos::FancyOStream &out, bool &success)
+  {
+    int H1Order = 2;
+    bool useConformingTraces = true;
+    MeshPtr incrementalMesh = poissonUniformMesh(spaceDim, meshWidth, H1Order, useConformingTraces);
+    MeshPtr fullMesh = poissonUniformMesh(spaceDim, meshWidth, H1Order, useConformingTraces);
+    GDAMinimumRule* incrementalMinRule = dynamic_cast<GDAMinimumRule*>(incrementalMesh->globalDofAssignment().get());
+    GDAMinimumRule* fullMinRule = dynamic_cast<GDAMinimumRule*>(fullMesh->globalDofAssignment().get());
+    fullMinRule->setUseIncrementalRebuild(false);
+    
+    int numRefinements = 4;
+    for (int refNumber=0; refNumber<numRefinements; refNumber++)
+    {
+      for (MeshPtr mesh : {incrementalMesh, fullMesh})
+      {
+        bool minusOnesForOffRank = false;
+        vector<GlobalIndexType> cellIDs = mesh->cellIDsForPoints(refinementPoints, minusOnesForOffRank);
+        set<GlobalIndexType> cellIDSet(cellIDs.begin(), cellIDs.end());
+        if (refNumber % 2 == 0)
+        {
+          mesh->hRefine(cellIDSet);
+          mesh->enforceOneIrregularity();
+        }
+        else
+        {
+          int pToAdd = 1;
+          mesh->pRefine(cellIDSet, pToAdd);
+        }
+      }
+      TEST_EQUALITY(incrementalMesh->numGlobalDofs(), fullMesh->numGlobalDofs());
+      
+      // both meshes use the same partition policy, so they should be partitioned alike
+      const set<GlobalIndexType>* myCells = &incrementalMinRule->cellsInPartition(-1);
+      TEST_ASSERT(*myCells == fullMinRule->cellsInPartition(-1));
+      
+      int myMismatchCount = 0;
+      for (GlobalIndexType cellID : *myCells)
+      {
+        if (incrementalMinRule->globalDofIndicesForCell(cellID) != fullMinRule->globalDofIndicesForCell(cellID))
+        {
+          out << "dof indices differ for cell " << cellID << " on rank " << incrementalMesh->Comm()->MyPID() << endl;
+          myMismatchCount++;
+        }
+      }
+      int globalMismatchCount = 0;
+      incrementalMesh->Comm()->SumAll(&myMismatchCount, &globalMismatchCount, 1);
+      TEST_EQUALITY(globalMismatchCount, 0);
+      testContiguousGlobalDofNumbering(incrementalMinRule, out, success);
+    }
+    if (testCoarseBasis) testCoarseBasisEqualsWeightedFineBasis(incrementalMesh, out, success);
+  }
+  
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, IncrementalRebuildMatchesFullRebuild )
+  {
+    // local refinements near a corner
+    int spaceDim = 2, meshWidth = 4;
+    FieldContainer<double> cornerPoint(1,spaceDim);
+    cornerPoint(0,0) = 1e-3;
+    cornerPoint(0,1) = 1e-3;
+    bool testCoarseBasis = true;
+    testIncrementalRebuildMatchesFullRebuild(spaceDim, meshWidth, cornerPoint, testCoarseBasis, out, success);
+  }
+  
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, IncrementalRebuildMatchesFullRebuild_Hexahedra )
+  {
+    // local refinements near a corner of the unit cube; hanging faces and edges both arise
+    int spaceDim = 3, meshWidth = 2;
+    FieldContainer<double> cornerPoint(1,spaceDim);
+    cornerPoint(0,0) = 1e-3;
+    cornerPoint(0,1) = 1e-3;
+    cornerPoint(0,2) = 1e-3;
+    bool testCoarseBasis = false; // expensive in 3D; the 2D test covers it
+    testIncrementalRebuildMatchesFullRebuild(spaceDim, meshWidth, cornerPoint, testCoarseBasis, out, success);
+  }
+  
+  TEUCHOS_UNIT_TEST( GDAMinimumRule, IncrementalRebuildMatchesFullRebuild_PartitionBoundary )
+  {
+    // refinements on either side of the center, so that with more than one rank (runTestsMPI) the changed cells straddle a
+    // partition boundary, and repartitioning after each refinement moves cells between ranks
+    int spaceDim = 2, meshWidth = 4;
+    FieldContainer<double> centerPoints(2,spaceDim);
+    centerPoints(0,0) = 0.49;
+    centerPoints(0,1) = 0.49;
+    centerPoints(1,0) = 0.51;
+    centerPoints(1,1) = 0.51;
+    bool testCoarseBasis = false;
+    testIncrementalRebuildMatchesFullRebuild(spaceDim, meshWidth, centerPoints, testCoarseBasis, out, success);
+  }
+  
   TEUCHOS_UNIT_TEST( GDAMinimumRule, InterpretLocalBasisCoefficientsHangingNode_Triangles )
   {
     /*
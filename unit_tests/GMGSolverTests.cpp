@@ -831,7 +831,9 @@ void testOperatorIsSPD(int spaceDim, GridType gridType, GMGOperator::SmootherApp
     fineSolution->populateStiffnessAndLoad();
     solver->gmgOperator()->setFineStiffnessMatrix(fineSolution->getStiffnessMatrix().get());
 
-    vector<GMGOperator::SmootherChoice> smootherChoices = {GMGOperator::NONE, GMGOperator::IFPACK_ADDITIVE_SCHWARZ, GMGOperator::CAMELLIA_ADDITIVE_SCHWARZ};
+    vector<GMGOperator::SmootherChoice> smootherChoices = {GMGOperator::NONE, GMGOperator::IFPACK_ADDITIVE_SCHWARZ, GMGOperator::CAMELLIA_ADDITIVE_SCHWARZ,
+                                                          GMGOperator::CAMELLIA_BLOCK_JACOBI, GMGOperator::CAMELLIA_BLOCK_SYMMETRIC_GAUSS_SEIDEL,
+                                                          GMGOperator::CHEBYSHEV};
 
     for (GMGOperator::SmootherChoice smoother : smootherChoices)
     {
@@ -997,6 +999,142 @@ void testOperatorIsSPD(int spaceDim, GridType gridType, GMGOperator::SmootherApp
     testOperatorIsSPD(spaceDim, gridType, smootherApplicationType, out, success);
   }
 
+  TEUCHOS_UNIT_TEST( GMGSolver, PoissonPreconditionerReuse_2D )
+  {
+    // repeated solves with a lagged hierarchy should agree with a direct solve, and rebuild only when the policy says so
+    int spaceDim = 2;
+    FunctionPtr phi_exact = getPhiExact(spaceDim);
+    Teuchos::RCP<GMGSolver> gmgSolver;
+    SolutionPtr fineSolution;
+    setupPoissonGMGSolver_TwoGrid_h(gmgSolver, fineSolution, spaceDim, phi_exact);
+    
+    SolutionPtr directSolution = Solution::solution(fineSolution->mesh(), fineSolution->bc(), fineSolution->rhs(), fineSolution->ip());
+    directSolution->solve();
+    
+    vector<GMGSolver::PreconditionerReuse> reuseChoices = {GMGSolver::REUSE_HIERARCHY, GMGSolver::REUSE_COARSE_HIERARCHY};
+    for (GMGSolver::PreconditionerReuse reuseChoice : reuseChoices)
+    {
+      int maxReuseCount = 1;
+      gmgSolver->setPreconditionerReuse(reuseChoice, maxReuseCount);
+      int initialBuildCount = gmgSolver->getPreconditionerBuildCount();
+      gmgSolver->forcePreconditionerRebuild();
+      
+      int numSolves = 3; // build, reuse, rebuild
+      for (int i=0; i<numSolves; i++)
+      {
+        fineSolution->solve(gmgSolver);
+        
+        double tol = 1e-5;
+        for (VarPtr fieldVar : fineSolution->mesh()->bilinearForm()->varFactory()->fieldVars())
+        {
+          FunctionPtr gmgSoln = Function::solution(fieldVar, fineSolution);
+          FunctionPtr directSoln = Function::solution(fieldVar, directSolution);
+          double diff = (gmgSoln - directSoln)->l2norm(fineSolution->mesh());
+          TEST_COMPARE(diff, <, tol);
+        }
+      }
+      TEST_EQUALITY(gmgSolver->getPreconditionerBuildCount() - initialBuildCount, 2);
+      
+      map<string,double> timings = gmgSolver->timingReport();
+      TEST_COMPARE(timings["setup"], >, 0.0);
+      TEST_COMPARE(timings["solve"], >, 0.0);
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( GMGSolver, PoissonSinglePrecisionHierarchy_2D )
+  {
+    // storing the hierarchy in single precision should not change the solution, and should not materially change the iteration count
+    int spaceDim = 2;
+    FunctionPtr phi_exact = getPhiExact(spaceDim);
+    Teuchos::RCP<GMGSolver> gmgSolver;
+    SolutionPtr fineSolution;
+    int coarseElementCount = 2;
+    setupPoissonGMGSolver_ThreeGrid(gmgSolver, fineSolution, spaceDim, phi_exact, coarseElementCount);
+    gmgSolver->setUseConjugateGradient(true);
+
+    SolutionPtr directSolution = Solution::solution(fineSolution->mesh(), fineSolution->bc(), fineSolution->rhs(), fineSolution->ip());
+    directSolution->solve();
+
+    vector<GMGOperator::SmootherChoice> smootherChoices = {GMGOperator::CAMELLIA_BLOCK_JACOBI, GMGOperator::CHEBYSHEV};
+    for (GMGOperator::SmootherChoice smoother : smootherChoices)
+    {
+      out << "***************** Testing smoother choice " << GMGOperator::smootherString(smoother) << " *****************" << endl;
+      gmgSolver->setSmootherType(smoother);
+
+      // the second single-precision solve rebuilds the coarse matrices from the single-precision prolongation operator,
+      // since the double-precision one is released once the copy exists
+      vector<int> iterationCounts;
+      vector<long long> storageBytes; // prolongation operators and smoother factors, summed over the levels
+      for (bool useSinglePrecision : {false, true, true})
+      {
+        gmgSolver->setUseSinglePrecision(useSinglePrecision);
+        fineSolution->solve(gmgSolver);
+        iterationCounts.push_back(gmgSolver->iterationCount());
+        long long bytes = 0;
+        for (Teuchos::RCP<GMGOperator> op = gmgSolver->gmgOperator(); op != Teuchos::null; op = op->getCoarseOperator())
+        {
+          bytes += op->getStorageBytes();
+        }
+        storageBytes.push_back(bytes);
+        TEST_ASSERT(gmgSolver->gmgOperator()->getProlongationOperator() != Teuchos::null);
+
+        double tol = 1e-5;
+        for (VarPtr fieldVar : fineSolution->mesh()->bilinearForm()->varFactory()->fieldVars())
+        {
+          FunctionPtr gmgSoln = Function::solution(fieldVar, fineSolution);
+          FunctionPtr directSoln = Function::solution(fieldVar, directSolution);
+          double diff = (gmgSoln - directSoln)->l2norm(fineSolution->mesh());
+          TEST_COMPARE(diff, <, tol);
+        }
+      }
+      out << "iteration counts (double, single, single): " << iterationCounts[0] << ", " << iterationCounts[1] << ", " << iterationCounts[2] << endl;
+      int allowedExtraIterations = 2;
+      TEST_COMPARE(iterationCounts[1], <=, iterationCounts[0] + allowedExtraIterations);
+      TEST_COMPARE(iterationCounts[2], <=, iterationCounts[0] + allowedExtraIterations);
+
+      // per nonzero, the prolongation operator drops from 12 to 8 bytes, and the smoother factors from 8 to 4
+      out << "storage bytes (double, single, single): " << storageBytes[0] << ", " << storageBytes[1] << ", " << storageBytes[2] << endl;
+      TEST_COMPARE(storageBytes[0], >, 0);
+      TEST_COMPARE(storageBytes[1], <=, 2 * storageBytes[0] / 3);
+      TEST_COMPARE(storageBytes[2], <=, 2 * storageBytes[0] / 3);
+    }
+    TEST_ASSERT(gmgSolver->gmgOperator()->getUseSinglePrecision());
+  }
+
+  TEUCHOS_UNIT_TEST( GMGSolver, PoissonPipelinedCG_2D )
+  {
+    // pipelined CG should agree with a direct solve, in about as many iterations as AztecOO's CG
+    int spaceDim = 2;
+    FunctionPtr phi_exact = getPhiExact(spaceDim);
+    Teuchos::RCP<GMGSolver> gmgSolver;
+    SolutionPtr fineSolution;
+    setupPoissonGMGSolver_TwoGrid_h(gmgSolver, fineSolution, spaceDim, phi_exact);
+    gmgSolver->setUseConjugateGradient(true);
+
+    SolutionPtr directSolution = Solution::solution(fineSolution->mesh(), fineSolution->bc(), fineSolution->rhs(), fineSolution->ip());
+    directSolution->solve();
+
+    vector<int> iterationCounts;
+    for (bool usePipelinedCG : {false, true})
+    {
+      gmgSolver->setUsePipelinedConjugateGradient(usePipelinedCG);
+      fineSolution->solve(gmgSolver);
+      iterationCounts.push_back(gmgSolver->iterationCount());
+
+      double tol = 1e-5;
+      for (VarPtr fieldVar : fineSolution->mesh()->bilinearForm()->varFactory()->fieldVars())
+      {
+        FunctionPtr gmgSoln = Function::solution(fieldVar, fineSolution);
+        FunctionPtr directSoln = Function::solution(fieldVar, directSolution);
+        double diff = (gmgSoln - directSoln)->l2norm(fineSolution->mesh());
+        TEST_COMPARE(diff, <, tol);
+      }
+    }
+    out << "iteration counts (AztecOO CG, pipelined CG): " << iterationCounts[0] << ", " << iterationCounts[1] << endl;
+    int allowedExtraIterations = 2;
+    TEST_COMPARE(iterationCounts[1], <=, iterationCounts[0] + allowedExtraIterations);
+  }
+
 //  TEUCHOS_UNIT_TEST( GMGSolver, DebuggingOperatorApplyInverse )
 //  {
 //    int rank = Teuchos::GlobalMPISession::getRank();
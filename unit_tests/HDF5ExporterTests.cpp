@@ -0,0 +1,139 @@
+//
+//  HDF5ExporterTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "EpetraExt_ConfigDefs.h"
+#ifdef HAVE_EPETRAEXT_HDF5
+
+#include "DataIO.h"
+#include "Function.h"
+#include "HDF5Exporter.h"
+#include "MeshFactory.h"
+#include "ParametricCurve.h"
+#include "PoissonFormulation.h"
+
+#include "Epetra_SerialComm.h"
+#include "EpetraExt_HDF5.h"
+
+using namespace Camellia;
+using namespace std;
+
+namespace
+{
+  TEUCHOS_UNIT_TEST( HDF5Exporter, AsynchronousWritesFromTwoExporters )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 2, delta_k = 2, meshWidth = 4;
+    MeshPtr mesh = MeshFactory::quadMeshMinRule(form.bf(), H1Order, delta_k, 1.0, 1.0, meshWidth, meshWidth);
+
+    FunctionPtr x = Function::xn(1), y = Function::yn(1);
+    FunctionPtr f = x * x + y;
+
+    // two exporters, each with its own writer thread, with a small buffer so that exports queue up behind the writes
+    vector<string> dirNames = {"asyncExportTestA", "asyncExportTestB"};
+    size_t maxBufferedBytes = 4 * 1024;
+    HDF5Exporter exporterA(mesh, dirNames[0]), exporterB(mesh, dirNames[1]);
+    exporterA.setAsynchronousWrites(true, maxBufferedBytes);
+    exporterB.setAsynchronousWrites(true, maxBufferedBytes);
+    // without MPI_THREAD_MULTIPLE, the exporters fall back on synchronous writes; the rest of the test applies either way
+    TEST_EQUALITY(exporterA.asynchronousWrites(), HDF5Exporter::asynchronousWritesSupported());
+    TEST_EQUALITY(exporterB.asynchronousWrites(), HDF5Exporter::asynchronousWritesSupported());
+
+    int numTimeSteps = 8;
+    string meshFile = "asyncExportTestMesh.h5";
+    for (int timeStep=0; timeStep<numTimeSteps; timeStep++)
+    {
+      exporterA.exportFunction(f, "f", timeStep);
+      exporterB.exportFunction(f, "f", timeStep);
+      if (timeStep == numTimeSteps / 2)
+      {
+        // HDF5 use on the main thread, while the writer threads are busy
+        mesh->saveToHDF5(meshFile);
+      }
+    }
+    TEST_NOTHROW(exporterA.flush());
+    TEST_NOTHROW(exporterB.flush());
+
+    MeshPtr loadedMesh = MeshFactory::loadFromHDF5(form.bf(), meshFile);
+    TEST_EQUALITY(loadedMesh->numActiveElements(), mesh->numActiveElements());
+
+    // every queued write should have produced a readable file with the exported data
+    int rank = mesh->Comm()->MyPID();
+    for (string dirName : dirNames)
+    {
+      for (int timeStep=0; timeStep<numTimeSteps; timeStep++)
+      {
+        ostringstream filePath;
+        filePath << "./" << dirName << "/HDF5/field-part" << rank << "-time" << timeStep << ".h5";
+        std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
+        Epetra_SerialComm SerialComm;
+        EpetraExt::HDF5 hdf5(SerialComm);
+        hdf5.Open(filePath.str());
+        if (mesh->cellIDsInPartition().size() > 0)
+        {
+          TEST_ASSERT(hdf5.IsContained("f", "Data"));
+        }
+        hdf5.Close();
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( HDF5Exporter, SharedFileRewritesGeometryOnlyWhenChanged )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 2, delta_k = 2, meshWidth = 2;
+    MeshPtr mesh = MeshFactory::quadMeshMinRule(form.bf(), H1Order, delta_k, 1.0, 1.0, meshWidth, meshWidth);
+
+    FunctionPtr f = Function::xn(1) + Function::yn(1);
+
+    string dirName = "sharedFileExportTest";
+    HDF5Exporter exporter(mesh, dirName);
+    exporter.setOutputMode(HDF5Exporter::SHARED_FILE);
+
+    // time 0 writes the geometry; time 1 has the same cells and geometry, so it refers to time 0's file
+    exporter.exportFunction(f, "f", 0);
+    exporter.exportFunction(f, "f", 1);
+
+    // curving an edge changes the geometry without changing the exported cells
+    const double PI  = 3.141592653589793238462;
+    GlobalIndexType curvedCellID = 0;
+    vector<unsigned> vertices = mesh->vertexIndicesForCell(curvedCellID);
+    map< pair<GlobalIndexType,GlobalIndexType>, ParametricCurvePtr > edgeToCurveMap;
+    for (int vertexOrdinal=0; vertexOrdinal<vertices.size(); vertexOrdinal++)
+    {
+      unsigned v0 = vertices[vertexOrdinal], v1 = vertices[(vertexOrdinal+1)%vertices.size()];
+      Intrepid::FieldContainer<double> x0 = mesh->vertexCoordinates(v0), x1 = mesh->vertexCoordinates(v1);
+      if ((x0(1) != 0.0) || (x1(1) != 0.0)) continue;
+      double halfLength = abs(x1(0) - x0(0)) / 2.0, xMid = (x0(0) + x1(0)) / 2.0;
+      ParametricCurvePtr arc = ParametricCurve::circularArc(halfLength * sqrt(2.0), xMid, halfLength, 5.0 * PI / 4.0, 7.0 * PI / 4.0);
+      if (x0(0) > x1(0)) arc = ParametricCurve::reverse(arc);
+      edgeToCurveMap[{v0,v1}] = arc;
+    }
+    TEST_EQUALITY(edgeToCurveMap.size(), 1);
+    mesh->setEdgeToCurveMap(edgeToCurveMap);
+    exporter.exportFunction(f, "f", 2);
+    exporter.flush();
+
+    map<int,bool> expectPoints = {{0,true},{1,false},{2,true}};
+    for (auto timeEntry : expectPoints)
+    {
+      ostringstream filePath;
+      filePath << "./" << dirName << "/HDF5/field-time" << timeEntry.first << ".h5";
+      std::lock_guard<std::recursive_mutex> hdf5Lock(DataIO::hdf5Mutex());
+      EpetraExt::HDF5 hdf5(*mesh->Comm());
+      hdf5.Open(filePath.str());
+      TEST_ASSERT(hdf5.IsContained("f", "Data"));
+      TEST_EQUALITY(hdf5.IsContained("Points", "Data"), timeEntry.second);
+      hdf5.Close();
+    }
+  }
+} // namespace
+
+#endif
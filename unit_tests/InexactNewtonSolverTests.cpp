@@ -0,0 +1,104 @@
+//
+//  InexactNewtonSolverTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "InexactNewtonSolver.h"
+#include "NonlinearSolveStrategy.h"
+#include "PipelinedCGSolver.h"
+#include "Solution.h"
+#include "TestingUtilities.h"
+
+using namespace Camellia;
+
+namespace
+{
+  TEUCHOS_UNIT_TEST( InexactNewtonSolver, ForcingTerms )
+  {
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Teuchos::RCP<Epetra_CrsMatrix> A = solution->getStiffnessMatrix();
+    Teuchos::RCP<Epetra_MultiVector> b0 = solution->getRHSVector();
+
+    Teuchos::RCP<PipelinedCGSolver> cgSolver = Teuchos::rcp( new PipelinedCGSolver(5000, 1e-10) );
+    double gamma = 0.9, alpha = 2.0, maxForcingTerm = 0.9;
+    InexactNewtonSolver newtonSolver(cgSolver, 1e-10, maxForcingTerm);
+    newtonSolver.setForcingParameters(gamma, alpha);
+
+    // mimic a Newton iteration whose residual drops by a factor of 10 per step
+    vector<double> residualScalings = {1.0, 0.1, 0.01};
+    double expectedForcingTerm = maxForcingTerm;
+    for (int step=0; step<residualScalings.size(); step++)
+    {
+      Teuchos::RCP<Epetra_MultiVector> b = Teuchos::rcp( new Epetra_MultiVector(*b0) );
+      b->Scale(residualScalings[step]);
+      Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+      newtonSolver.setProblem(A, x, b);
+      TEST_EQUALITY(newtonSolver.solve(), 0);
+
+      if (step > 0)
+      {
+        // the ratio term gamma * 0.1^alpha is small, so the safeguard gamma * eta_{k-1}^alpha is active
+        double ratioTerm = gamma * pow(0.1, alpha);
+        expectedForcingTerm = max(ratioTerm, gamma * pow(expectedForcingTerm, alpha));
+      }
+      TEST_FLOATING_EQUALITY(newtonSolver.forcingTerm(), expectedForcingTerm, 1e-12);
+
+      double bNorm, b0Norm;
+      b->Norm2(&bNorm);
+      b0->Norm2(&b0Norm);
+      TEST_FLOATING_EQUALITY(newtonSolver.residualNorm(), bNorm, 1e-12);
+      TEST_FLOATING_EQUALITY(newtonSolver.initialResidualNorm(), b0Norm, 1e-12);
+
+      // the linear residual should satisfy the forcing term
+      Epetra_MultiVector r(A->RowMap(), 1);
+      A->Apply(*x, r);
+      r.Update(1.0, *b, -1.0);
+      double rNorm;
+      r.Norm2(&rNorm);
+      TEST_COMPARE(rNorm, <=, 1.01 * expectedForcingTerm * bNorm);
+    }
+
+    newtonSolver.reset();
+    TEST_EQUALITY(newtonSolver.forcingTerm(), maxForcingTerm);
+
+    // the wrapped solver keeps the last forcing term until restoreTolerance() is called
+    TEST_FLOATING_EQUALITY(cgSolver->getTolerance(), expectedForcingTerm, 1e-12);
+    newtonSolver.restoreTolerance();
+    TEST_FLOATING_EQUALITY(cgSolver->getTolerance(), 1e-10, 1e-12);
+  }
+
+  void testNonlinearSolveLeavesTolerance(bool useInexactNewton, Teuchos::FancyOStream &out, bool &success)
+  {
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr backgroundFlow = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    SolutionPtr increment = Solution::solution(backgroundFlow->mesh(), backgroundFlow->bc(), backgroundFlow->rhs(), backgroundFlow->ip());
+
+    double tol = 1e-10;
+    Teuchos::RCP<PipelinedCGSolver> cgSolver = Teuchos::rcp( new PipelinedCGSolver(5000, tol) );
+    Teuchos::RCP<NonlinearStepSize> stepSize = Teuchos::rcp( new NonlinearStepSize(1.0) );
+    NonlinearSolveStrategy solveStrategy(backgroundFlow, increment, stepSize, 1e-8);
+    solveStrategy.setSolver(cgSolver);
+    solveStrategy.setConvergenceTest(NonlinearSolveStrategy::RESIDUAL_NORM);
+    solveStrategy.setUseInexactNewton(useInexactNewton);
+    solveStrategy.setMaxIterations(2); // the problem is linear, so the load never changes; we just need a couple of steps
+    solveStrategy.solve();
+
+    TEST_FLOATING_EQUALITY(cgSolver->getTolerance(), tol, 1e-12);
+  }
+
+  TEUCHOS_UNIT_TEST( InexactNewtonSolver, ResidualNormTestLeavesTolerance )
+  {
+    // with inexact Newton off, the residual test only records norms and must not loosen the user's tolerance
+    bool useInexactNewton = false;
+    testNonlinearSolveLeavesTolerance(useInexactNewton, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( InexactNewtonSolver, InexactNewtonRestoresTolerance )
+  {
+    bool useInexactNewton = true;
+    testNonlinearSolveLeavesTolerance(useInexactNewton, out, success);
+  }
+} // namespace
@@ -731,4 +731,44 @@ TEUCHOS_UNIT_TEST( LinearTerm, SpaceTimeNonzeroTimeDerivative_2D )
 //  {
 //    testSpaceTimeNonzeroTimeDerivative(3,out,success);
 //  }
+
+TEUCHOS_UNIT_TEST( LinearTerm, SymmetricIntegrationMatchesGeneral )
+{
+  // integrating a term against itself takes a symmetric code path; compare against integration against a copy of the term
+  int spaceDim = 2;
+  bool useConformingTraces = true;
+  PoissonFormulation form(spaceDim, useConformingTraces);
+
+  int H1Order = 3;
+  MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), {1.0,2.0}, {1,1}, H1Order); // non-square element
+  GlobalIndexType cellID = 0;
+  const set<GlobalIndexType>* myCells = &mesh->cellIDsInPartition();
+  if (myCells->find(cellID) == myCells->end()) return;
+
+  bool testVsTest = true;
+  BasisCachePtr basisCache = BasisCache::basisCacheForCell(mesh, cellID, testVsTest);
+  DofOrderingPtr testOrdering = mesh->getElementType(cellID)->testOrderPtr;
+  int numTestDofs = testOrdering->totalDofs();
+
+  VarPtr q = form.q(), tau = form.tau();
+  vector<LinearTermPtr> terms = {tau->div() - 3.0 * q, tau + q->grad()};
+  for (LinearTermPtr lt : terms)
+  {
+    LinearTermPtr ltCopy = Teuchos::rcp( new LinearTerm(*lt) );
+
+    FieldContainer<double> symmetricValues(1,numTestDofs,numTestDofs), generalValues(1,numTestDofs,numTestDofs);
+    lt->integrate(symmetricValues, testOrdering, lt, testOrdering, basisCache);
+    lt->integrate(generalValues, testOrdering, ltCopy, testOrdering, basisCache);
+
+    double tol = 1e-13;
+    for (int i=0; i<numTestDofs; i++)
+    {
+      for (int j=0; j<numTestDofs; j++)
+      {
+        TEST_COMPARE(std::abs(symmetricValues(0,i,j) - generalValues(0,i,j)), <, tol);
+        TEST_COMPARE(std::abs(symmetricValues(0,i,j) - symmetricValues(0,j,i)), <, tol);
+      }
+    }
+  }
+}
 } // namespace
@@ -10,7 +10,10 @@
 #include "BasisCache.h"
 #include "GlobalDofAssignment.h"
 #include "MeshFactory.h"
+#include "MeshPartitionPolicy.h"
+#include "MPIWrapper.h"
 #include "PoissonFormulation.h"
+#include "RefinementStrategy.h"
 #include "StokesVGPFormulation.h"
 
 #include <cstdio>
@@ -204,6 +207,40 @@ MeshPtr makeTestMesh( int spaceDim, bool spaceTime )
     TEST_EQUALITY(numActiveCellsForCentralEdge, numActiveCellsForCentralEdgeExpected);
   }
   
+  TEUCHOS_UNIT_TEST( Mesh, EnforceRegularityIncrementalMatchesFull )
+  {
+    // repeatedly refine toward a corner, enforcing 1-irregularity after each step; the incremental search should
+    // produce exactly the same meshes as the full search
+    int spaceDim = 2;
+    vector<int> elementCounts = {3,3};
+    vector<double> dimensions(spaceDim,1.0);
+    int H1Order = 1, delta_k = 1;
+    bool useConformingTraces = true;
+    PoissonFormulation poissonForm(spaceDim, useConformingTraces);
+    MeshPtr incrementalMesh = MeshFactory::rectilinearMesh(poissonForm.bf(), dimensions, elementCounts, H1Order, delta_k);
+    MeshPtr fullMesh = MeshFactory::rectilinearMesh(poissonForm.bf(), dimensions, elementCounts, H1Order, delta_k);
+    fullMesh->setUseIncrementalRegularityEnforcement(false);
+    
+    FieldContainer<double> cornerPoint(1,spaceDim);
+    cornerPoint(0,0) = 1e-3;
+    cornerPoint(0,1) = 1e-3;
+    
+    int numRefinements = 5;
+    for (int refNumber=0; refNumber<numRefinements; refNumber++)
+    {
+      for (MeshPtr mesh : {incrementalMesh, fullMesh})
+      {
+        bool minusOnesForOffRank = false;
+        GlobalIndexType cornerCellID = mesh->cellIDsForPoints(cornerPoint, minusOnesForOffRank)[0];
+        mesh->hRefine(vector<GlobalIndexType>{cornerCellID}, false);
+        mesh->enforceOneIrregularity(true);
+      }
+      TEST_EQUALITY(incrementalMesh->irregularity(), 1);
+      bool sameActiveCells = (incrementalMesh->getTopology()->getActiveCellIndices() == fullMesh->getTopology()->getActiveCellIndices());
+      TEST_ASSERT(sameActiveCells);
+    }
+  }
+  
   TEUCHOS_UNIT_TEST( Mesh, EnforceRegularityHexadralMeshComplex )
   {
     /*
@@ -432,6 +469,100 @@ void testSaveAndLoad2D(BFPtr bf, Teuchos::FancyOStream &out, bool &success)
   loadedMesh->pRefine(cellsToRefine);
 }
   
+  TEUCHOS_UNIT_TEST( Mesh, RepartitionSkippedUnderImbalanceThreshold )
+  {
+    int spaceDim = 2;
+    bool conformingTraces = true;
+    PoissonFormulation form(spaceDim,conformingTraces);
+    
+    int H1Order = 2;
+    vector<int> elemCounts = {4,4};
+    
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), {1.0,1.0}, elemCounts, H1Order);
+    GlobalDofAssignmentPtr gda = mesh->globalDofAssignment();
+
+    map<GlobalIndexType,PartitionIndexType> parentPartitions;
+    for (GlobalIndexType cellID : mesh->getActiveCellIDs())
+    {
+      parentPartitions[cellID] = gda->partitionForCellID(cellID);
+    }
+    
+    // uniform refinement leaves the load balanced, so a generous threshold means the partition should be kept
+    gda->getPartitionPolicy()->setImbalanceThreshold(1e6);
+    RefinementStrategy::hRefineUniformly(mesh);
+    
+    TEST_ASSERT(gda->lastRepartitionSkipped());
+    TEST_EQUALITY(gda->lastRepartitionMigratedCellCount(), 0);
+    TEST_EQUALITY(gda->lastRepartitionMigratedBytes(), 0);
+    
+    MeshTopologyViewPtr meshTopo = mesh->getTopology();
+    for (GlobalIndexType cellID : mesh->getActiveCellIDs())
+    {
+      GlobalIndexType parentID = meshTopo->getCell(cellID)->getParent()->cellIndex();
+      TEST_EQUALITY(gda->partitionForCellID(cellID), parentPartitions[parentID]);
+    }
+    
+    // with the default threshold, we always repartition
+    gda->getPartitionPolicy()->setImbalanceThreshold(0.0);
+    RefinementStrategy::hRefineUniformly(mesh);
+    TEST_ASSERT(!gda->lastRepartitionSkipped());
+  }
+
+  TEUCHOS_UNIT_TEST( Mesh, InitialPartitionIgnoresImbalanceThreshold )
+  {
+    // run this on several MPI ranks to exercise the distribution: before the first partition, every cell is on rank 0,
+    // which is maximally imbalanced, so even an enormous threshold must not keep that assignment
+    int spaceDim = 2;
+    bool conformingTraces = true;
+    PoissonFormulation form(spaceDim,conformingTraces);
+
+    int H1Order = 2, delta_k = 1;
+    vector<int> elemCounts = {4,4};
+    MeshTopologyPtr meshTopo = MeshFactory::rectilinearMeshTopology({1.0,1.0}, elemCounts);
+    Epetra_CommPtr Comm = MPIWrapper::CommWorld();
+    MeshPartitionPolicyPtr partitionPolicy = MeshPartitionPolicy::standardPartitionPolicy(Comm);
+    partitionPolicy->setImbalanceThreshold(1e6);
+    MeshPtr mesh = Teuchos::rcp( new Mesh(meshTopo, form.bf()->varFactory(), H1Order, delta_k, map<int,int>(), map<int,int>(),
+                                          partitionPolicy, Comm) );
+    mesh->setBilinearForm(form.bf());
+    GlobalDofAssignmentPtr gda = mesh->globalDofAssignment();
+
+    TEST_ASSERT(!gda->lastRepartitionSkipped());
+    int numProcs = Comm->NumProc();
+    int numCells = elemCounts[0] * elemCounts[1];
+    if ((numProcs > 1) && (numProcs <= numCells))
+    {
+      TEST_COMPARE(gda->partitionImbalance(), <, numProcs);
+      int myCellCount = mesh->cellIDsInPartition().size();
+      int minCellCount;
+      Comm->MinAll(&myCellCount, &minCellCount, 1);
+      TEST_COMPARE(minCellCount, >, 0);
+    }
+
+    // once partitioned, the threshold applies: children stay with their parents, and nothing migrates
+    RefinementStrategy::hRefineUniformly(mesh);
+    TEST_ASSERT(gda->lastRepartitionSkipped());
+    TEST_EQUALITY(gda->lastRepartitionMigratedCellCount(), 0);
+    TEST_EQUALITY(gda->lastRepartitionMigratedBytes(), 0);
+
+    // a real repartition; the migration statistics are global sums, so they must agree across ranks
+    partitionPolicy->setImbalanceThreshold(0.0);
+    RefinementStrategy::hRefineUniformly(mesh);
+    TEST_ASSERT(!gda->lastRepartitionSkipped());
+    int migratedCellCount = gda->lastRepartitionMigratedCellCount();
+    int maxMigratedCellCount;
+    Comm->MaxAll(&migratedCellCount, &maxMigratedCellCount, 1);
+    TEST_EQUALITY(migratedCellCount, maxMigratedCellCount);
+    if (migratedCellCount == 0)
+    {
+      TEST_EQUALITY(gda->lastRepartitionMigratedBytes(), 0);
+    }
+    else
+    {
+      TEST_COMPARE(gda->lastRepartitionMigratedBytes(), >, 0);
+    }
+  }
+  
   TEUCHOS_UNIT_TEST( Mesh, ProjectFieldSolution )
   {
     double tol = 1e-15;
@@ -12,6 +12,7 @@
 #include "MeshFactory.h"
 #include "MeshTransferFunction.h"
 #include "PoissonFormulation.h"
+#include "Solution.h"
 
 using namespace Camellia;
 using namespace Intrepid;
@@ -836,4 +837,94 @@ TEUCHOS_UNIT_TEST( MeshTransferFunction, FunctionValuesWithHangingNodes)
     }
   }
 }
+
+// for a function whose value on each originalMesh cell is that cell's ID, checks that the transferred values at the
+// newMesh side points are the IDs of the originalMesh cells that contain those points
+void checkTransferredCellIDValues(MeshTransferFunction &transferFunction, MeshPtr originalMesh, MeshPtr newMesh,
+                                  Teuchos::FancyOStream &out, bool &success)
+{
+  set<GlobalIndexType> myCellIDs = newMesh->cellIDsInPartition();
+  for (GlobalIndexType myCellID : myCellIDs)
+  {
+    CellPtr myCell = newMesh->getTopology()->getCell(myCellID);
+    for (int sideOrdinal=0; sideOrdinal<myCell->getSideCount(); sideOrdinal++)
+    {
+      pair<GlobalIndexType, unsigned> cellSide = make_pair(myCellID, sideOrdinal);
+      pair<GlobalIndexType, unsigned> originalCellSide, newCellSideAncestor;
+      unsigned permutation;
+      if (!transferFunction.findAncestralPairForNewMeshCellSide(cellSide, newCellSideAncestor, originalCellSide, permutation)) continue;
+
+      BasisCachePtr sideBasisCache = BasisCache::basisCacheForCell(newMesh, myCellID)->getSideBasisCache(sideOrdinal);
+      const FieldContainer<double>* physicalPoints = &sideBasisCache->getPhysicalCubaturePoints();
+      int numPoints = physicalPoints->dimension(1);
+      int spaceDim = physicalPoints->dimension(2);
+      int oneCell = 1;
+      FieldContainer<double> actualValues(oneCell,numPoints);
+      transferFunction.values(actualValues, sideBasisCache);
+
+      // the interface is the top of originalMesh; nudge the points into its interior to identify the containing cell
+      FieldContainer<double> originalMeshPoints(numPoints,spaceDim);
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          originalMeshPoints(pointOrdinal,d) = (*physicalPoints)(0,pointOrdinal,d);
+        }
+        originalMeshPoints(pointOrdinal,spaceDim-1) -= 1e-8;
+      }
+      bool minusOnesForOffRank = false;
+      vector<GlobalIndexType> originalCellIDs = originalMesh->cellIDsForPoints(originalMeshPoints, minusOnesForOffRank);
+      for (int pointOrdinal=0; pointOrdinal<numPoints; pointOrdinal++)
+      {
+        TEST_FLOATING_EQUALITY(actualValues(0,pointOrdinal), (double)originalCellIDs[pointOrdinal], 1e-12);
+      }
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST( MeshTransferFunction, FunctionValuesWithOriginalMeshRefinement)
+{
+  // originalMesh finer than newMesh along the interface, so that points in a newMesh side are spread across several
+  // originalMesh sides; the cached point locations must follow refinements of either mesh.  The transferred function is a
+  // solution on originalMesh whose value on each cell is that cell's ID, so that a stale location gives a wrong value.
+  int spaceDim = 2;
+  bool conformingTraces = true;
+  PoissonFormulation formulation(spaceDim, conformingTraces);
+
+  int H1Order = 3, delta_k = spaceDim;
+  double width = 1.0, height = 1.0;
+  int horizontalCells = 2, verticalCells = 1;
+  double x0 = 0, y0 = 0;
+  MeshPtr bottomMesh = MeshFactory::quadMeshMinRule(formulation.bf(), H1Order, delta_k, width, height,
+                                                    horizontalCells, verticalCells, false, x0, y0);
+  double y_interface = y0 + height;
+  MeshPtr topMesh = MeshFactory::quadMeshMinRule(formulation.bf(), H1Order, delta_k, width, height,
+                                                 horizontalCells, verticalCells, false, x0, y_interface);
+
+  bottomMesh->hRefine(set<GlobalIndexType>{0}, RefinementPattern::regularRefinementPatternQuad());
+
+  // phi is an L^2 field, so the projection of the piecewise-constant cell ID function is exact
+  VarPtr phi = formulation.phi();
+  SolutionPtr bottomSolution = Solution::solution(formulation.bf(), bottomMesh);
+  map<int, FunctionPtr> cellIDFunctionMap = {{phi->ID(), Teuchos::rcp( new CellIDFunction )}};
+  bottomSolution->projectOntoMesh(cellIDFunctionMap);
+  FunctionPtr myFunction = Function::solution(phi, bottomSolution);
+  MeshTransferFunction transferFunction(myFunction, bottomMesh, topMesh, y_interface);
+
+  checkTransferredCellIDValues(transferFunction, bottomMesh, topMesh, out, success);
+  checkTransferredCellIDValues(transferFunction, bottomMesh, topMesh, out, success); // uses cached locations
+
+  // refine an originalMesh cell adjacent to the interface: the cached locations that point to it must be dropped
+  FieldContainer<double> interfacePoint(1,spaceDim);
+  interfacePoint(0,0) = 0.1;
+  interfacePoint(0,1) = y_interface - 0.01;
+  GlobalIndexType interfaceCellID = bottomMesh->cellIDsForPoints(interfacePoint, false)[0];
+  bottomMesh->hRefine(set<GlobalIndexType>{interfaceCellID}, RefinementPattern::regularRefinementPatternQuad());
+  bottomSolution->projectOntoMesh(cellIDFunctionMap); // the children get their own IDs, distinct from the parent's
+  checkTransferredCellIDValues(transferFunction, bottomMesh, topMesh, out, success);
+
+  // refine newMesh
+  topMesh->hRefine(set<GlobalIndexType>{1}, RefinementPattern::regularRefinementPatternQuad());
+  checkTransferredCellIDValues(transferFunction, bottomMesh, topMesh, out, success);
+}
 } // namespace
@@ -13,6 +13,8 @@
 #include "CamelliaTestingHelpers.h"
 #include "MeshFactory.h"
 #include "MeshTransformationFunction.h"
+#include "ParametricCurve.h"
+#include "PoissonFormulation.h"
 #include "SpaceTimeHeatFormulation.h"
 
 using namespace Camellia;
@@ -20,6 +22,168 @@ using namespace Intrepid;
 
 namespace
 {
+  BasisCachePtr basisCacheForCells(MeshPtr mesh, const vector<GlobalIndexType> &cellIDs)
+  {
+    BasisCachePtr basisCache = BasisCache::basisCacheForCell(mesh, cellIDs[0]);
+    FieldContainer<double> cellNodes = mesh->physicalCellNodesForCell(cellIDs[0]);
+    int numNodes = cellNodes.dimension(1), spaceDim = cellNodes.dimension(2);
+    FieldContainer<double> physicalCellNodes(cellIDs.size(), numNodes, spaceDim);
+    for (int cellOrdinal=0; cellOrdinal<cellIDs.size(); cellOrdinal++)
+    {
+      cellNodes = mesh->physicalCellNodesForCell(cellIDs[cellOrdinal]);
+      for (int node=0; node<numNodes; node++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          physicalCellNodes(cellOrdinal,node,d) = cellNodes(0,node,d);
+        }
+      }
+    }
+    bool createSideCaches = true;
+    basisCache->setPhysicalCellNodes(physicalCellNodes, cellIDs, createSideCaches);
+    return basisCache;
+  }
+
+  MeshTransformationFunction* meshTransformationFunction(MeshPtr mesh)
+  {
+    return dynamic_cast<MeshTransformationFunction*>(mesh->getTransformationFunction().get());
+  }
+
+  // 2x1 quad mesh on the unit square, with the bottom edge of cell 0, from (0,0) to (0.5,0), replaced by a circular arc that bulges downward
+  MeshPtr curvedQuadMesh(BFPtr bf, int H1Order, int delta_k)
+  {
+    double width = 1.0, height = 1.0;
+    int horizontalElements = 2, verticalElements = 1;
+    MeshPtr mesh = MeshFactory::quadMeshMinRule(bf, H1Order, delta_k, width, height, horizontalElements, verticalElements);
+
+    const double PI  = 3.141592653589793238462;
+    GlobalIndexType curvedCellID = 0;
+    vector<unsigned> vertices = mesh->vertexIndicesForCell(curvedCellID);
+    map< pair<GlobalIndexType,GlobalIndexType>, ParametricCurvePtr > edgeToCurveMap;
+    for (int vertexOrdinal=0; vertexOrdinal<vertices.size(); vertexOrdinal++)
+    {
+      unsigned v0 = vertices[vertexOrdinal], v1 = vertices[(vertexOrdinal+1)%vertices.size()];
+      FieldContainer<double> x0 = mesh->vertexCoordinates(v0), x1 = mesh->vertexCoordinates(v1);
+      if ((x0(1) != 0.0) || (x1(1) != 0.0)) continue;
+      ParametricCurvePtr arc = ParametricCurve::circularArc(0.25 * sqrt(2.0), 0.25, 0.25, 5.0 * PI / 4.0, 7.0 * PI / 4.0);
+      if (x0(0) > x1(0)) arc = ParametricCurve::reverse(arc);
+      edgeToCurveMap[{v0,v1}] = arc;
+    }
+    mesh->setEdgeToCurveMap(edgeToCurveMap);
+    return mesh;
+  }
+
+  // compares geometry from the caching mesh's transformation against an identical mesh whose transformation does not cache
+  void testCachedGeometryMatchesUncached(MeshPtr mesh, MeshPtr uncachedMesh, const vector<GlobalIndexType> &cellIDs,
+                                         Teuchos::FancyOStream &out, bool &success)
+  {
+    TEST_ASSERT(meshTransformationFunction(mesh)->cachesGeometry());
+    TEST_ASSERT(!meshTransformationFunction(uncachedMesh)->cachesGeometry());
+
+    BasisCachePtr uncachedBasisCache = basisCacheForCells(uncachedMesh, cellIDs);
+    int numSides = uncachedBasisCache->cellTopology()->getSideCount();
+
+    double tol = 1e-15;
+    for (int pass=0; pass<2; pass++) // first pass fills the cache (unless it is already warm), second uses it
+    {
+      BasisCachePtr cachedBasisCache = basisCacheForCells(mesh, cellIDs);
+      for (int sideOrdinal=-1; sideOrdinal<numSides; sideOrdinal++)
+      {
+        BasisCachePtr expected = (sideOrdinal == -1) ? uncachedBasisCache : uncachedBasisCache->getSideBasisCache(sideOrdinal);
+        BasisCachePtr actual = (sideOrdinal == -1) ? cachedBasisCache : cachedBasisCache->getSideBasisCache(sideOrdinal);
+        out << "testing pass " << pass << ", side " << sideOrdinal << endl;
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(expected->getPhysicalCubaturePoints(), actual->getPhysicalCubaturePoints(), tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(expected->getJacobian(), actual->getJacobian(), tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(expected->getJacobianDet(), actual->getJacobianDet(), tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(expected->getJacobianInv(), actual->getJacobianInv(), tol);
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( MeshTransformationFunction, CachedGeometryMatchesUncached )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 3, delta_k = 2;
+    MeshPtr mesh = curvedQuadMesh(form.bf(), H1Order, delta_k);
+    MeshPtr uncachedMesh = curvedQuadMesh(form.bf(), H1Order, delta_k);
+    meshTransformationFunction(uncachedMesh)->setCachesGeometry(false);
+
+    MeshTransformationFunction* transform = meshTransformationFunction(mesh);
+    TEST_EQUALITY(transform->curvedCellGeometryCount(), 0);
+
+    // a batch with one curved and one straight cell
+    GlobalIndexType curvedCellID = 0, straightCellID = 1;
+    testCachedGeometryMatchesUncached(mesh, uncachedMesh, {curvedCellID, straightCellID}, out, success);
+    testCachedGeometryMatchesUncached(mesh, uncachedMesh, {curvedCellID}, out, success);
+    int cachedCount = transform->curvedCellGeometryCount();
+    TEST_ASSERT(cachedCount > 0);
+
+    // refining the straight cell leaves the curved cell's geometry cached
+    mesh->hRefine(set<GlobalIndexType>({straightCellID}));
+    uncachedMesh->hRefine(set<GlobalIndexType>({straightCellID}));
+    TEST_EQUALITY(transform->curvedCellGeometryCount(), cachedCount);
+    testCachedGeometryMatchesUncached(mesh, uncachedMesh, {curvedCellID}, out, success);
+    TEST_EQUALITY(transform->curvedCellGeometryCount(), cachedCount);
+
+    // refinements invalidate the cached geometry for the refined cells
+    mesh->hRefine(set<GlobalIndexType>({curvedCellID}));
+    uncachedMesh->hRefine(set<GlobalIndexType>({curvedCellID}));
+    set<GlobalIndexType> activeCellIDs = mesh->getActiveCellIDs();
+    for (GlobalIndexType cellID : activeCellIDs)
+    {
+      testCachedGeometryMatchesUncached(mesh, uncachedMesh, {cellID}, out, success);
+    }
+    mesh->pRefine(activeCellIDs);
+    uncachedMesh->pRefine(activeCellIDs);
+    for (GlobalIndexType cellID : activeCellIDs)
+    {
+      testCachedGeometryMatchesUncached(mesh, uncachedMesh, {cellID}, out, success);
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( MeshTransformationFunction, CachedGeometryKeepsEachCubaturePhase )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 3, delta_k = 2;
+    MeshPtr mesh = curvedQuadMesh(form.bf(), H1Order, delta_k);
+    MeshPtr uncachedMesh = curvedQuadMesh(form.bf(), H1Order, delta_k);
+    meshTransformationFunction(uncachedMesh)->setCachesGeometry(false);
+    MeshTransformationFunction* transform = meshTransformationFunction(mesh);
+
+    GlobalIndexType curvedCellID = 0;
+    BasisCachePtr basisCache = BasisCache::basisCacheForCell(mesh, curvedCellID);
+    BasisCachePtr uncachedBasisCache = BasisCache::basisCacheForCell(uncachedMesh, curvedCellID);
+    int numPoints = basisCache->getRefCellPoints().dimension(0);
+    // phases of equal size: the point sets differ, but their counts and dimensions agree
+    int maxPointsPerPhase = (numPoints + 1) / 2;
+    basisCache->setMaxPointsPerCubaturePhase(maxPointsPerPhase);
+    uncachedBasisCache->setMaxPointsPerCubaturePhase(maxPointsPerPhase);
+    int phaseCount = basisCache->getCubaturePhaseCount();
+    TEST_ASSERT(phaseCount > 1);
+
+    double tol = 1e-15;
+    int countAfterFirstPass = -1;
+    for (int pass=0; pass<2; pass++)
+    {
+      for (int phase=0; phase<phaseCount; phase++)
+      {
+        basisCache->setCubaturePhase(phase);
+        uncachedBasisCache->setCubaturePhase(phase);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(uncachedBasisCache->getPhysicalCubaturePoints(), basisCache->getPhysicalCubaturePoints(), tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(uncachedBasisCache->getJacobian(), basisCache->getJacobian(), tol);
+        TEST_COMPARE_FLOATING_ARRAYS_CAMELLIA(uncachedBasisCache->getJacobianDet(), basisCache->getJacobianDet(), tol);
+      }
+      if (pass == 0) countAfterFirstPass = transform->curvedCellGeometryCount();
+    }
+    // one entry per phase, and the second pass found each of them rather than replacing one with another
+    TEST_EQUALITY(countAfterFirstPass, phaseCount);
+    TEST_EQUALITY(transform->curvedCellGeometryCount(), phaseCount);
+  }
+
   void testTimeCoordinatesOfCell(double t0, double t1, MeshPtr spaceTimeMesh, IndexType cellIndex, Teuchos::FancyOStream &out, bool &success)
   {
     FieldContainer<double> physicalCellNodes = spaceTimeMesh->physicalCellNodesForCell(cellIndex);
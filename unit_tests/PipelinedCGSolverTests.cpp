@@ -0,0 +1,136 @@
+//
+//  PipelinedCGSolverTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "CellBlockSmoother.h"
+#include "PipelinedCGSolver.h"
+#include "Solution.h"
+#include "TestingUtilities.h"
+
+using namespace Camellia;
+
+namespace
+{
+  TEUCHOS_UNIT_TEST( PipelinedCGSolver, MatchesDirectSolve )
+  {
+    int spaceDim = 2, cellCount = 3, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Teuchos::RCP<Epetra_CrsMatrix> A = solution->getStiffnessMatrix();
+    Teuchos::RCP<Epetra_MultiVector> b = solution->getRHSVector();
+
+    Teuchos::RCP<Epetra_MultiVector> xDirect = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+    SolverPtr directSolver = Solver::getDirectSolver();
+    directSolver->setProblem(A, xDirect, b);
+    directSolver->solve();
+    double xDirectNorm;
+    xDirect->NormInf(&xDirectNorm);
+
+    Teuchos::RCP<CellBlockSmoother> blockJacobi = Teuchos::rcp( new CellBlockSmoother(A.get(), solution->mesh(), solution->getDofInterpreter()) );
+    blockJacobi->Compute();
+
+    int maxIters = 5000;
+    double tol = 1e-10;
+    vector<int> residualReplacementIntervals = {0, 5};
+    for (int interval : residualReplacementIntervals)
+    {
+      for (bool usePreconditioner : {false, true})
+      {
+        PipelinedCGSolver solver(maxIters, tol);
+        if (usePreconditioner) solver.setPreconditioner(blockJacobi);
+        solver.setResidualReplacementInterval(interval);
+
+        Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+        solver.setProblem(A, x, b);
+        int result = solver.solve();
+        TEST_EQUALITY(result, 0);
+        out << "interval " << interval << ", preconditioned = " << usePreconditioner << ": " << solver.iterationCount() << " iterations, ";
+        out << solver.residualReplacementCount() << " residual replacements" << endl;
+        if (interval == 0) TEST_EQUALITY(solver.residualReplacementCount(), 0);
+
+        x->Update(-1.0, *xDirect, 1.0);
+        double diffNorm;
+        x->NormInf(&diffNorm);
+        TEST_COMPARE(diffNorm, <, 1e-6 * xDirectNorm);
+      }
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( PipelinedCGSolver, ZeroRHSGivesZeroSolution )
+  {
+    int spaceDim = 2, cellCount = 2, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Teuchos::RCP<Epetra_CrsMatrix> A = solution->getStiffnessMatrix();
+
+    Teuchos::RCP<Epetra_MultiVector> b = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+    Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+    x->PutScalar(1.0);
+
+    PipelinedCGSolver solver(100, 1e-10);
+    solver.setProblem(A, x, b);
+    TEST_EQUALITY(solver.solve(), 0);
+    TEST_EQUALITY(solver.iterationCount(), 0);
+    double xNorm;
+    x->NormInf(&xNorm);
+    TEST_EQUALITY(xNorm, 0.0);
+  }
+
+  TEUCHOS_UNIT_TEST( PipelinedCGSolver, ResidualScaling )
+  {
+    int spaceDim = 2, cellCount = 3, H1Order = 2;
+    SolutionPtr solution = TestingUtilities::poissonSolutionWithStiffness(spaceDim, cellCount, H1Order);
+    Teuchos::RCP<Epetra_CrsMatrix> A = solution->getStiffnessMatrix();
+    Teuchos::RCP<Epetra_MultiVector> b = solution->getRHSVector();
+
+    Teuchos::RCP<Epetra_MultiVector> xDirect = Teuchos::rcp( new Epetra_MultiVector(A->RowMap(), 1) );
+    SolverPtr directSolver = Solver::getDirectSolver();
+    directSolver->setProblem(A, xDirect, b);
+    directSolver->solve();
+
+    // an initial guess close to the solution, so that ||r_0|| is far smaller than ||b||
+    Epetra_MultiVector perturbation(A->RowMap(), 1);
+    perturbation.Random();
+    double xDirectNorm, perturbationNorm;
+    xDirect->NormInf(&xDirectNorm);
+    perturbation.NormInf(&perturbationNorm);
+    perturbation.Scale(1e-6 * xDirectNorm / perturbationNorm);
+
+    Epetra_MultiVector r0(A->RowMap(), 1);
+    double bNorm, r0Norm;
+    b->Norm2(&bNorm);
+    A->Apply(perturbation, r0); // b - A (xDirect + perturbation) = - A perturbation
+    r0.Norm2(&r0Norm);
+
+    int maxIters = 5000;
+    double tol = 1e-4;
+    TEST_COMPARE(r0Norm, <, tol * bNorm); // so that the scalings differ in whether any iterations are needed
+
+    for (PipelinedCGSolver::ResidualScaling scaling : {PipelinedCGSolver::RHS_NORM, PipelinedCGSolver::INITIAL_RESIDUAL_NORM})
+    {
+      PipelinedCGSolver solver(maxIters, tol);
+      solver.setResidualScaling(scaling);
+      Teuchos::RCP<Epetra_MultiVector> x = Teuchos::rcp( new Epetra_MultiVector(*xDirect) );
+      x->Update(1.0, perturbation, 1.0);
+      solver.setProblem(A, x, b);
+      TEST_EQUALITY(solver.solve(), 0);
+
+      Epetra_MultiVector residual(*b);
+      Epetra_MultiVector Ax(A->RowMap(), 1);
+      A->Apply(*x, Ax);
+      residual.Update(-1.0, Ax, 1.0);
+      double residualNorm;
+      residual.Norm2(&residualNorm);
+      if (scaling == PipelinedCGSolver::RHS_NORM)
+      {
+        TEST_EQUALITY(solver.iterationCount(), 0); // the initial guess already meets tol * ||b||
+      }
+      else
+      {
+        TEST_COMPARE(solver.iterationCount(), >, 0);
+        TEST_COMPARE(residualNorm, <, 10.0 * tol * r0Norm); // allow for drift of the recursively updated residual
+      }
+    }
+  }
+} // namespace
@@ -95,6 +95,42 @@ void testProjectFunctionOnTensorTopoSides(CellTopoPtr spaceTopo, int H1Order, Ca
   }
 }
 
+TEUCHOS_UNIT_TEST( Projector, InterpolatingProjectionReusedForSeveralFunctions )
+{
+  // two unit squares side by side; a factored projection onto the Q3 basis should reproduce each function in its span
+  CellTopoPtr quadTopo = CellTopology::quad();
+  int numCells = 2, numNodes = 4, spaceDim = 2;
+  FieldContainer<double> physicalCellNodes(numCells,numNodes,spaceDim);
+  double refNodes[4][2] = {{0,0},{1,0},{1,1},{0,1}};
+  for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+  {
+    for (int node=0; node<numNodes; node++)
+    {
+      physicalCellNodes(cellOrdinal,node,0) = refNodes[node][0] + cellOrdinal;
+      physicalCellNodes(cellOrdinal,node,1) = refNodes[node][1];
+    }
+  }
+  int H1Order = 4, cubatureDegree = 8;
+  BasisPtr basis = BasisFactory::basisFactory()->getBasis(H1Order, quadTopo, Camellia::FUNCTION_SPACE_HGRAD);
+  BasisCachePtr projectionCache = Teuchos::rcp( new BasisCache(physicalCellNodes, quadTopo, cubatureDegree) );
+  BasisCachePtr integrationCache = Teuchos::rcp( new BasisCache(physicalCellNodes, quadTopo, cubatureDegree) );
+
+  Projector<double>::InterpolatingProjection projection(basis, projectionCache);
+
+  FunctionPtr x = Function::xn(1), y = Function::yn(1);
+  vector<FunctionPtr> functions = {x * x * y, x + y * y * y, Function::constant(2.0)};
+  double tol = 1e-12;
+  for (FunctionPtr f : functions)
+  {
+    FieldContainer<double> basisCoefficients(numCells,basis->getCardinality());
+    projection.apply(basisCoefficients, f, projectionCache);
+    FunctionPtr projectedFunction = BasisSumFunction::basisSumFunction(basis, basisCoefficients);
+    FunctionPtr diff = projectedFunction - f;
+    double errSquared = (diff * diff)->integrate(integrationCache);
+    TEST_ASSERT(errSquared < tol);
+  }
+}
+
 TEUCHOS_UNIT_TEST( Projector, TensorTopologyFlux1D )
 {
   // project a function that involves normal values
@@ -17,8 +17,10 @@
 #include "GlobalDofAssignment.h"
 #include "HDF5Exporter.h"
 #include "MeshFactory.h"
+#include "MeshPartitionPolicy.h"
 #include "MeshTools.h"
 #include "MeshUtilities.h"
+#include "MPIWrapper.h"
 #include "PoissonFormulation.h"
 #include "Projector.h"
 #include "RHS.h"
@@ -255,6 +257,58 @@ namespace
     }
   }
   
+  void testEliminateBCsDuringAssembly(bool useCondensedSolve, bool useTriangles, Teuchos::FancyOStream &out, bool &success)
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int meshWidth = useTriangles ? 4 : 2, H1Order = 3, delta_k = 2;
+    MeshPtr mesh;
+    if (useTriangles)
+    {
+      // with more than one MPI rank, some triangles touch the boundary only at a vertex whose boundary sides are on other ranks
+      bool divideIntoTriangles = true;
+      mesh = MeshFactory::quadMeshMinRule(form.bf(), H1Order, delta_k, 1.0, 1.0, meshWidth, meshWidth, divideIntoTriangles);
+    }
+    else
+    {
+      vector<double> dimensions(spaceDim,1.0);
+      vector<int> elementCounts(spaceDim,meshWidth);
+      mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+    }
+    mesh->hRefine(vector<GlobalIndexType>{0}); // hanging nodes: constrained dofs on the boundary
+
+    // nonzero BC values, so that the lift matters
+    FunctionPtr x = Function::xn(1), y = Function::yn(1);
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), x * x - y);
+    RHSPtr rhs = RHS::rhs();
+    rhs->addTerm(Function::constant(1.0) * form.q());
+    IPPtr ip = form.bf()->graphNorm();
+
+    SolutionPtr expectedSolution = Solution::solution(form.bf(), mesh, bc, rhs, ip);
+    SolutionPtr actualSolution = Solution::solution(form.bf(), mesh, bc, rhs, ip);
+    actualSolution->setEliminateBCsDuringAssembly(true);
+    TEST_ASSERT(actualSolution->eliminatesBCsDuringAssembly());
+    if (useCondensedSolve)
+    {
+      expectedSolution->setUseCondensedSolve(true);
+      actualSolution->setUseCondensedSolve(true);
+    }
+    expectedSolution->solve();
+    actualSolution->solve();
+
+    double tol = 1e-10;
+    vector<VarPtr> vars = {form.phi(), form.psi()};
+    for (VarPtr var : vars)
+    {
+      FunctionPtr expected = Function::solution(var, expectedSolution);
+      FunctionPtr diff = Function::solution(var, actualSolution) - expected;
+      double diffNorm = diff->l2norm(mesh);
+      TEST_COMPARE(diffNorm, <, tol * max(1.0, expected->l2norm(mesh)));
+    }
+  }
+
   TEUCHOS_UNIT_TEST( Solution, AddSolution )
   {
     bool useConformingTraces = true;
@@ -987,6 +1041,28 @@ namespace
     testCondensedSolveZeroMeanConstraint(minRule, out, success);
   }
   
+  TEUCHOS_UNIT_TEST( Solution, EliminateBCsDuringAssembly )
+  {
+    bool useCondensedSolve = false;
+    bool useTriangles = false;
+    testEliminateBCsDuringAssembly(useCondensedSolve, useTriangles, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( Solution, EliminateBCsDuringAssemblyCondensed )
+  {
+    bool useCondensedSolve = true;
+    bool useTriangles = false;
+    testEliminateBCsDuringAssembly(useCondensedSolve, useTriangles, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( Solution, EliminateBCsDuringAssemblyTriangles )
+  {
+    // run with several MPI ranks to exercise BC dofs seen by cells without boundary sides on the rank
+    bool useCondensedSolve = false;
+    bool useTriangles = true;
+    testEliminateBCsDuringAssembly(useCondensedSolve, useTriangles, out, success);
+  }
+
   TEUCHOS_UNIT_TEST( Solution, ImportOffRankCellData_1D )
   {
     int spaceDim = 1;
@@ -1011,7 +1087,61 @@ namespace
     
     testImportOffRankCellSolution(spaceDim, meshWidth, out, success);
   }
-  
+
+  TEUCHOS_UNIT_TEST( Solution, MultipleLoadsMatchSeparateSolves )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int meshWidth = 2, H1Order = 2, delta_k = 2;
+    vector<double> dimensions(spaceDim,1.0);
+    vector<int> elementCounts(spaceDim,meshWidth);
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+
+    FunctionPtr x = Function::xn(1), y = Function::yn(1);
+    vector<FunctionPtr> forcingFunctions = {Function::constant(1.0), x, x * y * y};
+    vector<RHSPtr> rhsList;
+    for (FunctionPtr f : forcingFunctions)
+    {
+      RHSPtr rhs = RHS::rhs();
+      rhs->addTerm(f * form.q());
+      rhsList.push_back(rhs);
+    }
+
+    vector<BF::OptimalTestSolver> testSolvers = {BF::CHOLESKY, BF::FACTORED_CHOLESKY};
+    for (BF::OptimalTestSolver testSolver : testSolvers)
+    {
+      form.bf()->setOptimalTestSolver(testSolver);
+
+      SolutionPtr solution = Solution::solution(form.bf(), mesh, bc, rhsList[0], form.bf()->graphNorm());
+      vector<SolutionPtr> solutions;
+      int result = solution->solve(Solver::getDirectSolver(), rhsList, solutions);
+      TEST_EQUALITY(result, 0);
+      TEST_EQUALITY(solutions.size(), rhsList.size());
+
+      double tol = 1e-12;
+      for (int loadOrdinal=0; loadOrdinal<rhsList.size(); loadOrdinal++)
+      {
+        SolutionPtr separateSolution = Solution::solution(form.bf(), mesh, bc, rhsList[loadOrdinal], form.bf()->graphNorm());
+        separateSolution->solve();
+
+        for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+        {
+          FieldContainer<double> expectedCoefficients = separateSolution->allCoefficientsForCellID(cellID);
+          FieldContainer<double> actualCoefficients = solutions[loadOrdinal]->allCoefficientsForCellID(cellID);
+          for (int dofOrdinal=0; dofOrdinal<expectedCoefficients.size(); dofOrdinal++)
+          {
+            double diff = actualCoefficients[dofOrdinal] - expectedCoefficients[dofOrdinal];
+            TEST_COMPARE(abs(diff),<,tol);
+          }
+        }
+      }
+    }
+  }
+
   void testProjectTraceOnTensorMesh(CellTopoPtr spaceTopo, int H1Order, FunctionPtr f, VarType traceOrFlux,
                                     Teuchos::FancyOStream &out, bool &success)
   {
@@ -1545,6 +1675,77 @@ namespace
     loadedMesh->pRefine(cellsToRefine);
   }
   
+  TEUCHOS_UNIT_TEST( Solution, SaveAndLoadCheckpoint )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int meshWidth = 2, H1Order = 2, delta_k = 2;
+    vector<double> dimensions(spaceDim,1.0);
+    vector<int> elementCounts(spaceDim,meshWidth);
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), dimensions, elementCounts, H1Order, delta_k);
+
+    // refine twice toward the origin, and p-refine a couple of cells, so that the checkpoint includes hanging nodes
+    // and nonuniform H1 orders
+    FieldContainer<double> originPoint(1,spaceDim);
+    originPoint.initialize(1e-3);
+    for (int refNumber=0; refNumber<2; refNumber++)
+    {
+      bool minusOnesForOffRank = false;
+      GlobalIndexType cellID = mesh->cellIDsForPoints(originPoint, minusOnesForOffRank)[0];
+      mesh->hRefine(vector<GlobalIndexType>{cellID});
+      mesh->enforceOneIrregularity();
+    }
+    mesh->pRefine(vector<GlobalIndexType>{*mesh->getActiveCellIDs().rbegin()});
+    mesh->pRefine(vector<GlobalIndexType>{*mesh->getActiveCellIDs().rbegin()}, 2);
+
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+    RHSPtr rhs = RHS::rhs();
+    rhs->addTerm(Function::xn(1) * form.q());
+    IPPtr ip = form.bf()->graphNorm();
+    SolutionPtr solution = Solution::solution(form.bf(), mesh, bc, rhs, ip);
+    solution->solve();
+
+    string filePrefix = "SolutionCheckpoint";
+    solution->saveCheckpoint(filePrefix);
+    SolutionPtr loadedSolution = Solution::loadFromCheckpoint(form.bf(), filePrefix);
+    MeshPtr loadedMesh = loadedSolution->mesh();
+
+    TEST_ASSERT(loadedMesh->getActiveCellIDs() == mesh->getActiveCellIDs());
+    TEST_EQUALITY(loadedMesh->getTopology()->cellCount(), mesh->getTopology()->cellCount());
+    TEST_EQUALITY(loadedMesh->globalDofCount(), mesh->globalDofCount());
+    TEST_ASSERT(loadedMesh->cellIDsInPartition() == mesh->cellIDsInPartition());
+
+    double tol = 1e-12;
+    for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+    {
+      TEST_ASSERT(loadedMesh->getElementType(cellID)->trialOrderPtr->totalDofs() == mesh->getElementType(cellID)->trialOrderPtr->totalDofs());
+      FieldContainer<double> expectedCoefficients = solution->allCoefficientsForCellID(cellID);
+      FieldContainer<double> actualCoefficients = loadedSolution->allCoefficientsForCellID(cellID);
+      TEST_EQUALITY(actualCoefficients.size(), expectedCoefficients.size());
+      if (actualCoefficients.size() != expectedCoefficients.size()) continue;
+      for (int dofOrdinal=0; dofOrdinal<expectedCoefficients.size(); dofOrdinal++)
+      {
+        TEST_FLOATING_EQUALITY(actualCoefficients[dofOrdinal], expectedCoefficients[dofOrdinal], tol);
+      }
+    }
+
+    // solving on the loaded mesh should reproduce the original solution, confirming that the dof maps agree
+    loadedSolution->setBC(bc);
+    loadedSolution->setRHS(rhs);
+    loadedSolution->setIP(ip);
+    loadedSolution->solve();
+    FunctionPtr phiDiff = Function::solution(form.phi(), loadedSolution) - Function::solution(form.phi(), solution);
+    TEST_COMPARE(phiDiff->l2norm(mesh), <, tol);
+
+    int rank = mesh->Comm()->MyPID();
+    if (rank == 0) remove((filePrefix+".mesh.ckpt").c_str());
+    ostringstream solutionFileName;
+    solutionFileName << filePrefix << ".soln.ckpt." << rank;
+    remove(solutionFileName.str().c_str());
+  }
+
   TEUCHOS_UNIT_TEST( Solution, SaveAndLoadPoissonConforming )
   {
     int spaceDim = 2;
@@ -1561,4 +1762,264 @@ namespace
     StokesVGPFormulation form = StokesVGPFormulation::steadyFormulation(spaceDim,mu,conformingTraces);
     testSaveAndLoad2D(form.bf(), out, success);
   }
+  
+  void testSolutionValuesMatchPerCellSums(SolutionPtr soln, BasisCachePtr basisCache, VarPtr var, Teuchos::FancyOStream &out, bool &success)
+  {
+    MeshPtr mesh = soln->mesh();
+    const vector<GlobalIndexType>* cellIDs = &basisCache->cellIDs();
+    int numCells = cellIDs->size();
+    int sideOrdinal = basisCache->getSideIndex();
+    bool fluxOrTrace = (var->varType() == FLUX) || (var->varType() == TRACE);
+    bool weightForCubature = false;
+    
+    Teuchos::Array<int> dim;
+    basisCache->getPhysicalCubaturePoints().dimensions(dim); // (C,P,D)
+    if (var->rank() == 0) dim.resize(2); // (C,P)
+    FieldContainer<double> values(dim);
+    soln->solutionValues(values, var->ID(), basisCache, weightForCubature, OP_VALUE);
+    
+    FieldContainer<double> expectedValues(dim);
+    int valuesPerCell = values.size() / numCells;
+    for (int cellOrdinal=0; cellOrdinal<numCells; cellOrdinal++)
+    {
+      GlobalIndexType cellID = (*cellIDs)[cellOrdinal];
+      DofOrderingPtr trialOrder = mesh->getElementType(cellID)->trialOrderPtr;
+      int coefficientSideOrdinal = fluxOrTrace ? sideOrdinal : -1;
+      BasisPtr basis = trialOrder->getBasis(var->ID(), coefficientSideOrdinal);
+      Teuchos::RCP<const FieldContainer<double> > transformedValues;
+      if (fluxOrTrace || (sideOrdinal == -1))
+        transformedValues = basisCache->getTransformedValues(basis, OP_VALUE);
+      else
+        transformedValues = basisCache->getVolumeBasisCache()->getTransformedValues(basis, OP_VALUE, sideOrdinal, true);
+      FieldContainer<double> basisCoefficients;
+      soln->solnCoeffsForCellID(basisCoefficients, cellID, var->ID(), coefficientSideOrdinal);
+      for (int basisOrdinal=0; basisOrdinal<basis->getCardinality(); basisOrdinal++)
+      {
+        for (int i=0; i<valuesPerCell; i++)
+        {
+          int fieldOffset = (cellOrdinal * basis->getCardinality() + basisOrdinal) * valuesPerCell;
+          expectedValues[cellOrdinal * valuesPerCell + i] += (*transformedValues)[fieldOffset + i] * basisCoefficients(basisOrdinal);
+        }
+      }
+    }
+    
+    double tol = 1e-12;
+    for (int i=0; i<values.size(); i++)
+    {
+      double diff = abs(values[i] - expectedValues[i]);
+      TEST_COMPARE(diff, <, tol);
+    }
+  }
+  
+  TEUCHOS_UNIT_TEST( Solution, SolutionValuesForCellBatchesMatchPerCellSums )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    
+    // a p-refinement gives us more than one element type
+    int H1Order = 2;
+    MeshPtr mesh = poissonUniformMesh(spaceDim, 2, H1Order, useConformingTraces);
+    mesh->pRefine(vector<GlobalIndexType>{0});
+    SolutionPtr soln = Solution::solution(mesh);
+    
+    // arbitrary, distinct, coefficients on each cell
+    for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+    {
+      FieldContainer<double> cellDofs(mesh->getElementType(cellID)->trialOrderPtr->totalDofs());
+      for (int dofOrdinal=0; dofOrdinal<cellDofs.size(); dofOrdinal++)
+      {
+        cellDofs[dofOrdinal] = 1.0 + cellID + 0.25 * dofOrdinal;
+      }
+      soln->setLocalCoefficientsForCell(cellID, cellDofs);
+    }
+    
+    vector<BasisCachePtr> basisCaches;
+    for (ElementTypePtr elemType : mesh->elementTypes())
+    {
+      basisCaches.push_back(BasisCache::basisCacheForCellType(mesh, elemType));
+    }
+    
+    // one batch with every active cell, so that it mixes element types and, with more than one rank, includes off-rank cells
+    vector<GlobalIndexType> allCellIDs;
+    for (GlobalIndexType cellID : mesh->getActiveCellIDs())
+    {
+      allCellIDs.push_back(cellID);
+    }
+    BasisCachePtr mixedBasisCache = BasisCache::basisCacheForCell(mesh, 0); // cell 0 has the highest order, so cubature suffices for all
+    FieldContainer<double> cellNodes = mesh->physicalCellNodesForCell(0);
+    int numNodes = cellNodes.dimension(1);
+    FieldContainer<double> allCellNodes(allCellIDs.size(), numNodes, spaceDim);
+    for (int cellOrdinal=0; cellOrdinal<allCellIDs.size(); cellOrdinal++)
+    {
+      cellNodes = mesh->physicalCellNodesForCell(allCellIDs[cellOrdinal]);
+      for (int node=0; node<numNodes; node++)
+      {
+        for (int d=0; d<spaceDim; d++)
+        {
+          allCellNodes(cellOrdinal,node,d) = cellNodes(0,node,d);
+        }
+      }
+    }
+    bool createSideCaches = true;
+    mixedBasisCache->setPhysicalCellNodes(allCellNodes, allCellIDs, createSideCaches);
+    basisCaches.push_back(mixedBasisCache);
+    soln->importSolutionForOffRankCells(basisCaches);
+    
+    // after the import, every cell in the batches, on- or off-rank, should have the coefficients its owner set
+    for (GlobalIndexType cellID : allCellIDs)
+    {
+      bool warnAboutOffRankImports = false;
+      const FieldContainer<double>* cellDofs = &soln->allCoefficientsForCellID(cellID, warnAboutOffRankImports);
+      TEST_EQUALITY(cellDofs->size(), mesh->getElementType(cellID)->trialOrderPtr->totalDofs());
+      for (int dofOrdinal=0; dofOrdinal<cellDofs->size(); dofOrdinal++)
+      {
+        TEST_EQUALITY((*cellDofs)[dofOrdinal], 1.0 + cellID + 0.25 * dofOrdinal);
+      }
+    }
+    
+    int sideOrdinal = 0;
+    for (BasisCachePtr basisCache : basisCaches)
+    {
+      testSolutionValuesMatchPerCellSums(soln, basisCache, form.phi(), out, success);
+      testSolutionValuesMatchPerCellSums(soln, basisCache, form.psi(), out, success);
+      BasisCachePtr sideCache = basisCache->getSideBasisCache(sideOrdinal);
+      testSolutionValuesMatchPerCellSums(soln, sideCache, form.phi(), out, success);
+      testSolutionValuesMatchPerCellSums(soln, sideCache, form.phi_hat(), out, success);
+    }
+    
+    // gathered coefficients should match those for individual cells; the mixed batch has no single element type
+    for (BasisCachePtr basisCache : basisCaches)
+    {
+      vector<GlobalIndexType> cellIDs = basisCache->cellIDs();
+      FieldContainer<double> coefficients;
+      ElementTypePtr elemType = soln->gatherCoefficients(coefficients, cellIDs, form.phi()->ID());
+      if (basisCache == mixedBasisCache)
+      {
+        TEST_ASSERT(elemType == Teuchos::null);
+        continue;
+      }
+      TEST_ASSERT(elemType != Teuchos::null);
+      if (elemType == Teuchos::null) continue;
+      for (int cellOrdinal=0; cellOrdinal<cellIDs.size(); cellOrdinal++)
+      {
+        FieldContainer<double> basisCoefficients;
+        soln->solnCoeffsForCellID(basisCoefficients, cellIDs[cellOrdinal], form.phi()->ID());
+        for (int basisOrdinal=0; basisOrdinal<basisCoefficients.size(); basisOrdinal++)
+        {
+          TEST_EQUALITY(coefficients(cellOrdinal,basisOrdinal), basisCoefficients(basisOrdinal));
+        }
+      }
+    }
+  }
+
+  void testSolveOnSubcommunicatorMatchesWorldSolve(bool useCondensedSolve, Teuchos::FancyOStream &out, bool &success)
+  {
+    // each rank solves the whole problem on its own (serial) communicator; this should match the solve over MPI_COMM_WORLD
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 2, delta_k = 1;
+    vector<double> dimensions(spaceDim,1.0);
+    vector<int> elementCounts(spaceDim,3);
+
+    RHSPtr rhs = RHS::rhs();
+    rhs->addTerm(1.0 * form.q());
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+
+    vector<Epetra_CommPtr> comms = {MPIWrapper::CommWorld(), MPIWrapper::CommSerial()};
+    vector<SolutionPtr> solutions;
+    for (Epetra_CommPtr Comm : comms)
+    {
+      MeshTopologyPtr meshTopo = MeshFactory::rectilinearMeshTopology(dimensions, elementCounts);
+      MeshPartitionPolicyPtr partitionPolicy = MeshPartitionPolicy::spaceFillingCurvePartitionPolicy(Comm);
+      MeshPtr mesh = Teuchos::rcp( new Mesh(meshTopo, form.bf()->varFactory(), H1Order, delta_k, map<int,int>(), map<int,int>(),
+                                            partitionPolicy, Comm) );
+      mesh->setBilinearForm(form.bf());
+      TEST_EQUALITY(mesh->Comm()->NumProc(), Comm->NumProc());
+
+      SolutionPtr soln = Solution::solution(form.bf(), mesh, bc, rhs, form.bf()->graphNorm());
+      soln->setUseCondensedSolve(useCondensedSolve);
+      TEST_EQUALITY(soln->solve(), 0);
+      solutions.push_back(soln);
+    }
+
+    SolutionPtr worldSoln = solutions[0];
+    SolutionPtr serialSoln = solutions[1];
+    // the serial solution has coefficients for every cell, so we can compare on the world mesh's rank-local cells
+    FunctionPtr phiWorld = Function::solution(form.phi(), worldSoln);
+    FunctionPtr phiSerial = Function::solution(form.phi(), serialSoln);
+    double diff_l2 = (phiWorld - phiSerial)->l2norm(worldSoln->mesh());
+    double phi_l2 = phiWorld->l2norm(worldSoln->mesh());
+    double tol = 1e-12;
+    TEST_COMPARE(phi_l2, >, 0.0);
+    TEST_COMPARE(diff_l2, <, tol * phi_l2);
+  }
+
+  TEUCHOS_UNIT_TEST( Solution, SolveOnSubcommunicatorMatchesWorldSolve )
+  {
+    bool useCondensedSolve = false;
+    testSolveOnSubcommunicatorMatchesWorldSolve(useCondensedSolve, out, success);
+  }
+
+  TEUCHOS_UNIT_TEST( Solution, SolveOnSubcommunicatorMatchesWorldSolveCondensed )
+  {
+    bool useCondensedSolve = true;
+    testSolveOnSubcommunicatorMatchesWorldSolve(useCondensedSolve, out, success);
+  }
+  
+  TEUCHOS_UNIT_TEST( Solution, AssemblyImportsBackgroundSolutionForRankLocalCells )
+  {
+    int spaceDim = 2;
+    bool useConformingTraces = true;
+    PoissonFormulation form(spaceDim, useConformingTraces);
+    int H1Order = 2;
+    MeshPtr mesh = poissonUniformMesh(spaceDim, 3, H1Order, useConformingTraces);
+    
+    // the background solution lives on a copy of the mesh with the partitions in reverse rank order, so that (with more than
+    // one rank) the cells we assemble are mostly off-rank for the background solution
+    MeshPtr backgroundMesh = mesh->deepCopy();
+    backgroundMesh->setBilinearForm(form.bf());
+    int numProcs = mesh->Comm()->NumProc();
+    vector<set<GlobalIndexType>> reversedPartitions(numProcs);
+    for (int rank=0; rank<numProcs; rank++)
+    {
+      reversedPartitions[numProcs-1-rank] = mesh->globalDofAssignment()->cellsInPartition(rank);
+    }
+    backgroundMesh->globalDofAssignment()->setPartitions(reversedPartitions);
+    
+    SolutionPtr backgroundSoln = Solution::solution(backgroundMesh);
+    for (GlobalIndexType cellID : backgroundMesh->cellIDsInPartition())
+    {
+      FieldContainer<double> cellDofs(backgroundMesh->getElementType(cellID)->trialOrderPtr->totalDofs());
+      for (int dofOrdinal=0; dofOrdinal<cellDofs.size(); dofOrdinal++)
+      {
+        cellDofs[dofOrdinal] = 1.0 + cellID + 0.25 * dofOrdinal;
+      }
+      backgroundSoln->setLocalCoefficientsForCell(cellID, cellDofs);
+    }
+    
+    // a right-hand side that depends on the background solution, as for a Newton step
+    BCPtr bc = BC::bc();
+    bc->addDirichlet(form.phi_hat(), SpatialFilter::allSpace(), Function::zero());
+    RHSPtr rhs = RHS::rhs();
+    rhs->addTerm(Function::solution(form.phi(), backgroundSoln) * form.q());
+    SolutionPtr soln = Solution::solution(mesh, bc, rhs, form.bf()->graphNorm());
+    soln->initializeLHSVector();
+    soln->initializeStiffnessAndLoad();
+    soln->populateStiffnessAndLoad();
+    
+    // assembly should have imported the background coefficients for each of our cells
+    for (GlobalIndexType cellID : mesh->cellIDsInPartition())
+    {
+      bool warnAboutOffRankImports = false;
+      const FieldContainer<double>* cellDofs = &backgroundSoln->allCoefficientsForCellID(cellID, warnAboutOffRankImports);
+      TEST_EQUALITY(cellDofs->size(), backgroundMesh->getElementType(cellID)->trialOrderPtr->totalDofs());
+      for (int dofOrdinal=0; dofOrdinal<cellDofs->size(); dofOrdinal++)
+      {
+        TEST_EQUALITY((*cellDofs)[dofOrdinal], 1.0 + cellID + 0.25 * dofOrdinal);
+      }
+    }
+  }
 } // namespace
@@ -0,0 +1,99 @@
+//
+//  SpaceFillingCurvePartitionPolicyTests.cpp
+//  Camellia
+//
+
+#include "Teuchos_UnitTestHarness.hpp"
+
+#include "GlobalDofAssignment.h"
+#include "MeshFactory.h"
+#include "MPIWrapper.h"
+#include "PoissonFormulation.h"
+#include "RefinementStrategy.h"
+#include "Solution.h"
+#include "SpaceFillingCurvePartitionPolicy.h"
+
+using namespace Camellia;
+using namespace Intrepid;
+
+namespace
+{
+  TEUCHOS_UNIT_TEST( SpaceFillingCurvePartitionPolicy, CurveIndex2D )
+  {
+    // with one bit per dimension, the Hilbert curve visits (0,0), (0,1), (1,1), (1,0)
+    typedef SpaceFillingCurvePartitionPolicy SFC;
+    int b = 1;
+    TEST_EQUALITY(SFC::curveIndex(SFC::HILBERT, {0,0}, b), 0);
+    TEST_EQUALITY(SFC::curveIndex(SFC::HILBERT, {0,1}, b), 1);
+    TEST_EQUALITY(SFC::curveIndex(SFC::HILBERT, {1,1}, b), 2);
+    TEST_EQUALITY(SFC::curveIndex(SFC::HILBERT, {1,0}, b), 3);
+
+    // Morton order simply interleaves the bits
+    TEST_EQUALITY(SFC::curveIndex(SFC::MORTON, {0,0}, b), 0);
+    TEST_EQUALITY(SFC::curveIndex(SFC::MORTON, {0,1}, b), 1);
+    TEST_EQUALITY(SFC::curveIndex(SFC::MORTON, {1,0}, b), 2);
+    TEST_EQUALITY(SFC::curveIndex(SFC::MORTON, {1,1}, b), 3);
+  }
+
+  TEUCHOS_UNIT_TEST( SpaceFillingCurvePartitionPolicy, HilbertOrderingIsContiguous )
+  {
+    // on a uniform grid, consecutive cells along the Hilbert curve are neighbors
+    int spaceDim = 2;
+    bool conformingTraces = true;
+    PoissonFormulation form(spaceDim,conformingTraces);
+
+    int H1Order = 1;
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), {1.0,1.0}, {4,4}, H1Order);
+
+    SpaceFillingCurvePartitionPolicy partitionPolicy(MPIWrapper::CommWorld());
+    vector<GlobalIndexType> orderedCells = partitionPolicy.orderedActiveCells(mesh->getTopology());
+    TEST_EQUALITY(orderedCells.size(), 16);
+
+    double h = 0.25, tol = 1e-14;
+    for (int i=1; i<orderedCells.size(); i++)
+    {
+      vector<double> previousCentroid = mesh->getTopology()->getCellCentroid(orderedCells[i-1]);
+      vector<double> centroid = mesh->getTopology()->getCellCentroid(orderedCells[i]);
+      double distance = std::abs(centroid[0]-previousCentroid[0]) + std::abs(centroid[1]-previousCentroid[1]);
+      TEST_FLOATING_EQUALITY(distance, h, tol);
+    }
+  }
+
+  TEUCHOS_UNIT_TEST( SpaceFillingCurvePartitionPolicy, PartitionRefinedMesh )
+  {
+    int spaceDim = 2;
+    bool conformingTraces = true;
+    PoissonFormulation form(spaceDim,conformingTraces);
+
+    int H1Order = 2;
+    MeshPtr mesh = MeshFactory::rectilinearMesh(form.bf(), {1.0,1.0}, {2,2}, H1Order);
+    mesh->setPartitionPolicy(MeshPartitionPolicy::spaceFillingCurvePartitionPolicy(mesh->Comm()));
+
+    SolutionPtr solution = Solution::solution(form.bf(), mesh);
+    mesh->registerSolution(solution);
+    map<int, FunctionPtr> solutionMap;
+    FunctionPtr x = Function::xn();
+    solutionMap[form.phi()->ID()] = x;
+    solution->projectOntoMesh(solutionMap);
+
+    RefinementStrategy::hRefineUniformly(mesh);
+    set<GlobalIndexType> cellsToRefine = {*mesh->getActiveCellIDs().begin()};
+    mesh->hRefine(cellsToRefine);
+
+    // every active cell should belong to exactly one partition
+    GlobalDofAssignmentPtr gda = mesh->globalDofAssignment();
+    int numPartitions = gda->getPartitionCount();
+    GlobalIndexType cellCount = 0;
+    for (int i=0; i<numPartitions; i++)
+    {
+      cellCount += gda->cellsInPartition(i).size();
+    }
+    TEST_EQUALITY(cellCount, mesh->numActiveElements());
+
+    // projected solution should survive refinement and migration
+    double tol = 1e-14;
+    FunctionPtr phiSoln = Function::solution(form.phi(), solution, false);
+    double err = (phiSoln - x)->l2norm(mesh);
+    TEST_COMPARE(err, <, tol);
+  }
+} // namespace